@@ -0,0 +1,335 @@
+#include "clock_align.h"
+#include <QMutexLocker>
+#include <algorithm>
+#include <cmath>
+
+const char* clockSyncStateName(int state)
+{
+    switch (state) {
+        case ClockConverging: return "收敛中";
+        case ClockLocked: return "已锁定";
+        default: return "未知";
+    }
+}
+
+double ClockAligner::modelOffset(const DeviceClock& c, uint64_t deviceNs)
+{
+    return c.intercept + c.slope * (double(int64_t(deviceNs - c.refDeviceNs)));
+}
+
+// 对各桶最小偏移做直线拟合，偏高（拥塞）的桶剔除后再拟合一次
+void ClockAligner::fit(DeviceClock& c)
+{
+    const int n = c.buckets.size();
+    if (n == 0) return;
+    const Bucket& first = c.buckets.first();
+    if (n < 3) {
+        const Bucket* best = &first;
+        for (const Bucket& b : c.buckets) {
+            if (b.offsetNs < best->offsetNs) best = &b;
+        }
+        c.refDeviceNs = best->deviceNs;
+        c.intercept = double(best->offsetNs);
+        c.slope = 0.0;
+        c.residualNs = 0.0;
+        return;
+    }
+
+    QVector<uint8_t> used(n, 1);
+    double slope = 0.0, mid = 0.0;
+    double x0 = 0.0;
+    for (int pass = 0; pass < 2; ++pass) {
+        double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+        int m = 0;
+        for (int i = 0; i < n; ++i) {
+            if (!used[i]) continue;
+            const double x = double(int64_t(c.buckets[i].deviceNs - first.deviceNs));
+            const double y = double(c.buckets[i].offsetNs - first.offsetNs);
+            sx += x; sy += y; sxx += x * x; sxy += x * y;
+            m++;
+        }
+        if (m < 2) break;
+        const double denom = double(m) * sxx - sx * sx;
+        slope = denom > 0.0 ? (double(m) * sxy - sx * sy) / denom : 0.0;
+        x0 = sx / m;
+        mid = sy / m;
+
+        if (pass == 1) break;
+        // MAD 剔除偏高的桶（只会因排队变晚，不会提前）
+        QVector<double> residuals;
+        residuals.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            const double x = double(int64_t(c.buckets[i].deviceNs - first.deviceNs));
+            const double y = double(c.buckets[i].offsetNs - first.offsetNs);
+            residuals.append(y - (mid + slope * (x - x0)));
+        }
+        QVector<double> sorted = residuals;
+        for (double& r : sorted) r = std::fabs(r);
+        std::nth_element(sorted.begin(), sorted.begin() + n / 2, sorted.end());
+        const double limit = 3.0 * std::max(1.4826 * sorted[n / 2], 20000.0);
+        bool dropped = false;
+        for (int i = 0; i < n; ++i) {
+            if (residuals[i] > limit) { used[i] = 0; dropped = true; }
+        }
+        if (!dropped) break;
+    }
+
+    double sumSq = 0.0;
+    int m = 0;
+    for (int i = 0; i < n; ++i) {
+        if (!used[i]) continue;
+        const double x = double(int64_t(c.buckets[i].deviceNs - first.deviceNs));
+        const double y = double(c.buckets[i].offsetNs - first.offsetNs);
+        const double r = y - (mid + slope * (x - x0));
+        sumSq += r * r;
+        m++;
+    }
+    c.residualNs = m ? std::sqrt(sumSq / m) : 0.0;
+    c.slope = slope;
+    c.refDeviceNs = first.deviceNs + uint64_t(int64_t(x0));
+    c.intercept = double(first.offsetNs) + mid;
+}
+
+ClockAligner::Model ClockAligner::modelOf(const DeviceClock& c)
+{
+    Model m;
+    m.started = c.started;
+    m.refDeviceNs = c.refDeviceNs;
+    m.intercept = c.intercept;
+    m.slope = c.slope;
+    return m;
+}
+
+std::shared_ptr<const ClockAligner::DeviceTable> ClockAligner::table() const
+{
+    return std::atomic_load(&m_table);
+}
+
+std::shared_ptr<ClockAligner::Device> ClockAligner::findOrAdd(uint32_t handle)
+{
+    {
+        const std::shared_ptr<const DeviceTable> t = table();
+        auto it = t->constFind(handle);
+        if (it != t->constEnd()) return it.value();
+    }
+    // 新设备：复制设备表后整体替换，读者始终看到完整的快照
+    QMutexLocker locker(&m_mutex);
+    const std::shared_ptr<const DeviceTable> t = table();
+    auto it = t->constFind(handle);
+    if (it != t->constEnd()) return it.value();
+    std::shared_ptr<DeviceTable> next = std::make_shared<DeviceTable>(*t);
+    std::shared_ptr<Device> d = std::make_shared<Device>();
+    d->onlineOrder = m_nextOnlineOrder++;
+    next->insert(handle, d);
+    std::atomic_store(&m_table, std::shared_ptr<const DeviceTable>(next));
+    if (!reference()->valid) {
+        std::shared_ptr<Reference> ref = std::make_shared<Reference>();
+        ref->valid = true;
+        ref->handle = handle;
+        std::atomic_store(&m_reference, std::shared_ptr<const Reference>(ref));
+    }
+    return d;
+}
+
+std::shared_ptr<const ClockAligner::Reference> ClockAligner::reference() const
+{
+    return std::atomic_load(&m_reference);
+}
+
+bool ClockAligner::referenceModel(const Reference& ref, Model* out) const
+{
+    if (!ref.valid) return false;
+    const std::shared_ptr<const DeviceTable> t = table();
+    auto it = t->constFind(ref.handle);
+    if (it == t->constEnd()) return false;
+    QMutexLocker locker(&it.value()->mutex);
+    *out = modelOf(it.value()->clock);
+    return out->started;
+}
+
+// 设备时间 → 主机时间 → 参考设备时间（参考设备模型的反函数）
+uint64_t ClockAligner::mapToReference(uint32_t handle, const Model& c, uint64_t deviceNs) const
+{
+    const std::shared_ptr<const Reference> ref = reference();
+    if (!ref->valid) return deviceNs;
+    const uint64_t shift = uint64_t(ref->shiftNs);
+    Model r;
+    if (handle == ref->handle || !c.started || !referenceModel(*ref, &r)) return deviceNs + shift;
+    // host = d + intercept + slope·(d - refD)，以相对参考原点的差值计算避免精度损失
+    const double ownOffset = c.intercept + c.slope * double(int64_t(deviceNs - c.refDeviceNs));
+    const double host = double(int64_t(deviceNs - r.refDeviceNs)) + ownOffset - r.intercept;
+    const double d = host / (1.0 + r.slope);
+    const double mapped = double(r.refDeviceNs) + d;
+    return (mapped > 0.0 ? uint64_t(mapped) : 0) + shift;
+}
+
+int ClockAligner::stateOf(const DeviceClock& c)
+{
+    if (!c.started || c.buckets.size() < 2) return ClockUnknown;
+    if (c.buckets.size() >= 10 && c.residualNs < 1e6) return ClockLocked;
+    return ClockConverging;
+}
+
+uint64_t ClockAligner::observe(uint32_t handle, uint64_t deviceNs, uint64_t hostNs)
+{
+    const std::shared_ptr<Device> device = findOrAdd(handle);
+    Model model;
+    {
+        QMutexLocker locker(&device->mutex);
+        DeviceClock& c = device->clock;
+        const int64_t offset = int64_t(hostNs - deviceNs);
+
+        if (c.started) {
+            // 设备时间跳变（回退、或到达早于下包络太多）时重建模型
+            const double deviation = double(offset) - modelOffset(c, deviceNs);
+            const bool backwards = deviceNs + uint64_t(kResetThresholdNs) < c.lastDeviceNs;
+            if (backwards || deviation < -double(kResetThresholdNs) || deviation > 10.0 * double(kResetThresholdNs)) {
+                const uint64_t resets = c.resets + 1;
+                c = DeviceClock();
+                c.resets = resets;
+            }
+        }
+        if (!c.started) {
+            c.started = true;
+            c.refDeviceNs = deviceNs;
+            c.intercept = double(offset);
+        }
+        c.samples++;
+        c.lastDeviceNs = std::max(c.lastDeviceNs, deviceNs);
+
+        // 更新下包络分桶；进入新桶时重新拟合
+        const uint64_t index = deviceNs / kBucketNs;
+        if (c.buckets.isEmpty() || c.buckets.last().index < index) {
+            Bucket b;
+            b.index = index;
+            b.deviceNs = deviceNs;
+            b.offsetNs = offset;
+            c.buckets.append(b);
+            if (c.buckets.size() > kBuckets) c.buckets.removeFirst();
+            fit(c);
+        } else {
+            for (int i = c.buckets.size() - 1; i >= 0; --i) {
+                Bucket& b = c.buckets[i];
+                if (b.index != index) {
+                    if (b.index < index) break;
+                    continue;
+                }
+                if (offset < b.offsetNs) {
+                    b.offsetNs = offset;
+                    b.deviceNs = deviceNs;
+                    // 尚未拟合出漂移时，下包络变低立即生效
+                    if (c.buckets.size() < 3) fit(c);
+                }
+                break;
+            }
+        }
+
+        const double predicted = modelOffset(c, deviceNs);
+        c.jitterNs += (std::max(0.0, double(offset) - predicted) - c.jitterNs) / 64.0;
+        model = modelOf(c);
+    }
+    return mapToReference(handle, model, deviceNs);
+}
+
+uint64_t ClockAligner::toCommon(uint32_t handle, uint64_t deviceNs) const
+{
+    const std::shared_ptr<const DeviceTable> t = table();
+    auto it = t->constFind(handle);
+    if (it == t->constEnd()) return deviceNs;
+    Model model;
+    {
+        QMutexLocker locker(&it.value()->mutex);
+        model = modelOf(it.value()->clock);
+    }
+    return mapToReference(handle, model, deviceNs);
+}
+
+uint32_t ClockAligner::referenceHandle() const
+{
+    return reference()->handle;
+}
+
+bool ClockAligner::summary(uint32_t handle, ClockSyncSummary* out) const
+{
+    const std::shared_ptr<const DeviceTable> t = table();
+    auto it = t->constFind(handle);
+    if (it == t->constEnd() || !out) return false;
+    Model model;
+    uint64_t lastDeviceNs = 0;
+    {
+        QMutexLocker locker(&it.value()->mutex);
+        const DeviceClock& c = it.value()->clock;
+        out->handle = handle;
+        out->state = stateOf(c);
+        out->samples = c.samples;
+        out->offsetNs = int64_t(modelOffset(c, c.lastDeviceNs));
+        out->driftPpm = c.slope * 1e6;
+        out->jitterUs = c.jitterNs / 1000.0;
+        out->residualUs = c.residualNs / 1000.0;
+        out->resets = c.resets;
+        model = modelOf(c);
+        lastDeviceNs = c.lastDeviceNs;
+    }
+    const std::shared_ptr<const Reference> ref = reference();
+    out->reference = ref->valid && handle == ref->handle;
+    out->toReferenceNs = int64_t(mapToReference(handle, model, lastDeviceNs) - lastDeviceNs);
+    return true;
+}
+
+QVector<ClockSyncSummary> ClockAligner::snapshot() const
+{
+    QVector<ClockSyncSummary> out;
+    const std::shared_ptr<const DeviceTable> t = table();
+    for (auto it = t->constBegin(); it != t->constEnd(); ++it) {
+        ClockSyncSummary s;
+        if (summary(it.key(), &s)) out.append(s);
+    }
+    return out;
+}
+
+void ClockAligner::remove(uint32_t handle)
+{
+    QMutexLocker locker(&m_mutex);
+    const std::shared_ptr<const DeviceTable> t = table();
+    if (!t->contains(handle)) return;
+    std::shared_ptr<DeviceTable> next = std::make_shared<DeviceTable>(*t);
+    next->remove(handle);
+
+    const std::shared_ptr<const Reference> ref = reference();
+    if (ref->valid && handle == ref->handle) {
+        // 其余设备中最早上线的接任参考设备
+        std::shared_ptr<Reference> successor = std::make_shared<Reference>();
+        std::shared_ptr<Device> best;
+        for (auto it = next->constBegin(); it != next->constEnd(); ++it) {
+            if (!best || it.value()->onlineOrder < best->onlineOrder) {
+                best = it.value();
+                successor->handle = it.key();
+            }
+        }
+        if (best) {
+            successor->valid = true;
+            successor->shiftNs = ref->shiftNs;
+            Model model;
+            uint64_t lastDeviceNs = 0;
+            {
+                QMutexLocker deviceLocker(&best->mutex);
+                model = modelOf(best->clock);
+                lastDeviceNs = best->clock.lastDeviceNs;
+            }
+            // 旧参考设备仍在表中：按旧时基映射新参考设备的最新时间，两者之差即为衔接所需的平移
+            if (model.started) {
+                successor->shiftNs = int64_t(mapToReference(successor->handle, model, lastDeviceNs) - lastDeviceNs);
+            }
+        }
+        // 先切换参考设备再移除旧表项，读者不会看到“参考设备已不在表中”的组合
+        std::atomic_store(&m_reference, std::shared_ptr<const Reference>(successor));
+    }
+    std::atomic_store(&m_table, std::shared_ptr<const DeviceTable>(next));
+}
+
+void ClockAligner::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    std::atomic_store(&m_reference, std::make_shared<const Reference>());
+    std::atomic_store(&m_table, std::make_shared<const DeviceTable>());
+}
@@ -0,0 +1,119 @@
+#ifndef CLOCK_ALIGN_H
+#define CLOCK_ALIGN_H
+
+#include <QMap>
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// 单设备时钟同步状态
+enum ClockSyncState {
+    ClockUnknown = 0,   // 样本不足，按首包偏移映射
+    ClockConverging,    // 已有偏移，漂移尚未稳定
+    ClockLocked         // 偏移 + 漂移已收敛
+};
+
+const char* clockSyncStateName(int state);
+
+struct ClockSyncSummary {
+    uint32_t handle = 0;
+    int state = ClockUnknown;
+    uint64_t samples = 0;
+    bool reference = false;     // 是否为统一时基的参考设备
+    int64_t offsetNs = 0;       // 当前 主机时间 - 设备时间（含网络最小时延）
+    int64_t toReferenceNs = 0;  // 映射到参考设备时间需加的量（时钟已同步的设备应接近 0）
+    double driftPpm = 0.0;      // 设备时钟相对主机的漂移（正值：设备走得慢）
+    double jitterUs = 0.0;      // 到达时延相对下包络的平均抖动
+    double residualUs = 0.0;    // 下包络拟合残差（RMS）
+    uint64_t resets = 0;        // 设备时间跳变导致的模型重置（重新同步、修改时间偏移等）
+};
+
+// 多设备时钟对齐：以主机到达时间为桥梁，为每个设备在线估计 offset + drift，
+// 把设备时间戳映射到参考设备（最早上线且仍在线的设备）的时间轴，再参与滑动窗口合并。
+// 参考设备自身的时间戳不变，单设备时与未对齐完全一致。参考设备下线时改由其余设备中最早上线的
+// 接任，并记下新旧参考设备之间的差值作为整体平移，统一时基不因切换而跳变。
+// 网络/调度时延只会让到达偏晚，因此按时间分桶取每桶最小的 (主机 - 设备) 作为下包络，
+// 对下包络做直线拟合（剔除偏高的离群桶），对抖动不敏感。
+// observe()/toCommon() 可在任意线程调用，每设备独立加锁，不同设备的线程互不阻塞。
+// 关闭时仍持续估计（用于显示同步质量），但流水线按原始设备时间戳合并。
+class ClockAligner
+{
+public:
+    static const uint64_t kBucketNs = 500000000ULL;     // 下包络分桶（设备时间）
+    static const int kBuckets = 60;                      // 拟合使用最近 30s
+    static const int64_t kResetThresholdNs = 100000000; // 偏离模型超过 100ms 视为时间跳变
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // 记录一个包（设备时间戳、主机到达时间），返回映射后的统一时间
+    uint64_t observe(uint32_t handle, uint64_t deviceNs, uint64_t hostNs);
+    // 按当前模型映射；设备未知时原样返回
+    uint64_t toCommon(uint32_t handle, uint64_t deviceNs) const;
+    uint32_t referenceHandle() const;
+
+    QVector<ClockSyncSummary> snapshot() const;
+    bool summary(uint32_t handle, ClockSyncSummary* out) const;
+    void remove(uint32_t handle);
+    void reset();
+
+private:
+    struct Bucket {
+        uint64_t index = 0;         // deviceNs / kBucketNs
+        uint64_t deviceNs = 0;      // 取到最小偏移的样本
+        int64_t offsetNs = 0;
+    };
+    struct DeviceClock {
+        bool started = false;
+        uint64_t refDeviceNs = 0;   // 拟合的时间原点
+        double intercept = 0.0;     // refDeviceNs 处的偏移（ns）
+        double slope = 0.0;         // 每 ns 设备时间的偏移变化
+        QVector<Bucket> buckets;    // 按 index 递增
+        double jitterNs = 0.0;
+        double residualNs = 0.0;
+        uint64_t samples = 0;
+        uint64_t resets = 0;
+        uint64_t lastDeviceNs = 0;
+    };
+
+    // 映射所需的模型参数（从设备锁内复制出来，映射时不持有任何锁）
+    struct Model {
+        bool started = false;
+        uint64_t refDeviceNs = 0;
+        double intercept = 0.0;
+        double slope = 0.0;
+    };
+    struct Device {
+        mutable QMutex mutex;
+        DeviceClock clock;
+        uint64_t onlineOrder = 0;   // 上线顺序，创建后不变
+    };
+    // 参考设备与整体平移，整体替换保证两者一致
+    struct Reference {
+        bool valid = false;
+        uint32_t handle = 0;
+        int64_t shiftNs = 0;        // 映射结果统一加上该值（切换参考设备时衔接时基）
+    };
+    using DeviceTable = QMap<uint32_t, std::shared_ptr<Device>>;
+
+    static double modelOffset(const DeviceClock& c, uint64_t deviceNs);
+    static Model modelOf(const DeviceClock& c);
+    static void fit(DeviceClock& c);
+    static int stateOf(const DeviceClock& c);
+    std::shared_ptr<const DeviceTable> table() const;
+    std::shared_ptr<Device> findOrAdd(uint32_t handle);
+    std::shared_ptr<const Reference> reference() const;
+    bool referenceModel(const Reference& ref, Model* out) const;
+    uint64_t mapToReference(uint32_t handle, const Model& own, uint64_t deviceNs) const;
+
+    std::atomic<bool> m_enabled{true};
+    // 设备表为只读快照（std::atomic_load/store），仅增删设备时在 m_mutex 下复制替换
+    mutable QMutex m_mutex;
+    std::shared_ptr<const DeviceTable> m_table = std::make_shared<const DeviceTable>();
+    std::shared_ptr<const Reference> m_reference = std::make_shared<const Reference>();
+    uint64_t m_nextOnlineOrder = 0;     // 受 m_mutex 保护
+};
+
+#endif // CLOCK_ALIGN_H
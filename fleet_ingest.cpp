@@ -0,0 +1,301 @@
+#include "fleet_ingest.h"
+#include "latency_tracker.h"
+#include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+const int kIdleSleepMs = 1;
+
+} // namespace
+
+void FleetIngest::publishLocked(const std::shared_ptr<Table>& table)
+{
+    std::atomic_store(&m_table, std::shared_ptr<const Table>(table));
+}
+
+void FleetIngest::start(int workers)
+{
+    if (m_running.load()) return;
+    if (workers <= 0) workers = std::max(1, QThread::idealThreadCount());
+    {
+        QMutexLocker locker(&m_mutex);
+        m_workers.clear();
+        for (int i = 0; i < workers; ++i) m_workers.append(std::make_shared<Worker>());
+        // 已登记的设备按顺序轮流分配
+        std::shared_ptr<Table> next = std::make_shared<Table>();
+        next->devices = table()->devices;
+        next->workers.resize(workers);
+        int index = 0;
+        for (auto it = next->devices.begin(); it != next->devices.end(); ++it) {
+            it.value()->worker = index;
+            next->workers[index].append(it.value());
+            index = (index + 1) % workers;
+        }
+        publishLocked(next);
+        m_sinceSnapshot.start();
+    }
+    m_running.store(true);
+    for (int i = 0; i < workers; ++i) {
+        m_workers[i]->thread = std::thread([this, i]() { runWorker(i); });
+    }
+    m_accepting.store(true);
+}
+
+void FleetIngest::stop()
+{
+    if (!m_running.load()) return;
+    // 先关闭入口，等进行中的 push 写完，此后队列不再增长
+    m_accepting.store(false);
+    while (m_pushers.load() > 0) std::this_thread::yield();
+    if (!m_running.exchange(false)) return;
+
+    QVector<std::shared_ptr<Worker>> workers;
+    {
+        QMutexLocker locker(&m_mutex);
+        workers = m_workers;
+    }
+    for (const auto& w : workers) {
+        if (w->thread.joinable()) w->thread.join();
+    }
+    QMutexLocker locker(&m_mutex);
+    m_workers.clear();
+    // 丢弃未处理的包，下次启动不再处理过期数据
+    const std::shared_ptr<const Table> t = table();
+    for (auto it = t->devices.constBegin(); it != t->devices.constEnd(); ++it) {
+        Device& d = *it.value();
+        const uint64_t mask = uint64_t(kRingPackets) - 1;
+        for (;;) {
+            Slot& slot = d.slots[d.dequeue & mask];
+            if (slot.seq.load(std::memory_order_acquire) != d.dequeue + 1) break;
+            slot.seq.store(d.dequeue + kRingPackets, std::memory_order_release);
+            d.dequeue++;
+        }
+    }
+}
+
+int FleetIngest::workerCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_workers.size();
+}
+
+std::shared_ptr<FleetIngest::Device> FleetIngest::findOrAdd(uint32_t handle)
+{
+    {
+        const std::shared_ptr<const Table> t = table();
+        auto it = t->devices.constFind(handle);
+        if (it != t->devices.constEnd()) return it.value();
+    }
+
+    // 新设备：复制设备表后整体替换
+    QMutexLocker locker(&m_mutex);
+    const std::shared_ptr<const Table> t = table();
+    auto it = t->devices.constFind(handle);
+    if (it != t->devices.constEnd()) return it.value();
+
+    std::shared_ptr<Device> d = std::make_shared<Device>();
+    d->handle = handle;
+    d->slots.reset(new Slot[kRingPackets]);
+    for (int i = 0; i < kRingPackets; ++i) d->slots[i].seq.store(uint64_t(i), std::memory_order_relaxed);
+
+    int rendered = 0;
+    for (auto r = t->devices.constBegin(); r != t->devices.constEnd(); ++r) {
+        if (r.value()->rendered.load()) rendered++;
+    }
+    d->rendered.store(rendered < kDefaultRendered);
+
+    std::shared_ptr<Table> next = std::make_shared<Table>(*t);
+    // 分配到设备最少的工作线程
+    if (!next->workers.isEmpty()) {
+        int best = 0;
+        for (int i = 1; i < next->workers.size(); ++i) {
+            if (next->workers[i].size() < next->workers[best].size()) best = i;
+        }
+        d->worker = best;
+        next->workers[best].append(d);
+    }
+    next->devices.insert(handle, d);
+    publishLocked(next);
+    return d;
+}
+
+void FleetIngest::addDevice(uint32_t handle)
+{
+    findOrAdd(handle);
+}
+
+void FleetIngest::removeDevice(uint32_t handle)
+{
+    QMutexLocker locker(&m_mutex);
+    const std::shared_ptr<const Table> t = table();
+    auto it = t->devices.constFind(handle);
+    if (it == t->devices.constEnd()) return;
+    const std::shared_ptr<Device> d = it.value();
+    std::shared_ptr<Table> next = std::make_shared<Table>(*t);
+    next->devices.remove(handle);
+    for (auto& list : next->workers) list.removeAll(d);
+    publishLocked(next);
+}
+
+void FleetIngest::setRendered(uint32_t handle, bool rendered)
+{
+    findOrAdd(handle)->rendered.store(rendered);
+}
+
+bool FleetIngest::isRendered(uint32_t handle) const
+{
+    const std::shared_ptr<const Table> t = table();
+    auto it = t->devices.constFind(handle);
+    return it != t->devices.constEnd() && it.value()->rendered.load();
+}
+
+bool FleetIngest::push(uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t hostArrivalNs)
+{
+    if (!packet) return false;
+    // 登记为生产者后再检查入口，stop() 关闭入口后等待计数归零
+    m_pushers.fetch_add(1);
+    if (!m_accepting.load()) {
+        m_pushers.fetch_sub(1);
+        return false;
+    }
+    const bool ok = [&]() {
+        const std::shared_ptr<Device> d = findOrAdd(handle);
+        // length 即整包大小（含包头）
+        const size_t size = packet->length;
+        if (size < offsetof(LivoxLidarEthernetPacket, data) || size > size_t(kMaxPacketBytes)) {
+            d->dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // 有界多生产者队列（同 LogRing），满时丢弃最新包并计数
+        const uint64_t mask = uint64_t(kRingPackets) - 1;
+        uint64_t pos = d->enqueue.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        for (;;) {
+            slot = &d->slots[pos & mask];
+            const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+            const int64_t diff = int64_t(seq) - int64_t(pos);
+            if (diff == 0) {
+                if (d->enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                d->dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = d->enqueue.load(std::memory_order_relaxed);
+            }
+        }
+        std::memcpy(slot->data, packet, size);
+        slot->size = uint16_t(size);
+        slot->arrivalNs = hostArrivalNs;
+        slot->seq.store(pos + 1, std::memory_order_release);
+
+        d->packets.fetch_add(1, std::memory_order_relaxed);
+        d->points.fetch_add(packet->dot_num, std::memory_order_relaxed);
+        d->lastArrivalNs.store(hostArrivalNs, std::memory_order_relaxed);
+        return true;
+    }();
+    m_pushers.fetch_sub(1);
+    return ok;
+}
+
+int FleetIngest::drain(Device& d, uint64_t* points)
+{
+    const uint64_t mask = uint64_t(kRingPackets) - 1;
+    int n = 0;
+    // 每轮最多一圈，避免单台设备独占工作线程
+    while (n < kRingPackets) {
+        Slot& slot = d.slots[d.dequeue & mask];
+        if (slot.seq.load(std::memory_order_acquire) != d.dequeue + 1) break;
+        const LivoxLidarEthernetPacket* packet = reinterpret_cast<const LivoxLidarEthernetPacket*>(slot.data);
+        *points += packet->dot_num;
+        if (m_handler) {
+            // 每包读取显示状态，取消显示后不再有该设备的帧进入合并窗口
+            const bool render = d.rendered.load(std::memory_order_relaxed);
+            m_handler(d.handle, packet, slot.arrivalNs, render);
+        }
+        slot.seq.store(d.dequeue + kRingPackets, std::memory_order_release);
+        d.dequeue++;
+        n++;
+    }
+    return n;
+}
+
+void FleetIngest::runWorker(int index)
+{
+    std::shared_ptr<Worker> worker;
+    {
+        QMutexLocker locker(&m_mutex);
+        worker = m_workers[index];
+    }
+    while (m_running.load()) {
+        // 每轮取一次设备表快照，不与 push 及其他工作线程争锁
+        const std::shared_ptr<const Table> t = table();
+        int handled = 0;
+        if (index < t->workers.size()) {
+            for (const auto& d : t->workers[index]) {
+                const uint64_t t0 = hostMonotonicNs();
+                uint64_t points = 0;
+                const int n = drain(*d, &points);
+                if (n == 0) continue;
+                const uint64_t busy = hostMonotonicNs() - t0;
+                d->busyNs.fetch_add(busy, std::memory_order_relaxed);
+                worker->busyNs.fetch_add(busy, std::memory_order_relaxed);
+                worker->packets.fetch_add(uint64_t(n), std::memory_order_relaxed);
+                if (m_batchHandler) m_batchHandler(d->handle, n, points, busy);
+                handled += n;
+            }
+        }
+        if (handled == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(kIdleSleepMs));
+        }
+    }
+}
+
+QVector<FleetDeviceStats> FleetIngest::snapshot(QVector<FleetWorkerStats>* workers)
+{
+    QVector<FleetDeviceStats> out;
+    QMutexLocker locker(&m_mutex);
+    const double seconds = m_sinceSnapshot.isValid() ? std::max(1e-3, double(m_sinceSnapshot.restart()) / 1000.0) : 1.0;
+    if (!m_sinceSnapshot.isValid()) m_sinceSnapshot.start();
+    const std::shared_ptr<const Table> t = table();
+    out.reserve(t->devices.size());
+    for (auto it = t->devices.constBegin(); it != t->devices.constEnd(); ++it) {
+        Device& d = *it.value();
+        FleetDeviceStats s;
+        s.handle = d.handle;
+        s.worker = d.worker;
+        s.rendered = d.rendered.load();
+        s.packets = d.packets.load(std::memory_order_relaxed);
+        s.points = d.points.load(std::memory_order_relaxed);
+        s.dropped = d.dropped.load(std::memory_order_relaxed);
+        s.lastArrivalNs = d.lastArrivalNs.load(std::memory_order_relaxed);
+        const uint64_t busy = d.busyNs.load(std::memory_order_relaxed);
+        const uint64_t packets = s.packets - d.packetsAtSnapshot;
+        s.packetsPerSec = double(packets) / seconds;
+        s.pointsPerSec = double(s.points - d.pointsAtSnapshot) / seconds;
+        s.busyUsPerPacket = packets ? double(busy - d.busyAtSnapshot) / 1e3 / double(packets) : 0.0;
+        d.packetsAtSnapshot = s.packets;
+        d.pointsAtSnapshot = s.points;
+        d.busyAtSnapshot = busy;
+        out.append(s);
+    }
+    if (workers) {
+        workers->clear();
+        for (int i = 0; i < m_workers.size(); ++i) {
+            Worker* w = m_workers[i].get();
+            FleetWorkerStats s;
+            s.packets = w->packets.load(std::memory_order_relaxed);
+            const uint64_t busy = w->busyNs.load(std::memory_order_relaxed);
+            s.busyRatio = std::min(1.0, double(busy - w->busyAtSnapshot) / 1e9 / seconds);
+            s.devices = i < t->workers.size() ? t->workers[i].size() : 0;
+            w->busyAtSnapshot = busy;
+            workers->append(s);
+        }
+    }
+    return out;
+}
@@ -0,0 +1,131 @@
+#ifndef FLEET_INGEST_H
+#define FLEET_INGEST_H
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+
+extern "C" {
+    #include "livox_lidar_def.h"
+}
+
+struct FleetDeviceStats {
+    uint32_t handle = 0;
+    int worker = 0;
+    bool rendered = false;
+    uint64_t packets = 0;
+    uint64_t points = 0;
+    uint64_t dropped = 0;           // 环形队列满或包过大而丢弃
+    uint64_t lastArrivalNs = 0;     // hostMonotonicNs
+    double packetsPerSec = 0.0;     // 距上次 snapshot
+    double pointsPerSec = 0.0;
+    double busyUsPerPacket = 0.0;   // 工作线程处理耗时（解码、录制）
+};
+
+struct FleetWorkerStats {
+    uint64_t packets = 0;
+    double busyRatio = 0.0;         // 距上次 snapshot 的忙碌比例
+    int devices = 0;
+};
+
+// 多雷达接收（车队模式）：SDK 回调线程只把数据包拷入该设备的有界环形队列，
+// 设备按负载分配到固定的工作线程，由工作线程取出后调用处理函数（解码、录制）。
+// 同一设备始终由同一线程按到达顺序处理，设备之间互不阻塞，CPU 随设备数分摊到多核。
+// 未选中显示的设备 render 为 false，处理函数可跳过解码，只保留统计与录制。
+// 设备表是整体替换的只读快照，push 与工作线程查表不加锁；只有增删设备、启停时持有 m_mutex。
+class FleetIngest
+{
+public:
+    using PacketHandler = std::function<void(uint32_t handle, const LivoxLidarEthernetPacket* packet,
+                                             uint64_t hostArrivalNs, bool render)>;
+    // 每台设备每轮取完后调用一次，用于按批记录统计，避免每包争用共享锁
+    using BatchHandler = std::function<void(uint32_t handle, int packets, uint64_t points, uint64_t busyNs)>;
+
+    static const int kRingPackets = 512;        // 2 的幂；约 250ms 的 Mid-360 点云包
+    static const int kMaxPacketBytes = 1500;    // 单个 UDP 负载上限
+    static const int kDefaultRendered = 4;      // 新设备默认显示，直到已显示设备达到该数量
+
+    FleetIngest() = default;
+    ~FleetIngest() { stop(); }
+    FleetIngest(const FleetIngest&) = delete;
+    FleetIngest& operator=(const FleetIngest&) = delete;
+
+    // 处理函数在工作线程调用，需在 start() 前设置
+    void setHandler(const PacketHandler& handler) { m_handler = handler; }
+    void setBatchHandler(const BatchHandler& handler) { m_batchHandler = handler; }
+    // workers <= 0 时取 CPU 核心数
+    void start(int workers = 0);
+    // 先关闭入口并等待进行中的 push 返回，再停止工作线程并丢弃未处理的包
+    void stop();
+    bool isRunning() const { return m_running.load(); }
+    int workerCount() const;
+
+    // 任意线程；未登记的设备在首个数据包到达时自动加入。未启动或正在停止时返回 false
+    bool push(uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t hostArrivalNs);
+    void addDevice(uint32_t handle);
+    void removeDevice(uint32_t handle);
+
+    void setRendered(uint32_t handle, bool rendered);
+    bool isRendered(uint32_t handle) const;
+
+    QVector<FleetDeviceStats> snapshot(QVector<FleetWorkerStats>* workers = nullptr);
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq{0};
+        uint64_t arrivalNs = 0;
+        uint16_t size = 0;
+        alignas(8) uint8_t data[kMaxPacketBytes];
+    };
+    struct Device {
+        uint32_t handle = 0;
+        int worker = 0;
+        std::unique_ptr<Slot[]> slots;
+        alignas(64) std::atomic<uint64_t> enqueue{0};
+        alignas(64) uint64_t dequeue = 0;       // 仅所属工作线程
+        std::atomic_bool rendered{false};
+        std::atomic<uint64_t> packets{0};
+        std::atomic<uint64_t> points{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> busyNs{0};
+        std::atomic<uint64_t> lastArrivalNs{0};
+        uint64_t packetsAtSnapshot = 0;
+        uint64_t pointsAtSnapshot = 0;
+        uint64_t busyAtSnapshot = 0;
+    };
+    struct Worker {
+        std::thread thread;
+        std::atomic<uint64_t> packets{0};
+        std::atomic<uint64_t> busyNs{0};
+        uint64_t busyAtSnapshot = 0;
+    };
+    // 只读快照：设备表及各工作线程负责的设备
+    struct Table {
+        QMap<uint32_t, std::shared_ptr<Device>> devices;
+        QVector<QVector<std::shared_ptr<Device>>> workers;
+    };
+
+    std::shared_ptr<const Table> table() const { return std::atomic_load(&m_table); }
+    void publishLocked(const std::shared_ptr<Table>& table);
+    std::shared_ptr<Device> findOrAdd(uint32_t handle);
+    void runWorker(int index);
+    int drain(Device& device, uint64_t* points);
+
+    mutable QMutex m_mutex;                     // 增删设备、启停、snapshot
+    std::shared_ptr<const Table> m_table = std::make_shared<const Table>();
+    QVector<std::shared_ptr<Worker>> m_workers;
+    QElapsedTimer m_sinceSnapshot;
+    PacketHandler m_handler;
+    BatchHandler m_batchHandler;
+    std::atomic_bool m_running{false};
+    std::atomic_bool m_accepting{false};
+    std::atomic<int> m_pushers{0};              // 正在 push 的生产者数
+};
+
+#endif // FLEET_INGEST_H
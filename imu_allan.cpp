@@ -0,0 +1,165 @@
+#include "imu_allan.h"
+#include <cmath>
+#include <thread>
+
+void AllanAxis::push(Level& l, double theta)
+{
+    const int size = l.history.size();
+    l.history[l.pos] = theta;
+    if (++l.filled >= uint64_t(size)) {
+        // 环形缓冲中最旧的是 θ(n-2m)，往后 span 个是 θ(n-m)
+        int oldest = l.pos + 1;
+        if (oldest == size) oldest = 0;
+        int mid = oldest + l.span;
+        if (mid >= size) mid -= size;
+        const double d = theta - 2.0 * l.history[mid] + l.history[oldest];
+        l.sum += d * d;
+        l.terms++;
+    }
+    if (++l.pos == size) l.pos = 0;
+}
+
+AllanAxis::AllanAxis()
+{
+    for (int j = 0; j < kLevels; ++j) {
+        Level& l = m_levels[j];
+        const uint64_t m = 1ULL << j;
+        l.stride = m > uint64_t(kResolution) ? m / uint64_t(kResolution) : 1;
+        l.span = int(m / l.stride);
+        l.history.resize(2 * l.span + 1);
+    }
+}
+
+void AllanAxis::reset()
+{
+    for (Level& l : m_levels) {
+        l.pos = 0;
+        l.filled = 0;
+        l.sum = 0.0;
+        l.terms = 0;
+    }
+    m_theta = 0.0;
+    m_offset = 0.0;
+    m_count = 0;
+}
+
+void AllanAxis::add(const ImuSample* samples, int count, int channel)
+{
+    for (int i = 0; i < count; ++i) {
+        const double y = samples[i].value[channel];
+        if (m_count == 0) {
+            m_offset = y;
+            for (Level& l : m_levels) push(l, 0.0);
+        }
+        m_theta += y - m_offset;
+        m_count++;
+        // 步长均为 2 的幂且逐层不减，某层不在抽样点上时更高层也不在
+        for (Level& l : m_levels) {
+            if (m_count & (l.stride - 1)) break;
+            push(l, m_theta);
+        }
+    }
+}
+
+QVector<AllanPoint> AllanAxis::curve(double tau0) const
+{
+    QVector<AllanPoint> out;
+    for (int j = 0; j < kLevels; ++j) {
+        const Level& l = m_levels[j];
+        if (l.terms == 0) break;
+        const double m = double(1ULL << j);
+        AllanPoint p;
+        p.tau = m * tau0;
+        p.adev = std::sqrt(l.sum / (2.0 * m * m * double(l.terms)));
+        p.clusters = m_count >> j;
+        out.append(p);
+    }
+    return out;
+}
+
+void AllanDeviation::reset()
+{
+    for (AllanAxis& a : m_axes) a.reset();
+    m_lastTs = 0;
+    m_intervalSumNs = 0;
+    m_intervals = 0;
+    m_gaps = 0;
+}
+
+void AllanDeviation::addSamples(const ImuSample* samples, int count)
+{
+    if (count <= 0) return;
+    // 采样间隔与丢包统计（跨越丢包的间隔不计入）
+    for (int i = 0; i < count; ++i) {
+        const uint64_t ts = samples[i].timestamp;
+        if (m_lastTs != 0 && ts > m_lastTs) {
+            const uint64_t dt = ts - m_lastTs;
+            if (m_intervals > 0 && dt > 2 * m_intervalSumNs / m_intervals) {
+                m_gaps++;
+            } else {
+                m_intervalSumNs += dt;
+                m_intervals++;
+            }
+        }
+        m_lastTs = ts;
+    }
+
+    if (count < kParallelMinSamples) {
+        for (int ch = 0; ch < ImuChannelCount; ++ch) m_axes[ch].add(samples, count, ch);
+        return;
+    }
+    std::thread workers[ImuChannelCount - 1];
+    for (int ch = 1; ch < ImuChannelCount; ++ch) {
+        workers[ch - 1] = std::thread([this, samples, count, ch]() { m_axes[ch].add(samples, count, ch); });
+    }
+    m_axes[0].add(samples, count, 0);
+    for (std::thread& w : workers) w.join();
+}
+
+double AllanDeviation::sampleInterval() const
+{
+    if (m_intervals == 0) return 0.005;
+    return double(m_intervalSumNs) / double(m_intervals) / 1e9;
+}
+
+QVector<AllanPoint> AllanDeviation::curve(int channel) const
+{
+    if (channel < 0 || channel >= ImuChannelCount) return QVector<AllanPoint>();
+    return m_axes[channel].curve(sampleInterval());
+}
+
+AllanNoise AllanDeviation::characterize(const QVector<AllanPoint>& curve)
+{
+    AllanNoise noise;
+    QVector<AllanPoint> points;
+    for (const AllanPoint& p : curve) {
+        if (p.clusters >= uint64_t(kMinClusters) && p.adev > 0.0) points.append(p);
+    }
+    if (points.size() < 3) return noise;
+
+    // 零偏不稳定性：平坦段（曲线最小值）
+    int minIndex = 0;
+    for (int i = 1; i < points.size(); ++i) {
+        if (points[i].adev < points[minIndex].adev) minIndex = i;
+    }
+    noise.biasInstability = points[minIndex].adev / 0.664;
+    noise.biasTau = points[minIndex].tau;
+
+    // 随机游走：最小值之前局部斜率最接近 -1/2 的一段，沿 -1/2 斜率外推到 τ=1s
+    int best = -1;
+    double bestError = 0.0;
+    for (int i = 0; i + 1 <= minIndex; ++i) {
+        const double slope = std::log(points[i + 1].adev / points[i].adev) / std::log(points[i + 1].tau / points[i].tau);
+        const double error = std::fabs(slope + 0.5);
+        if (best < 0 || error < bestError) {
+            best = i;
+            bestError = error;
+        }
+    }
+    if (best < 0) best = 0;     // 曲线单调上升（漂移主导），取最短 τ
+    const AllanPoint& a = points[best];
+    const AllanPoint& b = points[best + 1 < points.size() ? best + 1 : best];
+    noise.randomWalk = std::sqrt(a.adev * b.adev) * std::sqrt(std::sqrt(a.tau * b.tau));
+    noise.valid = true;
+    return noise;
+}
@@ -0,0 +1,86 @@
+#ifndef IMU_ALLAN_H
+#define IMU_ALLAN_H
+
+#include "imu_ring.h"
+#include <QVector>
+#include <cstdint>
+
+// Allan 偏差曲线上的一点
+struct AllanPoint {
+    double tau = 0.0;           // 簇时间 s
+    double adev = 0.0;          // 原始单位（gyro rad/s，acc g）
+    uint64_t clusters = 0;      // 不重叠簇数 N/m，用于判断可信度
+};
+
+// 由曲线读出的噪声参数（原始单位）
+struct AllanNoise {
+    double randomWalk = 0.0;        // ARW（rad/√s）或 VRW（g·√s）：斜率 -1/2 段在 τ=1s 处的值
+    double biasInstability = 0.0;   // 曲线最小值 / 0.664
+    double biasTau = 0.0;           // 最小值所在的 τ
+    bool valid = false;
+};
+
+// 单轴流式重叠 Allan 方差：簇长 m = 2^j（倍频程），对累积和 θ 求二阶差分平方和。
+// 每层只保留 2K+1 个 θ 抽样（间隔 max(1, m/K)），m ≤ K 时完全重叠，更长的簇按 m/K 步长部分重叠，
+// 统计效率与完全重叠几乎相同，而内存与每样本耗时都与总时长无关。
+class alignas(64) AllanAxis
+{
+public:
+    static const int kLevels = 24;          // m 最大 2^23，200Hz 约 11.6 小时
+    static const int kResolution = 64;      // K：每层在一个簇长内的抽样数
+
+    AllanAxis();
+    void reset();
+    void add(const ImuSample* samples, int count, int channel);
+    uint64_t samples() const { return m_count; }
+    // 各层 σ(τ)；tau0 为采样间隔
+    QVector<AllanPoint> curve(double tau0) const;
+
+private:
+    struct Level {
+        uint64_t stride = 1;
+        int span = 1;                   // m / stride
+        QVector<double> history;        // 2·span+1 个 θ 抽样的环形缓冲
+        int pos = 0;
+        uint64_t filled = 0;
+        double sum = 0.0;               // 二阶差分平方和
+        uint64_t terms = 0;
+    };
+
+    static void push(Level& l, double theta);
+
+    Level m_levels[kLevels];
+    double m_theta = 0.0;
+    double m_offset = 0.0;              // 首个样本值，减去后累积和不随常值偏置（重力）增长
+    uint64_t m_count = 0;
+};
+
+// 六轴 Allan 偏差：样本块较大时各轴在独立线程中并行累积。非线程安全（同一时刻只能有一个调用者）。
+class AllanDeviation
+{
+public:
+    static const int kParallelMinSamples = 4096;
+
+    void reset();
+    void addSamples(const ImuSample* samples, int count);
+    void addSamples(const QVector<ImuSample>& samples) { addSamples(samples.constData(), samples.size()); }
+
+    uint64_t samples() const { return m_axes[0].samples(); }
+    // 由时间戳估计的采样间隔（无样本时按 200Hz）
+    double sampleInterval() const;
+    uint64_t gaps() const { return m_gaps; }    // 间隔超过 2 倍采样间隔的次数（丢包会抬高短 τ 段）
+    QVector<AllanPoint> curve(int channel) const;
+
+    // 从曲线读出随机游走与零偏不稳定性；只使用不重叠簇数不少于 kMinClusters 的点
+    static const int kMinClusters = 8;
+    static AllanNoise characterize(const QVector<AllanPoint>& curve);
+
+private:
+    AllanAxis m_axes[ImuChannelCount];
+    uint64_t m_lastTs = 0;
+    uint64_t m_intervalSumNs = 0;
+    uint64_t m_intervals = 0;
+    uint64_t m_gaps = 0;
+};
+
+#endif // IMU_ALLAN_H
@@ -0,0 +1,230 @@
+#include "imu_ring.h"
+#include <algorithm>
+
+namespace {
+
+const uint64_t kMask = uint64_t(ImuSampleRing::kCapacity) - 1;
+const int kReadChunk = 4096;
+const int kMaxPacketSamples = 100;     // 与回调中的包校验一致
+
+} // namespace
+
+int imuSamplesFromPacket(const LivoxLidarEthernetPacket* packet, ImuSample* out, int maxCount)
+{
+    if (!packet || packet->data_type != kLivoxLidarImuData || packet->dot_num == 0) return 0;
+    const int count = std::min(int(packet->dot_num), maxCount);
+    const LivoxLidarImuRawPoint* imu = reinterpret_cast<const LivoxLidarImuRawPoint*>(packet->data);
+    const uint64_t ts = parsePacketTimestamp(packet->timestamp);
+    const uint64_t step = packet->dot_num > 1 ? uint64_t(packet->time_interval) * 100ULL / packet->dot_num : 0;
+    for (int i = 0; i < count; ++i) {
+        ImuSample& s = out[i];
+        s.timestamp = ts + uint64_t(i) * step;
+        s.value[ImuGyroX] = imu[i].gyro_x;
+        s.value[ImuGyroY] = imu[i].gyro_y;
+        s.value[ImuGyroZ] = imu[i].gyro_z;
+        s.value[ImuAccX] = imu[i].acc_x;
+        s.value[ImuAccY] = imu[i].acc_y;
+        s.value[ImuAccZ] = imu[i].acc_z;
+    }
+    return count;
+}
+
+ImuSampleRing::ImuSampleRing()
+    : m_slots(new ImuSample[kCapacity])
+{
+}
+
+void ImuSampleRing::push(const ImuSample& sample)
+{
+    const uint64_t h = m_head.load(std::memory_order_relaxed);
+    // 先声明将要覆盖的槽位，读者据此判断读到的样本是否可能被改写（seqlock 方式）
+    m_writing.store(h + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_slots[h & kMask] = sample;
+    m_head.store(h + 1, std::memory_order_release);
+}
+
+int ImuSampleRing::read(uint64_t from, uint64_t to, ImuSample* out, int maxCount, uint64_t* first) const
+{
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    const uint64_t capacity = uint64_t(kCapacity);
+    to = std::min(to, head);
+    from = std::max(from, head > capacity ? head - capacity : 0);
+    if (from >= to || maxCount <= 0) {
+        *first = std::max(from, std::min(to, head));
+        return 0;
+    }
+    to = std::min(to, from + uint64_t(maxCount));
+    for (uint64_t i = from; i < to; ++i) out[i - from] = m_slots[i & kMask];
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // 写入序号 w-1 的样本会改写 w-1-kCapacity 的槽位，更早的都可能已被覆盖
+    const uint64_t writing = m_writing.load(std::memory_order_relaxed);
+    const uint64_t valid = writing > capacity ? writing - capacity : 0;
+    if (valid > from) {
+        const uint64_t drop = std::min(valid, to) - from;
+        std::copy(out + drop, out + (to - from), out);
+        from += drop;
+    }
+    *first = from;
+    return int(to - from);
+}
+
+bool ImuSampleRing::latest(ImuSample* out) const
+{
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    if (head == 0) return false;
+    uint64_t first = 0;
+    return read(head - 1, head, out, 1, &first) == 1;
+}
+
+ImuHistory::ImuHistory()
+{
+}
+
+ImuHistory::~ImuHistory()
+{
+    for (Slot& s : m_slots) delete s.ring;
+}
+
+ImuSampleRing* ImuHistory::writableRing(uint32_t handle)
+{
+    for (Slot& s : m_slots) {
+        if (s.state.load(std::memory_order_acquire) == SlotReady && s.handle == handle) return s.ring;
+    }
+    for (Slot& s : m_slots) {
+        int expected = SlotFree;
+        if (!s.state.compare_exchange_strong(expected, SlotClaiming, std::memory_order_acq_rel)) continue;
+        s.handle = handle;
+        s.ring = new ImuSampleRing;
+        s.state.store(SlotReady, std::memory_order_release);
+        return s.ring;
+    }
+    return nullptr;
+}
+
+void ImuHistory::pushPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet)
+{
+    ImuSample samples[kMaxPacketSamples];
+    const int n = imuSamplesFromPacket(packet, samples, kMaxPacketSamples);
+    if (n == 0) return;
+    ImuSampleRing* ring = writableRing(handle);
+    if (!ring) return;
+    for (int i = 0; i < n; ++i) ring->push(samples[i]);
+}
+
+void ImuHistory::push(uint32_t handle, const ImuSample& sample)
+{
+    if (ImuSampleRing* ring = writableRing(handle)) ring->push(sample);
+}
+
+QVector<uint32_t> ImuHistory::devices() const
+{
+    QVector<uint32_t> out;
+    for (const Slot& s : m_slots) {
+        if (s.state.load(std::memory_order_acquire) == SlotReady) out.append(s.handle);
+    }
+    return out;
+}
+
+const ImuSampleRing* ImuHistory::ring(uint32_t handle) const
+{
+    for (const Slot& s : m_slots) {
+        if (s.state.load(std::memory_order_acquire) == SlotReady && s.handle == handle) return s.ring;
+    }
+    return nullptr;
+}
+
+bool ImuHistory::latest(uint32_t handle, ImuSample* out) const
+{
+    const ImuSampleRing* r = ring(handle);
+    return r && r->latest(out);
+}
+
+void ImuMinMaxDecimator::configure(uint64_t windowNs, int columns)
+{
+    columns = std::max(1, columns);
+    windowNs = std::max<uint64_t>(windowNs, uint64_t(columns));
+    if (windowNs == m_windowNs && columns == m_columns && !m_ring.isEmpty()) return;
+    m_windowNs = windowNs;
+    m_columns = columns;
+    m_columnNs = windowNs / uint64_t(columns);
+    // 多留两列：右端列仍在累积，左端列滚出窗口前不被新列覆盖
+    m_ring.resize(columns + 2);
+    reset();
+    m_next = 0;     // 从缓冲中最旧的样本回填
+}
+
+void ImuMinMaxDecimator::reset()
+{
+    for (Column& c : m_ring) c.index = -1;
+    m_latestTs = 0;
+    m_samples = 0;
+}
+
+void ImuMinMaxDecimator::add(const ImuSample& s)
+{
+    // 设备时间大幅回退（重启、重新同步）时丢弃旧的列
+    if (m_latestTs != 0 && s.timestamp + m_windowNs < m_latestTs) reset();
+    const int64_t col = int64_t(s.timestamp / m_columnNs);
+    Column& c = m_ring[int(col % m_ring.size())];
+    if (c.index != col) {
+        if (c.index > col) return;      // 槽位已被更新的列占用，样本已滚出窗口
+        c.index = col;
+        for (int ch = 0; ch < ImuChannelCount; ++ch) {
+            c.min[ch] = s.value[ch];
+            c.max[ch] = s.value[ch];
+        }
+        c.minLater = 0;
+    } else {
+        for (int ch = 0; ch < ImuChannelCount; ++ch) {
+            const float v = s.value[ch];
+            if (v < c.min[ch]) {
+                c.min[ch] = v;
+                c.minLater |= uint8_t(1u << ch);
+            } else if (v > c.max[ch]) {
+                c.max[ch] = v;
+                c.minLater &= uint8_t(~(1u << ch));
+            }
+        }
+    }
+    m_latestTs = std::max(m_latestTs, s.timestamp);
+    m_samples++;
+}
+
+void ImuMinMaxDecimator::update(const ImuSampleRing& ring)
+{
+    if (m_ring.isEmpty()) return;
+    if (m_scratch.size() < kReadChunk) m_scratch.resize(kReadChunk);
+    const uint64_t head = ring.head();
+    while (m_next < head) {
+        uint64_t first = 0;
+        const int n = ring.read(m_next, head, m_scratch.data(), m_scratch.size(), &first);
+        for (int i = 0; i < n; ++i) add(m_scratch[i]);
+        const uint64_t next = first + uint64_t(n);
+        if (next <= m_next) break;
+        m_next = next;
+    }
+}
+
+void ImuMinMaxDecimator::build(int channel, uint64_t endTs, QVector<QPointF>& out) const
+{
+    out.clear();
+    if (m_ring.isEmpty() || m_latestTs == 0 || channel < 0 || channel >= ImuChannelCount) return;
+    const int64_t endCol = int64_t(endTs / m_columnNs);
+    const int size = m_ring.size();
+    const uint8_t bit = uint8_t(1u << channel);
+    out.reserve(m_columns * 2);
+    for (int64_t col = std::max<int64_t>(0, endCol - m_columns + 1); col <= endCol; ++col) {
+        const Column& c = m_ring[int(col % size)];
+        if (c.index != col) continue;
+        const double x = ((double(col) + 0.5) * double(m_columnNs) - double(endTs)) / 1e9;
+        if (c.minLater & bit) {
+            out.append(QPointF(x, c.max[channel]));
+            out.append(QPointF(x, c.min[channel]));
+        } else {
+            out.append(QPointF(x, c.min[channel]));
+            out.append(QPointF(x, c.max[channel]));
+        }
+    }
+}
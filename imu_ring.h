@@ -0,0 +1,127 @@
+#ifndef IMU_RING_H
+#define IMU_RING_H
+
+#include "point_decode.h"
+#include <QPointF>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+enum ImuChannel {
+    ImuGyroX = 0,
+    ImuGyroY,
+    ImuGyroZ,
+    ImuAccX,
+    ImuAccY,
+    ImuAccZ,
+    ImuChannelCount
+};
+
+struct ImuSample {
+    uint64_t timestamp = 0;         // 设备时间 ns
+    float value[ImuChannelCount] = {};
+};
+
+// 解析 IMU 数据包中的样本（包内按 time_interval 均分时间戳），返回写入 out 的个数
+int imuSamplesFromPacket(const LivoxLidarEthernetPacket* packet, ImuSample* out, int maxCount);
+
+// 单生产者无锁环形缓冲：写满覆盖最旧样本，读者不消费。
+// 样本按写入序号寻址，读取后根据写入进度校验，可能已被覆盖的样本丢弃（写者从不等待读者）。
+class ImuSampleRing
+{
+public:
+    static const int kCapacity = 131072;    // 2 的幂，200Hz 约 11 分钟
+
+    ImuSampleRing();
+
+    void push(const ImuSample& sample);
+    // 已写入的样本总数（下一个样本的序号）
+    uint64_t head() const { return m_head.load(std::memory_order_acquire); }
+    // 读取序号 [from, to) 中仍在缓冲内的样本到 out（最多 maxCount 个），
+    // 返回读到的个数，*first 为首个样本的序号（早于 first 的已被覆盖）
+    int read(uint64_t from, uint64_t to, ImuSample* out, int maxCount, uint64_t* first) const;
+    // 最新样本（无等待；写者在读取期间绕回整个缓冲才会失败）
+    bool latest(ImuSample* out) const;
+
+private:
+    std::unique_ptr<ImuSample[]> m_slots;
+    std::atomic<uint64_t> m_head{0};
+    std::atomic<uint64_t> m_writing{0};     // 正在写入的样本序号 + 1
+};
+
+// 各设备的 IMU 历史：SDK 回调线程写入，GUI 线程读取，均不加锁。
+// 设备槽位首次出现时以 CAS 占用，缓冲一经分配不再释放（设备重连沿用原缓冲）。
+class ImuHistory
+{
+public:
+    static const int kMaxDevices = 16;
+
+    ImuHistory();
+    ~ImuHistory();
+    ImuHistory(const ImuHistory&) = delete;
+    ImuHistory& operator=(const ImuHistory&) = delete;
+
+    // 每个设备同一时刻只能有一个线程写入；槽位用尽时丢弃
+    void pushPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet);
+    void push(uint32_t handle, const ImuSample& sample);
+
+    QVector<uint32_t> devices() const;
+    const ImuSampleRing* ring(uint32_t handle) const;
+    bool latest(uint32_t handle, ImuSample* out) const;
+
+private:
+    enum SlotState { SlotFree = 0, SlotClaiming, SlotReady };
+    struct Slot {
+        std::atomic<int> state{SlotFree};
+        uint32_t handle = 0;
+        ImuSampleRing* ring = nullptr;
+    };
+
+    ImuSampleRing* writableRing(uint32_t handle);
+
+    Slot m_slots[kMaxDevices];
+};
+
+// 按像素列的 min/max 抽稀：列宽 = 窗口 / 列数，列边界对齐绝对时间，
+// 已完成的列不随窗口滚动重新计算，每次只处理新到的样本；绘制代价只与列数有关。
+// 仅在 GUI 线程使用。
+class ImuMinMaxDecimator
+{
+public:
+    void configure(uint64_t windowNs, int columns);
+    uint64_t windowNs() const { return m_windowNs; }
+    int columns() const { return m_columns; }
+
+    // 读取 ring 中新写入的样本（首次或重新配置后回填整个缓冲）
+    void update(const ImuSampleRing& ring);
+    bool isEmpty() const { return m_latestTs == 0; }
+    uint64_t latestTimestamp() const { return m_latestTs; }
+    uint64_t samples() const { return m_samples; }
+
+    // 以 endTs 为右端输出窗口内某通道的折线：每列两个点（按出现先后排列的 min、max），
+    // 横坐标为列中心相对 endTs 的秒数（负值）
+    void build(int channel, uint64_t endTs, QVector<QPointF>& out) const;
+
+private:
+    struct Column {
+        int64_t index = -1;
+        float min[ImuChannelCount];
+        float max[ImuChannelCount];
+        uint8_t minLater = 0;           // 按位：该通道 min 出现在 max 之后
+    };
+
+    void reset();
+    void add(const ImuSample& s);
+
+    uint64_t m_windowNs = 10000000000ULL;
+    int m_columns = 0;
+    uint64_t m_columnNs = 0;
+    QVector<Column> m_ring;             // 按列号取模
+    uint64_t m_next = 0;                // 下一个待读样本序号
+    uint64_t m_latestTs = 0;
+    uint64_t m_samples = 0;
+    QVector<ImuSample> m_scratch;
+};
+
+#endif // IMU_RING_H
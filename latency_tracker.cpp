@@ -0,0 +1,182 @@
+#include "latency_tracker.h"
+#include <QFile>
+#include <algorithm>
+#include <chrono>
+
+uint64_t hostMonotonicNs()
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+const char* latencySegmentName(int segment)
+{
+    switch (segment) {
+        case LatencyDecode: return "解码";
+        case LatencyMerge: return "合并";
+        case LatencyUpload: return "上传";
+        case LatencyPresent: return "显示";
+        case LatencyTotal: return "总计";
+        default: return "?";
+    }
+}
+
+namespace {
+
+double spanMs(uint64_t from, uint64_t to)
+{
+    return to > from ? double(to - from) / 1e6 : 0.0;
+}
+
+// 由直方图估计分位数（取桶中点）
+double histogramPercentile(const QVector<uint32_t>& histogram, uint64_t total, double q)
+{
+    if (total == 0) return 0.0;
+    const uint64_t target = uint64_t(double(total - 1) * q) + 1;
+    uint64_t acc = 0;
+    for (int i = 0; i < histogram.size(); ++i) {
+        acc += histogram[i];
+        if (acc >= target) return (i + 0.5) * LatencyTracker::kBucketMs;
+    }
+    return double(histogram.size() * LatencyTracker::kBucketMs);
+}
+
+} // namespace
+
+uint64_t LatencyTracker::frameMerged(const QMap<uint32_t, FrameLatencyStamp>& stamps, uint64_t mergedNs)
+{
+    if (!isEnabled() || stamps.isEmpty()) return 0;
+    InFlightFrame f;
+    f.id = m_nextId++;
+    f.stamps = stamps;
+    f.mergedNs = mergedNs;
+    // 渲染暂停等情况下帧可能永远不会上传，限制在途帧数
+    if (m_inFlight.size() >= 8) {
+        m_inFlight.removeFirst();
+        m_dropped++;
+    }
+    m_inFlight.append(f);
+    return f.id;
+}
+
+void LatencyTracker::frameUploaded(uint64_t frameId, uint64_t uploadedNs)
+{
+    if (frameId == 0) return;
+    for (int i = 0; i < m_inFlight.size(); ++i) {
+        if (m_inFlight[i].id != frameId) continue;
+        m_inFlight[i].uploadedNs = uploadedNs;
+        // 更早上传但尚未显示的帧已被覆盖
+        for (int j = 0; j < i; ++j) {
+            if (m_inFlight[j].uploadedNs) m_dropped++;
+        }
+        m_inFlight.remove(0, i);
+        return;
+    }
+}
+
+void LatencyTracker::framePresented(uint64_t presentedNs)
+{
+    // 显示的是最近一次上传的帧；纯相机重绘（没有新上传）不计入
+    int latest = -1;
+    for (int i = 0; i < m_inFlight.size(); ++i) {
+        if (m_inFlight[i].uploadedNs) latest = i;
+    }
+    if (latest < 0) return;
+    if (isEnabled()) complete(m_inFlight[latest], presentedNs);
+    m_inFlight.remove(0, latest + 1);
+}
+
+void LatencyTracker::complete(const InFlightFrame& frame, uint64_t presentedNs)
+{
+    m_presented++;
+    if (m_records.isEmpty()) m_records.reserve(kRecordCapacity);
+    for (auto it = frame.stamps.begin(); it != frame.stamps.end(); ++it) {
+        const FrameLatencyStamp& s = it.value();
+        double ms[LatencySegmentCount];
+        ms[LatencyDecode] = spanMs(s.arrivalNs, s.decodedNs);
+        ms[LatencyMerge] = spanMs(s.decodedNs, frame.mergedNs);
+        ms[LatencyUpload] = spanMs(frame.mergedNs, frame.uploadedNs);
+        ms[LatencyPresent] = spanMs(frame.uploadedNs, presentedNs);
+        ms[LatencyTotal] = spanMs(s.arrivalNs, presentedNs);
+
+        DeviceAccum& d = m_devices[it.key()];
+        d.frames++;
+        for (int i = 0; i < LatencySegmentCount; ++i) d.sumMs[i] += ms[i];
+        d.maxTotalMs = std::max(d.maxTotalMs, ms[LatencyTotal]);
+        const int bucket = std::min(kBucketCount - 1, int(ms[LatencyTotal] / kBucketMs));
+        d.histogram[bucket]++;
+
+        const Record r = { frame.id, it.key(), s.arrivalNs, s.decodedNs, frame.mergedNs, frame.uploadedNs, presentedNs };
+        if (m_records.size() < kRecordCapacity) {
+            m_records.append(r);
+        } else {
+            m_records[m_recordHead] = r;
+            m_recordHead = (m_recordHead + 1) % kRecordCapacity;
+        }
+    }
+}
+
+LatencySnapshot LatencyTracker::snapshot() const
+{
+    LatencySnapshot out;
+    out.presentedFrames = m_presented;
+    out.droppedFrames = m_dropped;
+    for (auto it = m_devices.begin(); it != m_devices.end(); ++it) {
+        const DeviceAccum& d = it.value();
+        LatencyDeviceSummary s;
+        s.handle = it.key();
+        s.frames = d.frames;
+        if (d.frames) {
+            for (int i = 0; i < LatencySegmentCount; ++i) s.avgMs[i] = d.sumMs[i] / double(d.frames);
+        }
+        s.p50TotalMs = histogramPercentile(d.histogram, d.frames, 0.50);
+        s.p99TotalMs = histogramPercentile(d.histogram, d.frames, 0.99);
+        s.maxTotalMs = d.maxTotalMs;
+        s.histogram = d.histogram;
+        out.devices.append(s);
+    }
+    return out;
+}
+
+bool LatencyTracker::writeCsv(const QString& path, QString* errorString) const
+{
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (errorString) *errorString = f.errorString();
+        return false;
+    }
+    QByteArray body;
+    body.reserve(m_records.size() * 96 + 128);
+    body += "frame,device,arrival_ns,decode_ms,merge_ms,upload_ms,present_ms,total_ms\n";
+    for (int n = 0; n < m_records.size(); ++n) {
+        // 按时间顺序输出环形缓冲
+        const Record& r = m_records[(m_recordHead + n) % m_records.size()];
+        body += QByteArray::number(qulonglong(r.frameId));
+        body += ',';
+        body += QByteArray::number(r.handle);
+        body += ',';
+        body += QByteArray::number(qulonglong(r.arrivalNs));
+        const double ms[] = { spanMs(r.arrivalNs, r.decodedNs), spanMs(r.decodedNs, r.mergedNs),
+                              spanMs(r.mergedNs, r.uploadedNs), spanMs(r.uploadedNs, r.presentedNs),
+                              spanMs(r.arrivalNs, r.presentedNs) };
+        for (double v : ms) {
+            body += ',';
+            body += QByteArray::number(v, 'f', 3);
+        }
+        body += '\n';
+    }
+    const bool ok = f.write(body) == body.size();
+    if (!ok && errorString) *errorString = f.errorString();
+    f.close();
+    return ok;
+}
+
+void LatencyTracker::reset()
+{
+    m_inFlight.clear();
+    m_devices.clear();
+    m_records.clear();
+    m_recordHead = 0;
+    m_presented = 0;
+    m_dropped = 0;
+}
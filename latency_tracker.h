@@ -0,0 +1,106 @@
+#ifndef LATENCY_TRACKER_H
+#define LATENCY_TRACKER_H
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+
+// 主机单调时钟（ns），包到达/解码/合并/上传/显示统一使用
+uint64_t hostMonotonicNs();
+
+// 合并窗口内某设备最新一包的主机时间
+struct FrameLatencyStamp {
+    uint64_t arrivalNs = 0;     // SDK 回调收到
+    uint64_t decodedNs = 0;     // 解码完成并入队
+};
+
+// 端到端延迟的各段（包到达 → 屏幕显示）
+enum LatencySegment {
+    LatencyDecode = 0,  // 到达 → 解码完成（含投递到主线程的排队）
+    LatencyMerge,       // 解码 → 合并输出（等待渲染节拍 + 合并/着色/滤波）
+    LatencyUpload,      // 合并 → VBO 上传完成
+    LatencyPresent,     // 上传 → 帧交换（显示）
+    LatencyTotal,       // 到达 → 显示
+    LatencySegmentCount
+};
+
+const char* latencySegmentName(int segment);
+
+struct LatencyDeviceSummary {
+    uint32_t handle = 0;
+    uint64_t frames = 0;
+    double avgMs[LatencySegmentCount] = {};
+    double p50TotalMs = 0.0;
+    double p99TotalMs = 0.0;
+    double maxTotalMs = 0.0;
+    QVector<uint32_t> histogram;    // 总延迟分布，见 LatencyTracker::kBucketMs
+};
+
+struct LatencySnapshot {
+    QVector<LatencyDeviceSummary> devices;
+    uint64_t presentedFrames = 0;
+    uint64_t droppedFrames = 0;     // 已上传但在显示前被新帧覆盖
+};
+
+// 包到显示（packet-to-photon）延迟统计：
+//   frameMerged()（流水线输出时）→ frameUploaded()（VBO 上传后）→ framePresented()（frameSwapped）
+// 每个显示帧按设备取窗口内最新一包计算各段延迟，即屏幕上最新数据的陈旧程度。
+// 仅在 GUI 线程使用。
+class LatencyTracker
+{
+public:
+    static const int kBucketMs = 2;             // 直方图桶宽
+    static const int kBucketCount = 100;        // 0~200ms，最后一桶包含溢出
+    static const int kRecordCapacity = 20000;   // CSV 导出保留的最近记录数
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // 返回帧 id（关闭时返回 0，后续调用忽略）
+    uint64_t frameMerged(const QMap<uint32_t, FrameLatencyStamp>& stamps, uint64_t mergedNs);
+    void frameUploaded(uint64_t frameId, uint64_t uploadedNs);
+    void framePresented(uint64_t presentedNs);
+
+    LatencySnapshot snapshot() const;
+    // 每行一个（帧, 设备）记录，时间为相对到达的毫秒数
+    bool writeCsv(const QString& path, QString* errorString = nullptr) const;
+    void reset();
+
+private:
+    struct InFlightFrame {
+        uint64_t id = 0;
+        QMap<uint32_t, FrameLatencyStamp> stamps;
+        uint64_t mergedNs = 0;
+        uint64_t uploadedNs = 0;
+    };
+    struct DeviceAccum {
+        uint64_t frames = 0;
+        double sumMs[LatencySegmentCount] = {};
+        double maxTotalMs = 0.0;
+        QVector<uint32_t> histogram = QVector<uint32_t>(kBucketCount, 0);
+    };
+    struct Record {
+        uint64_t frameId;
+        uint32_t handle;
+        uint64_t arrivalNs;
+        uint64_t decodedNs;
+        uint64_t mergedNs;
+        uint64_t uploadedNs;
+        uint64_t presentedNs;
+    };
+
+    void complete(const InFlightFrame& frame, uint64_t presentedNs);
+
+    std::atomic<bool> m_enabled{false};
+    uint64_t m_nextId = 1;
+    QVector<InFlightFrame> m_inFlight;
+    QMap<uint32_t, DeviceAccum> m_devices;
+    QVector<Record> m_records;      // 环形
+    int m_recordHead = 0;
+    uint64_t m_presented = 0;
+    uint64_t m_dropped = 0;
+};
+
+#endif // LATENCY_TRACKER_H
@@ -0,0 +1,53 @@
+#include "lidar_discovery.h"
+
+namespace {
+
+const int kHeaderSize = 24;
+
+inline uint8_t byteAt(const QByteArray& data, int i)
+{
+    return static_cast<uint8_t>(data[i]);
+}
+
+} // namespace
+
+QByteArray discoveryRequest()
+{
+    return QByteArray::fromHex("aa00180002000000000000000000000000000a9200000000");
+}
+
+bool parseDiscoveryReply(const QByteArray& data, DiscoveryReply* reply)
+{
+    // 包头 24 字节 + data 段（ret_code, dev_type, sn[16], ip[4], cmd_port[2]）
+    if (data.size() < kHeaderSize + 24) return false;
+    if (byteAt(data, 0) != 0xAA || byteAt(data, 1) != 0x00) return false;
+    const uint16_t length = uint16_t(byteAt(data, 2) | (byteAt(data, 3) << 8));
+    if (data.size() < length) return false;
+    const uint16_t cmdId = uint16_t((byteAt(data, 8) << 8) | byteAt(data, 9));
+    if (cmdId != 0x0000) return false;
+    if (byteAt(data, 10) != 0x01) return false;     // cmd_type: ACK
+    if (byteAt(data, 11) != 0x01) return false;     // sender_type: 雷达
+    if (byteAt(data, kHeaderSize) != 0x00) return false;   // ret_code
+
+    if (reply) {
+        reply->devType = byteAt(data, kHeaderSize + 1);
+        reply->sn = QString::fromLatin1(data.mid(kHeaderSize + 2, 16).constData()).trimmed();
+        const int ipOffset = kHeaderSize + 18;
+        reply->ip = (uint32_t(byteAt(data, ipOffset)) << 24) | (uint32_t(byteAt(data, ipOffset + 1)) << 16) |
+                    (uint32_t(byteAt(data, ipOffset + 2)) << 8) | uint32_t(byteAt(data, ipOffset + 3));
+        reply->cmdPort = uint16_t(byteAt(data, ipOffset + 4) | (byteAt(data, ipOffset + 5) << 8));
+    }
+    return true;
+}
+
+int discoveryRetryDelayMs(int attempt)
+{
+    int delay = kDiscoveryFirstRetryMs;
+    for (int i = 0; i < attempt && delay < kDiscoveryMaxRetryMs; ++i) delay *= 2;
+    return delay < kDiscoveryMaxRetryMs ? delay : kDiscoveryMaxRetryMs;
+}
+
+QString discoveryIpString(uint32_t ip)
+{
+    return QString("%1.%2.%3.%4").arg((ip >> 24) & 0xFF).arg((ip >> 16) & 0xFF).arg((ip >> 8) & 0xFF).arg(ip & 0xFF);
+}
@@ -0,0 +1,28 @@
+#ifndef LIDAR_DISCOVERY_H
+#define LIDAR_DISCOVERY_H
+
+#include <QByteArray>
+#include <QString>
+#include <cstdint>
+
+// Livox 设备发现协议：向 56000 端口广播请求，雷达回复 ACK（cmd_id 0x0000）。
+// 只包含报文构造/解析与重发节奏，套接字与网口枚举由调用方负责。
+static const uint16_t kDiscoveryPort = 56000;
+static const int kDiscoveryFirstRetryMs = 100;  // 首次重发间隔，之后倍增
+static const int kDiscoveryMaxRetryMs = 3000;
+
+struct DiscoveryReply {
+    uint8_t devType = 0;
+    QString sn;
+    uint32_t ip = 0;            // 雷达 IPv4（主机字节序，与 QHostAddress::toIPv4Address 一致）
+    uint16_t cmdPort = 0;
+};
+
+QByteArray discoveryRequest();
+// 非雷达发出的 ACK（包括本机发出的请求被自己收到）返回 false
+bool parseDiscoveryReply(const QByteArray& data, DiscoveryReply* reply);
+// 第 attempt 次（从 0 开始）发送后到下一次发送的间隔：100、200、400 ... 3000ms
+int discoveryRetryDelayMs(int attempt);
+QString discoveryIpString(uint32_t ip);
+
+#endif // LIDAR_DISCOVERY_H
@@ -0,0 +1,894 @@
+// LivoxBench - 点云流水线基准测试
+// 覆盖解码、组帧、着色、tag 滤波、框选查询、文件写入与 VBO 上传，
+// 输出 points/s、ns/point 与每次迭代的内存分配次数，并与基线 JSON 比较（超出阈值返回 1）
+//
+// 数据由 synthetic_source 生成（Mid360 点频），不依赖雷达与 Livox SDK 库
+
+#include "point_decode.h"
+#include "point_color.h"
+#include "point_filter.h"
+#include "point_select.h"
+#include "point_export.h"
+#include "livox_pipeline.h"
+#include "lvx2_writer.h"
+#include "packet_crc.h"
+#include "point_deskew.h"
+#include "render_budget.h"
+#include "point_octree.h"
+#include "imu_ring.h"
+#include "imu_allan.h"
+#include "param_poller.h"
+#include "telemetry_log.h"
+#include "log_ring.h"
+#include "fleet_ingest.h"
+#include "synthetic_source.h"
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMatrix4x4>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QOffscreenSurface>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <memory>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// =============================================================================
+// 内存分配计数
+// glibc 下拦截 malloc/calloc/realloc（Qt 容器直接使用 malloc），其他平台统计 operator new
+// =============================================================================
+
+static std::atomic<uint64_t> g_allocCount{0};
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) noexcept
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+}
+#else
+void* operator new(size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+#endif
+
+// =============================================================================
+// 基准框架
+// =============================================================================
+
+// 防止结果被优化掉
+static volatile uint64_t g_sink = 0;
+
+struct BenchCase {
+    QString name;
+    std::function<bool()> prepare;      // 每次迭代前调用，不计时；返回 false 表示跳过该用例
+    std::function<uint64_t()> run;      // 计时部分，返回本次处理的点数
+};
+
+struct BenchResult {
+    QString name;
+    bool skipped = false;
+    int iterations = 0;
+    uint64_t pointsPerIter = 0;
+    double nsPerPoint = 0.0;
+    double pointsPerSec = 0.0;
+    double allocsPerIter = 0.0;
+};
+
+static void printLine(const QString& line)
+{
+    std::fputs(line.toLocal8Bit().constData(), stdout);
+    std::fputc('\n', stdout);
+    std::fflush(stdout);
+}
+
+static BenchResult runCase(const BenchCase& c, qint64 minTimeNs, int minIterations)
+{
+    BenchResult r;
+    r.name = c.name;
+
+    // 预热一次（首次分配、缓存）
+    if (c.prepare && !c.prepare()) {
+        r.skipped = true;
+        return r;
+    }
+    g_sink = g_sink + c.run();
+
+    qint64 totalNs = 0;
+    uint64_t totalPoints = 0;
+    uint64_t totalAllocs = 0;
+    QElapsedTimer timer;
+    while (r.iterations < minIterations || totalNs < minTimeNs) {
+        if (c.prepare && !c.prepare()) {
+            r.skipped = true;
+            return r;
+        }
+        const uint64_t allocsBefore = g_allocCount.load(std::memory_order_relaxed);
+        timer.start();
+        const uint64_t points = c.run();
+        totalNs += timer.nsecsElapsed();
+        totalAllocs += g_allocCount.load(std::memory_order_relaxed) - allocsBefore;
+        totalPoints += points;
+        g_sink = g_sink + points;
+        r.iterations++;
+    }
+
+    r.pointsPerIter = totalPoints / uint64_t(r.iterations);
+    r.nsPerPoint = totalPoints ? double(totalNs) / double(totalPoints) : 0.0;
+    r.pointsPerSec = totalNs ? double(totalPoints) * 1e9 / double(totalNs) : 0.0;
+    r.allocsPerIter = double(totalAllocs) / double(r.iterations);
+    return r;
+}
+
+// =============================================================================
+// 测试数据
+// =============================================================================
+
+static const uint64_t kStartNs = 1000000000ULL;
+
+// 生成 seconds 秒的 Mid360 点云包
+static QVector<QByteArray> generatePackets(uint8_t dataType, double seconds)
+{
+    SyntheticLidarDevice device(SyntheticMid360, dataType, SyntheticLidarSource::deviceHandle(0));
+    const uint64_t durationNs = uint64_t(seconds * 1e9);
+    QVector<QByteArray> packets;
+    for (uint64_t i = 0; device.pointPacketOffsetNs(i + 1) <= durationNs; ++i) {
+        const LivoxLidarEthernetPacket* pkt = device.nextPointPacket(kStartNs + device.pointPacketOffsetNs(i));
+        packets.append(QByteArray(reinterpret_cast<const char*>(pkt), int(pkt->length)));
+    }
+    return packets;
+}
+
+static const LivoxLidarEthernetPacket* packetAt(const QVector<QByteArray>& packets, int i)
+{
+    return reinterpret_cast<const LivoxLidarEthernetPacket*>(packets.at(i).constData());
+}
+
+static QVector<PointCloudFrame> decodeFrames(const QVector<QByteArray>& packets)
+{
+    QVector<PointCloudFrame> frames;
+    frames.reserve(packets.size());
+    for (int i = 0; i < packets.size(); ++i) {
+        const LivoxLidarEthernetPacket* pkt = packetAt(packets, i);
+        PointCloudFrame frame;
+        frame.timestamp = parsePacketTimestamp(pkt->timestamp);
+        frame.device_handle = SyntheticLidarSource::deviceHandle(0);
+        frame.timeSpanNs = uint32_t(pkt->time_interval) * 100U;
+        decodePointPacket(pkt, PointDecodeOptions(), frame.points);
+        frames.append(frame);
+    }
+    return frames;
+}
+
+// 共享的数据集与 GL 环境
+struct BenchData {
+    QVector<QByteArray> packetsHigh;    // 1s
+    QVector<QByteArray> packetsLow;     // 1s
+    QVector<QByteArray> packetsSph;     // 1s
+    QVector<PointCloudFrame> frames;    // 10s，高精度
+    QVector<Point3D> cloud;             // 1s 合并点云
+    QVector<PointDeskewSpan> cloudSpans;    // cloud 中各包的位置与时间
+    QVector<Point3D> work;              // 会被修改的用例的工作副本
+    QTemporaryDir tempDir;
+
+    QOpenGLContext* glContext = nullptr;
+    QOffscreenSurface* glSurface = nullptr;
+    GLuint vbo = 0;
+    bool glTried = false;
+};
+
+static bool ensureGl(BenchData& d)
+{
+    if (d.glTried) return d.glContext != nullptr;
+    d.glTried = true;
+
+    std::unique_ptr<QOpenGLContext> context(new QOpenGLContext);
+    if (!context->create()) return false;
+    std::unique_ptr<QOffscreenSurface> surface(new QOffscreenSurface);
+    surface->setFormat(context->format());
+    surface->create();
+    if (!surface->isValid() || !context->makeCurrent(surface.get())) return false;
+
+    context->functions()->glGenBuffers(1, &d.vbo);
+    d.glContext = context.release();
+    d.glSurface = surface.release();
+    return true;
+}
+
+static void releaseGl(BenchData& d)
+{
+    if (!d.glContext) return;
+    d.glContext->makeCurrent(d.glSurface);
+    d.glContext->functions()->glDeleteBuffers(1, &d.vbo);
+    d.glContext->doneCurrent();
+    delete d.glContext;
+    delete d.glSurface;
+    d.glContext = nullptr;
+    d.glSurface = nullptr;
+}
+
+// 与界面默认视角相近的投影：相机在 (-10, 0, 5) 看向原点
+static QMatrix4x4 benchProjection()
+{
+    QMatrix4x4 projection;
+    projection.perspective(45.0f, 1600.0f / 900.0f, 0.1f, 1000.0f);
+    return projection;
+}
+
+static QMatrix4x4 benchModelView()
+{
+    QMatrix4x4 view;
+    view.lookAt(QVector3D(-10.0f, 0.0f, 5.0f), QVector3D(0.0f, 0.0f, 0.0f), QVector3D(0.0f, 0.0f, 1.0f));
+    return view;
+}
+
+static QVector<BenchCase> buildCases(BenchData& d)
+{
+    QVector<BenchCase> cases;
+
+    // ---- 解码：与 PointCloudPipeline::pushPacket 相同，每包一个新缓冲
+    struct DecodeSet { const char* name; const QVector<QByteArray>* packets; };
+    const DecodeSet decodeSets[] = {
+        { "decode/high", &d.packetsHigh },
+        { "decode/low", &d.packetsLow },
+        { "decode/spherical", &d.packetsSph },
+    };
+    for (const DecodeSet& s : decodeSets) {
+        const QVector<QByteArray>* packets = s.packets;
+        cases.append(BenchCase{ s.name, nullptr, [packets]() {
+            const PointDecodeOptions options;
+            uint64_t n = 0;
+            for (int i = 0; i < packets->size(); ++i) {
+                const LivoxLidarEthernetPacket* pkt = packetAt(*packets, i);
+                QVector<Point3D> points;
+                points.reserve(pkt->dot_num);
+                n += uint64_t(decodePointPacket(pkt, options, points));
+            }
+            return n;
+        } });
+    }
+
+    // ---- 解码同时应用主机外参（多雷达拼接）
+    const DecodeSet extrinsicSets[] = {
+        { "decode/high+extrinsic", &d.packetsHigh },
+        { "decode/spherical+extrinsic", &d.packetsSph },
+    };
+    for (const DecodeSet& s : extrinsicSets) {
+        const QVector<QByteArray>* packets = s.packets;
+        cases.append(BenchCase{ s.name, nullptr, [packets]() {
+            const PointDecodeOptions options;
+            ExtrinsicParams params;
+            params.roll = 1.5f;
+            params.pitch = -2.0f;
+            params.yaw = 90.0f;
+            params.x = 0.5f;
+            params.z = 1.2f;
+            const PointExtrinsic extrinsic = pointExtrinsicFromParams(params);
+            uint64_t n = 0;
+            for (int i = 0; i < packets->size(); ++i) {
+                const LivoxLidarEthernetPacket* pkt = packetAt(*packets, i);
+                QVector<Point3D> points;
+                points.reserve(pkt->dot_num);
+                n += uint64_t(decodePointPacket(pkt, options, points, &extrinsic));
+            }
+            return n;
+        } });
+    }
+
+    // ---- CRC 校验：运行时选择的实现与查表实现对比
+    cases.append(BenchCase{ "crc/dispatch", nullptr, [&d]() {
+        uint64_t n = 0;
+        for (int i = 0; i < d.packetsHigh.size(); ++i) {
+            const LivoxLidarEthernetPacket* pkt = packetAt(d.packetsHigh, i);
+            if (verifyPacketCrc(pkt)) n += pkt->dot_num;
+        }
+        return n;
+    } });
+    cases.append(BenchCase{ "crc/table", nullptr, [&d]() {
+        uint64_t n = 0;
+        for (int i = 0; i < d.packetsHigh.size(); ++i) {
+            const LivoxLidarEthernetPacket* pkt = packetAt(d.packetsHigh, i);
+            const size_t length = sizeof(pkt->timestamp) + size_t(pkt->dot_num) * pointDataSize(pkt->data_type);
+            if (crc32IeeeTable(pkt->timestamp, length) == pkt->crc32) n += pkt->dot_num;
+        }
+        return n;
+    } });
+
+    // ---- 车队模式接收：1s 数据包轮流分给 32 台设备，工作线程经流水线各设备通道解码，等待处理完毕
+    struct FleetState {
+        FleetIngest ingest;
+        PointCloudPipeline pipeline;
+        std::atomic<uint64_t> handled{0};
+        std::atomic<uint64_t> points{0};
+    };
+    std::shared_ptr<FleetState> fleet = std::make_shared<FleetState>();
+    cases.append(BenchCase{ "fleet/ingest-32", [fleet]() {
+        if (fleet->ingest.isRunning()) return true;
+        fleet->ingest.setHandler([fleet](uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t arrivalNs, bool render) {
+            if (render) {
+                PointCloudFrame frame;
+                fleet->pipeline.decodePacket(handle, packet, arrivalNs, frame);
+                fleet->points.fetch_add(uint64_t(frame.points.size()), std::memory_order_relaxed);
+            }
+            fleet->handled.fetch_add(1, std::memory_order_relaxed);
+        });
+        for (uint32_t h = 1; h <= 32; ++h) fleet->ingest.setRendered(h, true);
+        fleet->ingest.start();
+        return true;
+    }, [&d, fleet]() {
+        const uint64_t target = fleet->handled.load() + uint64_t(d.packetsHigh.size());
+        uint64_t n = 0;
+        for (int i = 0; i < d.packetsHigh.size(); ++i) {
+            const LivoxLidarEthernetPacket* pkt = packetAt(d.packetsHigh, i);
+            // 队列满时等待工作线程（基准只测吞吐，不丢包）
+            while (!fleet->ingest.push(1 + uint32_t(i % 32), pkt, 0)) std::this_thread::yield();
+            n += pkt->dot_num;
+        }
+        while (fleet->handled.load() < target) std::this_thread::yield();
+        return n;
+    } });
+
+    // ---- 组帧：滑动窗口合并
+    struct WindowSet { const char* name; uint64_t ms; };
+    const WindowSet windows[] = { { "assemble/100ms", 100 }, { "assemble/1s", 1000 }, { "assemble/10s", 10000 } };
+    for (const WindowSet& w : windows) {
+        std::shared_ptr<PointCloudPipeline> pipeline = std::make_shared<PointCloudPipeline>();
+        pipeline->setWindowMs(w.ms);
+        const QVector<PointCloudFrame>* frames = &d.frames;
+        std::shared_ptr<bool> filled = std::make_shared<bool>(false);
+        cases.append(BenchCase{ w.name, [pipeline, frames, filled]() {
+            if (!*filled) {
+                for (const PointCloudFrame& f : *frames) pipeline->pushFrame(f);
+                *filled = true;
+            }
+            return true;
+        }, [pipeline]() {
+            PointCloudFrame merged;
+            pipeline->assembleWindow(merged);
+            return uint64_t(merged.points.size());
+        } });
+    }
+
+    // ---- 着色：各模式原地着色 1s 点云
+    struct ColorSet { const char* name; int mode; };
+    const ColorSet colors[] = {
+        { "color/reflectivity", PointColorByReflectivity },
+        { "color/distance", PointColorByDistance },
+        { "color/elevation", PointColorByElevation },
+        { "color/solid", PointColorSolid },
+        { "color/planar", PointColorByPlanarProjection },
+    };
+    for (const ColorSet& c : colors) {
+        const int mode = c.mode;
+        cases.append(BenchCase{ c.name, [&d]() { d.work = d.cloud; d.work.detach(); return true; }, [&d, mode]() {
+            PointColorOptions options;
+            options.mode = mode;
+            const PointColorLegend legend = colorizePoints(d.work, options);
+            g_sink = g_sink + uint64_t(legend.maxVal);
+            return uint64_t(d.work.size());
+        } });
+    }
+
+    // ---- 运动去畸变：1s 点云，200Hz IMU 匀速转动
+    std::shared_ptr<PointDeskew> deskew = std::make_shared<PointDeskew>();
+    deskew->setEnabled(true);
+    for (int i = 0; i <= 220; ++i) {
+        ImuGyroSample s;
+        s.timestamp = kStartNs - 50000000ULL + uint64_t(i) * 5000000ULL;
+        s.gx = 0.05f;
+        s.gz = 0.8f;
+        deskew->pushImuSample(SyntheticLidarSource::deviceHandle(0), s);
+    }
+    cases.append(BenchCase{ "deskew/1s", [&d]() { d.work = d.cloud; d.work.detach(); return true; }, [&d, deskew]() {
+        deskew->apply(d.work, d.cloudSpans, QMap<uint32_t, PointExtrinsic>());
+        return uint64_t(d.work.size());
+    } });
+
+    // ---- tag 滤波
+    const QVector<uint8_t> noiseTags = { 0x01, 0x02, 0x04 };
+    cases.append(BenchCase{ "filter/tag-highlight", [&d]() { d.work = d.cloud; d.work.detach(); return true; }, [&d, noiseTags]() {
+        const uint64_t n = uint64_t(d.work.size());
+        applyTagNoiseFilter(d.work, noiseTags, true, false);
+        return n;
+    } });
+    cases.append(BenchCase{ "filter/tag-remove", [&d]() { d.work = d.cloud; d.work.detach(); return true; }, [&d, noiseTags]() {
+        const uint64_t n = uint64_t(d.work.size());
+        applyTagNoiseFilter(d.work, noiseTags, false, true);
+        return n;
+    } });
+
+    // ---- 自适应点数预算：上传前的分层重排
+    cases.append(BenchCase{ "render/stratify", nullptr, [&d]() {
+        stratifyPointOrder(d.cloud, d.work);
+        return uint64_t(d.cloud.size());
+    } });
+
+    // ---- 累积地图八叉树：1s 点云增量插入；10s 累积后的可见节点选择
+    std::shared_ptr<PointOctree> octree = std::make_shared<PointOctree>();
+    cases.append(BenchCase{ "lod/insert", [octree]() { octree->clear(); return true; }, [&d, octree]() {
+        octree->insert(d.cloud);
+        return uint64_t(d.cloud.size());
+    } });
+    std::shared_ptr<PointOctree> octree10s = std::make_shared<PointOctree>();
+    cases.append(BenchCase{ "lod/select", [&d, octree10s]() {
+        if (octree10s->counters().points == 0) {
+            for (const PointCloudFrame& f : d.frames) octree10s->insert(f.points);
+        }
+        return true;
+    }, [octree10s]() {
+        const QMatrix4x4 mvp = benchProjection() * benchModelView();
+        OctreeView view;
+        view.mvp = mvp.constData();
+        view.eye[0] = -10.0f;
+        view.eye[2] = 5.0f;
+        view.projScale = 900.0f / (2.0f * std::tan(45.0f * float(M_PI) / 360.0f));
+        view.minSpacingPx = 2.0f;
+        view.pointBudget = 1000000;
+        OctreeSelection selection;
+        octree10s->select(view, selection);
+        g_sink = g_sink + uint64_t(selection.points);
+        return octree10s->counters().points;
+    } });
+
+    // ---- IMU 曲线：10 分钟 200Hz 历史，每帧读入新样本并按 1000 列抽稀 6 个通道（点数按窗口内样本计）
+    struct ImuChartState {
+        ImuHistory history;
+        ImuMinMaxDecimator decimator;
+        QVector<QPointF> points;
+        uint64_t next = 0;
+    };
+    std::shared_ptr<ImuChartState> imu = std::make_shared<ImuChartState>();
+    cases.append(BenchCase{ "imu/chart-frame", [imu]() {
+        if (imu->next == 0) {
+            imu->decimator.configure(600ULL * 1000000000ULL, 1000);
+            for (; imu->next < 200 * 600; ++imu->next) {
+                ImuSample s;
+                s.timestamp = imu->next * 5000000ULL;
+                for (int ch = 0; ch < ImuChannelCount; ++ch) s.value[ch] = std::sin(float(imu->next) * 0.01f * float(ch + 1));
+                imu->history.push(1, s);
+            }
+            imu->decimator.update(*imu->history.ring(1));
+        }
+        return true;
+    }, [imu]() {
+        // 一帧（约 33ms）到达的样本
+        for (int i = 0; i < 7; ++i, ++imu->next) {
+            ImuSample s;
+            s.timestamp = imu->next * 5000000ULL;
+            for (int ch = 0; ch < ImuChannelCount; ++ch) s.value[ch] = std::sin(float(imu->next) * 0.01f * float(ch + 1));
+            imu->history.push(1, s);
+        }
+        imu->decimator.update(*imu->history.ring(1));
+        for (int ch = 0; ch < ImuChannelCount; ++ch) {
+            imu->decimator.build(ch, imu->decimator.latestTimestamp(), imu->points);
+            g_sink = g_sink + uint64_t(imu->points.size());
+        }
+        return uint64_t(200 * 600);
+    } });
+
+    // ---- Allan 偏差：文件分析的一块样本（六轴并行累积）
+    struct AllanState {
+        AllanDeviation allan;
+        QVector<ImuSample> block;
+    };
+    std::shared_ptr<AllanState> allan = std::make_shared<AllanState>();
+    cases.append(BenchCase{ "imu/allan-block", [allan]() {
+        if (allan->block.isEmpty()) {
+            allan->block.resize(65536);
+            uint32_t seed = 1;
+            for (int i = 0; i < allan->block.size(); ++i) {
+                ImuSample& s = allan->block[i];
+                s.timestamp = uint64_t(i + 1) * 5000000ULL;
+                for (int ch = 0; ch < ImuChannelCount; ++ch) {
+                    seed = seed * 1664525u + 1013904223u;
+                    s.value[ch] = float(seed >> 8) / 16777216.0f - 0.5f;
+                }
+            }
+        }
+        return true;
+    }, [allan]() {
+        allan->allan.addSamples(allan->block);
+        return uint64_t(allan->block.size());
+    } });
+
+    // ---- 参数应答：40 个键中只有温度与本地时间变化（其余键跳过格式化）
+    struct ParamState {
+        ParamPoller poller;
+        QByteArray reply;
+        int tempOffset = 0;
+        int timeOffset = 0;
+        uint16_t keys = 0;
+        int32_t temp = 0;
+        uint64_t time = 0;
+    };
+    std::shared_ptr<ParamState> param = std::make_shared<ParamState>();
+    cases.append(BenchCase{ "param/response", [param]() {
+        if (param->reply.isEmpty()) {
+            auto append = [param](uint16_t key, uint16_t length) {
+                const int off = param->reply.size();
+                param->reply.append(reinterpret_cast<const char*>(&key), 2);
+                param->reply.append(reinterpret_cast<const char*>(&length), 2);
+                param->reply.append(QByteArray(length, char(key & 0xFF)));
+                param->keys++;
+                return off + 4;
+            };
+            for (uint16_t key = 0x0001; key <= 0x0026; ++key) append(key, key % 3 == 0 ? 24 : 4);
+            param->tempOffset = append(kKeyCoreTemp, 4);
+            param->timeOffset = append(kKeyLocalTimeNow, 8);
+            param->poller.setFormatter([](uint16_t key, const QByteArray& raw) {
+                return QString("0x%1: %2").arg(key, 4, 16, QChar('0')).arg(QString::fromLatin1(raw.toHex().constData()));
+            });
+            param->poller.addDevice(1);
+        }
+        return true;
+    }, [param]() {
+        param->temp = (param->temp + 1) % 8000;
+        param->time += 1000000000ULL;
+        std::memcpy(param->reply.data() + param->tempOffset, &param->temp, sizeof(param->temp));
+        std::memcpy(param->reply.data() + param->timeOffset, &param->time, sizeof(param->time));
+        param->poller.handleResponse(1, true, param->keys, reinterpret_cast<const uint8_t*>(param->reply.constData()));
+        return uint64_t(param->keys);
+    } });
+
+    // ---- 框选查询（与界面上限一致：200000 点）
+    cases.append(BenchCase{ "select/aabb", nullptr, [&d]() {
+        const float lo[3] = { -5.0f, -5.0f, -1.0f };
+        const float hi[3] = { 5.0f, 5.0f, 2.0f };
+        g_sink = g_sink + uint64_t(selectPointsInAabb(d.cloud, lo, hi, 200000).size());
+        return uint64_t(d.cloud.size());
+    } });
+    cases.append(BenchCase{ "select/screen-rect", nullptr, [&d]() {
+        const QMatrix4x4 mvp = benchProjection() * benchModelView();
+        ScreenSelection sel;
+        sel.mvp = mvp.constData();
+        sel.viewportW = 1600.0f;
+        sel.viewportH = 900.0f;
+        sel.left = 600.0f; sel.top = 300.0f; sel.right = 1000.0f; sel.bottom = 600.0f;
+        sel.pixelSnap = true;
+        g_sink = g_sink + uint64_t(selectPointsInScreenRect(d.cloud, sel, 200000).size());
+        return uint64_t(d.cloud.size());
+    } });
+    cases.append(BenchCase{ "select/persist", nullptr, [&d]() {
+        const QMatrix4x4 modelView = benchModelView();
+        const QMatrix4x4 mvp = benchProjection() * modelView;
+        ScreenSelection sel;
+        sel.mvp = mvp.constData();
+        sel.modelView = modelView.constData();
+        sel.viewportW = 1600.0f;
+        sel.viewportH = 900.0f;
+        sel.left = 600.0f; sel.top = 300.0f; sel.right = 1000.0f; sel.bottom = 600.0f;
+        sel.viewZMin = -30.0f;
+        sel.viewZMax = -5.0f;
+        g_sink = g_sink + uint64_t(selectPointsInScreenRect(d.cloud, sel, 200000).size());
+        return uint64_t(d.cloud.size());
+    } });
+
+    // ---- 文件写入（1s 点云 / 1s 原始包）
+    const QString dir = d.tempDir.path();
+    cases.append(BenchCase{ "export/pcd-binary", nullptr, [&d, dir]() {
+        savePointsAsPCD(dir + "/bench.pcd", d.cloud, true);
+        return uint64_t(d.cloud.size());
+    } });
+    cases.append(BenchCase{ "export/pcd-ascii", nullptr, [&d, dir]() {
+        savePointsAsPCD(dir + "/bench_ascii.pcd", d.cloud, false);
+        return uint64_t(d.cloud.size());
+    } });
+    cases.append(BenchCase{ "export/las", nullptr, [&d, dir]() {
+        savePointsAsLAS(dir + "/bench.las", d.cloud);
+        return uint64_t(d.cloud.size());
+    } });
+    cases.append(BenchCase{ "export/ply", nullptr, [&d, dir]() {
+        savePointsAsPLY(dir + "/bench.ply", d.cloud);
+        return uint64_t(d.cloud.size());
+    } });
+    cases.append(BenchCase{ "export/lvx2", nullptr, [&d, dir]() {
+        LVX2DeviceInfo dev{};
+        dev.lidar_id = SyntheticLidarSource::deviceHandle(0);
+        Lvx2Writer writer;
+        writer.open(dir + "/bench.lvx2", QVector<LVX2DeviceInfo>() << dev);
+        uint64_t n = 0;
+        for (int i = 0; i < d.packetsHigh.size(); ++i) {
+            const LivoxLidarEthernetPacket* pkt = packetAt(d.packetsHigh, i);
+            writer.writePacket(dev.lidar_id, pkt);
+            n += pkt->dot_num;
+        }
+        writer.close();
+        return n;
+    } });
+
+    // ---- 遥测查询：10 小时 10Hz 的温度序列，按 1000 列抽取整段
+    struct TelemetryState {
+        TelemetryReader reader;
+        uint64_t samples = 0;
+    };
+    std::shared_ptr<TelemetryState> tlm = std::make_shared<TelemetryState>();
+    cases.append(BenchCase{ "telemetry/query-10h", [tlm, dir]() {
+        if (tlm->reader.isOpen()) return true;
+        const QString path = dir + "/bench.lvxtlm";
+        TelemetryWriter writer;
+        if (!writer.open(path)) return false;
+        const int64_t t0 = 1700000000000000000LL;
+        tlm->samples = 10 * 3600 * 10;
+        for (uint64_t i = 0; i < tlm->samples; ++i) {
+            writer.append(1, TelemetryCoreTemp, t0 + int64_t(i) * 100000000LL, 4000 + int64_t((i / 600) % 50));
+        }
+        writer.close();
+        return tlm->reader.open(path);
+    }, [tlm]() {
+        g_sink = g_sink + uint64_t(tlm->reader.query(1, TelemetryCoreTemp, tlm->reader.firstNs(), tlm->reader.lastNs(), 1000).size());
+        return tlm->samples;
+    } });
+
+    // ---- 日志：高频路径每帧一条带站点的日志，超出限速后应只剩一次原子计数
+    std::shared_ptr<LogRing> logRing = std::make_shared<LogRing>();
+    cases.append(BenchCase{ "log/post-limited", nullptr, [logRing]() {
+        static const QString text = QString("PCD保存: %1").arg("bench.pcd");
+        uint64_t posted = 0;
+        for (int i = 0; i < 1000; ++i) posted += logRing->post(LogInfo, text, "bench-save") ? 1 : 0;
+        g_sink = g_sink + posted;
+        return uint64_t(1000);
+    } });
+
+    // ---- VBO 上传：与 PointCloudWidget::updatePointCloud 相同的整帧 glBufferData
+    // 无可用 OpenGL（如无显卡的 CI）时跳过
+    cases.append(BenchCase{ "vbo/upload", [&d]() { return ensureGl(d); }, [&d]() {
+        QOpenGLFunctions* f = d.glContext->functions();
+        f->glBindBuffer(GL_ARRAY_BUFFER, d.vbo);
+        f->glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(d.cloud.size() * sizeof(Point3D)), d.cloud.constData(), GL_DYNAMIC_DRAW);
+        f->glBindBuffer(GL_ARRAY_BUFFER, 0);
+        f->glFinish();
+        return uint64_t(d.cloud.size());
+    } });
+
+    return cases;
+}
+
+// =============================================================================
+// 基线
+// =============================================================================
+
+static QJsonObject resultsToJson(const QVector<BenchResult>& results, double threshold)
+{
+    QJsonObject cases;
+    for (const BenchResult& r : results) {
+        if (r.skipped) continue;
+        QJsonObject o;
+        o["ns_per_point"] = r.nsPerPoint;
+        o["points_per_sec"] = r.pointsPerSec;
+        o["allocs_per_iter"] = r.allocsPerIter;
+        o["points_per_iter"] = double(r.pointsPerIter);
+        o["iterations"] = r.iterations;
+        cases[r.name] = o;
+    }
+    QJsonObject root;
+    root["version"] = 1;
+    root["threshold"] = threshold;
+    root["alloc_slack"] = 1.0;
+    root["cases"] = cases;
+    return root;
+}
+
+static bool writeJson(const QString& path, const QJsonObject& root)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+    f.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+// 比较结果与基线：ns/point 超过 基线*(1+阈值)，或分配次数超过 基线*(1+阈值)+alloc_slack 视为回退
+static int compareWithBaseline(const QVector<BenchResult>& results, const QJsonObject& baseline,
+                               double thresholdOverride)
+{
+    const double defaultThreshold = thresholdOverride >= 0.0 ? thresholdOverride
+                                                             : baseline.value("threshold").toDouble(0.25);
+    const double allocSlack = baseline.value("alloc_slack").toDouble(1.0);
+    const QJsonObject cases = baseline.value("cases").toObject();
+
+    int regressions = 0;
+    printLine("");
+    printLine(QString("%1 %2 %3 %4 %5")
+                  .arg("case", -26).arg("ns/pt", 10).arg("base", 10).arg("delta", 9).arg("allocs(base)", 16));
+    for (const BenchResult& r : results) {
+        if (r.skipped) continue;
+        if (!cases.contains(r.name)) {
+            printLine(QString("%1 %2 %3").arg(r.name, -26).arg(r.nsPerPoint, 10, 'f', 3).arg("(无基线)", 10));
+            continue;
+        }
+        const QJsonObject b = cases.value(r.name).toObject();
+        const double threshold = (thresholdOverride < 0.0 && b.contains("threshold"))
+                                     ? b.value("threshold").toDouble() : defaultThreshold;
+        const double baseNs = b.value("ns_per_point").toDouble();
+        const double baseAllocs = b.value("allocs_per_iter").toDouble();
+        const double delta = baseNs > 0.0 ? (r.nsPerPoint - baseNs) / baseNs : 0.0;
+
+        QStringList problems;
+        if (baseNs > 0.0 && r.nsPerPoint > baseNs * (1.0 + threshold)) {
+            problems << QString("耗时 +%1% > %2%").arg(delta * 100.0, 0, 'f', 1).arg(threshold * 100.0, 0, 'f', 0);
+        }
+        if (r.allocsPerIter > baseAllocs * (1.0 + threshold) + allocSlack) {
+            problems << QString("分配 %1 > %2").arg(r.allocsPerIter, 0, 'f', 1).arg(baseAllocs, 0, 'f', 1);
+        }
+        regressions += problems.isEmpty() ? 0 : 1;
+
+        printLine(QString("%1 %2 %3 %4 %5  %6")
+                      .arg(r.name, -26)
+                      .arg(r.nsPerPoint, 10, 'f', 3)
+                      .arg(baseNs, 10, 'f', 3)
+                      .arg(QString("%1%2%").arg(delta >= 0 ? "+" : "").arg(delta * 100.0, 0, 'f', 1), 9)
+                      .arg(QString("%1(%2)").arg(r.allocsPerIter, 0, 'f', 1).arg(baseAllocs, 0, 'f', 1), 16)
+                      .arg(problems.isEmpty() ? QString("OK") : QString("回退: ") + problems.join("; ")));
+    }
+    return regressions;
+}
+
+// =============================================================================
+// main
+// =============================================================================
+
+int main(int argc, char *argv[])
+{
+    // VBO 用例只需离屏上下文，默认使用 offscreen 平台以便在无显示的环境运行
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication app(argc, argv);
+    app.setApplicationName("LivoxBench");
+    app.setApplicationVersion("1.0");
+    app.setOrganizationName("FelixCooper1026");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("点云流水线基准测试（解码/组帧/着色/滤波/框选/写文件/VBO）");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption quickOpt("quick", "快速模式（每个用例约 100ms，用于 ctest）");
+    QCommandLineOption filterOpt("filter", "只运行名称包含该字符串的用例", "text");
+    QCommandLineOption minTimeOpt("min-time", "每个用例最短计时（ms）", "ms");
+    QCommandLineOption baselineOpt("baseline", "与基线 JSON 比较，回退时返回 1", "file");
+    QCommandLineOption thresholdOpt("threshold", "允许的回退比例（覆盖基线文件中的设置，如 0.25）", "ratio");
+    QCommandLineOption reportOnlyOpt("report-only", "只报告与基线的差异，不因回退返回失败");
+    QCommandLineOption jsonOpt("json", "将结果写入 JSON（格式与基线相同，可直接作为新基线）", "file");
+    parser.addOptions({quickOpt, filterOpt, minTimeOpt, baselineOpt, thresholdOpt, reportOnlyOpt, jsonOpt});
+    parser.process(app);
+
+    const bool quick = parser.isSet(quickOpt);
+    const qint64 minTimeMs = parser.isSet(minTimeOpt) ? parser.value(minTimeOpt).toLongLong() : (quick ? 100 : 1000);
+    const int minIterations = quick ? 2 : 5;
+    double thresholdOverride = -1.0;
+    if (parser.isSet(thresholdOpt)) {
+        thresholdOverride = parser.value(thresholdOpt).toDouble();
+    } else if (!qEnvironmentVariableIsEmpty("LIVOX_BENCH_THRESHOLD")) {
+        thresholdOverride = qEnvironmentVariable("LIVOX_BENCH_THRESHOLD").toDouble();
+    }
+
+    QJsonObject baseline;
+    if (parser.isSet(baselineOpt)) {
+        QFile f(parser.value(baselineOpt));
+        if (!f.open(QIODevice::ReadOnly)) {
+            printLine(QString("无法打开基线文件: %1").arg(f.fileName()));
+            return 1;
+        }
+        QJsonParseError err;
+        const QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &err);
+        if (doc.isNull() || !doc.isObject()) {
+            printLine(QString("基线文件格式错误: %1").arg(err.errorString()));
+            return 1;
+        }
+        baseline = doc.object();
+    }
+
+    // 准备数据
+    QElapsedTimer setupTimer;
+    setupTimer.start();
+    BenchData data;
+    if (!data.tempDir.isValid()) {
+        printLine("无法创建临时目录");
+        return 1;
+    }
+    data.packetsHigh = generatePackets(kLivoxLidarCartesianCoordinateHighData, 1.0);
+    data.packetsLow = generatePackets(kLivoxLidarCartesianCoordinateLowData, 1.0);
+    data.packetsSph = generatePackets(kLivoxLidarSphericalCoordinateData, 1.0);
+    data.frames = decodeFrames(generatePackets(kLivoxLidarCartesianCoordinateHighData, 10.0));
+    const QVector<PointCloudFrame> oneSecond = decodeFrames(data.packetsHigh);
+    for (const PointCloudFrame& f : oneSecond) {
+        PointDeskewSpan s;
+        s.handle = f.device_handle;
+        s.offset = data.cloud.size();
+        s.count = f.points.size();
+        s.timestamp = f.timestamp;
+        s.spanNs = f.timeSpanNs;
+        data.cloudSpans.append(s);
+        data.cloud += f.points;
+    }
+    printLine(QString("数据准备完成: %1 点/秒, %2 ms").arg(data.cloud.size()).arg(setupTimer.elapsed()));
+    printLine(QString("CRC32 实现: %1").arg(crc32Implementation()));
+    printLine("");
+
+    const QString filter = parser.value(filterOpt);
+    QVector<BenchCase> cases = buildCases(data);
+    QVector<BenchResult> results;
+
+    printLine(QString("%1 %2 %3 %4 %5 %6")
+                  .arg("case", -26).arg("iters", 6).arg("pts/iter", 10)
+                  .arg("Mpts/s", 10).arg("ns/pt", 10).arg("allocs/iter", 12));
+    for (const BenchCase& c : cases) {
+        if (!filter.isEmpty() && !c.name.contains(filter)) continue;
+        const BenchResult r = runCase(c, minTimeMs * 1000000LL, minIterations);
+        results.append(r);
+        if (r.skipped) {
+            printLine(QString("%1 (跳过: 环境不支持)").arg(r.name, -26));
+            continue;
+        }
+        printLine(QString("%1 %2 %3 %4 %5 %6")
+                      .arg(r.name, -26)
+                      .arg(r.iterations, 6)
+                      .arg(qulonglong(r.pointsPerIter), 10)
+                      .arg(r.pointsPerSec / 1e6, 10, 'f', 2)
+                      .arg(r.nsPerPoint, 10, 'f', 3)
+                      .arg(r.allocsPerIter, 12, 'f', 1));
+    }
+    releaseGl(data);
+
+    if (parser.isSet(jsonOpt)) {
+        const double threshold = thresholdOverride >= 0.0 ? thresholdOverride
+                                                           : baseline.value("threshold").toDouble(0.25);
+        if (!writeJson(parser.value(jsonOpt), resultsToJson(results, threshold))) {
+            printLine(QString("无法写入结果文件: %1").arg(parser.value(jsonOpt)));
+            return 1;
+        }
+    }
+
+    if (!baseline.isEmpty()) {
+        const int regressions = compareWithBaseline(results, baseline, thresholdOverride);
+        printLine("");
+        if (regressions > 0) {
+            printLine(QString("%1 个用例性能回退").arg(regressions));
+            return parser.isSet(reportOnlyOpt) ? 0 : 1;
+        }
+        printLine("所有用例均在基线阈值内");
+    }
+    return 0;
+}
@@ -0,0 +1,496 @@
+// LivoxConvert - 无界面批量转换工具
+// 将 LVX2 / 原始数据包录制（.lvxraw）转换为 PCD(二进制/ASCII)、LAS、PLY
+// 解码与 GUI 共用 point_decode，保证在线与离线结果一致
+
+#include "point_decode.h"
+#include "point_export.h"
+#include "lvx2_reader.h"
+#include "raw_capture.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QDir>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QThread>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+enum class OutputFormat { PcdBinary, PcdAscii, Las, Ply };
+
+struct ConvertOptions {
+    OutputFormat format = OutputFormat::PcdBinary;
+    QString outputDir;
+    int jobs = 1;
+    uint64_t windowMs = 100;   // 组帧窗口，与界面默认积分时间一致
+    bool merge = false;        // 每个输入合并为一个输出文件
+    bool quiet = false;
+    bool extrinsics = false;   // 按 LVX2 设备表外参把各雷达变换到同一坐标系
+    PointDecodeOptions decode;
+};
+
+// 一帧内的原始点数据
+struct ConvertPacket {
+    uint8_t dataType = 0;
+    uint32_t dotNum = 0;
+    QByteArray data;
+    bool hasExtrinsic = false;
+    PointExtrinsic extrinsic;
+};
+
+struct ConvertJob {
+    qint64 index = 0;
+    uint64_t timestamp = 0;
+    QVector<ConvertPacket> packets;
+};
+
+struct ConvertResult {
+    qint64 index = 0;
+    uint64_t timestamp = 0;
+    qint64 pointCount = 0;
+    qint64 bytesOut = 0;
+    bool ok = true;
+    QString filePath;
+    QVector<Point3D> points;   // 仅合并输出时保留
+};
+
+struct ConvertStats {
+    qint64 frames = 0;
+    qint64 packets = 0;
+    qint64 points = 0;
+    qint64 bytesIn = 0;
+    qint64 bytesOut = 0;
+    qint64 failed = 0;
+};
+
+static void printLine(const QString& line)
+{
+    std::fputs(line.toLocal8Bit().constData(), stdout);
+    std::fputc('\n', stdout);
+    std::fflush(stdout);
+}
+
+static QString formatExtension(OutputFormat format)
+{
+    switch (format) {
+        case OutputFormat::Las: return "las";
+        case OutputFormat::Ply: return "ply";
+        default: return "pcd";
+    }
+}
+
+static bool savePoints(OutputFormat format, const QString& filePath, const QVector<Point3D>& points)
+{
+    switch (format) {
+        case OutputFormat::PcdBinary: return savePointsAsPCD(filePath, points, true);
+        case OutputFormat::PcdAscii: return savePointsAsPCD(filePath, points, false);
+        case OutputFormat::Las: return savePointsAsLAS(filePath, points);
+        case OutputFormat::Ply: return savePointsAsPLY(filePath, points);
+    }
+    return false;
+}
+
+// 多线程帧转换：工作线程并行解码/写文件，结果按帧序号重排后顺序提交
+class FrameConverter
+{
+public:
+    FrameConverter(const ConvertOptions& options, const QString& outputBase)
+        : m_options(options), m_outputBase(outputBase)
+    {
+        const int n = std::max(1, options.jobs);
+        m_maxQueued = n * 2;
+        for (int i = 0; i < n; ++i) {
+            m_workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~FrameConverter() { finish(false); }
+
+    // 队列满时阻塞，限制内存占用
+    void submit(ConvertJob&& job)
+    {
+        QMutexLocker lk(&m_queueMutex);
+        while (m_queue.size() >= m_maxQueued) {
+            m_queueNotFull.wait(&m_queueMutex);
+        }
+        m_queue.append(std::move(job));
+        m_queueNotEmpty.wakeOne();
+    }
+
+    // inputOk 为 false（输入读取失败）时不写合并输出
+    void finish(bool inputOk = true)
+    {
+        {
+            QMutexLocker lk(&m_queueMutex);
+            if (m_finished) return;
+            m_finished = true;
+            m_queueNotEmpty.wakeAll();
+        }
+        for (std::thread& t : m_workers) {
+            if (t.joinable()) t.join();
+        }
+        m_workers.clear();
+        if (m_options.merge && inputOk && m_merged.isEmpty()) {
+            if (!m_options.quiet) printLine("合并输出: 无点数据，未写入文件");
+        } else if (m_options.merge && inputOk) {
+            const QString filePath = m_outputBase + "." + formatExtension(m_options.format);
+            if (savePoints(m_options.format, filePath, m_merged)) {
+                m_stats.bytesOut += QFileInfo(filePath).size();
+                if (!m_options.quiet) printLine(QString("合并输出: %1 (%2 点)").arg(QDir::toNativeSeparators(filePath)).arg(m_merged.size()));
+            } else {
+                m_stats.failed++;
+                printLine(QString("写入失败: %1").arg(QDir::toNativeSeparators(filePath)));
+            }
+        }
+        m_merged.clear();
+    }
+
+    const ConvertStats& stats() const { return m_stats; }
+
+private:
+    void workerLoop()
+    {
+        for (;;) {
+            ConvertJob job;
+            {
+                QMutexLocker lk(&m_queueMutex);
+                while (m_queue.isEmpty() && !m_finished) {
+                    m_queueNotEmpty.wait(&m_queueMutex);
+                }
+                if (m_queue.isEmpty()) return;
+                job = m_queue.takeFirst();
+                m_queueNotFull.wakeOne();
+            }
+            deliver(convert(job));
+        }
+    }
+
+    ConvertResult convert(const ConvertJob& job)
+    {
+        ConvertResult result;
+        result.index = job.index;
+        result.timestamp = job.timestamp;
+
+        int total = 0;
+        for (const ConvertPacket& pkt : job.packets) total += int(pkt.dotNum);
+        QVector<Point3D> points;
+        points.reserve(total);
+        for (const ConvertPacket& pkt : job.packets) {
+            decodePointData(pkt.dataType, reinterpret_cast<const uint8_t*>(pkt.data.constData()),
+                            pkt.dotNum, m_options.decode, points, pkt.hasExtrinsic ? &pkt.extrinsic : nullptr);
+        }
+        result.pointCount = points.size();
+
+        if (m_options.merge) {
+            result.points = std::move(points);
+            return result;
+        }
+        result.filePath = QString("%1_%2_%3.%4")
+            .arg(m_outputBase)
+            .arg(job.index, 6, 10, QChar('0'))
+            .arg(job.timestamp)
+            .arg(formatExtension(m_options.format));
+        result.ok = savePoints(m_options.format, result.filePath, points);
+        if (result.ok) result.bytesOut = QFileInfo(result.filePath).size();
+        return result;
+    }
+
+    void deliver(ConvertResult&& result)
+    {
+        QMutexLocker lk(&m_resultMutex);
+        m_reorder.insert(result.index, std::move(result));
+        // 按帧序号顺序提交，保证日志与合并输出的顺序与输入一致
+        while (!m_reorder.isEmpty() && m_reorder.firstKey() == m_nextIndex) {
+            ConvertResult r = m_reorder.take(m_nextIndex);
+            m_stats.frames++;
+            m_stats.points += r.pointCount;
+            m_stats.bytesOut += r.bytesOut;
+            if (m_options.merge) {
+                m_merged += r.points;
+            } else if (!r.ok) {
+                m_stats.failed++;
+                printLine(QString("写入失败: %1").arg(QDir::toNativeSeparators(r.filePath)));
+            } else if (!m_options.quiet) {
+                printLine(QString("[%1] %2 (%3 点)").arg(r.index).arg(QDir::toNativeSeparators(r.filePath)).arg(r.pointCount));
+            }
+            m_nextIndex++;
+        }
+    }
+
+    ConvertOptions m_options;
+    QString m_outputBase;
+    std::vector<std::thread> m_workers;
+
+    QMutex m_queueMutex;
+    QWaitCondition m_queueNotEmpty;
+    QWaitCondition m_queueNotFull;
+    QList<ConvertJob> m_queue;
+    int m_maxQueued = 2;
+    bool m_finished = false;
+
+    QMutex m_resultMutex;
+    QMap<qint64, ConvertResult> m_reorder;
+    qint64 m_nextIndex = 0;
+    QVector<Point3D> m_merged;
+    ConvertStats m_stats;
+};
+
+// 按时间窗口把数据包组帧后提交给转换器。窗口起点按 lidar_id 分别记录：
+// 多雷达文件中各设备时钟不一致、包交错出现，不能按相邻包时间差分帧
+class JobBuilder
+{
+public:
+    JobBuilder(FrameConverter& converter, uint64_t windowMs)
+        : m_converter(converter), m_windowNs(windowMs * 1000000ULL) {}
+
+    // 每个 lidar_id 的外参，解码时应用
+    void setExtrinsics(const QMap<uint32_t, PointExtrinsic>& extrinsics) { m_extrinsics = extrinsics; }
+
+    void addPacket(uint64_t timestamp, uint8_t dataType, uint32_t dotNum, QByteArray data, uint32_t lidarId = 0)
+    {
+        if (dotNum == 0 || pointDataSize(dataType) == 0) return;
+        auto start = m_frameStartNs.find(lidarId);
+        if (start == m_frameStartNs.end()) {
+            m_frameStartNs.insert(lidarId, timestamp);
+        } else if (timestamp >= start.value() && timestamp - start.value() >= m_windowNs) {
+            flush();
+            m_frameStartNs.insert(lidarId, timestamp);
+        } else if (timestamp + m_windowNs < start.value()) {
+            // 时钟回跳超过一个窗口（如重新同步）：只重置该设备的起点，不作为分帧依据
+            start.value() = timestamp;
+        }
+        ConvertPacket pkt;
+        pkt.dataType = dataType;
+        pkt.dotNum = dotNum;
+        pkt.data = std::move(data);
+        auto ext = m_extrinsics.constFind(lidarId);
+        if (ext != m_extrinsics.constEnd()) {
+            pkt.hasExtrinsic = true;
+            pkt.extrinsic = ext.value();
+        }
+        m_job.packets.append(std::move(pkt));
+        m_job.timestamp = timestamp;
+        m_packets++;
+    }
+
+    void flush()
+    {
+        if (m_job.packets.isEmpty()) return;
+        m_job.index = m_nextIndex++;
+        m_converter.submit(std::move(m_job));
+        m_job = ConvertJob();
+        m_frameStartNs.clear();
+    }
+
+    qint64 packetCount() const { return m_packets; }
+
+private:
+    FrameConverter& m_converter;
+    uint64_t m_windowNs;
+    QMap<uint32_t, uint64_t> m_frameStartNs;   // lidar_id -> 当前帧窗口起点
+    ConvertJob m_job;
+    QMap<uint32_t, PointExtrinsic> m_extrinsics;
+    qint64 m_nextIndex = 0;
+    qint64 m_packets = 0;
+};
+
+static bool convertLvx2(const QString& inputPath, JobBuilder& builder, bool applyExtrinsics, bool quiet, QString& error)
+{
+    Lvx2Reader reader;
+    if (!reader.open(inputPath)) {
+        error = reader.errorString();
+        return false;
+    }
+    if (applyExtrinsics) {
+        QMap<uint32_t, PointExtrinsic> extrinsics;
+        for (const LVX2DeviceInfo& dev : reader.devices()) {
+            if (!dev.extrinsic_enable) continue;
+            ExtrinsicParams params;
+            params.roll = dev.roll;
+            params.pitch = dev.pitch;
+            params.yaw = dev.yaw;
+            params.x = dev.x;
+            params.y = dev.y;
+            params.z = dev.z;
+            const PointExtrinsic e = pointExtrinsicFromParams(params);
+            if (isIdentityExtrinsic(e)) continue;
+            extrinsics.insert(dev.lidar_id, e);
+            if (!quiet) {
+                printLine(QString("  外参 %1 (id %2): R/P/Y %3/%4/%5°, X/Y/Z %6/%7/%8 m")
+                              .arg(QString::fromLatin1(dev.lidar_sn, int(strnlen(dev.lidar_sn, sizeof(dev.lidar_sn)))))
+                              .arg(dev.lidar_id).arg(dev.roll).arg(dev.pitch).arg(dev.yaw)
+                              .arg(dev.x).arg(dev.y).arg(dev.z));
+            }
+        }
+        builder.setExtrinsics(extrinsics);
+    }
+    Lvx2Frame frame;
+    while (reader.readNextFrame(frame)) {
+        for (Lvx2Package& pkg : frame.packages) {
+            const uint32_t pointSize = pointDataSize(pkg.header.data_type);
+            if (pointSize == 0) continue;
+            const uint32_t dotNum = pkg.header.data_length / pointSize;
+            builder.addPacket(pkg.header.timestamp, pkg.header.data_type, dotNum, std::move(pkg.data), pkg.header.lidar_id);
+        }
+    }
+    if (!reader.errorString().isEmpty()) {
+        printLine(QString("警告: %1").arg(reader.errorString()));
+    }
+    return true;
+}
+
+static bool convertRawCapture(const QString& inputPath, JobBuilder& builder, QString& error)
+{
+    RawCaptureReader reader;
+    if (!reader.open(inputPath)) {
+        error = reader.errorString();
+        return false;
+    }
+    RawCaptureRecord record;
+    const int headerSize = int(offsetof(LivoxLidarEthernetPacket, data));
+    while (reader.next(record)) {
+        if (record.header.kind != RawCapturePointCloud) continue;
+        const LivoxLidarEthernetPacket* packet = record.ethernetPacket();
+        const uint32_t pointSize = pointDataSize(packet->data_type);
+        if (pointSize == 0) continue;
+        // 防御损坏记录：点数不能超过记录中实际携带的数据
+        const uint32_t available = uint32_t(record.packet.size() - headerSize) / pointSize;
+        const uint32_t dotNum = std::min<uint32_t>(packet->dot_num, available);
+        builder.addPacket(parsePacketTimestamp(packet->timestamp), packet->data_type, dotNum,
+                          record.packet.mid(headerSize, int(dotNum * pointSize)), record.header.handle);
+    }
+    if (!reader.errorString().isEmpty()) {
+        printLine(QString("警告: %1").arg(reader.errorString()));
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("LivoxConvert");
+    app.setApplicationVersion("1.0");
+    app.setOrganizationName("FelixCooper1026");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("LVX2/原始数据包离线批量转换（PCD/LAS/PLY）");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("inputs", "输入文件（.lvx2 / .lvxraw）", "<files...>");
+    QCommandLineOption formatOpt({"f", "format"}, "输出格式: pcd(二进制) | pcd-ascii | las | ply", "format", "pcd");
+    QCommandLineOption outputOpt({"o", "output"}, "输出目录（默认与输入文件同目录）", "dir");
+    QCommandLineOption jobsOpt({"j", "jobs"}, "工作线程数（默认CPU核心数）", "n", QString::number(QThread::idealThreadCount()));
+    QCommandLineOption windowOpt({"w", "window"}, "组帧时间窗口（ms）", "ms", "100");
+    QCommandLineOption mergeOpt({"m", "merge"}, "每个输入文件合并为一个输出文件");
+    QCommandLineOption quietOpt({"q", "quiet"}, "只输出汇总信息");
+    QCommandLineOption depthOpt("projection-depth", "球坐标深度投影（m），与界面选项一致", "m");
+    QCommandLineOption planarOpt("planar-radius", "球坐标平面投影半径（m），与界面选项一致", "m");
+    QCommandLineOption extrinsicsOpt("extrinsics", "应用 LVX2 设备表中的外参（多雷达拼接）");
+    parser.addOptions({formatOpt, outputOpt, jobsOpt, windowOpt, mergeOpt, quietOpt, depthOpt, planarOpt, extrinsicsOpt});
+    parser.process(app);
+
+    const QStringList inputs = parser.positionalArguments();
+    if (inputs.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    ConvertOptions options;
+    const QString fmt = parser.value(formatOpt).toLower();
+    if (fmt == "pcd") options.format = OutputFormat::PcdBinary;
+    else if (fmt == "pcd-ascii") options.format = OutputFormat::PcdAscii;
+    else if (fmt == "las") options.format = OutputFormat::Las;
+    else if (fmt == "ply") options.format = OutputFormat::Ply;
+    else {
+        printLine(QString("未知输出格式: %1").arg(fmt));
+        return 1;
+    }
+    options.outputDir = parser.value(outputOpt);
+    options.jobs = std::max(1, parser.value(jobsOpt).toInt());
+    options.windowMs = std::max(1, parser.value(windowOpt).toInt());
+    options.merge = parser.isSet(mergeOpt);
+    options.quiet = parser.isSet(quietOpt);
+    options.extrinsics = parser.isSet(extrinsicsOpt);
+    if (parser.isSet(depthOpt)) {
+        options.decode.projectionDepthEnabled = true;
+        options.decode.projectionDepthMeters = parser.value(depthOpt).toFloat();
+    }
+    if (parser.isSet(planarOpt)) {
+        options.decode.planarProjectionEnabled = true;
+        options.decode.planarProjectionRadius = parser.value(planarOpt).toFloat();
+        if (!parser.isSet(depthOpt)) options.decode.projectionDepthMeters = 0.0f;
+    }
+
+    ConvertStats total;
+    qint64 totalPackets = 0;
+    int failedInputs = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (const QString& input : inputs) {
+        QFileInfo fi(input);
+        if (!fi.exists()) {
+            printLine(QString("文件不存在: %1").arg(input));
+            failedInputs++;
+            continue;
+        }
+        QDir outDir(options.outputDir.isEmpty() ? fi.absolutePath() : options.outputDir);
+        if (!outDir.exists() && !outDir.mkpath(".")) {
+            printLine(QString("无法创建输出目录: %1").arg(outDir.absolutePath()));
+            return 1;
+        }
+        QString outputBase = outDir.filePath(fi.completeBaseName());
+        if (!options.merge) {
+            // 逐帧输出放到以输入文件名命名的子目录
+            outDir.mkpath(fi.completeBaseName());
+            outputBase = QDir(outDir.filePath(fi.completeBaseName())).filePath(fi.completeBaseName());
+        }
+
+        if (!options.quiet) printLine(QString("转换: %1").arg(QDir::toNativeSeparators(fi.absoluteFilePath())));
+
+        FrameConverter converter(options, outputBase);
+        JobBuilder builder(converter, options.windowMs);
+        QString error;
+        const bool isRaw = fi.suffix().compare("lvxraw", Qt::CaseInsensitive) == 0;
+        const bool ok = isRaw ? convertRawCapture(input, builder, error)
+                              : convertLvx2(input, builder, options.extrinsics, options.quiet, error);
+        builder.flush();
+        converter.finish(ok);
+        if (!ok) {
+            printLine(QString("读取失败: %1 (%2)").arg(input, error));
+            failedInputs++;
+            continue;
+        }
+
+        const ConvertStats& s = converter.stats();
+        total.frames += s.frames;
+        total.points += s.points;
+        total.bytesOut += s.bytesOut;
+        total.failed += s.failed;
+        total.bytesIn += fi.size();
+        totalPackets += builder.packetCount();
+    }
+
+    // 吞吐量汇总
+    const double sec = std::max(1e-9, timer.nsecsElapsed() / 1e9);
+    printLine("=== 转换完成 ===");
+    printLine(QString("输入文件: %1 (失败 %2)").arg(inputs.size()).arg(failedInputs));
+    printLine(QString("帧数: %1  数据包: %2  点数: %3").arg(total.frames).arg(totalPackets).arg(total.points));
+    printLine(QString("输入: %1 MB  输出: %2 MB  写入失败: %3")
+              .arg(total.bytesIn / 1048576.0, 0, 'f', 2)
+              .arg(total.bytesOut / 1048576.0, 0, 'f', 2)
+              .arg(total.failed));
+    printLine(QString("耗时: %1 s  线程: %2").arg(sec, 0, 'f', 3).arg(options.jobs));
+    printLine(QString("吞吐: %1 Mpts/s  %2 MB/s (输入)  %3 帧/s")
+              .arg(total.points / sec / 1e6, 0, 'f', 2)
+              .arg(total.bytesIn / 1048576.0 / sec, 0, 'f', 2)
+              .arg(total.frames / sec, 0, 'f', 1));
+
+    return (failedInputs > 0 || total.failed > 0) ? 1 : 0;
+}
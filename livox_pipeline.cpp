@@ -0,0 +1,452 @@
+#include "livox_pipeline.h"
+#include <QMutexLocker>
+#include <algorithm>
+
+namespace {
+
+// 滑动窗口使用的时间：对齐后的统一时基（未对齐时为设备时间戳）
+inline uint64_t windowTime(const PointCloudFrame& frame)
+{
+    return frame.alignedTimestamp ? frame.alignedTimestamp : frame.timestamp;
+}
+
+// CRC 标记模式：校验失败包中的点显示为品红色
+void paintCrcFailed(QVector<Point3D>& points, const QVector<QPair<int, int>>& ranges)
+{
+    for (const auto& r : ranges) {
+        Point3D* p = points.data() + r.first;
+        for (int i = 0; i < r.second; ++i) {
+            p[i].r = 1.0f; p[i].g = 0.0f; p[i].b = 1.0f;
+        }
+    }
+}
+
+} // namespace
+
+bool PointCloudPipeline::pushPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t hostArrivalNs)
+{
+    if (!packet || packet->dot_num == 0) {
+        return true;
+    }
+
+    TraceZone trace("pipeline.decode");
+    ScopedStageTimer timer(m_stats, StageDecode);
+    if (m_stats) m_stats->recordPacket(handle, packet->dot_num);
+
+    PointCloudFrame frame;
+    if (!decodePacket(handle, packet, hostArrivalNs, frame)) {
+        return false;
+    }
+    pushFrame(frame);
+    return true;
+}
+
+bool PointCloudPipeline::decodePacket(uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t hostArrivalNs,
+                                      PointCloudFrame& frame)
+{
+    frame.points.clear();
+    frame.device_handle = handle;
+    if (!packet || packet->dot_num == 0) {
+        return true;
+    }
+
+    // CRC 校验（timestamp + 点数据）；dot_num 超出包长的包无法解码，无论模式一律丢弃
+    const int crcMode = m_crcMode.load(std::memory_order_relaxed);
+    const bool lengthValid = packetLengthValid(packet);
+    bool crcFailed = !lengthValid;
+    if (crcMode != PacketCrcOff) {
+        if (lengthValid) crcFailed = !verifyPacketCrc(packet);
+        const std::shared_ptr<Lane> lane = findOrAddLane(handle);
+        QMutexLocker locker(&lane->mutex);
+        lane->crc.checked++;
+        if (crcFailed) lane->crc.failed++;
+    }
+    if (!lengthValid || (crcFailed && crcMode == PacketCrcDrop)) {
+        return false;
+    }
+
+    frame.timestamp = parsePacketTimestamp(packet->timestamp);
+    frame.timeSpanNs = uint32_t(packet->time_interval) * 100U;
+    frame.hostArrivalNs = hostArrivalNs ? hostArrivalNs : hostMonotonicNs();
+    frame.alignedTimestamp = 0;
+    if (m_clock) {
+        const uint64_t aligned = m_clock->observe(handle, frame.timestamp, frame.hostArrivalNs);
+        if (m_clock->isEnabled()) frame.alignedTimestamp = aligned;
+    }
+    frame.points.reserve(packet->dot_num);
+    const std::shared_ptr<const DecodeConfig> config = decodeConfig();
+    auto it = config->extrinsics.constFind(handle);
+    const PointExtrinsic* extrinsic = it != config->extrinsics.constEnd() ? &it.value() : nullptr;
+    decodePointPacket(packet, config->options, frame.points, extrinsic);
+    frame.hostDecodedNs = hostMonotonicNs();
+    frame.crcFailed = crcFailed;
+    return true;
+}
+
+std::shared_ptr<PointCloudPipeline::Lane> PointCloudPipeline::findOrAddLane(uint32_t handle)
+{
+    {
+        const std::shared_ptr<const LaneTable> t = lanes();
+        auto it = t->constFind(handle);
+        if (it != t->constEnd()) return it.value();
+    }
+    QMutexLocker locker(&m_laneMutex);
+    const std::shared_ptr<const LaneTable> t = lanes();
+    auto it = t->constFind(handle);
+    if (it != t->constEnd()) return it.value();
+    std::shared_ptr<LaneTable> next = std::make_shared<LaneTable>(*t);
+    std::shared_ptr<Lane> lane = std::make_shared<Lane>();
+    next->insert(handle, lane);
+    std::atomic_store(&m_lanes, std::shared_ptr<const LaneTable>(next));
+    return lane;
+}
+
+void PointCloudPipeline::pushFrame(const PointCloudFrame& frame)
+{
+    // 推入该设备的待处理队列，记录最新时间戳
+    const std::shared_ptr<Lane> lane = findOrAddLane(frame.device_handle);
+    QMutexLocker locker(&lane->mutex);
+    lane->pending.enqueue(frame);
+    lane->lastSeen = windowTime(frame);
+}
+
+void PointCloudPipeline::clearPending()
+{
+    const std::shared_ptr<const LaneTable> t = lanes();
+    for (auto it = t->constBegin(); it != t->constEnd(); ++it) {
+        QMutexLocker locker(&it.value()->mutex);
+        it.value()->pending.clear();
+        it.value()->lastChunk = 0;
+    }
+}
+
+void PointCloudPipeline::clearDevice(uint32_t handle)
+{
+    QMutexLocker locker(&m_laneMutex);
+    const std::shared_ptr<const LaneTable> t = lanes();
+    if (!t->contains(handle)) return;
+    std::shared_ptr<LaneTable> next = std::make_shared<LaneTable>(*t);
+    next->remove(handle);
+    std::atomic_store(&m_lanes, std::shared_ptr<const LaneTable>(next));
+}
+
+QMap<uint32_t, int> PointCloudPipeline::pendingDepths() const
+{
+    QMap<uint32_t, int> depths;
+    const std::shared_ptr<const LaneTable> t = lanes();
+    for (auto it = t->constBegin(); it != t->constEnd(); ++it) {
+        QMutexLocker locker(&it.value()->mutex);
+        depths.insert(it.key(), it.value()->pending.size());
+    }
+    return depths;
+}
+
+void PointCloudPipeline::setDecodeOptions(const PointDecodeOptions& options)
+{
+    QMutexLocker locker(&m_configMutex);
+    m_decodeOptions = options;
+    publishDecodeConfigLocked();
+}
+
+void PointCloudPipeline::publishDecodeConfigLocked()
+{
+    std::shared_ptr<DecodeConfig> config = std::make_shared<DecodeConfig>();
+    config->options = m_decodeOptions;
+    config->extrinsics = m_extrinsics;
+    std::atomic_store(&m_decodeConfig, std::shared_ptr<const DecodeConfig>(config));
+}
+
+PointDecodeOptions PointCloudPipeline::decodeOptions() const
+{
+    QMutexLocker locker(&m_configMutex);
+    return m_decodeOptions;
+}
+
+void PointCloudPipeline::setColorOptions(const PointColorOptions& options)
+{
+    QMutexLocker locker(&m_configMutex);
+    m_colorOptions = options;
+}
+
+PointColorOptions PointCloudPipeline::colorOptions() const
+{
+    QMutexLocker locker(&m_configMutex);
+    return m_colorOptions;
+}
+
+void PointCloudPipeline::setWindowMs(uint64_t ms)
+{
+    QMutexLocker locker(&m_configMutex);
+    m_windowMs = ms;
+}
+
+uint64_t PointCloudPipeline::windowMs() const
+{
+    QMutexLocker locker(&m_configMutex);
+    return m_windowMs;
+}
+
+void PointCloudPipeline::setCrcMode(int mode)
+{
+    m_crcMode.store(mode, std::memory_order_relaxed);
+}
+
+int PointCloudPipeline::crcMode() const
+{
+    return m_crcMode.load(std::memory_order_relaxed);
+}
+
+void PointCloudPipeline::setDeviceExtrinsic(uint32_t handle, const PointExtrinsic& extrinsic)
+{
+    QMutexLocker locker(&m_configMutex);
+    if (isIdentityExtrinsic(extrinsic)) {
+        m_extrinsics.remove(handle);
+    } else {
+        m_extrinsics.insert(handle, extrinsic);
+    }
+    publishDecodeConfigLocked();
+}
+
+void PointCloudPipeline::clearDeviceExtrinsic(uint32_t handle)
+{
+    QMutexLocker locker(&m_configMutex);
+    m_extrinsics.remove(handle);
+    publishDecodeConfigLocked();
+}
+
+bool PointCloudPipeline::deviceExtrinsic(uint32_t handle, PointExtrinsic* extrinsic) const
+{
+    QMutexLocker locker(&m_configMutex);
+    auto it = m_extrinsics.constFind(handle);
+    if (it == m_extrinsics.constEnd()) return false;
+    if (extrinsic) *extrinsic = it.value();
+    return true;
+}
+
+QMap<uint32_t, PacketCrcCounters> PointCloudPipeline::crcCounters() const
+{
+    QMap<uint32_t, PacketCrcCounters> counters;
+    const std::shared_ptr<const LaneTable> t = lanes();
+    for (auto it = t->constBegin(); it != t->constEnd(); ++it) {
+        QMutexLocker locker(&it.value()->mutex);
+        if (it.value()->crc.checked > 0) counters.insert(it.key(), it.value()->crc);
+    }
+    return counters;
+}
+
+void PointCloudPipeline::resetCrcCounters()
+{
+    const std::shared_ptr<const LaneTable> t = lanes();
+    for (auto it = t->constBegin(); it != t->constEnd(); ++it) {
+        QMutexLocker locker(&it.value()->mutex);
+        it.value()->crc = PacketCrcCounters();
+    }
+}
+
+int PointCloudPipeline::addFilter(const PointFilter& filter)
+{
+    const int id = m_nextId++;
+    m_filters.append(qMakePair(id, filter));
+    return id;
+}
+
+void PointCloudPipeline::removeFilter(int id)
+{
+    for (int i = 0; i < m_filters.size(); ++i) {
+        if (m_filters[i].first == id) { m_filters.remove(i); return; }
+    }
+}
+
+int PointCloudPipeline::addSink(const FrameSink& sink)
+{
+    const int id = m_nextId++;
+    m_sinks.append(qMakePair(id, sink));
+    return id;
+}
+
+void PointCloudPipeline::removeSink(int id)
+{
+    for (int i = 0; i < m_sinks.size(); ++i) {
+        if (m_sinks[i].first == id) { m_sinks.remove(i); return; }
+    }
+}
+
+int PointCloudPipeline::addChunkSink(const FrameSink& sink)
+{
+    const int id = m_nextId++;
+    m_chunkSinks.append(qMakePair(id, sink));
+    return id;
+}
+
+void PointCloudPipeline::removeChunkSink(int id)
+{
+    for (int i = 0; i < m_chunkSinks.size(); ++i) {
+        if (m_chunkSinks[i].first == id) { m_chunkSinks.remove(i); return; }
+    }
+}
+
+bool PointCloudPipeline::collectNewPoints(PointCloudFrame& chunk, QVector<QPair<int, int>>* crcFailed)
+{
+    chunk.points.clear();
+    chunk.timestamp = 0;
+    chunk.device_handle = 0;
+    const std::shared_ptr<const LaneTable> t = lanes();
+    for (auto it = t->constBegin(); it != t->constEnd(); ++it) {
+        Lane& lane = *it.value();
+        QMutexLocker locker(&lane.mutex);
+        const QQueue<PointCloudFrame>& q = lane.pending;
+        if (q.isEmpty()) continue;
+        uint64_t& last = lane.lastChunk;
+        // 设备时间回退（重新同步）时从头输出，重复的点由累积端去重
+        if (q.last().timestamp < last) last = 0;
+        for (int i = 0; i < q.size(); ++i) {
+            const PointCloudFrame& f = q.at(i);
+            if (f.timestamp <= last) continue;
+            if (crcFailed && f.crcFailed && !f.points.isEmpty()) crcFailed->append(qMakePair(chunk.points.size(), f.points.size()));
+            chunk.points += f.points;
+            chunk.timestamp = std::max(chunk.timestamp, windowTime(f));
+        }
+        last = std::max(last, q.last().timestamp);
+    }
+    return !chunk.points.isEmpty();
+}
+
+bool PointCloudPipeline::assembleWindow(PointCloudFrame& merged, uint64_t* windowBegin,
+                                        QMap<uint32_t, FrameLatencyStamp>* latency,
+                                        QVector<PointDeskewSpan>* spans,
+                                        QVector<QPair<int, int>>* crcFailed)
+{
+    merged.points.clear();
+    merged.timestamp = 0;
+    merged.device_handle = 0;
+
+    const uint64_t window_ns = windowMs() * 1000000ULL;
+    const std::shared_ptr<const LaneTable> t = lanes();
+
+    // 以各设备最新到达的时间戳作为窗口末尾
+    uint64_t now_ns = 0;
+    for (auto it = t->constBegin(); it != t->constEnd(); ++it) {
+        QMutexLocker locker(&it.value()->mutex);
+        if (it.value()->lastSeen > now_ns) now_ns = it.value()->lastSeen;
+    }
+    if (now_ns == 0) return false;
+
+    const uint64_t window_begin = (now_ns > window_ns) ? (now_ns - window_ns) : 0ULL;
+    merged.timestamp = now_ns;
+    if (windowBegin) *windowBegin = window_begin;
+
+    // 先丢弃过期帧并统计点数，一次性分配合并缓冲区（两遍之间新到的帧至多引起一次扩容）
+    int total = 0;
+    for (auto it = t->constBegin(); it != t->constEnd(); ++it) {
+        QMutexLocker locker(&it.value()->mutex);
+        QQueue<PointCloudFrame>& q = it.value()->pending;
+        while (!q.isEmpty() && windowTime(q.head()) < window_begin) {
+            q.dequeue();
+        }
+        for (int i = 0; i < q.size(); ++i) {
+            const PointCloudFrame& f = q.at(i);
+            const uint64_t time = windowTime(f);
+            if (time >= window_begin && time <= now_ns) total += f.points.size();
+        }
+    }
+    if (total == 0) return false;
+
+    merged.points.reserve(total);
+    for (auto it = t->constBegin(); it != t->constEnd(); ++it) {
+        QMutexLocker locker(&it.value()->mutex);
+        const QQueue<PointCloudFrame>& q = it.value()->pending;
+        for (int i = 0; i < q.size(); ++i) {
+            const PointCloudFrame& f = q.at(i);
+            const uint64_t time = windowTime(f);
+            if (time >= window_begin && time <= now_ns) {
+                if (spans && !f.points.isEmpty()) {
+                    PointDeskewSpan s;
+                    s.handle = it.key();
+                    s.offset = merged.points.size();
+                    s.count = f.points.size();
+                    s.timestamp = f.timestamp;
+                    s.spanNs = f.timeSpanNs;
+                    s.windowTime = time;
+                    spans->append(s);
+                }
+                if (crcFailed && f.crcFailed && !f.points.isEmpty()) crcFailed->append(qMakePair(merged.points.size(), f.points.size()));
+                merged.points += f.points;
+                // 队列按到达顺序，最后一个即窗口内最新的包
+                if (latency && f.hostArrivalNs) {
+                    FrameLatencyStamp& s = (*latency)[it.key()];
+                    s.arrivalNs = f.hostArrivalNs;
+                    s.decodedNs = f.hostDecodedNs;
+                }
+            }
+        }
+    }
+    return !merged.points.isEmpty();
+}
+
+bool PointCloudPipeline::process()
+{
+    PointCloudFrame merged;
+    PipelineOutput info;
+    // 平面投影为展开图，不做去畸变
+    const bool deskew = m_deskew && m_deskew->isEnabled() && !decodeOptions().planarProjectionEnabled;
+    QVector<PointDeskewSpan> spans;
+    const bool tagCrc = crcMode() == PacketCrcTag;
+    QVector<QPair<int, int>> crcFailed;
+    {
+        TraceZone trace("pipeline.merge");
+        ScopedStageTimer timer(m_stats, StageMerge);
+        if (!assembleWindow(merged, &info.windowBegin, &info.latency, deskew ? &spans : nullptr,
+                            tagCrc ? &crcFailed : nullptr)) {
+            return false;
+        }
+    }
+    info.windowEnd = merged.timestamp;
+
+    if (deskew) {
+        TraceZone trace("pipeline.deskew");
+        ScopedStageTimer timer(m_stats, StageDeskew);
+        // 所有设备校正到同一时刻（合并时基的窗口末尾）
+        m_deskew->apply(merged.points, spans, decodeConfig()->extrinsics, info.windowEnd);
+    }
+
+    const PointColorOptions color = colorOptions();
+    info.colorMode = color.mode;
+    {
+        TraceZone trace("pipeline.color");
+        ScopedStageTimer timer(m_stats, StageColor);
+        info.legend = colorizePoints(merged.points, color);
+        paintCrcFailed(merged.points, crcFailed);
+    }
+
+    {
+        TraceZone trace("pipeline.filter");
+        ScopedStageTimer timer(m_stats, StageFilter);
+        for (const auto& f : m_filters) {
+            f.second(merged.points);
+        }
+    }
+    info.mergedNs = hostMonotonicNs();
+    {
+        TraceZone trace("pipeline.sinks");
+        for (const auto& s : m_sinks) {
+            s.second(merged, info);
+        }
+    }
+
+    if (!m_chunkSinks.isEmpty()) {
+        TraceZone trace("pipeline.chunk");
+        PointCloudFrame chunk;
+        crcFailed.clear();
+        if (collectNewPoints(chunk, tagCrc ? &crcFailed : nullptr)) {
+            colorizePoints(chunk.points, color);
+            paintCrcFailed(chunk.points, crcFailed);
+            for (const auto& f : m_filters) {
+                f.second(chunk.points);
+            }
+            for (const auto& s : m_chunkSinks) {
+                s.second(chunk, info);
+            }
+        }
+    }
+    return true;
+}
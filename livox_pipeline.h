@@ -0,0 +1,159 @@
+#ifndef LIVOX_PIPELINE_H
+#define LIVOX_PIPELINE_H
+
+#include "point_types.h"
+#include "point_decode.h"
+#include "point_color.h"
+#include "pipeline_stats.h"
+#include "pipeline_trace.h"
+#include "latency_tracker.h"
+#include "packet_crc.h"
+#include "point_deskew.h"
+#include "clock_align.h"
+#include <QMap>
+#include <QQueue>
+#include <QMutex>
+#include <QPair>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// 每次组帧输出的附加信息
+struct PipelineOutput {
+    uint64_t windowBegin = 0;   // 窗口起始时间（ns）
+    uint64_t windowEnd = 0;     // 窗口结束时间（ns），即合并帧时间戳
+    int colorMode = PointColorByReflectivity;
+    PointColorLegend legend;
+    QMap<uint32_t, FrameLatencyStamp> latency;  // 每设备窗口内最新一包的主机到达/解码时间
+    uint64_t mergedNs = 0;                      // 合并、着色、滤波完成的主机时间
+};
+
+// 数据包 CRC 校验（解码阶段）
+enum PacketCrcMode {
+    PacketCrcOff = 0,
+    PacketCrcDrop,      // 丢弃校验失败的包
+    PacketCrcTag        // 保留，帧标记 crcFailed，着色后显示为品红色（不改动点的 tag）
+};
+
+struct PacketCrcCounters {
+    uint64_t checked = 0;
+    uint64_t failed = 0;
+};
+
+// 点云处理流水线（不依赖 GUI）：
+//   数据源 pushPacket/pushFrame（任意线程）→ 解码 → 按设备排队
+//   process()（渲染节拍线程）→ 滑动窗口合并 → 着色 → 滤波 → 输出
+// 解码读取配置快照、入队只锁该设备的通道，多个线程解码不同设备时互不阻塞
+// 滤波器与输出需在调用 process() 的线程中注册
+class PointCloudPipeline
+{
+public:
+    using PointFilter = std::function<void(QVector<Point3D>& points)>;
+    using FrameSink = std::function<void(const PointCloudFrame& frame, const PipelineOutput& info)>;
+
+    PointCloudPipeline() = default;
+
+    // 数据源
+    // hostArrivalNs 为主机收到数据包的时间（hostMonotonicNs），为 0 时取当前时间
+    // CRC 校验失败且模式为 PacketCrcDrop 时丢弃并返回 false
+    bool pushPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t hostArrivalNs = 0);
+    // 只做 CRC 校验、时钟对齐与解码（不入队、不记录统计），返回值同 pushPacket；
+    // 供自行批量统计的工作线程使用，之后调用 pushFrame 入队
+    bool decodePacket(uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t hostArrivalNs,
+                      PointCloudFrame& frame);
+    void pushFrame(const PointCloudFrame& frame);
+    void clearPending();
+    // 移除单台设备的待处理帧与窗口时间（停止显示或断开的设备不再决定窗口末尾）
+    void clearDevice(uint32_t handle);
+    // 每设备待处理帧数（队列深度）
+    QMap<uint32_t, int> pendingDepths() const;
+
+    // 配置
+    void setDecodeOptions(const PointDecodeOptions& options);
+    PointDecodeOptions decodeOptions() const;
+    void setColorOptions(const PointColorOptions& options);
+    PointColorOptions colorOptions() const;
+    void setWindowMs(uint64_t ms);
+    uint64_t windowMs() const;
+    void setCrcMode(int mode);
+    int crcMode() const;
+    // 主机侧外参（多雷达拼接），在解码时应用；单位阵等同于清除
+    void setDeviceExtrinsic(uint32_t handle, const PointExtrinsic& extrinsic);
+    void clearDeviceExtrinsic(uint32_t handle);
+    bool deviceExtrinsic(uint32_t handle, PointExtrinsic* extrinsic) const;
+    QMap<uint32_t, PacketCrcCounters> crcCounters() const;
+    void resetCrcCounters();
+
+    // 滤波与输出，返回的 id 用于移除
+    int addFilter(const PointFilter& filter);
+    void removeFilter(int id);
+    int addSink(const FrameSink& sink);
+    void removeSink(int id);
+    // 新到达数据的输出（累积显示用）：每个数据包只输出一次，已着色、滤波，不做去畸变；
+    // 在 process() 中于窗口输出之后调用，info 与本次窗口输出相同
+    int addChunkSink(const FrameSink& sink);
+    void removeChunkSink(int id);
+
+    // 性能统计（可选）：解码/合并/着色/滤波耗时与每设备包速率
+    void setStats(PipelineStats* stats) { m_stats = stats; }
+    // 运动去畸变（可选）：合并后、着色前按 IMU 校正到窗口末尾时刻
+    void setDeskew(PointDeskew* deskew) { m_deskew = deskew; }
+    // 多设备时钟对齐（可选）：pushPacket 时按主机到达时间估计时钟模型，
+    // 启用时滑动窗口按统一时基合并
+    void setClockAligner(ClockAligner* aligner) { m_clock = aligner; }
+
+    // 合并窗口 → 着色 → 滤波 → 输出；窗口内无点时返回 false
+    bool process();
+    // 仅合并滑动窗口内所有设备的点（不着色、不滤波）
+    // spans 非空时记录每个源数据包在合并点集中的位置与时间（供去畸变使用）
+    // crcFailed 非空时记录 CRC 校验失败的包在合并点集中的范围（起始下标, 点数）
+    bool assembleWindow(PointCloudFrame& merged, uint64_t* windowBegin = nullptr,
+                        QMap<uint32_t, FrameLatencyStamp>* latency = nullptr,
+                        QVector<PointDeskewSpan>* spans = nullptr,
+                        QVector<QPair<int, int>>* crcFailed = nullptr);
+
+private:
+    // 解码配置快照：解码线程无锁读取（std::atomic_load），修改时在 m_configMutex 下整体替换
+    struct DecodeConfig {
+        PointDecodeOptions options;
+        QMap<uint32_t, PointExtrinsic> extrinsics;
+    };
+    // 每设备通道：待合并帧、窗口时间与 CRC 计数，各自加锁
+    struct Lane {
+        QMutex mutex;
+        QQueue<PointCloudFrame> pending;
+        uint64_t lastSeen = 0;      // 最新到达的时间戳（用于滑动窗口）
+        uint64_t lastChunk = 0;     // 已由 chunk 输出的最新设备时间戳
+        PacketCrcCounters crc;
+    };
+    using LaneTable = QMap<uint32_t, std::shared_ptr<Lane>>;
+
+    // 取出上次调用以来新入队的点（按设备时间戳判断）
+    bool collectNewPoints(PointCloudFrame& chunk, QVector<QPair<int, int>>* crcFailed);
+    std::shared_ptr<const DecodeConfig> decodeConfig() const { return std::atomic_load(&m_decodeConfig); }
+    void publishDecodeConfigLocked();
+    std::shared_ptr<const LaneTable> lanes() const { return std::atomic_load(&m_lanes); }
+    std::shared_ptr<Lane> findOrAddLane(uint32_t handle);
+
+    mutable QMutex m_configMutex;
+    PointDecodeOptions m_decodeOptions;
+    PointColorOptions m_colorOptions;
+    uint64_t m_windowMs = 100; // 100ms帧间隔
+    std::atomic<int> m_crcMode{PacketCrcOff};
+    QMap<uint32_t, PointExtrinsic> m_extrinsics;
+    std::shared_ptr<const DecodeConfig> m_decodeConfig = std::make_shared<const DecodeConfig>();
+
+    // 通道表为只读快照，仅增删设备时在 m_laneMutex 下复制替换
+    QMutex m_laneMutex;
+    std::shared_ptr<const LaneTable> m_lanes = std::make_shared<const LaneTable>();
+
+    int m_nextId = 1;
+    QVector<QPair<int, PointFilter>> m_filters;
+    QVector<QPair<int, FrameSink>> m_sinks;
+    QVector<QPair<int, FrameSink>> m_chunkSinks;
+    PipelineStats* m_stats = nullptr;
+    PointDeskew* m_deskew = nullptr;
+    ClockAligner* m_clock = nullptr;
+};
+
+#endif // LIVOX_PIPELINE_H
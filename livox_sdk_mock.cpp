@@ -0,0 +1,1203 @@
+#include "livox_sdk_mock.h"
+#include "synthetic_source.h"
+#include "raw_capture.h"
+#include "lvx2_reader.h"
+#include "point_decode.h"
+#include "packet_crc.h"
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QFile>
+#include <QVector>
+#include <QByteArray>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    #include "livox_lidar_api.h"
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 数据源输出的一条带时间的数据包
+struct MockEvent {
+    uint64_t timeNs = 0;
+    uint32_t handle = 0;
+    uint8_t devType = 0;
+    uint8_t kind = RawCapturePointCloud;
+    LivoxLidarEthernetPacket* packet = nullptr;
+};
+
+struct MockDeviceDesc {
+    uint32_t handle = 0;
+    uint8_t devType = 0;
+    QString sn;
+};
+
+class MockEventSource
+{
+public:
+    virtual ~MockEventSource() = default;
+    virtual bool open(QString& error) = 0;
+    virtual QVector<MockDeviceDesc> devices() const = 0;
+    virtual bool next(MockEvent& event) = 0;
+    virtual void rewind() = 0;
+    virtual void setDataType(uint32_t handle, uint8_t dataType) { (void)handle; (void)dataType; }
+};
+
+// 合成数据：由 SyntheticSchedule 按时间顺序合并 N 台虚拟雷达的点云与 IMU 包
+class SyntheticEventSource : public MockEventSource
+{
+public:
+    explicit SyntheticEventSource(const LivoxSdkMockOptions& options) : m_options(options) {}
+
+    bool open(QString& error) override
+    {
+        if (m_options.deviceCount < 1) {
+            error = "设备数必须大于0";
+            return false;
+        }
+        SyntheticSourceOptions source;
+        source.model = m_options.model;
+        source.dataType = m_options.dataType;
+        source.deviceCount = m_options.deviceCount;
+        m_baseNs = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        m_schedule.reset(source, m_baseNs);
+        return true;
+    }
+
+    QVector<MockDeviceDesc> devices() const override
+    {
+        QVector<MockDeviceDesc> out;
+        const std::vector<SyntheticLidarDevice>& devices = m_schedule.devices();
+        for (size_t i = 0; i < devices.size(); ++i) {
+            MockDeviceDesc d;
+            d.handle = devices[i].handle();
+            d.devType = devices[i].devType();
+            char sn[17];
+            snprintf(sn, sizeof(sn), "MOCK%02d%010u", int(m_options.model), unsigned(i + 1));
+            d.sn = QString::fromLatin1(sn);
+            out.append(d);
+        }
+        return out;
+    }
+
+    bool next(MockEvent& event) override
+    {
+        SyntheticPacket p;
+        if (!m_schedule.next(UINT64_MAX, p)) return false;
+        event.timeNs = m_baseNs + p.offsetNs;
+        event.handle = p.handle;
+        event.devType = p.devType;
+        event.kind = p.imu ? RawCaptureImu : RawCapturePointCloud;
+        event.packet = p.packet;
+        return true;
+    }
+
+    void rewind() override {}
+
+    void setDataType(uint32_t handle, uint8_t dataType) override
+    {
+        for (SyntheticLidarDevice& dev : m_schedule.devices()) {
+            if (dev.handle() == handle && dev.dataType() != dataType) dev.setDataType(dataType);
+        }
+    }
+
+private:
+    LivoxSdkMockOptions m_options;
+    uint64_t m_baseNs = 0;
+    SyntheticSchedule m_schedule;
+};
+
+// 原始包回放（.lvxraw），按录制时的主机接收时间重放
+class RawCaptureEventSource : public MockEventSource
+{
+public:
+    explicit RawCaptureEventSource(const QString& path) : m_path(path) {}
+
+    bool open(QString& error) override
+    {
+        if (!m_reader.open(m_path)) {
+            error = m_reader.errorString();
+            return false;
+        }
+        // 预扫描文件开头，收集设备列表
+        QMap<uint32_t, uint8_t> seen;
+        RawCaptureRecord record;
+        for (int i = 0; i < 4096 && m_reader.next(record); ++i) {
+            seen[record.header.handle] = record.header.dev_type;
+        }
+        m_reader.rewind();
+        for (auto it = seen.begin(); it != seen.end(); ++it) {
+            MockDeviceDesc d;
+            d.handle = it.key();
+            d.devType = it.value();
+            char sn[17];
+            snprintf(sn, sizeof(sn), "REPLAY%010u", unsigned(m_devices.size() + 1));
+            d.sn = QString::fromLatin1(sn);
+            m_devices.append(d);
+        }
+        if (m_devices.isEmpty()) {
+            error = "回放文件中没有数据包";
+            return false;
+        }
+        return true;
+    }
+
+    QVector<MockDeviceDesc> devices() const override { return m_devices; }
+
+    bool next(MockEvent& event) override
+    {
+        RawCaptureRecord record;
+        if (!m_reader.next(record)) return false;
+        m_buffer = record.packet;
+        event.timeNs = record.header.host_ns;
+        event.handle = record.header.handle;
+        event.devType = record.header.dev_type;
+        event.kind = record.header.kind;
+        event.packet = reinterpret_cast<LivoxLidarEthernetPacket*>(m_buffer.data());
+        return true;
+    }
+
+    void rewind() override { m_reader.rewind(); }
+
+private:
+    QString m_path;
+    RawCaptureReader m_reader;
+    QVector<MockDeviceDesc> m_devices;
+    QByteArray m_buffer;
+};
+
+// LVX2 回放：将包头与点数据还原为以太网数据包，按包时间戳重放
+class Lvx2EventSource : public MockEventSource
+{
+public:
+    explicit Lvx2EventSource(const QString& path) : m_path(path) {}
+
+    bool open(QString& error) override
+    {
+        if (!m_reader.open(m_path)) {
+            error = m_reader.errorString();
+            return false;
+        }
+        for (const LVX2DeviceInfo& info : m_reader.devices()) {
+            MockDeviceDesc d;
+            d.handle = info.lidar_id;
+            d.devType = info.device_type;
+            d.sn = QString::fromLatin1(info.lidar_sn, int(strnlen(info.lidar_sn, sizeof(info.lidar_sn))));
+            m_devTypes[info.lidar_id] = info.device_type;
+            m_devices.append(d);
+        }
+        if (m_devices.isEmpty()) {
+            error = "LVX2 文件中没有设备信息";
+            return false;
+        }
+        return true;
+    }
+
+    QVector<MockDeviceDesc> devices() const override { return m_devices; }
+
+    bool next(MockEvent& event) override
+    {
+        while (m_packageIndex >= m_frame.packages.size()) {
+            if (!m_reader.readNextFrame(m_frame)) return false;
+            m_packageIndex = 0;
+        }
+        const Lvx2Package& pkg = m_frame.packages[m_packageIndex++];
+        const uint32_t pointSize = pointDataSize(pkg.header.data_type);
+        const uint32_t dotNum = pointSize ? uint32_t(pkg.data.size()) / pointSize : 0;
+        const int headerSize = int(offsetof(LivoxLidarEthernetPacket, data));
+
+        m_buffer.fill('\0', headerSize + int(dotNum * pointSize));
+        LivoxLidarEthernetPacket* packet = reinterpret_cast<LivoxLidarEthernetPacket*>(m_buffer.data());
+        packet->version = pkg.header.version;
+        packet->length = uint16_t(headerSize + dotNum * pointSize);
+        packet->dot_num = uint16_t(dotNum);
+        packet->udp_cnt = pkg.header.udp_counter;
+        packet->frame_cnt = pkg.header.frame_counter;
+        packet->data_type = pkg.header.data_type;
+        packet->time_type = pkg.header.timestamp_type;
+        memcpy(packet->timestamp, &pkg.header.timestamp, sizeof(packet->timestamp));
+        memcpy(packet->data, pkg.data.constData(), dotNum * pointSize);
+        finalizePacketCrc(packet);   // LVX2 不保存 crc32，按回放内容重新计算
+
+        event.timeNs = pkg.header.timestamp;
+        event.handle = pkg.header.lidar_id;
+        event.devType = m_devTypes.value(pkg.header.lidar_id, 0);
+        event.kind = RawCapturePointCloud;
+        event.packet = packet;
+        return true;
+    }
+
+    void rewind() override
+    {
+        m_reader.close();
+        m_reader.open(m_path);
+        m_frame = Lvx2Frame();
+        m_packageIndex = 0;
+    }
+
+private:
+    QString m_path;
+    Lvx2Reader m_reader;
+    QVector<MockDeviceDesc> m_devices;
+    QMap<uint32_t, uint8_t> m_devTypes;
+    Lvx2Frame m_frame;
+    int m_packageIndex = 0;
+    QByteArray m_buffer;
+};
+
+struct MockDevice {
+    MockDeviceDesc desc;
+    bool connected = false;
+    bool streaming = true;      // 工作模式为采样且点云发送使能
+    bool imuEnabled = true;
+    uint8_t dataType = kLivoxLidarCartesianCoordinateHighData;
+    QMap<uint16_t, QByteArray> params;
+    QByteArray statusJson;      // 状态推送字符串（生命周期与设备相同）
+};
+
+template <typename T>
+QByteArray paramBytes(const T& value)
+{
+    return QByteArray(reinterpret_cast<const char*>(&value), int(sizeof(T)));
+}
+
+QByteArray ipBytes(const char* ip)
+{
+    unsigned a = 0, b = 0, c = 0, d = 0;
+    if (ip) sscanf(ip, "%u.%u.%u.%u", &a, &b, &c, &d);
+    QByteArray out(4, '\0');
+    out[0] = char(a); out[1] = char(b); out[2] = char(c); out[3] = char(d);
+    return out;
+}
+
+QByteArray fixedString(const QString& s, int size)
+{
+    QByteArray out = s.toLatin1().left(size);
+    out.append(QByteArray(size - out.size(), '\0'));
+    return out;
+}
+
+uint64_t nowNs()
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+class MockSdk
+{
+public:
+    ~MockSdk() { uninit(); }
+
+    bool init();
+    void uninit();
+
+    void setOptions(const LivoxSdkMockOptions& options)
+    {
+        QMutexLocker lk(&m_mutex);
+        m_options = options;
+        m_optionsSet = true;
+    }
+    LivoxSdkMockStats stats() const
+    {
+        LivoxSdkMockStats s;
+        s.pointPackets = m_pointPackets.load();
+        s.imuPackets = m_imuPackets.load();
+        s.commands = m_commands.load();
+        s.loops = m_loops.load();
+        return s;
+    }
+
+    // 回调注册
+    void setPointCloudCallback(LivoxLidarPointCloudCallBack cb, void* client)
+    {
+        QMutexLocker lk(&m_mutex);
+        m_pointCb = cb; m_pointClient = client;
+    }
+    void setImuCallback(LivoxLidarImuDataCallback cb, void* client)
+    {
+        QMutexLocker lk(&m_mutex);
+        m_imuCb = cb; m_imuClient = client;
+    }
+    void setInfoCallback(LivoxLidarInfoCallback cb, void* client)
+    {
+        QMutexLocker lk(&m_mutex);
+        m_infoCb = cb; m_infoClient = client;
+    }
+    void setInfoChangeCallback(LivoxLidarInfoChangeCallback cb, void* client)
+    {
+        QMutexLocker lk(&m_mutex);
+        m_infoChangeCb = cb; m_infoChangeClient = client;
+    }
+    void setUpgradeProgressCallback(OnLivoxLidarUpgradeProgressCallback cb, void* client)
+    {
+        QMutexLocker lk(&m_mutex);
+        m_upgradeCb = cb; m_upgradeClient = client;
+    }
+    uint16_t addPointCloudObserver(LivoxLidarPointCloudObserver cb, void* client)
+    {
+        QMutexLocker lk(&m_mutex);
+        const uint16_t id = m_nextObserverId++;
+        m_observers[id] = qMakePair(cb, client);
+        return id;
+    }
+    void removePointCloudObserver(uint16_t id)
+    {
+        QMutexLocker lk(&m_mutex);
+        m_observers.remove(id);
+    }
+
+    // 设置参数并异步应答
+    livox_status control(uint32_t handle, uint16_t key, const QByteArray& value,
+                         LivoxLidarAsyncControlCallback cb, void* client);
+    livox_status query(uint32_t handle, const QVector<uint16_t>& keys,
+                       QueryLivoxLidarInternalInfoCallback cb, void* client);
+    // 仅检查句柄并异步执行应答
+    livox_status respond(uint32_t handle, std::function<void()> fn, int delayMs = -1);
+    void upgrade(const uint32_t* handles, uint8_t num);
+    void reboot(uint32_t handle);
+
+private:
+    void post(std::function<void()> fn, int delayMs);
+    void commandLoop();
+    void dataLoop();
+    void announce(uint32_t handle, bool connected);
+    void scheduleStatusInfo();
+    void initParams(MockDevice& dev);
+
+    mutable QMutex m_mutex;
+    LivoxSdkMockOptions m_options;
+    bool m_optionsSet = false;
+    QMap<uint32_t, MockDevice> m_devices;
+    std::unique_ptr<MockEventSource> m_source;
+
+    LivoxLidarPointCloudCallBack m_pointCb = nullptr;
+    void* m_pointClient = nullptr;
+    LivoxLidarImuDataCallback m_imuCb = nullptr;
+    void* m_imuClient = nullptr;
+    LivoxLidarInfoCallback m_infoCb = nullptr;
+    void* m_infoClient = nullptr;
+    LivoxLidarInfoChangeCallback m_infoChangeCb = nullptr;
+    void* m_infoChangeClient = nullptr;
+    OnLivoxLidarUpgradeProgressCallback m_upgradeCb = nullptr;
+    void* m_upgradeClient = nullptr;
+    QMap<uint16_t, QPair<LivoxLidarPointCloudObserver, void*>> m_observers;
+    uint16_t m_nextObserverId = 1;
+
+    // 命令线程：按到期时间执行应答
+    QMutex m_cmdMutex;
+    QWaitCondition m_cmdCond;
+    std::multimap<Clock::time_point, std::function<void()>> m_cmdQueue;
+    std::thread m_cmdThread;
+    std::thread m_dataThread;
+    std::atomic<bool> m_running{false};
+
+    std::atomic<uint64_t> m_pointPackets{0};
+    std::atomic<uint64_t> m_imuPackets{0};
+    std::atomic<uint64_t> m_commands{0};
+    std::atomic<uint64_t> m_loops{0};
+};
+
+MockSdk& mockSdk()
+{
+    static MockSdk sdk;
+    return sdk;
+}
+
+void MockSdk::initParams(MockDevice& dev)
+{
+    QMap<uint16_t, QByteArray>& p = dev.params;
+    const uint32_t h = dev.desc.handle;
+    const char lidarIp[4] = { char(h & 0xFF), char((h >> 8) & 0xFF), char((h >> 16) & 0xFF), char((h >> 24) & 0xFF) };
+
+    p[kKeyPclDataType] = QByteArray(1, char(dev.dataType));
+    p[kKeyPatternMode] = QByteArray(1, char(kLivoxLidarScanPatternNoneRepetive));
+    p[kKeyDualEmitEn] = QByteArray(1, '\0');
+    p[kKeyPointSendEn] = QByteArray(1, '\1');
+    QByteArray ipCfg(lidarIp, 4);
+    ipCfg += ipBytes("255.255.255.0");
+    ipCfg += ipBytes("192.168.1.1");
+    p[kKeyLidarIpCfg] = ipCfg;
+    const QByteArray hostIp = ipBytes("192.168.1.50");
+    auto hostCfg = [&](uint16_t hostPort, uint16_t lidarPort) {
+        return hostIp + paramBytes(hostPort) + paramBytes(lidarPort);
+    };
+    p[kKeyStateInfoHostIpCfg] = hostCfg(56201, 56200);
+    p[kKeyLidarPointDataHostIpCfg] = hostCfg(56301, 56300);
+    p[kKeyLidarImuHostIpCfg] = hostCfg(56401, 56400);
+    p[kKeyInstallAttitude] = paramBytes(LivoxLidarInstallAttitude{ 0.0f, 0.0f, 0.0f, 0, 0, 0 });
+    p[kKeyFovCfg0] = paramBytes(FovCfg{ 0, 360, -7, 52, 0 });
+    p[kKeyFovCfg1] = paramBytes(FovCfg{ 0, 360, -7, 52, 0 });
+    p[kKeyFovCfgEn] = QByteArray(1, '\0');
+    p[kKeyDetectMode] = QByteArray(1, char(kLivoxLidarDetectNormal));
+    p[kKeyFuncIoCfg] = QByteArray(4, '\0');
+    p[kKeyWorkMode] = QByteArray(1, char(kLivoxLidarNormal));
+    p[kKeyImuDataEn] = QByteArray(1, '\1');
+    p[kKeySetEscMode] = QByteArray(1, char(kLivoxEscSpeedNormal));
+
+    p[kKeySn] = fixedString(dev.desc.sn, 16);
+    p[kKeyProductInfo] = fixedString("LivoxSdkMock", 64);
+    const char version[4] = { 1, 3, 0, 0 };
+    p[kKeyVersionApp] = QByteArray(version, 4);
+    p[kKeyVersionLoader] = QByteArray(version, 4);
+    p[kKeyVersionHardware] = QByteArray(version, 4);
+    const char mac[6] = { 0x02, 0x4C, 0x56, lidarIp[1], lidarIp[2], lidarIp[3] };
+    p[kKeyMac] = QByteArray(mac, 6);
+    p[kKeyCurWorkState] = QByteArray(1, char(kLivoxLidarNormal));
+    p[kKeyCoreTemp] = paramBytes(int32_t(4250));
+    p[kKeyPowerUpCnt] = paramBytes(uint32_t(1));
+    p[kKeyLocalTimeNow] = paramBytes(nowNs());
+    p[kKeyLastSyncTime] = paramBytes(uint64_t(0));
+    p[kKeyTimeOffset] = paramBytes(int64_t(0));
+    p[kKeyTimeSyncType] = QByteArray(1, '\0');
+    p[kKeyLidarDiagStatus] = paramBytes(uint16_t(0));
+    p[kKeyFwType] = QByteArray(1, '\1');
+    p[kKeyHmsCode] = QByteArray(32, '\0');
+
+    char json[128];
+    snprintf(json, sizeof(json), "{\"sn\":\"%s\",\"work_state\":1,\"mock\":true}",
+             dev.desc.sn.toLatin1().constData());
+    dev.statusJson = QByteArray(json);
+}
+
+bool MockSdk::init()
+{
+    if (m_running.load()) return true;
+
+    QMutexLocker lk(&m_mutex);
+    if (!m_optionsSet) {
+        m_options = livoxSdkMockOptionsFromEnvironment();
+    }
+
+    const QString path = m_options.replayPath;
+    if (path.isEmpty()) {
+        m_source.reset(new SyntheticEventSource(m_options));
+    } else if (path.endsWith(".lvx2", Qt::CaseInsensitive)) {
+        m_source.reset(new Lvx2EventSource(path));
+    } else {
+        m_source.reset(new RawCaptureEventSource(path));
+    }
+
+    QString error;
+    if (!m_source->open(error)) {
+        fprintf(stderr, "LivoxSdkMock: %s\n", error.toLocal8Bit().constData());
+        m_source.reset();
+        return false;
+    }
+
+    m_devices.clear();
+    for (const MockDeviceDesc& desc : m_source->devices()) {
+        MockDevice dev;
+        dev.desc = desc;
+        dev.dataType = m_options.replayPath.isEmpty() ? m_options.dataType : uint8_t(kLivoxLidarCartesianCoordinateHighData);
+        initParams(dev);
+        m_devices[desc.handle] = dev;
+    }
+    const QVector<MockDeviceDesc> devices = m_source->devices();
+    lk.unlock();
+
+    m_pointPackets = 0;
+    m_imuPackets = 0;
+    m_commands = 0;
+    m_loops = 0;
+    m_running = true;
+    m_cmdThread = std::thread(&MockSdk::commandLoop, this);
+    m_dataThread = std::thread(&MockSdk::dataLoop, this);
+
+    // 模拟设备发现：初始化后陆续上报
+    for (int i = 0; i < devices.size(); ++i) {
+        const uint32_t handle = devices[i].handle;
+        post([this, handle]() { announce(handle, true); }, 200 + i * 20);
+    }
+    scheduleStatusInfo();
+    return true;
+}
+
+void MockSdk::uninit()
+{
+    if (!m_running.exchange(false)) return;
+    {
+        QMutexLocker lk(&m_cmdMutex);
+        m_cmdCond.wakeAll();
+    }
+    if (m_cmdThread.joinable()) m_cmdThread.join();
+    if (m_dataThread.joinable()) m_dataThread.join();
+
+    QMutexLocker lk(&m_mutex);
+    m_cmdQueue.clear();
+    m_devices.clear();
+    m_source.reset();
+    m_optionsSet = false;
+}
+
+void MockSdk::post(std::function<void()> fn, int delayMs)
+{
+    if (delayMs < 0) {
+        QMutexLocker lk(&m_mutex);
+        delayMs = m_options.commandLatencyMs;
+    }
+    QMutexLocker lk(&m_cmdMutex);
+    m_cmdQueue.emplace(Clock::now() + std::chrono::milliseconds(delayMs), std::move(fn));
+    m_cmdCond.wakeOne();
+}
+
+void MockSdk::commandLoop()
+{
+    QMutexLocker lk(&m_cmdMutex);
+    while (m_running.load()) {
+        if (m_cmdQueue.empty()) {
+            m_cmdCond.wait(&m_cmdMutex, 100);
+            continue;
+        }
+        auto it = m_cmdQueue.begin();
+        const auto now = Clock::now();
+        if (it->first > now) {
+            const auto waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(it->first - now).count();
+            m_cmdCond.wait(&m_cmdMutex, static_cast<unsigned long>(std::max<long long>(1, waitMs)));
+            continue;
+        }
+        std::function<void()> fn = std::move(it->second);
+        m_cmdQueue.erase(it);
+        lk.unlock();
+        fn();
+        lk.relock();
+    }
+}
+
+void MockSdk::announce(uint32_t handle, bool connected)
+{
+    LivoxLidarInfoChangeCallback cb = nullptr;
+    void* client = nullptr;
+    LivoxLidarInfo info{};
+    {
+        QMutexLocker lk(&m_mutex);
+        if (!m_devices.contains(handle)) return;
+        MockDevice& dev = m_devices[handle];
+        dev.connected = connected;
+        cb = m_infoChangeCb;
+        client = m_infoChangeClient;
+        info.dev_type = dev.desc.devType;
+        const QByteArray sn = dev.desc.sn.toLatin1();
+        memcpy(info.sn, sn.constData(), std::min<size_t>(size_t(sn.size()), sizeof(info.sn) - 1));
+        const QByteArray& ip = dev.params[kKeyLidarIpCfg];
+        snprintf(info.lidar_ip, sizeof(info.lidar_ip), "%u.%u.%u.%u",
+                 uint8_t(ip[0]), uint8_t(ip[1]), uint8_t(ip[2]), uint8_t(ip[3]));
+    }
+    if (cb) cb(handle, connected ? &info : nullptr, client);
+}
+
+void MockSdk::scheduleStatusInfo()
+{
+    // 每秒推送一次状态信息
+    post([this]() {
+        QVector<QPair<uint32_t, QPair<uint8_t, const char*>>> items;
+        LivoxLidarInfoCallback cb = nullptr;
+        void* client = nullptr;
+        {
+            QMutexLocker lk(&m_mutex);
+            cb = m_infoCb;
+            client = m_infoClient;
+            for (auto it = m_devices.begin(); it != m_devices.end(); ++it) {
+                if (it.value().connected) {
+                    items.append(qMakePair(it.key(), qMakePair(it.value().desc.devType, it.value().statusJson.constData())));
+                }
+            }
+        }
+        if (cb) {
+            for (const auto& item : items) cb(item.first, item.second.first, item.second.second, client);
+        }
+        if (m_running.load()) scheduleStatusInfo();
+    }, 1000);
+}
+
+void MockSdk::dataLoop()
+{
+    bool paced = false;
+    uint64_t firstNs = 0;
+    Clock::time_point wallStart;
+    MockEvent event;
+
+    while (m_running.load()) {
+        double rate = 1.0;
+        bool loop = true;
+        bool gate = false;
+        LivoxLidarPointCloudCallBack pointCb = nullptr;
+        void* pointClient = nullptr;
+        LivoxLidarImuDataCallback imuCb = nullptr;
+        void* imuClient = nullptr;
+        QVector<QPair<LivoxLidarPointCloudObserver, void*>> observers;
+
+        {
+            QMutexLocker lk(&m_mutex);
+            if (!m_source) break;
+            rate = m_options.rate;
+            loop = m_options.loop;
+
+            // 尚无设备连接时不推进数据
+            bool anyConnected = false;
+            for (auto it = m_devices.begin(); it != m_devices.end(); ++it) {
+                if (it.value().connected) { anyConnected = true; break; }
+            }
+            if (!anyConnected) {
+                lk.unlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                paced = false;
+                continue;
+            }
+
+            if (!m_source->next(event)) {
+                if (!loop) {
+                    lk.unlock();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    continue;
+                }
+                m_source->rewind();
+                m_loops.fetch_add(1, std::memory_order_relaxed);
+                paced = false;
+                continue;
+            }
+
+            auto it = m_devices.find(event.handle);
+            if (it != m_devices.end()) {
+                const MockDevice& dev = it.value();
+                if (event.kind == RawCaptureImu) {
+                    gate = dev.connected && dev.imuEnabled;
+                } else {
+                    gate = dev.connected && dev.streaming;
+                }
+                m_source->setDataType(event.handle, dev.dataType);
+            }
+            pointCb = m_pointCb; pointClient = m_pointClient;
+            imuCb = m_imuCb; imuClient = m_imuClient;
+            for (auto ob = m_observers.begin(); ob != m_observers.end(); ++ob) observers.append(ob.value());
+        }
+
+        // 按数据时间戳节拍输出；rate<=0 时不限速
+        if (rate > 0.0) {
+            if (!paced || event.timeNs < firstNs) {
+                paced = true;
+                firstNs = event.timeNs;
+                wallStart = Clock::now();
+            }
+            const auto due = wallStart + std::chrono::nanoseconds(uint64_t(double(event.timeNs - firstNs) / rate));
+            if (due > Clock::now()) std::this_thread::sleep_until(due);
+        }
+
+        if (!gate) continue;
+        if (event.kind == RawCaptureImu) {
+            if (imuCb) imuCb(event.handle, event.devType, event.packet, imuClient);
+            m_imuPackets.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            if (pointCb) pointCb(event.handle, event.devType, event.packet, pointClient);
+            for (const auto& ob : observers) ob.first(event.handle, event.devType, event.packet, ob.second);
+            m_pointPackets.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+livox_status MockSdk::control(uint32_t handle, uint16_t key, const QByteArray& value,
+                              LivoxLidarAsyncControlCallback cb, void* client)
+{
+    {
+        QMutexLocker lk(&m_mutex);
+        auto it = m_devices.find(handle);
+        if (it == m_devices.end() || !it.value().connected) {
+            return kLivoxLidarStatusNotConnected;
+        }
+        MockDevice& dev = it.value();
+        const bool streamKey = key == kKeyWorkMode || key == kKeyPointSendEn
+                            || key == kKeyImuDataEn || key == kKeyPclDataType;
+        if (streamKey && value.isEmpty()) return kLivoxLidarStatusFailure;
+        if (!value.isEmpty()) dev.params[key] = value;
+        // 读取另一参数的首字节，缺失或为空时取 0
+        auto firstByte = [&dev](uint16_t k) {
+            const QByteArray v = dev.params.value(k);
+            return v.isEmpty() ? uint8_t(0) : uint8_t(v[0]);
+        };
+
+        // 影响数据流的参数
+        switch (key) {
+        case kKeyWorkMode:
+            dev.params[kKeyCurWorkState] = value;
+            dev.streaming = uint8_t(value[0]) == kLivoxLidarNormal && firstByte(kKeyPointSendEn) != 0;
+            break;
+        case kKeyPointSendEn:
+            dev.streaming = value[0] != 0 && firstByte(kKeyWorkMode) == kLivoxLidarNormal;
+            break;
+        case kKeyImuDataEn:
+            dev.imuEnabled = value[0] != 0;
+            break;
+        case kKeyPclDataType:
+            if (pointDataSize(uint8_t(value[0])) != 0) dev.dataType = uint8_t(value[0]);
+            break;
+        default:
+            break;
+        }
+    }
+    m_commands.fetch_add(1, std::memory_order_relaxed);
+    post([cb, handle, client]() {
+        static LivoxLidarAsyncControlResponse response{ 0, 0 };
+        if (cb) cb(kLivoxLidarStatusSuccess, handle, &response, client);
+    }, -1);
+    return kLivoxLidarStatusSuccess;
+}
+
+livox_status MockSdk::query(uint32_t handle, const QVector<uint16_t>& keys,
+                            QueryLivoxLidarInternalInfoCallback cb, void* client)
+{
+    QByteArray body;
+    uint16_t count = 0;
+    {
+        QMutexLocker lk(&m_mutex);
+        auto it = m_devices.find(handle);
+        if (it == m_devices.end() || !it.value().connected) {
+            return kLivoxLidarStatusNotConnected;
+        }
+        MockDevice& dev = it.value();
+        dev.params[kKeyLocalTimeNow] = paramBytes(nowNs());
+        for (auto p = dev.params.begin(); p != dev.params.end(); ++p) {
+            if (!keys.isEmpty() && !keys.contains(p.key())) continue;
+            body += paramBytes(uint16_t(p.key()));
+            body += paramBytes(uint16_t(p.value().size()));
+            body += p.value();
+            ++count;
+        }
+    }
+    m_commands.fetch_add(1, std::memory_order_relaxed);
+
+    // 应答布局与 LivoxLidarDiagInternalInfoResponse 一致：ret_code + param_num + 参数列表
+    QByteArray response(1, '\0');
+    response += paramBytes(count);
+    response += body;
+    post([cb, handle, client, response]() mutable {
+        if (cb) cb(kLivoxLidarStatusSuccess, handle,
+                   reinterpret_cast<LivoxLidarDiagInternalInfoResponse*>(response.data()), client);
+    }, -1);
+    return kLivoxLidarStatusSuccess;
+}
+
+livox_status MockSdk::respond(uint32_t handle, std::function<void()> fn, int delayMs)
+{
+    {
+        QMutexLocker lk(&m_mutex);
+        auto it = m_devices.find(handle);
+        if (it == m_devices.end() || !it.value().connected) {
+            return kLivoxLidarStatusNotConnected;
+        }
+    }
+    m_commands.fetch_add(1, std::memory_order_relaxed);
+    post(std::move(fn), delayMs);
+    return kLivoxLidarStatusSuccess;
+}
+
+void MockSdk::upgrade(const uint32_t* handles, uint8_t num)
+{
+    // 模拟升级：请求 → 传输固件 → 查询进度 → 完成，约 5 秒
+    for (uint8_t i = 0; i < num; ++i) {
+        const uint32_t handle = handles[i];
+        for (int step = 0; step <= 20; ++step) {
+            post([this, handle, step]() {
+                OnLivoxLidarUpgradeProgressCallback cb = nullptr;
+                void* client = nullptr;
+                {
+                    QMutexLocker lk(&m_mutex);
+                    cb = m_upgradeCb;
+                    client = m_upgradeClient;
+                }
+                LivoxLidarUpgradeState state;
+                state.progress = uint8_t(step * 5);
+                if (step == 0) state.state = kLivoxLidarEventRequestUpgrade;
+                else if (step < 10) state.state = kLivoxLidarEventXferFirmware;
+                else if (step < 20) state.state = kLivoxLidarEventGetUpgradeProgress;
+                else state.state = kLivoxLidarEventComplete;
+                if (cb) cb(handle, state, client);
+            }, 100 + step * 250);
+        }
+    }
+}
+
+void MockSdk::reboot(uint32_t handle)
+{
+    // 重启：断开后约 3 秒重新上线
+    post([this, handle]() { announce(handle, false); }, 500);
+    post([this, handle]() { announce(handle, true); }, 3500);
+}
+
+template <typename Response>
+livox_status respondWith(uint32_t handle, void (*cb)(livox_status, uint32_t, Response*, void*), void* client)
+{
+    return mockSdk().respond(handle, [cb, handle, client]() {
+        static Response response{};
+        if (cb) cb(kLivoxLidarStatusSuccess, handle, &response, client);
+    });
+}
+
+livox_status setParam(uint32_t handle, uint16_t key, const QByteArray& value,
+                      LivoxLidarAsyncControlCallback cb, void* client)
+{
+    return mockSdk().control(handle, key, value, cb, client);
+}
+
+} // namespace
+
+LivoxSdkMockOptions livoxSdkMockOptionsFromEnvironment()
+{
+    LivoxSdkMockOptions options;
+    if (const char* v = std::getenv("LIVOX_MOCK_REPLAY")) options.replayPath = QString::fromLocal8Bit(v);
+    if (const char* v = std::getenv("LIVOX_MOCK_MODEL")) {
+        const QString model = QString::fromLatin1(v).toLower();
+        if (model == "hap") options.model = SyntheticHAP;
+        else if (model == "avia") options.model = SyntheticAvia;
+        else options.model = SyntheticMid360;
+    }
+    if (const char* v = std::getenv("LIVOX_MOCK_DEVICES")) options.deviceCount = std::max(1, atoi(v));
+    if (const char* v = std::getenv("LIVOX_MOCK_DATA_TYPE")) {
+        const int type = atoi(v);
+        if (pointDataSize(uint8_t(type)) != 0) options.dataType = uint8_t(type);
+    }
+    if (const char* v = std::getenv("LIVOX_MOCK_RATE")) options.rate = atof(v);
+    if (const char* v = std::getenv("LIVOX_MOCK_LOOP")) options.loop = atoi(v) != 0;
+    if (const char* v = std::getenv("LIVOX_MOCK_LATENCY_MS")) options.commandLatencyMs = std::max(0, atoi(v));
+    return options;
+}
+
+void setLivoxSdkMockOptions(const LivoxSdkMockOptions& options)
+{
+    mockSdk().setOptions(options);
+}
+
+LivoxSdkMockStats livoxSdkMockStats()
+{
+    return mockSdk().stats();
+}
+
+// =============================================================================
+// livox_lidar_api.h 实现
+// =============================================================================
+
+void GetLivoxLidarSdkVer(LivoxLidarSdkVer* version)
+{
+    if (!version) return;
+    version->major = 1;
+    version->minor = 3;
+    version->patch = 0;
+}
+
+bool LivoxLidarSdkInit(const char* path, const char* host_ip, const LivoxLidarLoggerCfgInfo* log_cfg_info)
+{
+    (void)path; (void)host_ip; (void)log_cfg_info;
+    return mockSdk().init();
+}
+
+bool LivoxLidarSdkStart()
+{
+    return true;
+}
+
+void LivoxLidarSdkUninit()
+{
+    mockSdk().uninit();
+}
+
+void SetLivoxLidarPointCloudCallBack(LivoxLidarPointCloudCallBack cb, void* client_data)
+{
+    mockSdk().setPointCloudCallback(cb, client_data);
+}
+
+void LivoxLidarAddCmdObserver(LivoxLidarCmdObserverCallBack cb, void* client_data)
+{
+    // 模拟 SDK 不产生控制报文
+    (void)cb; (void)client_data;
+}
+
+void LivoxLidarRemoveCmdObserver()
+{
+}
+
+uint16_t LivoxLidarAddPointCloudObserver(LivoxLidarPointCloudObserver cb, void* client_data)
+{
+    return mockSdk().addPointCloudObserver(cb, client_data);
+}
+
+void LivoxLidarRemovePointCloudObserver(uint16_t id)
+{
+    mockSdk().removePointCloudObserver(id);
+}
+
+void SetLivoxLidarImuDataCallback(LivoxLidarImuDataCallback cb, void* client_data)
+{
+    mockSdk().setImuCallback(cb, client_data);
+}
+
+void SetLivoxLidarInfoCallback(LivoxLidarInfoCallback cb, void* client_data)
+{
+    mockSdk().setInfoCallback(cb, client_data);
+}
+
+void DisableLivoxSdkConsoleLogger()
+{
+}
+
+void SaveLivoxLidarSdkLoggerFile()
+{
+}
+
+void SetLivoxLidarInfoChangeCallback(LivoxLidarInfoChangeCallback cb, void* client_data)
+{
+    mockSdk().setInfoChangeCallback(cb, client_data);
+}
+
+livox_status QueryLivoxLidarInternalInfo(uint32_t handle, QueryLivoxLidarInternalInfoCallback cb, void* client_data)
+{
+    return mockSdk().query(handle, QVector<uint16_t>(), cb, client_data);
+}
+
+livox_status QueryLivoxLidarFwType(uint32_t handle, QueryLivoxLidarInternalInfoCallback cb, void* client_data)
+{
+    return mockSdk().query(handle, QVector<uint16_t>{ kKeyFwType }, cb, client_data);
+}
+
+livox_status QueryLivoxLidarFirmwareVer(uint32_t handle, QueryLivoxLidarInternalInfoCallback cb, void* client_data)
+{
+    return mockSdk().query(handle, QVector<uint16_t>{ kKeyVersionApp }, cb, client_data);
+}
+
+livox_status SetLivoxLidarPclDataType(uint32_t handle, LivoxLidarPointDataType data_type, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyPclDataType, QByteArray(1, char(data_type)), cb, client_data);
+}
+
+livox_status SetLivoxLidarScanPattern(uint32_t handle, LivoxLidarScanPattern scan_pattern, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyPatternMode, QByteArray(1, char(scan_pattern)), cb, client_data);
+}
+
+livox_status SetLivoxLidarDualEmit(uint32_t handle, bool enable, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyDualEmitEn, QByteArray(1, char(enable ? 1 : 0)), cb, client_data);
+}
+
+livox_status EnableLivoxLidarPointSend(uint32_t handle, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyPointSendEn, QByteArray(1, '\1'), cb, client_data);
+}
+
+livox_status DisableLivoxLidarPointSend(uint32_t handle, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyPointSendEn, QByteArray(1, '\0'), cb, client_data);
+}
+
+livox_status SetLivoxLidarIp(uint32_t handle, LivoxLidarIpInfo* ip_config,
+                             LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    if (!ip_config) return kLivoxLidarStatusFailure;
+    return setParam(handle, kKeyLidarIpCfg,
+                    ipBytes(ip_config->ip_addr) + ipBytes(ip_config->net_mask) + ipBytes(ip_config->gw_addr),
+                    cb, client_data);
+}
+
+livox_status SetLivoxLidarStateInfoHostIPCfg(uint32_t handle, HostStateInfoIpInfo* host_state_info_ipcfg,
+                                             LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    if (!host_state_info_ipcfg) return kLivoxLidarStatusFailure;
+    return setParam(handle, kKeyStateInfoHostIpCfg,
+                    ipBytes(host_state_info_ipcfg->host_ip_addr)
+                        + paramBytes(host_state_info_ipcfg->host_state_info_port)
+                        + paramBytes(host_state_info_ipcfg->lidar_state_info_port),
+                    cb, client_data);
+}
+
+livox_status SetLivoxLidarPointDataHostIPCfg(uint32_t handle, HostPointIPInfo* host_point_ipcfg,
+                                             LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    if (!host_point_ipcfg) return kLivoxLidarStatusFailure;
+    return setParam(handle, kKeyLidarPointDataHostIpCfg,
+                    ipBytes(host_point_ipcfg->host_ip_addr)
+                        + paramBytes(host_point_ipcfg->host_point_data_port)
+                        + paramBytes(host_point_ipcfg->lidar_point_data_port),
+                    cb, client_data);
+}
+
+livox_status SetLivoxLidarImuDataHostIPCfg(uint32_t handle, HostImuDataIPInfo* host_imu_ipcfg,
+                                           LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    if (!host_imu_ipcfg) return kLivoxLidarStatusFailure;
+    return setParam(handle, kKeyLidarImuHostIpCfg,
+                    ipBytes(host_imu_ipcfg->host_ip_addr)
+                        + paramBytes(host_imu_ipcfg->host_imu_data_port)
+                        + paramBytes(host_imu_ipcfg->lidar_imu_data_port),
+                    cb, client_data);
+}
+
+livox_status SetLivoxLidarInstallAttitude(uint32_t handle, LivoxLidarInstallAttitude* install_attitude,
+                                          LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    if (!install_attitude) return kLivoxLidarStatusFailure;
+    return setParam(handle, kKeyInstallAttitude, paramBytes(*install_attitude), cb, client_data);
+}
+
+livox_status SetLivoxLidarFovCfg0(uint32_t handle, FovCfg* fov_cfg0, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    if (!fov_cfg0) return kLivoxLidarStatusFailure;
+    return setParam(handle, kKeyFovCfg0, paramBytes(*fov_cfg0), cb, client_data);
+}
+
+livox_status SetLivoxLidarFovCfg1(uint32_t handle, FovCfg* fov_cfg1, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    if (!fov_cfg1) return kLivoxLidarStatusFailure;
+    return setParam(handle, kKeyFovCfg1, paramBytes(*fov_cfg1), cb, client_data);
+}
+
+livox_status EnableLivoxLidarFov(uint32_t handle, uint8_t fov_en, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyFovCfgEn, QByteArray(1, char(fov_en)), cb, client_data);
+}
+
+livox_status DisableLivoxLidarFov(uint32_t handle, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyFovCfgEn, QByteArray(1, '\0'), cb, client_data);
+}
+
+livox_status SetLivoxLidarDetectMode(uint32_t handle, LivoxLidarDetectMode mode, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyDetectMode, QByteArray(1, char(mode)), cb, client_data);
+}
+
+livox_status SetLivoxLidarFuncIOCfg(uint32_t handle, FuncIOCfg* func_io_cfg, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    if (!func_io_cfg) return kLivoxLidarStatusFailure;
+    return setParam(handle, kKeyFuncIoCfg, paramBytes(*func_io_cfg), cb, client_data);
+}
+
+livox_status SetLivoxLidarBlindSpot(uint32_t handle, uint32_t blind_spot, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyBlindSpotSet, paramBytes(blind_spot), cb, client_data);
+}
+
+livox_status SetLivoxLidarWorkMode(uint32_t handle, LivoxLidarWorkMode work_mode, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyWorkMode, QByteArray(1, char(work_mode)), cb, client_data);
+}
+
+livox_status EnableLivoxLidarGlassHeat(uint32_t handle, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyGlassHeat, QByteArray(1, '\1'), cb, client_data);
+}
+
+livox_status DisableLivoxLidarGlassHeat(uint32_t handle, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyGlassHeat, QByteArray(1, '\0'), cb, client_data);
+}
+
+livox_status StartForcedHeating(uint32_t handle, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyForceHeatEn, QByteArray(1, '\1'), cb, client_data);
+}
+
+livox_status StopForcedHeating(uint32_t handle, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyForceHeatEn, QByteArray(1, '\0'), cb, client_data);
+}
+
+livox_status SetLivoxLidarEscMode(uint32_t handle, LivoxLidarEscMode esc_mode, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeySetEscMode, QByteArray(1, char(esc_mode)), cb, client_data);
+}
+
+livox_status SetLivoxLidarGlassHeat(uint32_t handle, LivoxLidarGlassHeat glass_heat, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyGlassHeat, QByteArray(1, char(glass_heat)), cb, client_data);
+}
+
+livox_status EnableLivoxLidarImuData(uint32_t handle, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyImuDataEn, QByteArray(1, '\1'), cb, client_data);
+}
+
+livox_status DisableLivoxLidarImuData(uint32_t handle, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyImuDataEn, QByteArray(1, '\0'), cb, client_data);
+}
+
+livox_status EnableLivoxLidarFusaFunciont(uint32_t handle, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyFusaEn, QByteArray(1, '\1'), cb, client_data);
+}
+
+livox_status DisableLivoxLidarFusaFunciont(uint32_t handle, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyFusaEn, QByteArray(1, '\0'), cb, client_data);
+}
+
+livox_status LivoxLidarRequestReset(uint32_t handle, LivoxLidarResetCallback cb, void* client_data)
+{
+    return respondWith(handle, cb, client_data);
+}
+
+livox_status LivoxLidarStartLogger(const uint32_t handle, const LivoxLidarLogType log_type, LivoxLidarLoggerCallback cb, void* client_data)
+{
+    (void)log_type;
+    return respondWith(handle, cb, client_data);
+}
+
+livox_status LivoxLidarStopLogger(const uint32_t handle, const LivoxLidarLogType log_type, LivoxLidarLoggerCallback cb, void* client_data)
+{
+    (void)log_type;
+    return respondWith(handle, cb, client_data);
+}
+
+livox_status SetLivoxLidarDebugPointCloud(uint32_t handle, bool enable, LivoxLidarLoggerCallback cb, void* client_data)
+{
+    (void)enable;
+    return respondWith(handle, cb, client_data);
+}
+
+livox_status SetLivoxLidarRmcSyncTime(uint32_t handle, const char* rmc, uint16_t rmc_length, LivoxLidarRmcSyncTimeCallBack cb, void* client_data)
+{
+    if (!rmc || rmc_length == 0) return kLivoxLidarStatusFailure;
+    // 记为 GPS 同步
+    mockSdk().control(handle, kKeyTimeSyncType, QByteArray(1, '\2'), nullptr, nullptr);
+    mockSdk().control(handle, kKeyLastSyncTime, paramBytes(nowNs()), nullptr, nullptr);
+    return respondWith(handle, cb, client_data);
+}
+
+livox_status SetLivoxLidarWorkModeAfterBoot(const uint32_t handle, const LivoxLidarWorkModeAfterBoot work_mode, LivoxLidarAsyncControlCallback cb, void* client_data)
+{
+    return setParam(handle, kKeyWorkModeAfterBoot, QByteArray(1, char(work_mode)), cb, client_data);
+}
+
+livox_status LivoxLidarRequestReboot(uint32_t handle, LivoxLidarRebootCallback cb, void* client_data)
+{
+    const livox_status status = respondWith(handle, cb, client_data);
+    if (status == kLivoxLidarStatusSuccess) mockSdk().reboot(handle);
+    return status;
+}
+
+bool SetLivoxLidarUpgradeFirmwarePath(const char* firmware_path)
+{
+    return firmware_path && QFile::exists(QString::fromLocal8Bit(firmware_path));
+}
+
+void SetLivoxLidarUpgradeProgressCallback(OnLivoxLidarUpgradeProgressCallback cb, void* client_data)
+{
+    mockSdk().setUpgradeProgressCallback(cb, client_data);
+}
+
+void UpgradeLivoxLidars(const uint32_t* handle, const uint8_t lidar_num)
+{
+    if (handle && lidar_num > 0) mockSdk().upgrade(handle, lidar_num);
+}
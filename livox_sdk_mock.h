@@ -0,0 +1,43 @@
+#ifndef LIVOX_SDK_MOCK_H
+#define LIVOX_SDK_MOCK_H
+
+#include <QString>
+#include <cstdint>
+
+// 模拟 Livox SDK（livox_lidar_sdk_mock）
+// 实现 livox_lidar_api.h 中的全部接口，用回放文件或合成数据驱动回调，
+// 无需雷达即可端到端运行/剖析整个程序（设备发现、参数查询与配置、点云与 IMU）。
+//
+// 未调用 setLivoxSdkMockOptions() 时，LivoxLidarSdkInit 从环境变量读取配置：
+//   LIVOX_MOCK_REPLAY     回放文件（.lvxraw / .lvx2），为空时使用合成数据
+//   LIVOX_MOCK_MODEL      合成雷达型号 mid360 | hap | avia（默认 mid360）
+//   LIVOX_MOCK_DEVICES    合成设备数（默认 1）
+//   LIVOX_MOCK_DATA_TYPE  合成点云类型 1 | 2 | 3（默认 1）
+//   LIVOX_MOCK_RATE       相对实时速率倍数，0 表示不限速（默认 1）
+//   LIVOX_MOCK_LOOP       回放到文件末尾后是否循环（默认 1）
+//   LIVOX_MOCK_LATENCY_MS 控制命令应答延迟（默认 2ms）
+struct LivoxSdkMockOptions {
+    QString replayPath;
+    int model = 0;              // SyntheticLidarModel
+    int deviceCount = 1;
+    uint8_t dataType = 1;
+    double rate = 1.0;          // <=0 表示不限速
+    bool loop = true;
+    int commandLatencyMs = 2;
+};
+
+LivoxSdkMockOptions livoxSdkMockOptionsFromEnvironment();
+// 需在 LivoxLidarSdkInit 之前调用
+void setLivoxSdkMockOptions(const LivoxSdkMockOptions& options);
+
+// 运行统计
+struct LivoxSdkMockStats {
+    uint64_t pointPackets = 0;
+    uint64_t imuPackets = 0;
+    uint64_t commands = 0;
+    uint64_t loops = 0;         // 回放循环次数
+};
+
+LivoxSdkMockStats livoxSdkMockStats();
+
+#endif // LIVOX_SDK_MOCK_H
@@ -0,0 +1,198 @@
+#include "log_ring.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <chrono>
+#include <cstring>
+
+const char* logLevelName(int level)
+{
+    switch (level) {
+        case LogDebug: return "DEBUG";
+        case LogInfo: return "INFO";
+        case LogWarning: return "WARN";
+        case LogError: return "ERROR";
+        default: return "?";
+    }
+}
+
+LogRing::LogRing()
+    : m_slots(new Slot[kCapacity])
+{
+    for (int i = 0; i < kCapacity; ++i) m_slots[i].seq.store(uint64_t(i), std::memory_order_relaxed);
+}
+
+bool LogRing::admit(const char* site, int64_t nowMs, uint32_t* suppressedBefore)
+{
+    const size_t start = (reinterpret_cast<uintptr_t>(site) >> 3) % kSiteSlots;
+    for (int probe = 0; probe < kSiteSlots; ++probe) {
+        Site& s = m_sites[(start + probe) % kSiteSlots];
+        const char* key = s.key.load(std::memory_order_acquire);
+        if (!key && s.key.compare_exchange_strong(key, site, std::memory_order_acq_rel)) key = site;
+        if (key != site) continue;
+
+        int64_t window = s.windowMs.load(std::memory_order_relaxed);
+        if (nowMs - window >= 1000 && s.windowMs.compare_exchange_strong(window, nowMs, std::memory_order_relaxed)) {
+            s.count.store(0, std::memory_order_relaxed);
+            *suppressedBefore = s.suppressed.exchange(0, std::memory_order_relaxed);
+        }
+        if (s.count.fetch_add(1, std::memory_order_relaxed) < kSiteBurst) return true;
+        s.suppressed.fetch_add(1, std::memory_order_relaxed);
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;    // 站点表已满：不限速
+}
+
+bool LogRing::post(LogLevel level, const QString& text, const char* site)
+{
+    const int64_t nowMs = QDateTime::currentMSecsSinceEpoch();
+    uint32_t suppressedBefore = 0;
+    if (site && !admit(site, nowMs, &suppressedBefore)) return false;
+
+    // 先在槽位外完成编码与截断，占用槽位期间只做拷贝，消费者不会在未发布的槽位上等太久
+    const QByteArray utf8 = text.toUtf8();
+    int length = utf8.size() < kMaxTextBytes ? utf8.size() : kMaxTextBytes;
+    // 截断时不拆开多字节字符
+    if (length < utf8.size()) {
+        while (length > 0 && (uint8_t(utf8[length]) & 0xC0) == 0x80) --length;
+    }
+
+    const uint64_t mask = uint64_t(kCapacity) - 1;
+    uint64_t pos = m_enqueue.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &m_slots[pos & mask];
+        const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+        const int64_t diff = int64_t(seq) - int64_t(pos);
+        if (diff == 0) {
+            if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = m_enqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::memcpy(slot->text, utf8.constData(), size_t(length));
+    slot->length = uint16_t(length);
+    slot->level = uint8_t(level);
+    slot->timeMs = nowMs;
+    slot->suppressed = suppressedBefore;
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void LogRing::start(const QString& filePath, bool echoDebug)
+{
+    if (m_running.exchange(true)) return;
+    m_filePath = filePath;
+    m_echo = echoDebug;
+    m_thread = std::thread([this]() { run(); });
+}
+
+void LogRing::stop()
+{
+    m_running.store(false);
+    if (m_thread.joinable()) m_thread.join();
+}
+
+QStringList LogRing::takeLines()
+{
+    QMutexLocker locker(&m_pendingMutex);
+    QStringList lines;
+    lines.swap(m_pending);
+    return lines;
+}
+
+void LogRing::drain(QFile* file)
+{
+    const uint64_t mask = uint64_t(kCapacity) - 1;
+    QStringList lines;
+    QByteArray fileText;
+    for (;;) {
+        Slot& slot = m_slots[m_dequeue & mask];
+        if (slot.seq.load(std::memory_order_acquire) != m_dequeue + 1) break;
+        const QDateTime time = QDateTime::fromMSecsSinceEpoch(slot.timeMs);
+        QString text = QString::fromUtf8(slot.text, slot.length);
+        const int level = slot.level;
+        if (slot.suppressed > 0) text += QString("（此前 %1 条同类消息已抑制）").arg(slot.suppressed);
+        slot.seq.store(m_dequeue + kCapacity, std::memory_order_release);
+        m_dequeue++;
+
+        QString prefix;
+        if (level == LogWarning) prefix = "[警告] ";
+        else if (level == LogError) prefix = "[错误] ";
+        else if (level == LogDebug) prefix = "[调试] ";
+        const QString line = QString("[%1] %2%3").arg(time.toString("hh:mm:ss"), prefix, text);
+        lines.append(line);
+        if (m_echo) qDebug() << line;
+        if (file) {
+            fileText += time.toString("yyyy-MM-dd hh:mm:ss.zzz").toUtf8();
+            fileText += ' ';
+            fileText += logLevelName(level);
+            fileText += ' ';
+            fileText += text.toUtf8();
+            fileText += '\n';
+        }
+    }
+    const uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        const QDateTime now = QDateTime::currentDateTime();
+        const QString text = QString("日志过多，已丢弃 %1 条").arg(dropped);
+        lines.append(QString("[%1] [警告] %2").arg(now.toString("hh:mm:ss"), text));
+        if (file) fileText += (now.toString("yyyy-MM-dd hh:mm:ss.zzz") + " WARN " + text + "\n").toUtf8();
+    }
+    if (lines.isEmpty()) return;
+    if (file) {
+        file->write(fileText);
+        file->flush();
+        if (file->size() > kMaxFileBytes) rotate(file);
+    }
+
+    QMutexLocker locker(&m_pendingMutex);
+    m_pending.append(lines);
+    // 界面长时间未取走（如窗口阻塞）时丢弃最旧的行，计入下次的丢弃提示
+    if (m_pending.size() > kMaxPendingLines) {
+        const int excess = m_pending.size() - kMaxPendingLines;
+        m_pending.erase(m_pending.begin(), m_pending.begin() + excess);
+        m_dropped.fetch_add(uint64_t(excess), std::memory_order_relaxed);
+    }
+}
+
+// log → log.1 → … → log.kRotatedFiles（最旧的删除），然后重新打开空文件
+void LogRing::rotate(QFile* file)
+{
+    const QString path = file->fileName();
+    file->close();
+    QFile::remove(QString("%1.%2").arg(path).arg(kRotatedFiles));
+    for (int i = kRotatedFiles - 1; i >= 1; --i) {
+        QFile::rename(QString("%1.%2").arg(path).arg(i), QString("%1.%2").arg(path).arg(i + 1));
+    }
+    QFile::rename(path, path + ".1");
+    file->setFileName(path);
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qDebug() << "无法打开日志文件:" << path;
+    }
+}
+
+void LogRing::run()
+{
+    QFile file;
+    if (!m_filePath.isEmpty()) {
+        QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+        file.setFileName(m_filePath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            qDebug() << "无法打开日志文件:" << m_filePath;
+        }
+    }
+    while (m_running.load()) {
+        drain(file.isOpen() ? &file : nullptr);
+        std::this_thread::sleep_for(std::chrono::milliseconds(kDrainIntervalMs));
+    }
+    drain(file.isOpen() ? &file : nullptr);
+}
@@ -0,0 +1,93 @@
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+class QFile;
+
+enum LogLevel {
+    LogDebug = 0,
+    LogInfo,
+    LogWarning,
+    LogError
+};
+
+const char* logLevelName(int level);
+
+// 日志队列：任意线程无锁写入（有界多生产者环形队列，满时丢弃并计数），
+// 后台线程取出后统一加时间戳格式化、写日志文件并转交界面；界面定时一次性取走累积的行。
+// 带 site 的调用按站点限速（每秒 kSiteBurst 条），被抑制的条数附在该站点下一条日志后。
+// 日志文件超过 kMaxFileBytes 时轮转为 .1 ~ .kRotatedFiles，磁盘占用有上限。
+class LogRing
+{
+public:
+    static const int kCapacity = 4096;          // 2 的幂
+    static const int kMaxTextBytes = 480;       // UTF-8，超出截断
+    static const int kSiteSlots = 256;
+    static const int kSiteBurst = 5;
+    static const int kMaxPendingLines = 2000;   // 界面未取走时最多保留的行数
+    static const int kDrainIntervalMs = 50;
+    static const qint64 kMaxFileBytes = 16 * 1024 * 1024;
+    static const int kRotatedFiles = 3;
+
+    LogRing();
+    ~LogRing() { stop(); }
+    LogRing(const LogRing&) = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    // site 必须是静态字符串（按地址区分站点）
+    bool post(LogLevel level, const QString& text, const char* site = nullptr);
+
+    // filePath 为空时不写文件；echoDebug 同时输出到 qDebug
+    void start(const QString& filePath, bool echoDebug);
+    void stop();
+    QString filePath() const { return m_filePath; }
+
+    QStringList takeLines();
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    uint64_t suppressed() const { return m_suppressed.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq{0};
+        int64_t timeMs = 0;
+        uint32_t suppressed = 0;
+        uint16_t length = 0;
+        uint8_t level = 0;
+        char text[kMaxTextBytes];
+    };
+    struct Site {
+        std::atomic<const char*> key{nullptr};
+        std::atomic<int64_t> windowMs{0};
+        std::atomic<int> count{0};
+        std::atomic<uint32_t> suppressed{0};
+    };
+
+    bool admit(const char* site, int64_t nowMs, uint32_t* suppressedBefore);
+    void drain(QFile* file);
+    void rotate(QFile* file);
+    void run();
+
+    std::unique_ptr<Slot[]> m_slots;
+    alignas(64) std::atomic<uint64_t> m_enqueue{0};
+    alignas(64) uint64_t m_dequeue = 0;         // 仅后台线程
+    Site m_sites[kSiteSlots];
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_suppressed{0};
+
+    QMutex m_pendingMutex;
+    QStringList m_pending;
+
+    QString m_filePath;
+    bool m_echo = true;
+    std::atomic_bool m_running{false};
+    std::thread m_thread;
+};
+
+#endif // LOG_RING_H
@@ -0,0 +1,93 @@
+#include "lvx2_reader.h"
+#include <cstring>
+
+bool Lvx2Reader::open(const QString& filePath)
+{
+    close();
+    m_error.clear();
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = QString("无法打开文件: %1").arg(filePath);
+        return false;
+    }
+
+    LVX2PublicHeader pub;
+    if (!readExact(&pub, sizeof(pub))) {
+        m_error = "文件头不完整";
+        close();
+        return false;
+    }
+    LVX2PublicHeader expected;
+    if (std::strncmp(pub.signature, expected.signature, sizeof(pub.signature)) != 0 ||
+        pub.magic_code != expected.magic_code) {
+        m_error = "不是有效的LVX2文件";
+        close();
+        return false;
+    }
+    if (!readExact(&m_private, sizeof(m_private))) {
+        m_error = "私有头不完整";
+        close();
+        return false;
+    }
+    m_devices.resize(m_private.device_count);
+    for (int i = 0; i < m_devices.size(); ++i) {
+        if (!readExact(&m_devices[i], sizeof(LVX2DeviceInfo))) {
+            m_error = "设备信息不完整";
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void Lvx2Reader::close()
+{
+    if (m_file.isOpen()) m_file.close();
+    m_devices.clear();
+}
+
+bool Lvx2Reader::readExact(void* dst, qint64 size)
+{
+    return m_file.read(reinterpret_cast<char*>(dst), size) == size;
+}
+
+bool Lvx2Reader::readNextFrame(Lvx2Frame& frame)
+{
+    frame.packages.clear();
+    if (!m_file.isOpen() || m_file.atEnd()) {
+        return false;
+    }
+
+    const qint64 frameStart = m_file.pos();
+    LVX2FrameHeader fh;
+    if (!readExact(&fh, sizeof(fh))) {
+        return false;
+    }
+    // 录制中断时最后一帧的 next_offset 可能未回填，按文件末尾处理
+    qint64 frameEnd = qint64(fh.next_offset);
+    if (frameEnd <= frameStart || frameEnd > m_file.size()) {
+        frameEnd = m_file.size();
+    }
+    frame.index = fh.frame_index;
+
+    while (m_file.pos() + qint64(sizeof(LVX2PackageHeader)) <= frameEnd) {
+        Lvx2Package pkg;
+        if (!readExact(&pkg.header, sizeof(pkg.header))) {
+            m_error = "包头不完整";
+            return false;
+        }
+        if (m_file.pos() + qint64(pkg.header.data_length) > frameEnd) {
+            m_error = QString("帧%1 数据长度异常").arg(fh.frame_index);
+            m_file.seek(frameEnd);
+            break;
+        }
+        pkg.data = m_file.read(pkg.header.data_length);
+        if (pkg.data.size() != int(pkg.header.data_length)) {
+            m_error = "包数据不完整";
+            return false;
+        }
+        frame.packages.append(pkg);
+    }
+    m_file.seek(frameEnd);
+    return true;
+}
@@ -0,0 +1,50 @@
+#ifndef LVX2_READER_H
+#define LVX2_READER_H
+
+#include "point_types.h"
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+
+// LVX2 包：包头 + 原始点数据
+struct Lvx2Package {
+    LVX2PackageHeader header;
+    QByteArray data;
+};
+
+// LVX2 帧（对应文件中的一个 LVX2FrameHeader）
+struct Lvx2Frame {
+    uint64_t index = 0;
+    QVector<Lvx2Package> packages;
+};
+
+// LVX2 文件顺序读取（只依赖 QtCore）
+class Lvx2Reader
+{
+public:
+    Lvx2Reader() = default;
+    ~Lvx2Reader() { close(); }
+
+    bool open(const QString& filePath);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+    QString errorString() const { return m_error; }
+
+    const LVX2PrivateHeader& privateHeader() const { return m_private; }
+    const QVector<LVX2DeviceInfo>& devices() const { return m_devices; }
+    qint64 fileSize() const { return m_file.size(); }
+    qint64 position() const { return m_file.pos(); }
+
+    // 读取下一帧；到达文件末尾或数据损坏时返回 false
+    bool readNextFrame(Lvx2Frame& frame);
+
+private:
+    bool readExact(void* dst, qint64 size);
+
+    QFile m_file;
+    QString m_error;
+    LVX2PrivateHeader m_private;
+    QVector<LVX2DeviceInfo> m_devices;
+};
+
+#endif // LVX2_READER_H
@@ -0,0 +1,87 @@
+#include "lvx2_writer.h"
+#include "point_decode.h"
+#include <cstring>
+
+bool Lvx2Writer::open(const QString& filePath, const QVector<LVX2DeviceInfo>& devices, uint32_t frameDurationMs)
+{
+    close(false);
+    m_error.clear();
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly)) {
+        m_error = QString("无法打开文件: %1").arg(filePath);
+        return false;
+    }
+
+    // 写头
+    LVX2PublicHeader pub;
+    m_file.write(reinterpret_cast<const char*>(&pub), sizeof(pub));
+    LVX2PrivateHeader pri;
+    pri.frame_duration = frameDurationMs;
+    pri.device_count = uint8_t(devices.size());
+    m_file.write(reinterpret_cast<const char*>(&pri), sizeof(pri));
+    for (const LVX2DeviceInfo& dev : devices) {
+        m_file.write(reinterpret_cast<const char*>(&dev), sizeof(dev));
+    }
+
+    m_frameDurationNs = uint64_t(frameDurationMs) * 1000000ULL;
+    m_frameStartNs = 0;
+    m_frameIndex = 0;
+    // 预留一帧的缓冲，帧间复用（resize(0) 不释放已预留空间）
+    m_pending.clear();
+    m_pending.reserve(1 << 20);
+    return true;
+}
+
+void Lvx2Writer::close(bool flushPending)
+{
+    if (!m_file.isOpen()) return;
+    if (flushPending) flushFrame();
+    m_pending.clear();
+    m_file.close();
+}
+
+bool Lvx2Writer::writePacket(uint32_t lidarId, const LivoxLidarEthernetPacket* packet)
+{
+    if (!m_file.isOpen() || !packet) return false;
+    const uint32_t pointSize = pointDataSize(packet->data_type);
+    if (pointSize == 0) return false;
+
+    const uint64_t ts = parsePacketTimestamp(packet->timestamp);
+    if (m_frameStartNs == 0) m_frameStartNs = ts;
+
+    LVX2PackageHeader hdr{};
+    hdr.lidar_id = lidarId;
+    hdr.timestamp_type = packet->time_type;
+    std::memcpy(&hdr.timestamp, packet->timestamp, 8);
+    hdr.udp_counter = packet->udp_cnt;
+    hdr.data_type = packet->data_type;
+    hdr.data_length = packet->dot_num * pointSize;
+    hdr.frame_counter = packet->frame_cnt;
+    m_pending.append(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    m_pending.append(reinterpret_cast<const char*>(packet->data), int(hdr.data_length));
+
+    if (ts - m_frameStartNs >= m_frameDurationNs) {
+        if (!flushFrame()) return false;
+        m_frameStartNs = ts;
+    }
+    return true;
+}
+
+bool Lvx2Writer::flushFrame()
+{
+    if (!m_file.isOpen() || m_pending.isEmpty()) return true;
+
+    // 帧长度已知，直接填好偏移，无需回写帧头
+    LVX2FrameHeader fh;
+    fh.current_offset = uint64_t(m_file.pos());
+    fh.next_offset = fh.current_offset + sizeof(fh) + uint64_t(m_pending.size());
+    fh.frame_index = m_frameIndex++;
+    if (m_file.write(reinterpret_cast<const char*>(&fh), sizeof(fh)) != qint64(sizeof(fh)) ||
+        m_file.write(m_pending) != qint64(m_pending.size())) {
+        m_error = QString("写入失败: %1").arg(m_file.errorString());
+        m_pending.resize(0);
+        return false;
+    }
+    m_pending.resize(0);
+    return true;
+}
@@ -0,0 +1,44 @@
+#ifndef LVX2_WRITER_H
+#define LVX2_WRITER_H
+
+#include "point_types.h"
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+
+extern "C" {
+    #include "livox_lidar_def.h"
+}
+
+// LVX2 文件顺序写入（只依赖 QtCore）
+// 点云包按包时间戳累积，满一个帧周期后连同帧头一次写盘
+class Lvx2Writer
+{
+public:
+    Lvx2Writer() = default;
+    ~Lvx2Writer() { close(); }
+
+    bool open(const QString& filePath, const QVector<LVX2DeviceInfo>& devices, uint32_t frameDurationMs = 50);
+    // flushPending 为 false 时丢弃未满一帧的数据
+    void close(bool flushPending = true);
+    bool isOpen() const { return m_file.isOpen(); }
+    QString errorString() const { return m_error; }
+
+    // 追加一个点云包（lidarId 写入包头），未知数据类型返回 false
+    bool writePacket(uint32_t lidarId, const LivoxLidarEthernetPacket* packet);
+    // 将当前累积的包写成一帧
+    bool flushFrame();
+
+    uint64_t frameCount() const { return m_frameIndex; }
+    qint64 bytesWritten() const { return m_file.pos(); }
+
+private:
+    QFile m_file;
+    QString m_error;
+    QByteArray m_pending;           // 当前帧待写入包（包头 + 点数据）
+    uint64_t m_frameDurationNs = 50ULL * 1000000ULL;
+    uint64_t m_frameStartNs = 0;
+    uint64_t m_frameIndex = 0;
+};
+
+#endif // LVX2_WRITER_H
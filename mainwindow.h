@@ -18,6 +18,7 @@
 #include <QThread>
 #include <QMutex>
 #include <QMap>
+#include <QHash>
 #include <QDateTime>
 #include <QMutexLocker>
 #include <QMetaObject>
@@ -70,55 +71,22 @@ class QChart;
 QT_END_NAMESPACE
 QT_BEGIN_NAMESPACE
 
-#pragma pack(push, 1)
-struct LVX2PublicHeader {
-    char signature[16] = "livox_tech";
-    uint8_t version_a = 2;
-    uint8_t version_b = 0;
-    uint8_t version_c = 0;
-    uint8_t version_d = 0;
-    uint32_t magic_code = 0xAC0EA767;
-};
-
-struct LVX2PrivateHeader {
-    uint32_t frame_duration = 50;  // ms
-    uint8_t device_count = 1;
-};
-
-struct LVX2DeviceInfo {
-    char lidar_sn[16] = {};
-    char hub_sn[16] = {};
-    uint32_t lidar_id = 0;
-    uint8_t lidar_type = 247;
-    uint8_t device_type = 9;
-    uint8_t extrinsic_enable = 1;
-    float roll = 0.0f;
-    float pitch = 0.0f;
-    float yaw = 0.0f;
-    float x = 0.0f;
-    float y = 0.0f;
-    float z = 0.0f;
-};
-
-struct LVX2FrameHeader {
-    uint64_t current_offset = 0;
-    uint64_t next_offset = 0;
-    uint64_t frame_index = 0;
-};
-
-struct LVX2PackageHeader {
-    uint8_t version = 0;
-    uint32_t lidar_id = 0;
-    uint8_t lidar_type = 8;
-    uint8_t timestamp_type = 0;
-    uint64_t timestamp = 0;
-    uint16_t udp_counter = 0;
-    uint8_t data_type = 0;
-    uint32_t data_length = 0;
-    uint8_t frame_counter = 0;
-    uint8_t reserve[4] = {0};
-};
-#pragma pack(pop)
+#include "point_types.h"
+#include "livox_pipeline.h"
+#include "lvx2_writer.h"
+#include "raw_capture.h"
+#include "stream_health.h"
+#include "synthetic_source.h"
+#include "render_budget.h"
+#include "point_octree.h"
+#include "imu_ring.h"
+#include "imu_allan.h"
+#include "param_poller.h"
+#include "telemetry_log.h"
+#include "log_ring.h"
+#include "fleet_ingest.h"
+#include "lidar_discovery.h"
+#include "startup_profile.h"
 
 // Livox SDK includes
 extern "C" {
@@ -136,18 +104,15 @@ struct DeviceInfo {
     bool is_streaming;
 };
 
-// 点云数据结构
-struct Point3D {
-    float x, y, z;
-    float r, g, b;
-    uint8_t reflectivity;
-    uint8_t tag;
-};
-
-struct PointCloudFrame {
-    QVector<Point3D> points;
-    uint64_t timestamp;
-    uint32_t device_handle;
+// 累积地图（八叉树 LOD）绘制统计
+struct LodRenderStats {
+    int visibleNodes = 0;
+    int culledNodes = 0;
+    int cachedNodes = 0;        // 已有 GPU 缓冲的节点
+    int uploads = 0;            // 本帧上传的节点
+    int drawnPoints = 0;
+    qint64 gpuBytes = 0;
+    OctreeCounters tree;
 };
 
 // 点云可视化组件
@@ -190,6 +155,23 @@ public:
     // 设置平面投影视角（用于平面投影观察）
     void setTopDownView();
 
+    // 性能统计：VBO 上传/绘制计时与左上角叠加层（lines 由 MainWindow 定时刷新）
+    void setPipelineStats(PipelineStats* stats) { m_stats = stats; }
+    void setStatsOverlay(bool visible, const QStringList& lines = QStringList());
+
+    // 自适应点数预算：按实测绘制耗时抽稀以保持目标帧率，相机静止时恢复全密度
+    void setAdaptiveBudgetEnabled(bool enabled);
+    void setTargetFps(int fps) { m_renderBudget.setTargetFps(fps); }
+    RenderBudgetStatus renderBudgetStatus() const;
+
+    // 累积地图：新到达的点增量插入八叉树，按视锥与屏幕空间误差只绘制可见节点；
+    // 关闭时清空。框选、测距与选点仍基于当前滑动窗口的点
+    void setAccumulationEnabled(bool enabled);
+    bool isAccumulationEnabled() const { return m_lodEnabled; }
+    void appendAccumulated(const QVector<Point3D>& points);
+    void clearAccumulated();
+    LodRenderStats lodStats() const { return m_lodStats; }
+
 protected:
     void initializeGL() override;
     void paintGL() override;
@@ -265,6 +247,46 @@ private:
     QVector3D m_p2;
     QPoint m_p1Screen;
     QPoint m_p2Screen;
+
+    // 性能统计
+    void collectGpuQueries();
+    PipelineStats* m_stats = nullptr;
+    bool m_statsOverlayVisible = false;
+    QStringList m_statsOverlayLines;
+    static const int kGpuQueryCount = 4;       // 环形计时查询，读取前几帧结果避免等待 GPU
+    GLuint m_gpuQueries[kGpuQueryCount] = {};
+    bool m_gpuQueryPending[kGpuQueryCount] = {};
+    int m_gpuQueryPoints[kGpuQueryCount] = {};  // 各查询对应的绘制点数
+    int m_gpuQueryIndex = 0;
+
+    // 自适应点数预算
+    void noteCameraMotion();
+    void ensureStratifiedOrder();
+    RenderBudget m_renderBudget;
+    bool m_pointsStratified = false;    // m_points 已按分层顺序排列，可直接按前缀抽稀
+    QVector<Point3D> m_stratifyScratch;
+
+    // 累积地图：每节点一个 VBO，按最近使用淘汰
+    struct LodBuffer {
+        GLuint vbo = 0;
+        uint32_t version = 0;
+        int count = 0;
+        uint64_t lastUsedFrame = 0;
+    };
+    static const int kLodMaxPoints = 10000000;                  // 每帧绘制上限（相机静止时）
+    static const qint64 kLodGpuBudgetBytes = 768LL << 20;       // 节点缓冲总显存上限
+    static const qint64 kLodUploadBytesPerFrame = 32LL << 20;   // 每帧上传上限，其余节点顺延到后续帧
+    int drawLod();
+    void releaseLodBuffers(bool all);
+    bool m_lodEnabled = false;
+    bool m_vboStale = false;            // 累积模式下未上传窗口点，退出时补传
+    PointOctree m_octree;
+    OctreeSelection m_lodSelection;
+    QHash<int, LodBuffer> m_lodBuffers;
+    QOpenGLVertexArrayObject m_lodVao;
+    qint64 m_lodGpuBytes = 0;
+    uint64_t m_lodFrame = 0;
+    LodRenderStats m_lodStats;
 };
 
 class MainWindow : public QMainWindow
@@ -279,14 +301,36 @@ private:
     void setupUI();
     void setupLivoxSDK();
     void cleanupLivoxSDK();
+    // SDK 初始化在后台线程执行，完成后回到 GUI 线程注册回调
+    void startSdkInit(const QString& configPath);
+    void onSdkInitFinished(bool ok, const QString& configPath);
+
+    // 快速启动：按上次成功的网络配置直接初始化 SDK，网络校验在后台进行，失败时回到设备发现流程
+    bool tryFastStartup();
+    void onStartupNetworkChecked(bool ok, const QString& details);
+    void fallbackToDiscovery(const QString& reason);
+    void saveStartupProfile(const DeviceInfo& device);
+    StartupTimeline startupTimeline;
+    std::thread sdkInitThread;
+    std::thread networkCheckThread;
+    std::atomic_bool sdkInitPending{false};
+    std::atomic_bool sdkInitOk{false};
+    QString sdkConfigPath;              // 当前 SDK 使用的配置文件
+    bool fastStartup = false;           // 本次由缓存配置启动，尚未确认可用
     bool runConfigGeneratorDialog();
+    void runSyntheticSourceDialog();
+    // 导出最近 N 秒的流水线追踪（Chrome Trace JSON，可在 Perfetto 中打开）
+    void exportPipelineTrace();
 
     // 点云处理
-    void processPointCloudPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet);
+    // 返回 false 表示数据包因 CRC 校验失败被丢弃（不写入录制文件）
+    bool processPointCloudPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t hostArrivalNs = 0);
     uint64_t parseTimestamp(const uint8_t* timestamp);
-    void publishPointCloudFrame(const PointCloudFrame& frame);
-    void calculatePointColor(uint8_t reflectivity, uint8_t tag, float& r, float& g, float& b);
-    QString parseParamValue(uint16_t key, uint8_t* value, uint16_t length);
+    void publishPointCloudFrame(const PointCloudFrame& frame, uint64_t latencyFrameId = 0);
+    void onPipelineFrame(const PointCloudFrame& frame, const PipelineOutput& info);
+    void syncPipelineOptions();
+    static QString parseParamValue(uint16_t key, uint8_t* value, uint16_t length);
+    void applyDeviceParams(uint32_t handle);
 
     // 着色模式
     enum ColorMode {
@@ -311,6 +355,9 @@ private:
 
     QLabel* statusLabel;
     QTextEdit* logText;
+    LogRing appLog;                     // 任意线程写入，后台线程写文件
+    QTimer* logFlushTimer = nullptr;    // 批量追加到 logText
+    void flushLogView();
     PointCloudWidget* pointCloudWidget;
     QLabel* statusLabelBar;
 
@@ -331,17 +378,100 @@ private:
     bool sdk_started;
     bool shutting_down = false;
     QTimer* updateTimer;
-    QTimer* renderTimer;
+    QTimer* renderTimer = nullptr;
     QMutex deviceMutex;
     QMap<uint32_t, DeviceInfo> devices;
     DeviceInfo* currentDevice;
 
-    // 点云组帧相关
-    QMap<uint32_t, QQueue<PointCloudFrame>> pendingFrames;
-    QMap<uint32_t, uint64_t> lastFrameTimestamp;
-    QMap<uint32_t, uint64_t> lastSeenTimestamp; // 最新到达的每设备时间戳（用于滑动窗口）
-    QMutex frameMutex;
-    uint64_t frameIntervalMs = 100; // 100ms帧间隔
+    // 点云处理流水线（解码、滑动窗口组帧、着色、滤波）
+    PointCloudPipeline pipeline;
+
+    // 性能统计（叠加层或统计面板可见时才采集）
+    PipelineStats pipelineStats;
+    QDockWidget* statsDock = nullptr;
+    QTableWidget* statsStageTable = nullptr;
+    QTableWidget* statsDeviceTable = nullptr;
+    QLabel* statsSummaryLabel = nullptr;
+    QAction* actionStatsOverlay = nullptr;
+    QTimer* statsTimer = nullptr;
+    void setupStatsDock();
+    void updateStatsEnabled();
+    void onStatsTick();
+    QString statsDeviceName(uint32_t handle) const;
+
+    // 端到端（包到达 → 显示）延迟，与性能统计同时开启
+    LatencyTracker latencyTracker;
+    QTableWidget* latencyTable = nullptr;
+    QChart* latencyChart = nullptr;
+    QValueAxis* latencyAxisX = nullptr;
+    QValueAxis* latencyAxisY = nullptr;
+    QMap<uint32_t, QLineSeries*> latencySeries;
+    void updateLatencyView();
+    void exportLatencyCsv();
+
+    // 数据链路健康（udp_cnt 丢包/乱序、时间戳跳变），常开，告警可选
+    StreamHealthMonitor streamHealth;
+    QDockWidget* healthDock = nullptr;
+    QTableWidget* healthTable = nullptr;
+    QCheckBox* healthAlertCheck = nullptr;
+    QDoubleSpinBox* healthAlertThreshold = nullptr;
+    QComboBox* crcModeCombo = nullptr;
+    QTimer* healthTimer = nullptr;
+    QMap<uint64_t, qint64> healthLastAlertMs;           // 每数据流上次告警时间（限频）
+    QMap<uint64_t, uint64_t> healthLastTimestampIssues; // 每数据流上次的时间戳异常数
+    void setupHealthDock();
+    void onHealthTick();
+    QVector<StreamHealthSummary> lastHealthStreams;     // 最近一次快照（设备总览复用）
+
+    // 车队模式（多雷达）：回调线程按设备入队，工作线程解码与录制，只有选中显示的设备参与合并渲染
+    FleetIngest fleetIngest;
+    std::atomic_bool fleetMode{false};
+    struct FleetTile {
+        QFrame* frame = nullptr;
+        QLabel* title = nullptr;
+        QLabel* stats = nullptr;
+        QCheckBox* render = nullptr;
+        QString color;
+    };
+    QWidget* fleetWindow = nullptr;
+    QCheckBox* fleetModeCheck = nullptr;
+    QLabel* fleetSummaryLabel = nullptr;
+    QGridLayout* fleetGrid = nullptr;
+    QMap<uint32_t, FleetTile> fleetTiles;
+    void onActionFleetOverview();
+    void setFleetMode(bool enabled);
+    void setFleetDeviceRendered(uint32_t handle, bool rendered);
+    void refreshFleetOverview();
+    void handleFleetPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t hostArrivalNs, bool render);
+
+    // 多设备时钟对齐（offset + drift），同步质量显示在设备列表
+    ClockAligner clockAligner;
+    QCheckBox* clockAlignCheck = nullptr;
+    QString deviceListText(const DeviceInfo& device) const;
+    QString clockSyncToolTip(uint32_t handle) const;
+    void refreshDeviceListSync();
+
+    // 运动去畸变：IMU 陀螺仪样本在 SDK 回调线程入环形缓冲，组帧后按逐点时间校正
+    PointDeskew pointDeskew;
+    QCheckBox* deskewCheck = nullptr;
+
+    // 渲染帧率与自适应点数预算
+    QSpinBox* targetFpsSpin = nullptr;
+    QCheckBox* adaptiveBudgetCheck = nullptr;
+
+    // 累积地图（八叉树 LOD），由流水线 chunk 输出增量插入
+    QCheckBox* accumulateCheck = nullptr;
+    int accumulateSinkId = 0;
+
+    // 主机侧外参（多雷达拼接），按 SN 保存在 QSettings，设备上线时自动加载
+    QMap<uint32_t, ExtrinsicParams> hostExtrinsics;
+    void setHostExtrinsic(uint32_t handle, const QString& sn, const ExtrinsicParams& params);
+    void clearHostExtrinsic(uint32_t handle, const QString& sn);
+    void loadHostExtrinsic(uint32_t handle, const QString& sn);
+
+    // 模拟数据源（无硬件压测），经 onPointCloudData/onImuData 进入与真实设备相同的路径
+    SyntheticLidarSource syntheticSource;
+    QAction* actionSyntheticSource = nullptr;
 
     // 点云回调状态
     bool pointCloudCallbackEnabled;
@@ -350,7 +480,10 @@ private:
     bool isNormalMode;
 
     // 参数查询相关
-    QTimer* paramQueryTimer;
+    ParamPoller paramPoller;
+    std::atomic_bool paramUiPending{false};   // 已投递界面参数刷新，尚未执行
+    uint32_t paramUiHandle = 0;                // 界面已应用到的设备与修订号，只取其后变化的键
+    uint64_t paramUiRevision = 0;
     QMap<uint16_t, QString> paramValues;
     QMap<uint16_t, QLabel*> paramLabels;
 
@@ -427,30 +560,73 @@ private:
     QLabel* imuAsciiLabel = nullptr;
 
     // IMU charts
+    // 全部 IMU 样本在 SDK 回调线程写入各设备的无锁环形缓冲，曲线按显示刷新率从缓冲按像素列 min/max 抽稀重绘
+    ImuHistory imuHistory;
     QChartView* gyroChartView = nullptr;
     QChart* gyroChart = nullptr;
-    QLineSeries* gyroSeriesX = nullptr;
-    QLineSeries* gyroSeriesY = nullptr;
-    QLineSeries* gyroSeriesZ = nullptr;
     QValueAxis* gyroAxisX = nullptr;
     QValueAxis* gyroAxisY = nullptr;
 
     QChartView* accChartView = nullptr;
     QChart* accChart = nullptr;
-    QLineSeries* accSeriesX = nullptr;
-    QLineSeries* accSeriesY = nullptr;
-    QLineSeries* accSeriesZ = nullptr;
     QValueAxis* accAxisX = nullptr;
     QValueAxis* accAxisY = nullptr;
 
     QWidget* imuChartWindow = nullptr;
-
-    std::atomic_bool imuDisplayRunning{false};
-    std::thread imuDisplayThread;
-    std::atomic_bool imuChartRunning{false};
-    std::thread imuChartThread;
-    QMutex imuSampleMutex;
-    struct { float gx=0, gy=0, gz=0, ax=0, ay=0, az=0; bool have=false; } latestImu;
+    QSpinBox* imuWindowSpin = nullptr;
+    QLabel* imuChartInfoLabel = nullptr;
+    QMap<uint32_t, QVector<QLineSeries*>> imuChartSeries;     // 每设备 ImuChannelCount 条
+    QMap<uint32_t, ImuMinMaxDecimator> imuDecimators;
+    QVector<QPointF> imuChartPoints;
+    void addImuChartDevice(uint32_t handle);
+    void refreshImuCharts();
+
+    QTimer* imuDisplayTimer = nullptr;
+    void onImuDisplayTick();
+
+    // IMU 噪声分析：实时（GUI 线程从 imuHistory 读取）或录制文件（工作线程，各轴并行）计算 Allan 偏差
+    QWidget* imuAnalysisWindow = nullptr;
+    QComboBox* imuAnalysisSourceCombo = nullptr;
+    QPushButton* imuAnalysisLiveButton = nullptr;
+    QPushButton* imuAnalysisFileButton = nullptr;
+    QLabel* imuAnalysisStatusLabel = nullptr;
+    QTableWidget* imuAnalysisTable = nullptr;
+    QChart* allanGyroChart = nullptr;
+    QChart* allanAccChart = nullptr;
+    QTimer* imuAnalysisTimer = nullptr;
+    AllanDeviation imuAllan;
+    uint32_t imuAllanHandle = 0;
+    uint64_t imuAllanNext = 0;
+    QVector<ImuSample> imuAllanScratch;
+    std::atomic_bool imuAnalysisCancel{false};
+    std::thread imuAnalysisThread;
+    void onActionImuAnalysis();
+    void onImuAnalysisTick();
+    void refreshImuAnalysisSources();
+    void startImuFileAnalysis(const QString& filePath);
+    void stopImuFileAnalysis();
+    void showAllanCurves(const QVector<QVector<AllanPoint>>& curves, const QString& status);
+
+    // 遥测记录：所有设备的参数状态（每次轮询应答）与点云包率/丢包率（每秒）写入 .lvxtlm
+    TelemetryWriter telemetryWriter;
+    TelemetryReader telemetryReader;
+    QWidget* telemetryWindow = nullptr;
+    QSpinBox* telemetryIntervalSpin = nullptr;
+    QPushButton* telemetryRecordButton = nullptr;
+    QLabel* telemetryStatusLabel = nullptr;
+    QLabel* telemetryFileLabel = nullptr;
+    QComboBox* telemetryDeviceCombo = nullptr;
+    QComboBox* telemetryMetricCombo = nullptr;
+    QComboBox* telemetryRangeCombo = nullptr;
+    QLabel* telemetryQueryLabel = nullptr;
+    QChart* telemetryChart = nullptr;
+    QLineSeries* telemetrySeries = nullptr;
+    void onActionTelemetry();
+    void toggleTelemetryRecording();
+    void stopTelemetryRecording();
+    void openTelemetryFile(const QString& filePath);
+    void refreshTelemetryPlot();
+    void recordParamTelemetry(uint32_t handle, const DeviceParamStatus& status);
     // 串口转发GPS同步
     QComboBox* serialPortCombo = nullptr;
     QCheckBox* serialEnableCheck = nullptr;
@@ -498,13 +674,14 @@ private:
 
     // LVX2 录制
     QString lvx2SaveDir;          // 目标保存目录（LVX2_雷达SN）
-    bool lvx2SaveActive = false;  // 是否正在录制
-    QFile lvx2File;               // 当前打开文件
-    QVector<QByteArray> lvx2PendingPkgs; // 当前帧待写入包
-    uint64_t lvx2FrameStartNs = 0;       // 当前帧起始时间
-    uint64_t lvx2FrameIndex = 0;         // 帧序号
+    std::atomic_bool lvx2SaveActive{false};  // 是否正在录制（车队模式下工作线程读取）
+    Lvx2Writer lvx2Writer;        // 分帧写入
     QMutex lvx2Mutex;                     // 录制互斥
-    void startLvx2Recording(const QString& filePath, int durationSec);
+    // 随 LVX2 一同录制的原始数据包（.lvxraw）：SDK 回调线程按到达写入点云与 IMU 包，带主机接收时间，
+    // 可由模拟 SDK 回放、LivoxConvert 转换
+    RawCaptureWriter rawCaptureWriter;
+    std::atomic_bool rawCaptureActive{false};
+    void startLvx2Recording(const QString& filePath, int durationSec, bool rawPackets = false);
     void stopLvx2Recording(bool flushPending);
 
     // IMU CSV 采集
@@ -513,7 +690,10 @@ private:
     int imuSecondsRemaining = 0;
     int imuTotalSeconds = 0;
     QMutex imuCsvMutex;
+    uint32_t imuCsvHandle = 0;
+    uint64_t imuCsvNext = 0;      // 下一个待写入的环形缓冲样本序号
     void appendImuCsvRow(quint64 timestamp_ns, float gx, float gy, float gz, float ax, float ay, float az);
+    void drainImuCsv();
 
 
 
@@ -562,29 +742,42 @@ private:
             return false;
         }
     }
-    // 滤波处理
-    QVector<Point3D> applyPointCloudFilters(const QVector<Point3D>& inputPoints);
+    // 滤波处理（作为流水线滤波阶段注册）
+    void applyPointCloudFilters(QVector<Point3D>& points);
 
     // 更新滤噪列表显示
     void updateNoiseFilterList();
 
-    // 设备发现相关
+    // 设备发现相关：每个在线 IPv4 网口一个套接字，并行广播、快速重发，应答按 SN 合并
     void startDeviceDiscovery();
     void stopDeviceDiscovery();
     void sendBroadcastDiscovery();
-    void onDeviceDiscoveryResponse(const QByteArray& data, const QHostAddress& sender);
+    void onDeviceDiscoveryResponse(const QByteArray& data, const QHostAddress& sender, int interfaceIndex);
     bool updateHostIPForDevice(const QString& deviceIP);
     bool updateConfigFileIP(const QString& newHostIP);
     QString calculateCompatibleHostIP(const QString& deviceIP);
     // void printPacketDetails(const QByteArray& data, const QHostAddress& sender);
 
-    // UDP socket for device discovery
-    QUdpSocket* discoverySocket;
+    struct DiscoveryInterface {
+        QString name;
+        QHostAddress ip;
+        QHostAddress netmask;
+        QHostAddress broadcast;     // 子网定向广播地址
+        int prefixLength = -1;
+        QUdpSocket* socket = nullptr;   // 从该网口发出；绑定到 56000 时也接收应答
+        bool sendOnly = false;          // 56000 被占用，应答由 discoveryReceiveSocket 接收
+    };
+    QVector<DiscoveryInterface> discoveryInterfaces;
+    QUdpSocket* discoveryReceiveSocket = nullptr;      // AnyIPv4:56000 共享接收，仅在有网口只能发送时创建
+    int discoveryInterfaceFor(const QHostAddress& sender) const;
+    QMap<QString, DiscoveryReply> discoveredLidars;     // 本轮发现的雷达（按 SN）
     QTimer* discoveryTimer;
+    int discoveryAttempt = 0;
+    QElapsedTimer discoveryClock;
+    bool discoverySettling = false;     // 已找到可直连的雷达，短暂等待其余雷达应答后初始化 SDK
     bool discoveryActive;
 
 private slots:
-    void onParamQueryTimeout();
     void onParamConfigChanged(uint16_t key);
     void applyIpConfig(uint16_t key, const QString& ip, const QString& mask, const QString& gateway);
     void applyHostIpConfig(uint16_t key, const QString& ip, int port);
@@ -597,6 +790,8 @@ private slots:
     void updateDeviceInfo(const DeviceInfo& device);
     void updateStatus();
     void logMessage(const QString& message);
+    // 任意线程可调用；site 为静态字符串时按站点限速（用于高频路径）
+    void logMessage(const QString& message, LogLevel level, const char* site = nullptr);
     void addDeviceToList(const DeviceInfo& device);
     void onTabChanged(int index);  // 添加标签页切换槽函数
     void onRenderTick();           // 渲染定时器回调（滑动窗口）
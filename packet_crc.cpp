@@ -0,0 +1,251 @@
+#include "packet_crc.h"
+#include "point_decode.h"
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PACKET_CRC_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define PACKET_CRC_ARMV8 1
+#include <arm_acle.h>
+#endif
+
+namespace {
+
+// slice-by-8 查表（反射多项式 0xEDB88320）
+struct Crc32Tables {
+    uint32_t t[8][256];
+    Crc32Tables()
+    {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            t[0][i] = c;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int s = 1; s < 8; ++s) t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+        }
+    }
+};
+
+const Crc32Tables& tables()
+{
+    static const Crc32Tables instance;
+    return instance;
+}
+
+// 对未取反的内部状态计算
+uint32_t crc32SliceBy8(const uint8_t* p, size_t n, uint32_t c)
+{
+    const Crc32Tables& tb = tables();
+    while (n >= 8) {
+        uint32_t lo, hi;
+        memcpy(&lo, p, 4);
+        memcpy(&hi, p + 4, 4);
+        lo ^= c;    // 小端
+        c = tb.t[7][lo & 0xFF] ^ tb.t[6][(lo >> 8) & 0xFF] ^ tb.t[5][(lo >> 16) & 0xFF] ^ tb.t[4][lo >> 24] ^
+            tb.t[3][hi & 0xFF] ^ tb.t[2][(hi >> 8) & 0xFF] ^ tb.t[1][(hi >> 16) & 0xFF] ^ tb.t[0][hi >> 24];
+        p += 8;
+        n -= 8;
+    }
+    while (n--) c = tb.t[0][(c ^ *p++) & 0xFF] ^ (c >> 8);
+    return c;
+}
+
+#if defined(PACKET_CRC_X86)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PACKET_CRC_TARGET_CLMUL __attribute__((target("pclmul,sse4.1")))
+#else
+#define PACKET_CRC_TARGET_CLMUL
+#endif
+
+// PCLMULQDQ 折叠（Intel "Fast CRC Computation Using PCLMULQDQ"），要求 n >= 64，
+// 处理 16 字节整数倍部分，返回内部状态；其余字节由调用方查表处理
+PACKET_CRC_TARGET_CLMUL
+uint32_t crc32Clmul(const uint8_t* p, size_t n, uint32_t c)
+{
+    alignas(16) static const uint64_t k1k2[2] = { 0x0154442bd4ULL, 0x01c6e41596ULL };
+    alignas(16) static const uint64_t k3k4[2] = { 0x01751997d0ULL, 0x00ccaa009eULL };
+    alignas(16) static const uint64_t k5k0[2] = { 0x0163cd6124ULL, 0x0000000000ULL };
+    alignas(16) static const uint64_t poly[2] = { 0x01db710641ULL, 0x01f7011641ULL };
+
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x00));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x10));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x20));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(int(c)));
+    __m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    p += 64;
+    n -= 64;
+
+    // 4 路并行折叠
+    while (n >= 64) {
+        const __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        const __m128i x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        const __m128i x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        const __m128i x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x30)));
+        p += 64;
+        n -= 64;
+    }
+
+    // 合并为 128 位
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    __m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x4), x5);
+
+    // 剩余的 16 字节块
+    while (n >= 16) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))), x5);
+        p += 16;
+        n -= 16;
+    }
+
+    // 128 → 64 位
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x00), x2);
+
+    // Barrett 归约到 32 位
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return uint32_t(_mm_extract_epi32(x1, 1));
+}
+
+bool cpuHasClmul()
+{
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 1);
+    return (info[2] & (1 << 1)) && (info[2] & (1 << 19));   // PCLMULQDQ、SSE4.1
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+#endif // PACKET_CRC_X86
+
+#if defined(PACKET_CRC_ARMV8)
+uint32_t crc32Armv8(const uint8_t* p, size_t n, uint32_t c)
+{
+    while (n >= 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        c = __crc32d(c, v);
+        p += 8;
+        n -= 8;
+    }
+    while (n--) c = __crc32b(c, *p++);
+    return c;
+}
+#endif
+
+enum Crc32Impl { ImplTable, ImplClmul, ImplArmv8 };
+
+Crc32Impl detectImpl()
+{
+#if defined(PACKET_CRC_X86)
+    if (cpuHasClmul()) return ImplClmul;
+#endif
+#if defined(PACKET_CRC_ARMV8)
+    return ImplArmv8;
+#endif
+    return ImplTable;
+}
+
+Crc32Impl activeImpl()
+{
+    static const Crc32Impl impl = detectImpl();
+    return impl;
+}
+
+} // namespace
+
+uint32_t crc32IeeeTable(const uint8_t* data, size_t length, uint32_t crc)
+{
+    return ~crc32SliceBy8(data, length, ~crc);
+}
+
+uint32_t crc32Ieee(const uint8_t* data, size_t length, uint32_t crc)
+{
+    uint32_t c = ~crc;
+    switch (activeImpl()) {
+#if defined(PACKET_CRC_X86)
+    case ImplClmul:
+        if (length >= 64) {
+            const size_t folded = length & ~size_t(15);
+            c = crc32Clmul(data, folded, c);
+            data += folded;
+            length -= folded;
+        }
+        break;
+#endif
+#if defined(PACKET_CRC_ARMV8)
+    case ImplArmv8:
+        return ~crc32Armv8(data, length, c);
+#endif
+    default:
+        break;
+    }
+    return ~crc32SliceBy8(data, length, c);
+}
+
+const char* crc32Implementation()
+{
+    switch (activeImpl()) {
+    case ImplClmul: return "pclmul";
+    case ImplArmv8: return "armv8-crc";
+    default: return "slice-by-8";
+    }
+}
+
+uint32_t packetCrc32(const LivoxLidarEthernetPacket* packet)
+{
+    const uint32_t unit = packet->data_type == kLivoxLidarImuData ? uint32_t(sizeof(LivoxLidarImuRawPoint))
+                                                                  : pointDataSize(packet->data_type);
+    size_t length = sizeof(packet->timestamp) + size_t(packet->dot_num) * unit;
+    // dot_num 损坏时只覆盖包头 length 以内的字节，不读出缓冲区
+    const size_t available = packet->length > offsetof(LivoxLidarEthernetPacket, timestamp)
+                                 ? size_t(packet->length) - offsetof(LivoxLidarEthernetPacket, timestamp) : 0;
+    if (length > available) length = available;
+    return crc32Ieee(packet->timestamp, length);
+}
+
+bool verifyPacketCrc(const LivoxLidarEthernetPacket* packet)
+{
+    return packet && packetLengthValid(packet) && packetCrc32(packet) == packet->crc32;
+}
+
+void finalizePacketCrc(LivoxLidarEthernetPacket* packet)
+{
+    if (packet) packet->crc32 = packetCrc32(packet);
+}
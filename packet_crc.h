@@ -0,0 +1,26 @@
+#ifndef PACKET_CRC_H
+#define PACKET_CRC_H
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+    #include "livox_lidar_def.h"
+}
+
+// CRC-32（IEEE 802.3，与 zlib crc32 相同），crc 为上一段的结果，可分段累加
+// 运行时选择实现：x86 PCLMULQDQ 折叠 / ARMv8 CRC32 指令 / slice-by-8 查表
+uint32_t crc32Ieee(const uint8_t* data, size_t length, uint32_t crc = 0);
+// 当前使用的实现名称（"pclmul" / "armv8-crc" / "slice-by-8"）
+const char* crc32Implementation();
+// 强制使用查表实现（基准测试对比用）
+uint32_t crc32IeeeTable(const uint8_t* data, size_t length, uint32_t crc = 0);
+
+// 点云包 CRC：覆盖 timestamp 与点数据（dot_num × 单点字节数），不超出包头 length
+uint32_t packetCrc32(const LivoxLidarEthernetPacket* packet);
+// length 不足以容纳 dot_num 个点（packetLengthValid）时视为校验失败
+bool verifyPacketCrc(const LivoxLidarEthernetPacket* packet);
+// 为合成/回放的数据包填写 crc32
+void finalizePacketCrc(LivoxLidarEthernetPacket* packet);
+
+#endif // PACKET_CRC_H
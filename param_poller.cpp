@@ -0,0 +1,279 @@
+#include "param_poller.h"
+#include "latency_tracker.h"
+#include <QMutexLocker>
+#include <chrono>
+#include <cstring>
+
+extern "C" {
+    #include "livox_lidar_def.h"
+}
+
+namespace {
+
+const int kTickMs = 100;
+const uint16_t kMaxValueLength = 1024;
+
+template <typename T>
+T readValue(const QByteArray& raw)
+{
+    T v;
+    std::memcpy(&v, raw.constData(), sizeof(T));
+    return v;
+}
+
+} // namespace
+
+ParamGroup paramGroupOf(uint16_t key)
+{
+    switch (key) {
+        case kKeySn:
+        case kKeyProductInfo:
+        case kKeyVersionApp:
+        case kKeyVersionLoader:
+        case kKeyVersionHardware:
+        case kKeyMac:
+            return ParamGroupIdentity;
+        case kKeyCurWorkState:
+        case kKeyCoreTemp:
+        case kKeyPowerUpCnt:
+        case kKeyLocalTimeNow:
+        case kKeyLastSyncTime:
+        case kKeyTimeOffset:
+        case kKeyTimeSyncType:
+        case kKeyLidarDiagStatus:
+        case kKeyFwType:
+        case kKeyHmsCode:
+            return ParamGroupStatus;
+        default:
+            return ParamGroupConfig;
+    }
+}
+
+void ParamPoller::start()
+{
+    if (m_running.exchange(true)) return;
+    m_thread = std::thread([this]() { run(); });
+}
+
+void ParamPoller::stop()
+{
+    m_running.store(false);
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void ParamPoller::addDevice(uint32_t handle)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_devices.contains(handle)) return;
+    Device& d = m_devices[handle];
+    d.status.handle = handle;
+}
+
+void ParamPoller::removeDevice(uint32_t handle)
+{
+    QMutexLocker locker(&m_mutex);
+    m_devices.remove(handle);
+    if (m_focus == handle) m_focus = 0;
+}
+
+void ParamPoller::setFocus(uint32_t handle)
+{
+    QMutexLocker locker(&m_mutex);
+    m_focus = handle;
+}
+
+void ParamPoller::requestNow(uint32_t handle)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_devices.find(handle);
+    if (it != m_devices.end()) it.value().nextDueNs = 0;
+}
+
+void ParamPoller::invalidate(uint32_t handle, ParamGroup group)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_devices.find(handle);
+    if (it == m_devices.end()) return;
+    it.value().groupDecodedNs[group] = 0;
+    it.value().nextDueNs = 0;
+}
+
+void ParamPoller::setIntervals(int focusMs, int backgroundMs)
+{
+    QMutexLocker locker(&m_mutex);
+    m_focusIntervalMs = focusMs;
+    m_backgroundIntervalMs = backgroundMs;
+    // 按新间隔重新排期
+    for (auto it = m_devices.begin(); it != m_devices.end(); ++it) it.value().nextDueNs = 0;
+}
+
+int ParamPoller::intervalFor(const Device& d, bool focus) const
+{
+    int interval = focus ? m_focusIntervalMs : m_backgroundIntervalMs;
+    for (int i = 0; i < d.consecutiveFailures && interval < kMaxBackoffMs; ++i) interval *= 2;
+    return interval < kMaxBackoffMs ? interval : kMaxBackoffMs;
+}
+
+void ParamPoller::run()
+{
+    while (m_running.load()) {
+        const uint64_t now = hostMonotonicNs();
+        QVector<uint32_t> due;
+        {
+            QMutexLocker locker(&m_mutex);
+            for (auto it = m_devices.begin(); it != m_devices.end(); ++it) {
+                Device& d = it.value();
+                if (d.inFlight) {
+                    // 应答丢失：超时后视为失败，允许重新发送
+                    if (now - d.sentNs < uint64_t(kTimeoutMs) * 1000000ULL) {
+                        if (now >= d.nextDueNs) {
+                            d.status.coalesced++;
+                            d.nextDueNs = now + uint64_t(intervalFor(d, it.key() == m_focus)) * 1000000ULL;
+                        }
+                        continue;
+                    }
+                    d.inFlight = false;
+                    d.status.failures++;
+                    d.consecutiveFailures++;
+                }
+                if (now < d.nextDueNs) continue;
+                const int interval = intervalFor(d, it.key() == m_focus);
+                d.status.intervalMs = interval;
+                d.nextDueNs = now + uint64_t(interval) * 1000000ULL;
+                d.inFlight = true;
+                d.sentNs = now;
+                due.append(it.key());
+            }
+        }
+        // 发送不持锁（应答可能在发送返回前到达）
+        for (uint32_t handle : due) {
+            if (m_query && m_query(handle)) continue;
+            QMutexLocker locker(&m_mutex);
+            auto it = m_devices.find(handle);
+            if (it == m_devices.end()) continue;
+            it.value().inFlight = false;
+            it.value().status.failures++;
+            it.value().consecutiveFailures++;
+        }
+        for (int i = 0; i < kTickMs / 20 && m_running.load(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+}
+
+void ParamPoller::decodeTyped(DeviceParamStatus& s, uint16_t key, const QByteArray& raw)
+{
+    const int n = raw.size();
+    switch (key) {
+        case kKeyCoreTemp:
+            if (n >= 4) {
+                s.coreTempC = readValue<int32_t>(raw) / 100.0;
+                s.hasTemperature = true;
+            }
+            break;
+        case kKeyCurWorkState:
+            if (n >= 1) s.workState = uint8_t(raw[0]);
+            break;
+        case kKeyTimeSyncType:
+            if (n >= 1) s.timeSyncType = uint8_t(raw[0]);
+            break;
+        case kKeyTimeOffset:
+            if (n >= 8) s.timeOffsetNs = readValue<int64_t>(raw);
+            break;
+        case kKeyLidarDiagStatus:
+            if (n >= 2) s.diagStatus = readValue<uint16_t>(raw);
+            break;
+        case kKeyHmsCode:
+            if (n >= 32) std::memcpy(s.hmsCodes, raw.constData(), sizeof(s.hmsCodes));
+            break;
+        default:
+            break;
+    }
+}
+
+void ParamPoller::handleResponse(uint32_t handle, bool ok, uint16_t paramNum, const uint8_t* data)
+{
+    const uint64_t now = hostMonotonicNs();
+    bool changed = false;
+    DeviceParamStatus status;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_devices.find(handle);
+        if (it == m_devices.end()) return;
+        Device& d = it.value();
+        if (d.inFlight) d.status.latencyMs = double(now - d.sentNs) / 1e6;
+        d.inFlight = false;
+        if (!ok || !data) {
+            d.status.failures++;
+            d.consecutiveFailures++;
+            return;
+        }
+        d.consecutiveFailures = 0;
+        d.status.responses++;
+        d.status.lastResponseNs = now;
+        if (!d.status.valid) changed = true;
+        d.status.valid = true;
+
+        // 本次应答需解码的分组：身份信息一次，配置按间隔，状态每次
+        bool decode[ParamGroupCount];
+        decode[ParamGroupStatus] = true;
+        decode[ParamGroupConfig] = d.groupDecodedNs[ParamGroupConfig] == 0 ||
+                                   now - d.groupDecodedNs[ParamGroupConfig] >= uint64_t(kConfigIntervalMs) * 1000000ULL;
+        decode[ParamGroupIdentity] = d.groupDecodedNs[ParamGroupIdentity] == 0;
+
+        uint32_t off = 0;
+        for (uint16_t i = 0; i < paramNum; ++i) {
+            uint16_t key = 0, length = 0;
+            std::memcpy(&key, data + off, sizeof(uint16_t));
+            std::memcpy(&length, data + off + 2, sizeof(uint16_t));
+            const uint8_t* value = data + off + 4;
+            off += 4u + length;
+            if (off > 65535u) break;
+            if (length == 0 || length > kMaxValueLength || !decode[paramGroupOf(key)]) continue;
+
+            ParamEntry& e = d.params[key];
+            if (e.revision != 0 && e.raw.size() == length && std::memcmp(e.raw.constData(), value, length) == 0) continue;
+            e.raw = QByteArray(reinterpret_cast<const char*>(value), length);
+            e.text = m_format ? m_format(key, e.raw) : QString::fromLatin1(e.raw.toHex().constData());
+            e.updatedNs = now;
+            e.revision = ++d.revision;
+            decodeTyped(d.status, key, e.raw);
+            changed = true;
+        }
+        for (int g = 0; g < ParamGroupCount; ++g) {
+            if (decode[g]) d.groupDecodedNs[g] = now;
+        }
+        if (m_observe) status = d.status;
+    }
+    if (changed && m_notify) m_notify(handle);
+    if (m_observe) m_observe(handle, status);
+}
+
+uint64_t ParamPoller::revision(uint32_t handle) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_devices.constFind(handle);
+    return it == m_devices.constEnd() ? 0 : it.value().revision;
+}
+
+QMap<uint16_t, ParamEntry> ParamPoller::params(uint32_t handle, uint64_t sinceRevision, uint64_t* revision) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_devices.constFind(handle);
+    if (revision) *revision = it == m_devices.constEnd() ? 0 : it.value().revision;
+    if (it == m_devices.constEnd()) return QMap<uint16_t, ParamEntry>();
+    if (sinceRevision == 0) return it.value().params;
+    if (sinceRevision >= it.value().revision) return QMap<uint16_t, ParamEntry>();
+    QMap<uint16_t, ParamEntry> out;
+    for (auto p = it.value().params.constBegin(); p != it.value().params.constEnd(); ++p) {
+        if (p.value().revision > sinceRevision) out.insert(p.key(), p.value());
+    }
+    return out;
+}
+
+DeviceParamStatus ParamPoller::status(uint32_t handle) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_devices.constFind(handle);
+    return it == m_devices.constEnd() ? DeviceParamStatus() : it.value().status;
+}
@@ -0,0 +1,131 @@
+#ifndef PARAM_POLLER_H
+#define PARAM_POLLER_H
+
+#include <QByteArray>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+// 参数分组：决定应答中各键的解码间隔
+enum ParamGroup {
+    ParamGroupStatus = 0,       // 温度、工作状态、时间同步、诊断：每次应答
+    ParamGroupConfig,           // 可配置参数：kConfigIntervalMs，或本机修改后立即
+    ParamGroupIdentity,         // 序列号、版本、MAC：每次连接一次
+    ParamGroupCount
+};
+
+ParamGroup paramGroupOf(uint16_t key);
+
+struct ParamEntry {
+    QByteArray raw;
+    QString text;               // 显示文本（回调线程中格式化，值不变时不重复格式化）
+    uint64_t updatedNs = 0;     // 最近一次值变化的主机时间
+    uint64_t revision = 0;      // 变化时的设备缓存修订号
+};
+
+// 常用状态的类型化视图
+struct DeviceParamStatus {
+    uint32_t handle = 0;
+    bool valid = false;         // 至少收到一次应答
+    bool hasTemperature = false;
+    double coreTempC = 0.0;
+    uint8_t workState = 0;
+    uint8_t timeSyncType = 0;
+    int64_t timeOffsetNs = 0;
+    uint16_t diagStatus = 0;
+    uint32_t hmsCodes[8] = {};
+    uint64_t responses = 0;
+    uint64_t failures = 0;      // 发送失败、错误应答或超时
+    uint64_t coalesced = 0;     // 因上一请求未返回而跳过的轮询
+    uint64_t lastResponseNs = 0;
+    double latencyMs = 0.0;     // 最近一次请求到应答的耗时
+    int intervalMs = 0;         // 当前轮询间隔
+};
+
+// 多设备参数轮询：后台线程按设备调度查询（当前设备快、其余设备慢，失败退避），
+// 同一设备上一请求未返回时不重复发送；应答在 SDK 回调线程解码进每设备的类型化缓存，
+// 只有值变化的键才重新格式化并递增修订号。界面按修订号取变化部分。
+class ParamPoller
+{
+public:
+    static const int kFocusIntervalMs = 1000;
+    static const int kBackgroundIntervalMs = 5000;
+    static const int kConfigIntervalMs = 10000;
+    static const int kTimeoutMs = 3000;
+    static const int kMaxBackoffMs = 30000;
+
+    // 发起查询（返回 false 表示发送失败）；应答需回调 handleResponse
+    using QueryFunction = std::function<bool(uint32_t handle)>;
+    using Formatter = std::function<QString(uint16_t key, const QByteArray& raw)>;
+    // 缓存变化时在回调线程调用
+    using ChangeNotifier = std::function<void(uint32_t handle)>;
+    // 每次成功应答后在回调线程调用（遥测记录）
+    using ResponseObserver = std::function<void(uint32_t handle, const DeviceParamStatus& status)>;
+
+    ParamPoller() = default;
+    ~ParamPoller() { stop(); }
+    ParamPoller(const ParamPoller&) = delete;
+    ParamPoller& operator=(const ParamPoller&) = delete;
+
+    void setQueryFunction(QueryFunction fn) { m_query = std::move(fn); }
+    void setFormatter(Formatter fn) { m_format = std::move(fn); }
+    void setChangeNotifier(ChangeNotifier fn) { m_notify = std::move(fn); }
+    void setResponseObserver(ResponseObserver fn) { m_observe = std::move(fn); }
+    // 当前设备与其余设备的轮询间隔（遥测记录时调快）
+    void setIntervals(int focusMs, int backgroundMs);
+
+    void start();
+    void stop();
+
+    void addDevice(uint32_t handle);
+    void removeDevice(uint32_t handle);
+    void setFocus(uint32_t handle);
+    // 尽快查询（仍遵守在途合并）；invalidate 使指定分组在下一次应答中重新解码
+    void requestNow(uint32_t handle);
+    void invalidate(uint32_t handle, ParamGroup group);
+
+    // SDK 回调线程调用；data 为 param_num 个 key(2)+length(2)+value 的序列
+    void handleResponse(uint32_t handle, bool ok, uint16_t paramNum, const uint8_t* data);
+
+    uint64_t revision(uint32_t handle) const;
+    // 修订号大于 sinceRevision 的参数（0 取全部）；revision 返回与结果一致的当前修订号
+    QMap<uint16_t, ParamEntry> params(uint32_t handle, uint64_t sinceRevision = 0, uint64_t* revision = nullptr) const;
+    DeviceParamStatus status(uint32_t handle) const;
+
+private:
+    struct Device {
+        DeviceParamStatus status;
+        QMap<uint16_t, ParamEntry> params;
+        uint64_t revision = 0;
+        bool inFlight = false;
+        uint64_t sentNs = 0;
+        uint64_t nextDueNs = 0;
+        int consecutiveFailures = 0;
+        uint64_t groupDecodedNs[ParamGroupCount] = {};   // 0：下一次应答需解码
+    };
+
+    void run();
+    int intervalFor(const Device& d, bool focus) const;
+    void decodeTyped(DeviceParamStatus& s, uint16_t key, const QByteArray& raw);
+
+    QueryFunction m_query;
+    Formatter m_format;
+    ChangeNotifier m_notify;
+    ResponseObserver m_observe;
+
+    mutable QMutex m_mutex;
+    QMap<uint32_t, Device> m_devices;
+    uint32_t m_focus = 0;
+    int m_focusIntervalMs = kFocusIntervalMs;
+    int m_backgroundIntervalMs = kBackgroundIntervalMs;
+
+    std::atomic_bool m_running{false};
+    std::thread m_thread;
+};
+
+#endif // PARAM_POLLER_H
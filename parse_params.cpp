@@ -4,6 +4,9 @@
 #include <QMessageBox>
 #include <QTextStream>
 #include <QDateTime>
+#include <QFileInfo>
+#include <QtCharts/QDateTimeAxis>
+#include <cmath>
 #include <cstring>
 
 void MainWindow::onParamConfigChanged(uint16_t key)
@@ -166,6 +169,7 @@ void MainWindow::onParamConfigChanged(uint16_t key)
             logMessage(QString("配置成功: %1 -> %2").arg(paramName).arg(newValue));
             // 标记参数已更新，避免被定时器覆盖
             updatedConfigKeys.insert(key);
+            paramPoller.invalidate(currentDevice->handle, ParamGroupConfig);
         } else {
             logMessage(QString("配置失败: %1 -> %2").arg(paramName).arg(newValue));
         }
@@ -346,6 +350,43 @@ void MainWindow::applyAttitudeConfig(uint16_t key, double roll, double pitch, do
     }
 }
 
+void MainWindow::setHostExtrinsic(uint32_t handle, const QString& sn, const ExtrinsicParams& params)
+{
+    hostExtrinsics[handle] = params;
+    pipeline.setDeviceExtrinsic(handle, pointExtrinsicFromParams(params));
+    if (!sn.isEmpty()) {
+        QSettings("Livox", "LivoxViewerQT").setValue(QString("hostExtrinsics/%1").arg(sn),
+            QVariantList() << params.roll << params.pitch << params.yaw << params.x << params.y << params.z);
+    }
+    logMessage(QString("主机外参已应用: %1 (R/P/Y %2/%3/%4°, X/Y/Z %5/%6/%7 m)")
+                   .arg(sn).arg(params.roll).arg(params.pitch).arg(params.yaw)
+                   .arg(params.x).arg(params.y).arg(params.z));
+}
+
+void MainWindow::clearHostExtrinsic(uint32_t handle, const QString& sn)
+{
+    hostExtrinsics.remove(handle);
+    pipeline.clearDeviceExtrinsic(handle);
+    if (!sn.isEmpty()) QSettings("Livox", "LivoxViewerQT").remove(QString("hostExtrinsics/%1").arg(sn));
+    logMessage(QString("主机外参已清除: %1").arg(sn));
+}
+
+void MainWindow::loadHostExtrinsic(uint32_t handle, const QString& sn)
+{
+    const QVariantList v = QSettings("Livox", "LivoxViewerQT").value(QString("hostExtrinsics/%1").arg(sn)).toList();
+    if (v.size() != 6) return;
+    ExtrinsicParams params;
+    params.roll = v[0].toFloat();
+    params.pitch = v[1].toFloat();
+    params.yaw = v[2].toFloat();
+    params.x = v[3].toFloat();
+    params.y = v[4].toFloat();
+    params.z = v[5].toFloat();
+    hostExtrinsics[handle] = params;
+    pipeline.setDeviceExtrinsic(handle, pointExtrinsicFromParams(params));
+    logMessage(QString("已加载主机外参: %1").arg(sn));
+}
+
 void MainWindow::updateFovEnableState(QCheckBox* fov0Check, QCheckBox* fov1Check)
 {
     if (!currentDevice || !currentDevice->is_connected) {
@@ -381,22 +422,6 @@ void MainWindow::updateFovEnableState(QCheckBox* fov0Check, QCheckBox* fov1Check
     }
 }
 
-void MainWindow::onParamQueryTimeout()
-{
-    if (!currentDevice || !currentDevice->is_connected) {
-        return;
-    }
-    
-    // 只查询状态参数，不查询可配置参数
-    // 状态参数：序列号、产品信息、版本、温度、时间等
-    // 可配置参数：工作模式、扫描模式、点云格式等
-    livox_status status = QueryLivoxLidarInternalInfo(currentDevice->handle, onQueryInternalInfoResponse, this);
-    
-    if (status != kLivoxLidarStatusSuccess) {
-        logMessage(QString("查询雷达内部信息失败，错误码: %1").arg(status));
-    }
-}
-
 QString MainWindow::parseParamValue(uint16_t key, uint8_t* value, uint16_t length)
 {
     if (!value || length == 0) {
@@ -910,3 +935,250 @@ void MainWindow::stopRecordParams()
     
     logMessage(QString("设备参数记录已停止，文件保存至: %1").arg(recordParamsFilePath));
 }
+
+void MainWindow::recordParamTelemetry(uint32_t handle, const DeviceParamStatus& status)
+{
+    const int64_t nowNs = QDateTime::currentMSecsSinceEpoch() * 1000000LL;
+    int hmsCount = 0;
+    for (uint32_t code : status.hmsCodes) {
+        if (code != 0) hmsCount++;
+    }
+    if (status.hasTemperature) telemetryWriter.append(handle, TelemetryCoreTemp, nowNs, int64_t(std::llround(status.coreTempC * 100.0)));
+    telemetryWriter.append(handle, TelemetryWorkState, nowNs, status.workState);
+    telemetryWriter.append(handle, TelemetryTimeSyncType, nowNs, status.timeSyncType);
+    telemetryWriter.append(handle, TelemetryTimeOffset, nowNs, status.timeOffsetNs);
+    telemetryWriter.append(handle, TelemetryDiagStatus, nowNs, status.diagStatus);
+    telemetryWriter.append(handle, TelemetryHmsCount, nowNs, hmsCount);
+    telemetryWriter.append(handle, TelemetryParamLatency, nowNs, int64_t(std::llround(status.latencyMs * 1000.0)));
+}
+
+void MainWindow::onActionTelemetry()
+{
+    if (telemetryWindow && telemetryWindow->isVisible()) {
+        telemetryWindow->raise();
+        telemetryWindow->activateWindow();
+        return;
+    }
+    telemetryWindow = new QWidget(this, Qt::Window);
+    telemetryWindow->setAttribute(Qt::WA_DeleteOnClose);
+    telemetryWindow->setWindowTitle("遥测记录");
+    telemetryWindow->resize(900, 560);
+    QVBoxLayout* layout = new QVBoxLayout(telemetryWindow);
+
+    QSettings settings("Livox", "LivoxViewerQT");
+    QHBoxLayout* recordRow = new QHBoxLayout();
+    recordRow->addWidget(new QLabel("参数采样间隔 (ms):", telemetryWindow));
+    telemetryIntervalSpin = new QSpinBox(telemetryWindow);
+    telemetryIntervalSpin->setRange(200, 60000);
+    telemetryIntervalSpin->setSingleStep(100);
+    telemetryIntervalSpin->setValue(settings.value("telemetry/intervalMs", 1000).toInt());
+    telemetryIntervalSpin->setToolTip("记录期间所有设备按该间隔轮询参数；点云包率与丢包率每秒记录一次");
+    recordRow->addWidget(telemetryIntervalSpin);
+    telemetryRecordButton = new QPushButton(telemetryWriter.isOpen() ? "停止记录" : "开始记录...", telemetryWindow);
+    recordRow->addWidget(telemetryRecordButton);
+    telemetryStatusLabel = new QLabel(telemetryWindow);
+    recordRow->addWidget(telemetryStatusLabel, 1);
+    layout->addLayout(recordRow);
+
+    QHBoxLayout* viewRow = new QHBoxLayout();
+    QPushButton* openButton = new QPushButton("打开记录...", telemetryWindow);
+    viewRow->addWidget(openButton);
+    telemetryDeviceCombo = new QComboBox(telemetryWindow);
+    telemetryDeviceCombo->setMinimumWidth(160);
+    viewRow->addWidget(telemetryDeviceCombo);
+    telemetryMetricCombo = new QComboBox(telemetryWindow);
+    for (int m = 0; m < TelemetryMetricCount; ++m) {
+        const TelemetryMetricInfo& info = telemetryMetricInfo(m);
+        telemetryMetricCombo->addItem(*info.unit ? QString("%1 (%2)").arg(info.name, info.unit) : QString(info.name), m);
+    }
+    viewRow->addWidget(telemetryMetricCombo);
+    telemetryRangeCombo = new QComboBox(telemetryWindow);
+    telemetryRangeCombo->addItem("全部", 0);
+    telemetryRangeCombo->addItem("最近 24 小时", 24 * 3600);
+    telemetryRangeCombo->addItem("最近 1 小时", 3600);
+    telemetryRangeCombo->addItem("最近 10 分钟", 600);
+    viewRow->addWidget(telemetryRangeCombo);
+    QPushButton* reloadButton = new QPushButton("刷新", telemetryWindow);
+    reloadButton->setToolTip("重新读取文件（查看正在记录的文件时使用）");
+    viewRow->addWidget(reloadButton);
+    telemetryQueryLabel = new QLabel(telemetryWindow);
+    viewRow->addWidget(telemetryQueryLabel, 1);
+    layout->addLayout(viewRow);
+    telemetryFileLabel = new QLabel("未打开记录文件", telemetryWindow);
+    layout->addWidget(telemetryFileLabel);
+
+    telemetryChart = new QChart();
+    telemetryChart->legend()->setVisible(false);
+    telemetrySeries = new QLineSeries();
+    telemetryChart->addSeries(telemetrySeries);
+    QDateTimeAxis* axisX = new QDateTimeAxis();
+    axisX->setFormat("MM-dd hh:mm:ss");
+    axisX->setTickCount(6);
+    QValueAxis* axisY = new QValueAxis();
+    telemetryChart->addAxis(axisX, Qt::AlignBottom);
+    telemetryChart->addAxis(axisY, Qt::AlignLeft);
+    telemetrySeries->attachAxis(axisX);
+    telemetrySeries->attachAxis(axisY);
+    QChartView* view = new QChartView(telemetryChart, telemetryWindow);
+    view->setRenderHint(QPainter::Antialiasing);
+    layout->addWidget(view, 1);
+
+    QTimer* statusTimer = new QTimer(telemetryWindow);
+    auto updateStatus = [this]() {
+        if (!telemetryWriter.isOpen()) {
+            telemetryStatusLabel->setText("未记录");
+            return;
+        }
+        telemetryStatusLabel->setText(QString("记录中: %1 个样本, %2 KB")
+                                          .arg(telemetryWriter.samples())
+                                          .arg(telemetryWriter.bytesWritten() / 1024));
+    };
+    connect(statusTimer, &QTimer::timeout, telemetryWindow, updateStatus);
+    statusTimer->start(1000);
+    updateStatus();
+
+    connect(telemetryRecordButton, &QPushButton::clicked, this, &MainWindow::toggleTelemetryRecording);
+    connect(telemetryIntervalSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int ms) {
+        QSettings("Livox", "LivoxViewerQT").setValue("telemetry/intervalMs", ms);
+        if (telemetryWriter.isOpen()) paramPoller.setIntervals(ms, ms);
+    });
+    connect(openButton, &QPushButton::clicked, this, [this]() {
+        const QString fileName = QFileDialog::getOpenFileName(telemetryWindow, "打开遥测记录", QDir::homePath(), "遥测记录 (*.lvxtlm)");
+        if (!fileName.isEmpty()) openTelemetryFile(fileName);
+    });
+    connect(reloadButton, &QPushButton::clicked, this, [this]() {
+        if (telemetryReader.isOpen()) openTelemetryFile(telemetryReader.fileName());
+    });
+    connect(telemetryDeviceCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::refreshTelemetryPlot);
+    connect(telemetryMetricCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::refreshTelemetryPlot);
+    connect(telemetryRangeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::refreshTelemetryPlot);
+    connect(telemetryWindow, &QObject::destroyed, this, [this]() {
+        telemetryWindow = nullptr;
+        telemetryIntervalSpin = nullptr;
+        telemetryRecordButton = nullptr;
+        telemetryStatusLabel = nullptr;
+        telemetryFileLabel = nullptr;
+        telemetryDeviceCombo = nullptr;
+        telemetryMetricCombo = nullptr;
+        telemetryRangeCombo = nullptr;
+        telemetryQueryLabel = nullptr;
+        telemetryChart = nullptr;
+        telemetrySeries = nullptr;
+    });
+
+    if (telemetryWriter.isOpen()) openTelemetryFile(telemetryWriter.fileName());
+    telemetryWindow->show();
+}
+
+void MainWindow::toggleTelemetryRecording()
+{
+    if (telemetryWriter.isOpen()) {
+        stopTelemetryRecording();
+        return;
+    }
+    const QString defaultName = QString("%1_遥测.lvxtlm").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+    QString fileName = QFileDialog::getSaveFileName(telemetryWindow ? telemetryWindow : this, "选择遥测记录保存路径",
+                                                    QDir::homePath() + "/" + defaultName, "遥测记录 (*.lvxtlm)");
+    if (fileName.isEmpty()) return;
+    if (!fileName.endsWith(".lvxtlm", Qt::CaseInsensitive)) fileName += ".lvxtlm";
+    if (!telemetryWriter.open(fileName)) {
+        QMessageBox::warning(this, "错误", "无法创建文件: " + fileName);
+        return;
+    }
+    {
+        QMutexLocker locker(&deviceMutex);
+        for (auto it = devices.constBegin(); it != devices.constEnd(); ++it) {
+            telemetryWriter.setDeviceName(it.key(), it.value().sn);
+        }
+    }
+    const int interval = telemetryIntervalSpin ? telemetryIntervalSpin->value()
+                                               : QSettings("Livox", "LivoxViewerQT").value("telemetry/intervalMs", 1000).toInt();
+    paramPoller.setIntervals(interval, interval);
+    if (telemetryRecordButton) telemetryRecordButton->setText("停止记录");
+    logMessage(QString("遥测记录已开始: %1").arg(fileName));
+}
+
+void MainWindow::stopTelemetryRecording()
+{
+    if (!telemetryWriter.isOpen()) return;
+    const QString fileName = telemetryWriter.fileName();
+    paramPoller.setIntervals(ParamPoller::kFocusIntervalMs, ParamPoller::kBackgroundIntervalMs);
+    telemetryWriter.close();
+    if (telemetryRecordButton) telemetryRecordButton->setText("开始记录...");
+    logMessage(QString("遥测记录已停止，文件保存至: %1").arg(fileName));
+}
+
+void MainWindow::openTelemetryFile(const QString& filePath)
+{
+    // 正在记录的文件先写出未满的块
+    if (telemetryWriter.isOpen() && telemetryWriter.fileName() == filePath) telemetryWriter.flush();
+    if (!telemetryReader.open(filePath)) {
+        QMessageBox::warning(telemetryWindow ? telemetryWindow : this, "遥测记录", telemetryReader.errorString());
+        return;
+    }
+    if (!telemetryWindow) return;
+
+    const uint32_t previous = telemetryDeviceCombo->currentData().toUInt();
+    QVector<uint32_t> handles;
+    uint64_t samples = 0;
+    for (const TelemetryReader::SeriesInfo& s : telemetryReader.series()) {
+        if (!handles.contains(s.handle)) handles.append(s.handle);
+        samples += s.samples;
+    }
+    telemetryDeviceCombo->blockSignals(true);
+    telemetryDeviceCombo->clear();
+    for (uint32_t handle : handles) {
+        const QString name = telemetryReader.deviceName(handle);
+        telemetryDeviceCombo->addItem(name.isEmpty() ? QString("句柄 %1").arg(handle) : name, handle);
+    }
+    const int index = telemetryDeviceCombo->findData(previous);
+    if (index >= 0) telemetryDeviceCombo->setCurrentIndex(index);
+    telemetryDeviceCombo->blockSignals(false);
+
+    telemetryFileLabel->setText(QString("%1 | %2 台设备, %3 个样本, %4 ~ %5")
+                                    .arg(QFileInfo(filePath).fileName())
+                                    .arg(handles.size())
+                                    .arg(samples)
+                                    .arg(QDateTime::fromMSecsSinceEpoch(telemetryReader.firstNs() / 1000000).toString("yyyy-MM-dd hh:mm:ss"))
+                                    .arg(QDateTime::fromMSecsSinceEpoch(telemetryReader.lastNs() / 1000000).toString("yyyy-MM-dd hh:mm:ss")));
+    refreshTelemetryPlot();
+}
+
+void MainWindow::refreshTelemetryPlot()
+{
+    if (!telemetrySeries || !telemetryReader.isOpen() || telemetryDeviceCombo->currentIndex() < 0) return;
+    const uint32_t handle = telemetryDeviceCombo->currentData().toUInt();
+    const int metric = telemetryMetricCombo->currentData().toInt();
+    const int64_t rangeSec = telemetryRangeCombo->currentData().toLongLong();
+    const int64_t toNs = telemetryReader.lastNs();
+    int64_t fromNs = telemetryReader.firstNs();
+    if (rangeSec > 0 && toNs - rangeSec * 1000000000LL > fromNs) fromNs = toNs - rangeSec * 1000000000LL;
+
+    // 每像素列最多两个点
+    QElapsedTimer timer;
+    timer.start();
+    const int columns = qMax(100, int(telemetryChart->plotArea().width()));
+    const QVector<TelemetryPoint> points = telemetryReader.query(handle, metric, fromNs, toNs, columns);
+    const double queryMs = double(timer.nsecsElapsed()) / 1e6;
+
+    QVector<QPointF> chartPoints;
+    chartPoints.reserve(points.size());
+    double minValue = 0.0, maxValue = 0.0;
+    for (int i = 0; i < points.size(); ++i) {
+        const TelemetryPoint& p = points[i];
+        chartPoints.append(QPointF(double(p.timeNs / 1000000), p.value));
+        if (i == 0 || p.value < minValue) minValue = p.value;
+        if (i == 0 || p.value > maxValue) maxValue = p.value;
+    }
+    telemetrySeries->replace(chartPoints);
+
+    QDateTimeAxis* axisX = qobject_cast<QDateTimeAxis*>(telemetryChart->axes(Qt::Horizontal).value(0));
+    QValueAxis* axisY = qobject_cast<QValueAxis*>(telemetryChart->axes(Qt::Vertical).value(0));
+    if (axisX) axisX->setRange(QDateTime::fromMSecsSinceEpoch(fromNs / 1000000), QDateTime::fromMSecsSinceEpoch(toNs / 1000000 + 1));
+    if (axisY) {
+        const double pad = maxValue > minValue ? (maxValue - minValue) * 0.05 : 1.0;
+        axisY->setRange(minValue - pad, maxValue + pad);
+        axisY->setTitleText(telemetryMetricCombo->currentText());
+    }
+    telemetryQueryLabel->setText(QString("%1 点, 查询 %2 ms").arg(points.size()).arg(queryMs, 0, 'f', 1));
+}
@@ -0,0 +1,131 @@
+#include "pipeline_stats.h"
+#include <QMutexLocker>
+#include <algorithm>
+
+const char* pipelineStageName(int stage)
+{
+    switch (stage) {
+        case StageIngest: return "接收";
+        case StageDecode: return "解码";
+        case StageMerge: return "合并";
+        case StageDeskew: return "去畸变";
+        case StageColor: return "着色";
+        case StageFilter: return "滤波";
+        case StageUpload: return "上传";
+        case StagePaint: return "绘制(CPU)";
+        case StageGpuDraw: return "绘制(GPU)";
+        default: return "?";
+    }
+}
+
+PipelineStats::PipelineStats()
+{
+    m_sinceSnapshot.start();
+}
+
+void PipelineStats::recordStage(int stage, uint64_t ns)
+{
+    if (!isEnabled() || stage < 0 || stage >= StageCount) return;
+    const double us = double(ns) / 1000.0;
+    QMutexLocker locker(&m_mutex);
+    StageData& s = m_stages[stage];
+    s.samples[s.count % kStageSamples] = uint32_t(std::min<uint64_t>(ns, UINT32_MAX));
+    s.avgUs = s.count == 0 ? us : s.avgUs + (us - s.avgUs) * 0.05;
+    s.maxUs = std::max(s.maxUs, us);
+    s.count++;
+}
+
+void PipelineStats::recordPacket(uint32_t handle, uint32_t points)
+{
+    if (!isEnabled()) return;
+    QMutexLocker locker(&m_mutex);
+    DeviceCounter& d = m_devices[handle];
+    d.packets++;
+    d.points += points;
+}
+
+void PipelineStats::recordPackets(uint32_t handle, int packets, uint64_t points, uint64_t decodeNs)
+{
+    if (!isEnabled() || packets <= 0) return;
+    const uint64_t ns = decodeNs / uint64_t(packets);
+    const double us = double(ns) / 1000.0;
+    QMutexLocker locker(&m_mutex);
+    DeviceCounter& d = m_devices[handle];
+    d.packets += uint64_t(packets);
+    d.points += points;
+    StageData& s = m_stages[StageDecode];
+    s.samples[s.count % kStageSamples] = uint32_t(std::min<uint64_t>(ns, UINT32_MAX));
+    s.avgUs = s.count == 0 ? us : s.avgUs + (us - s.avgUs) * 0.05;
+    s.maxUs = std::max(s.maxUs, us);
+    s.count++;
+}
+
+void PipelineStats::recordUpload(uint64_t bytes)
+{
+    if (!isEnabled()) return;
+    QMutexLocker locker(&m_mutex);
+    m_uploadBytes += bytes;
+    m_uploadFrames++;
+}
+
+PipelineStatsSnapshot PipelineStats::snapshot(const QMap<uint32_t, int>& queueDepths)
+{
+    PipelineStatsSnapshot out;
+    QVector<uint32_t> sorted;
+    sorted.reserve(kStageSamples);
+
+    QMutexLocker locker(&m_mutex);
+    const double seconds = std::max(1e-3, double(m_sinceSnapshot.restart()) / 1000.0);
+
+    for (int i = 0; i < StageCount; ++i) {
+        const StageData& s = m_stages[i];
+        StageSummary& r = out.stages[i];
+        r.count = s.count;
+        r.avgUs = s.avgUs;
+        r.maxUs = s.maxUs;
+        const int n = int(std::min<uint64_t>(s.count, kStageSamples));
+        if (n == 0) continue;
+        sorted.resize(n);
+        std::copy(s.samples, s.samples + n, sorted.begin());
+        std::sort(sorted.begin(), sorted.end());
+        r.p50Us = sorted[n / 2] / 1000.0;
+        r.p99Us = sorted[std::min(n - 1, (n * 99) / 100)] / 1000.0;
+    }
+
+    // 速率按区间计算，计数清零；曾出现过的设备保留（速率为 0 说明已断流）
+    for (auto it = m_devices.begin(); it != m_devices.end(); ++it) {
+        DeviceRateSummary d;
+        d.handle = it.key();
+        d.packetsPerSec = double(it.value().packets) / seconds;
+        d.pointsPerSec = double(it.value().points) / seconds;
+        d.queueDepth = queueDepths.value(it.key(), 0);
+        out.devices.append(d);
+        it.value() = DeviceCounter();
+    }
+    for (auto it = queueDepths.begin(); it != queueDepths.end(); ++it) {
+        if (!m_devices.contains(it.key())) {
+            DeviceRateSummary d;
+            d.handle = it.key();
+            d.queueDepth = it.value();
+            out.devices.append(d);
+        }
+    }
+
+    out.uploadBytesPerFrame = m_uploadFrames ? double(m_uploadBytes) / double(m_uploadFrames) : 0.0;
+    out.framesPerSec = double(m_uploadFrames) / seconds;
+    m_uploadBytes = 0;
+    m_uploadFrames = 0;
+    return out;
+}
+
+void PipelineStats::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < StageCount; ++i) {
+        m_stages[i] = StageData();
+    }
+    m_devices.clear();
+    m_uploadBytes = 0;
+    m_uploadFrames = 0;
+    m_sinceSnapshot.restart();
+}
@@ -0,0 +1,114 @@
+#ifndef PIPELINE_STATS_H
+#define PIPELINE_STATS_H
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+
+// 流水线各阶段（顺序即显示顺序）
+enum PipelineStage {
+    StageIngest = 0,    // SDK 回调：拷贝并投递到主线程
+    StageDecode,        // 解码并入队
+    StageMerge,         // 滑动窗口合并
+    StageDeskew,        // 运动去畸变
+    StageColor,         // 着色
+    StageFilter,        // 滤波
+    StageUpload,        // VBO 上传
+    StagePaint,         // paintGL（CPU 侧）
+    StageGpuDraw,       // 点云绘制（GPU 计时查询）
+    StageCount
+};
+
+const char* pipelineStageName(int stage);
+
+// 单阶段统计（微秒）
+struct StageSummary {
+    uint64_t count = 0;     // 累计次数
+    double avgUs = 0.0;     // 指数滑动平均
+    double p50Us = 0.0;     // 以下基于最近 kStageSamples 个样本
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+};
+
+struct DeviceRateSummary {
+    uint32_t handle = 0;
+    double packetsPerSec = 0.0;
+    double pointsPerSec = 0.0;
+    int queueDepth = 0;     // 流水线待处理帧数
+};
+
+struct PipelineStatsSnapshot {
+    StageSummary stages[StageCount];
+    QVector<DeviceRateSummary> devices;
+    double uploadBytesPerFrame = 0.0;
+    double framesPerSec = 0.0;
+};
+
+// 流水线性能统计：各阶段耗时、每设备包/点速率、上传字节数
+// 关闭时（默认）记录接口只做一次原子读，开销可忽略；可从任意线程记录
+class PipelineStats
+{
+public:
+    static const int kStageSamples = 512;
+
+    PipelineStats();
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    void recordStage(int stage, uint64_t ns);
+    void recordPacket(uint32_t handle, uint32_t points);
+    // 车队模式按批记录：一批同设备的包只取一次锁，耗时按包均摊为一个解码样本
+    void recordPackets(uint32_t handle, int packets, uint64_t points, uint64_t decodeNs);
+    void recordUpload(uint64_t bytes);
+
+    // 计算当前统计；速率为距上次 snapshot 的平均值
+    // queueDepths 为 PointCloudPipeline::pendingDepths() 的结果
+    PipelineStatsSnapshot snapshot(const QMap<uint32_t, int>& queueDepths = QMap<uint32_t, int>());
+    void reset();
+
+private:
+    struct StageData {
+        uint64_t count = 0;
+        double avgUs = 0.0;
+        double maxUs = 0.0;
+        uint32_t samples[kStageSamples] = {};   // ns，饱和到 uint32
+    };
+    struct DeviceCounter {
+        uint64_t packets = 0;
+        uint64_t points = 0;
+    };
+
+    std::atomic<bool> m_enabled{false};
+    QMutex m_mutex;
+    StageData m_stages[StageCount];
+    QMap<uint32_t, DeviceCounter> m_devices;
+    uint64_t m_uploadBytes = 0;
+    uint64_t m_uploadFrames = 0;
+    QElapsedTimer m_sinceSnapshot;
+};
+
+// 作用域计时：构造时统计关闭则不计时
+class ScopedStageTimer
+{
+public:
+    ScopedStageTimer(PipelineStats* stats, int stage)
+        : m_stats(stats && stats->isEnabled() ? stats : nullptr), m_stage(stage)
+    {
+        if (m_stats) m_timer.start();
+    }
+    ~ScopedStageTimer()
+    {
+        if (m_stats) m_stats->recordStage(m_stage, uint64_t(m_timer.nsecsElapsed()));
+    }
+
+private:
+    PipelineStats* m_stats;
+    int m_stage;
+    QElapsedTimer m_timer;
+};
+
+#endif // PIPELINE_STATS_H
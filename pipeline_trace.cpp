@@ -0,0 +1,256 @@
+#include "pipeline_trace.h"
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+namespace {
+
+// 单线程写入的环形缓冲：写入事件后再发布 head，读取方按 head 前后两次比较丢弃被覆盖的槽位
+struct ThreadTraceBuffer {
+    int tid = 0;                        // 以下两项受 TraceRegistry::mutex 保护
+    bool retired = false;               // 所属线程已退出，导出后可交给新线程复用
+    bool exported = false;              // 退出后其事件已导出或清除
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> floor{0};     // clear() 时的 head，导出时跳过之前的事件
+    TraceEvent events[PipelineTrace::kEventsPerThread];
+};
+
+struct TraceRegistry {
+    QMutex mutex;
+    QVector<ThreadTraceBuffer*> buffers;
+    int nextTid = 0;
+};
+
+// 退出线程的缓冲至多保留这么多个未导出的，超出后直接复用最早退出的
+const int kRetiredBuffersKept = 4;
+
+// 有意不释放：SDK 线程可能在静态析构之后仍有回调
+TraceRegistry& registry()
+{
+    static TraceRegistry* r = new TraceRegistry();
+    return *r;
+}
+
+std::atomic<bool> g_traceEnabled{false};
+thread_local const char* t_threadName = nullptr;
+thread_local bool t_exited = false;
+
+// 线程退出时把缓冲标记为可复用，而不是随线程泄漏；事件保留到下次导出
+struct ThreadBufferOwner {
+    ThreadTraceBuffer* buffer = nullptr;
+    ~ThreadBufferOwner()
+    {
+        t_exited = true;
+        if (!buffer) return;
+        TraceRegistry& r = registry();
+        QMutexLocker locker(&r.mutex);
+        buffer->retired = true;
+        buffer->exported = false;
+        buffer = nullptr;
+    }
+};
+thread_local ThreadBufferOwner t_owner;
+
+ThreadTraceBuffer* threadBuffer()
+{
+    if (t_exited) return nullptr;
+    if (!t_owner.buffer) {
+        TraceRegistry& r = registry();
+        QMutexLocker locker(&r.mutex);
+        ThreadTraceBuffer* reuse = nullptr;
+        ThreadTraceBuffer* oldest = nullptr;
+        int retired = 0;
+        for (ThreadTraceBuffer* b : r.buffers) {
+            if (!b->retired) continue;
+            retired++;
+            if (!oldest) oldest = b;
+            if (b->exported || b->head.load(std::memory_order_relaxed) == b->floor.load(std::memory_order_relaxed)) {
+                reuse = b;
+                break;
+            }
+        }
+        if (!reuse && retired >= kRetiredBuffersKept) reuse = oldest;
+
+        ThreadTraceBuffer* b = reuse;
+        if (b) {
+            // 丢弃前一个线程的事件，新线程以新的 tid 显示
+            b->floor.store(b->head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            b->retired = false;
+            b->exported = false;
+        } else {
+            b = new ThreadTraceBuffer();
+            r.buffers.append(b);
+        }
+        b->tid = ++r.nextTid;
+        b->name.store(t_threadName, std::memory_order_relaxed);
+        t_owner.buffer = b;
+    }
+    return t_owner.buffer;
+}
+
+// 事件名为 UTF-8 字符串常量，仅需转义引号与控制字符
+void appendJsonString(QByteArray& out, const char* s)
+{
+    out += '"';
+    for (const char* p = s; p && *p; ++p) {
+        const char c = *p;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (uint8_t(c) < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+void PipelineTrace::setEnabled(bool enabled)
+{
+    g_traceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool PipelineTrace::isEnabled()
+{
+    return g_traceEnabled.load(std::memory_order_relaxed);
+}
+
+uint64_t PipelineTrace::nowNs()
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void PipelineTrace::setThreadName(const char* name)
+{
+    t_threadName = name;
+    if (ThreadTraceBuffer* b = t_exited ? nullptr : t_owner.buffer) b->name.store(name, std::memory_order_relaxed);
+}
+
+void PipelineTrace::record(const char* name, uint64_t beginNs, uint64_t endNs)
+{
+    ThreadTraceBuffer* b = threadBuffer();
+    if (!b) return;
+    const uint64_t h = b->head.load(std::memory_order_relaxed);
+    TraceEvent& e = b->events[h % kEventsPerThread];
+    e.name = name;
+    e.beginNs = beginNs;
+    e.endNs = endNs;
+    b->head.store(h + 1, std::memory_order_release);
+}
+
+void PipelineTrace::clear()
+{
+    TraceRegistry& r = registry();
+    QMutexLocker locker(&r.mutex);
+    for (ThreadTraceBuffer* b : r.buffers) {
+        b->floor.store(b->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+        if (b->retired) b->exported = true;
+    }
+}
+
+int PipelineTrace::writeChromeTrace(const QString& path, double lastSeconds, QString* errorString)
+{
+    struct ThreadEvents {
+        int tid;
+        const char* name;
+        QVector<TraceEvent> events;
+    };
+    QVector<ThreadEvents> threads;
+    {
+        TraceRegistry& r = registry();
+        QMutexLocker locker(&r.mutex);
+        threads.reserve(r.buffers.size());
+        for (ThreadTraceBuffer* b : r.buffers) {
+            ThreadEvents t;
+            t.tid = b->tid;
+            t.name = b->name.load(std::memory_order_relaxed);
+            const uint64_t floor = b->floor.load(std::memory_order_relaxed);
+            const uint64_t h1 = b->head.load(std::memory_order_acquire);
+            uint64_t begin = h1 > uint64_t(kEventsPerThread) ? h1 - kEventsPerThread : 0;
+            begin = std::max(begin, floor);
+            t.events.reserve(int(h1 - begin));
+            for (uint64_t i = begin; i < h1; ++i) {
+                t.events.append(b->events[i % kEventsPerThread]);
+            }
+            // 拷贝期间写入方可能已覆盖最旧的槽位；序号 h2 的事件可能正写入
+            // h2 - kEventsPerThread 所在槽位，该槽位也一并丢弃
+            const uint64_t h2 = b->head.load(std::memory_order_acquire);
+            if (h2 >= begin + kEventsPerThread) {
+                const int overwritten = int(std::min<uint64_t>(h2 + 1 - kEventsPerThread - begin, uint64_t(t.events.size())));
+                t.events.remove(0, overwritten);
+            }
+            threads.append(t);
+            if (b->retired) b->exported = true;
+        }
+    }
+
+    uint64_t latest = 0;
+    uint64_t earliest = UINT64_MAX;
+    for (const ThreadEvents& t : threads) {
+        for (const TraceEvent& e : t.events) {
+            latest = std::max(latest, e.endNs);
+        }
+    }
+    const uint64_t cutoff = (lastSeconds > 0.0 && latest > uint64_t(lastSeconds * 1e9))
+                                ? latest - uint64_t(lastSeconds * 1e9) : 0;
+    for (const ThreadEvents& t : threads) {
+        for (const TraceEvent& e : t.events) {
+            if (e.endNs >= cutoff) earliest = std::min(earliest, e.beginNs);
+        }
+    }
+    if (earliest == UINT64_MAX) earliest = 0;
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (errorString) *errorString = file.errorString();
+        return -1;
+    }
+    // 时间单位为微秒，以导出范围内最早的事件为 0
+    QByteArray out;
+    out.reserve(1 << 20);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"LivoxViewerQT\"}}";
+    int written = 0;
+    for (const ThreadEvents& t : threads) {
+        out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + QByteArray::number(t.tid) + ",\"args\":{\"name\":";
+        if (t.name) appendJsonString(out, t.name);
+        else out += "\"thread " + QByteArray::number(t.tid) + "\"";
+        out += "}}";
+        for (const TraceEvent& e : t.events) {
+            if (e.endNs < cutoff || e.beginNs < earliest) continue;
+            out += ",\n{\"name\":";
+            appendJsonString(out, e.name);
+            out += ",\"cat\":\"pipeline\",\"ph\":\"X\",\"pid\":1,\"tid\":" + QByteArray::number(t.tid);
+            out += ",\"ts\":" + QByteArray::number(double(e.beginNs - earliest) / 1000.0, 'f', 3);
+            out += ",\"dur\":" + QByteArray::number(double(e.endNs - e.beginNs) / 1000.0, 'f', 3);
+            out += '}';
+            written++;
+        }
+        // 分块写出，避免整份 JSON 驻留内存
+        if (out.size() > (1 << 20)) {
+            if (file.write(out) != out.size()) {
+                if (errorString) *errorString = file.errorString();
+                file.close();
+                return -1;
+            }
+            out.resize(0);
+        }
+    }
+    out += "\n]}\n";
+    if (file.write(out) != out.size()) {
+        if (errorString) *errorString = file.errorString();
+        file.close();
+        return -1;
+    }
+    file.close();
+    return written;
+}
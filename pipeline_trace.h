@@ -0,0 +1,60 @@
+#ifndef PIPELINE_TRACE_H
+#define PIPELINE_TRACE_H
+
+#include <QString>
+#include <cstdint>
+
+// 流水线事件追踪（帧节奏分析）：
+//   每个线程一个无锁环形缓冲（仅本线程写入），TraceZone 记录作用域的起止时间，
+//   导出为 Chrome Trace JSON，可在 Perfetto（ui.perfetto.dev）或 chrome://tracing 打开。
+// 关闭时（默认）TraceZone 只做一次原子读；事件名必须是字符串常量（只保存指针）。
+struct TraceEvent {
+    const char* name = nullptr;
+    uint64_t beginNs = 0;
+    uint64_t endNs = 0;
+};
+
+class PipelineTrace
+{
+public:
+    static const int kEventsPerThread = 1 << 15;   // 每线程环形缓冲容量
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // 单调时钟（ns）
+    static uint64_t nowNs();
+
+    // 当前线程在追踪中显示的名称（字符串常量），未设置时显示为 "thread N"
+    static void setThreadName(const char* name);
+
+    static void record(const char* name, uint64_t beginNs, uint64_t endNs);
+
+    // 导出最近 lastSeconds 秒的事件（<=0 导出缓冲内全部），返回写入的事件数，失败返回 -1
+    static int writeChromeTrace(const QString& path, double lastSeconds, QString* errorString = nullptr);
+    // 丢弃已记录的事件
+    static void clear();
+};
+
+// 作用域追踪：构造时追踪关闭则不记录
+class TraceZone
+{
+public:
+    explicit TraceZone(const char* name)
+        : m_name(name), m_beginNs(PipelineTrace::isEnabled() ? PipelineTrace::nowNs() : 0)
+    {
+    }
+    ~TraceZone()
+    {
+        if (m_beginNs) PipelineTrace::record(m_name, m_beginNs, PipelineTrace::nowNs());
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_beginNs;
+};
+
+#endif // PIPELINE_TRACE_H
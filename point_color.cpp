@@ -0,0 +1,177 @@
+#include "point_color.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void reflectivityToColor(uint8_t reflectivity, float& r, float& g, float& b)
+{
+    // 参考Livox Viewer的着色逻辑（Livox color-coding strategy）
+    uint8_t cur_reflectivity = reflectivity;
+
+    if (cur_reflectivity < 30) {
+        r = 0;
+        g = static_cast<float>(cur_reflectivity * 255 / 30) / 255.0f;
+        b = 1.0f;
+    }
+    else if (cur_reflectivity < 90) {
+        r = 0;
+        g = 1.0f;
+        b = static_cast<float>((90 - cur_reflectivity) * 255 / 60) / 255.0f;
+    }
+    else if (cur_reflectivity < 150) {
+        r = static_cast<float>((cur_reflectivity - 90) * 255 / 60) / 255.0f;
+        g = 1.0f;
+        b = 0;
+    }
+    else {
+        r = 1.0f;
+        g = static_cast<float>((255 - cur_reflectivity) * 255 / (256 - 150)) / 255.0f;
+        b = 0;
+    }
+}
+
+// 反射率只有 256 种取值，预先算好查表
+struct ReflectivityLut {
+    float rgb[256][3];
+    ReflectivityLut() {
+        for (int i = 0; i < 256; ++i) {
+            reflectivityToColor(uint8_t(i), rgb[i][0], rgb[i][1], rgb[i][2]);
+        }
+    }
+};
+
+static const ReflectivityLut& reflectivityLut()
+{
+    static const ReflectivityLut lut;
+    return lut;
+}
+
+static void colorByReflectivity(QVector<Point3D>& points)
+{
+    const ReflectivityLut& lut = reflectivityLut();
+    for (Point3D& p : points) {
+        const float* c = lut.rgb[p.reflectivity];
+        p.r = c[0]; p.g = c[1]; p.b = c[2];
+    }
+}
+
+static PointColorLegend colorByDistance(QVector<Point3D>& points)
+{
+    float minD = std::numeric_limits<float>::max();
+    float maxD = 0.0f;
+    for (const Point3D& p : points) {
+        float d = std::sqrt(p.x*p.x + p.y*p.y + p.z*p.z);
+        if (d < minD) minD = d;
+        if (d > maxD) maxD = d;
+    }
+    if (!(maxD > minD)) { minD = 0.0f; maxD = 1.0f; }
+    const float inv = 1.0f / (maxD - minD);
+    for (Point3D& p : points) {
+        const float dx = p.x, dy = p.y, dz = p.z;
+        float d = std::sqrt(dx*dx + dy*dy + dz*dz);
+        float t = std::clamp((d - minD) * inv, 0.0f, 1.0f);
+        // 蓝->青->绿->黄->红
+        if (t < 0.25f)      { p.r = 0.0f;           p.g = t/0.25f;     p.b = 1.0f; }
+        else if (t < 0.5f)  { p.r = 0.0f;           p.g = 1.0f;        p.b = 1.0f - (t-0.25f)/0.25f; }
+        else if (t < 0.75f) { p.r = (t-0.5f)/0.25f; p.g = 1.0f;        p.b = 0.0f; }
+        else                { p.r = 1.0f;           p.g = 1.0f-(t-0.75f)/0.25f; p.b = 0.0f; }
+    }
+    return { minD, maxD, true };
+}
+
+static PointColorLegend colorByElevation(QVector<Point3D>& points)
+{
+    float minZ = std::numeric_limits<float>::max();
+    float maxZ = std::numeric_limits<float>::lowest();
+    for (const Point3D& p : points) {
+        if (p.z < minZ) minZ = p.z;
+        if (p.z > maxZ) maxZ = p.z;
+    }
+    if (!(maxZ > minZ)) { minZ = -1.0f; maxZ = 1.0f; }
+    const float inv = 1.0f / (maxZ - minZ);
+    for (Point3D& p : points) {
+        // 低->高: 蓝->红
+        float t = std::clamp((p.z - minZ) * inv, 0.0f, 1.0f);
+        p.r = t; p.g = 0.0f; p.b = 1.0f - t;
+    }
+    return { minZ, maxZ, true };
+}
+
+static void colorByPlanarProjection(QVector<Point3D>& points, float planarRadius)
+{
+    // 平面投影模式：根据点在平面上的位置着色
+    float minX = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float minY = std::numeric_limits<float>::max();
+    float maxY = std::numeric_limits<float>::lowest();
+
+    // 计算平面坐标范围
+    for (const Point3D& p : points) {
+        if (p.x < minX) minX = p.x;
+        if (p.x > maxX) maxX = p.x;
+        if (p.y < minY) minY = p.y;
+        if (p.y > maxY) maxY = p.y;
+    }
+
+    if (!(maxX > minX)) { minX = -planarRadius; maxX = planarRadius; }
+    if (!(maxY > minY)) { minY = 0.0f; maxY = planarRadius; }
+
+    for (Point3D& p : points) {
+        // 根据平面位置着色
+        float tx = std::clamp((p.x - minX) / (maxX - minX), 0.0f, 1.0f);
+        float ty = std::clamp((p.y - minY) / (maxY - minY), 0.0f, 1.0f);
+
+        // 使用HSV颜色空间创建渐变效果
+        float hue = tx * 360.0f;  // X轴对应色相
+        float saturation = 0.8f;  // 固定饱和度
+        float value = 0.5f + ty * 0.5f;  // Y轴对应明度
+
+        // HSV转RGB
+        float c = value * saturation;
+        float x = c * (1.0f - std::abs(std::fmod(hue / 60.0f, 2.0f) - 1.0f));
+        float m = value - c;
+
+        if (hue < 60.0f) {
+            p.r = c + m; p.g = x + m; p.b = m;
+        } else if (hue < 120.0f) {
+            p.r = x + m; p.g = c + m; p.b = m;
+        } else if (hue < 180.0f) {
+            p.r = m; p.g = c + m; p.b = x + m;
+        } else if (hue < 240.0f) {
+            p.r = m; p.g = x + m; p.b = c + m;
+        } else if (hue < 300.0f) {
+            p.r = x + m; p.g = m; p.b = c + m;
+        } else {
+            p.r = c + m; p.g = m; p.b = x + m;
+        }
+
+        // 确保RGB值在[0,1]范围内
+        p.r = std::clamp(p.r, 0.0f, 1.0f);
+        p.g = std::clamp(p.g, 0.0f, 1.0f);
+        p.b = std::clamp(p.b, 0.0f, 1.0f);
+    }
+}
+
+PointColorLegend colorizePoints(QVector<Point3D>& points, const PointColorOptions& options)
+{
+    switch (options.mode) {
+        case PointColorByDistance:
+            return colorByDistance(points);
+        case PointColorByElevation:
+            return colorByElevation(points);
+        case PointColorSolid:
+            for (Point3D& p : points) {
+                p.r = options.solidR;
+                p.g = options.solidG;
+                p.b = options.solidB;
+            }
+            return { 0.0f, 1.0f, false };
+        case PointColorByPlanarProjection:
+            colorByPlanarProjection(points, options.planarRadius);
+            return { 0.0f, 1.0f, true };
+        case PointColorByReflectivity:
+        default:
+            colorByReflectivity(points);
+            return { 0.0f, 255.0f, true };
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef POINT_COLOR_H
+#define POINT_COLOR_H
+
+#include "point_types.h"
+
+// 着色模式（索引与界面下拉框、PointCloudWidget 图例一致）
+enum PointColorMode {
+    PointColorByReflectivity = 0,
+    PointColorByDistance = 1,
+    PointColorByElevation = 2,
+    PointColorSolid = 3,
+    PointColorByPlanarProjection = 4
+};
+
+struct PointColorOptions {
+    int mode = PointColorByReflectivity;
+    float solidR = 1.0f;
+    float solidG = 1.0f;
+    float solidB = 1.0f;
+    float planarRadius = 10.0f;   // 平面投影着色的默认范围（m）
+};
+
+// 图例范围（距离/高度模式为实际数值范围）
+struct PointColorLegend {
+    float minVal = 0.0f;
+    float maxVal = 1.0f;
+    bool visible = true;
+};
+
+// 反射率着色（Livox color-coding strategy）
+void reflectivityToColor(uint8_t reflectivity, float& r, float& g, float& b);
+
+// 按模式为整帧点着色，返回图例范围
+PointColorLegend colorizePoints(QVector<Point3D>& points, const PointColorOptions& options);
+
+#endif // POINT_COLOR_H
@@ -0,0 +1,200 @@
+#include "point_decode.h"
+#include <cmath>
+#include <cstddef>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+uint64_t parsePacketTimestamp(const uint8_t* timestamp)
+{
+    // 按小端序解析时间戳
+    uint64_t result = 0;
+    for (int i = 7; i >= 0; --i) {
+        result = (result << 8) | timestamp[i];
+    }
+    return result;
+}
+
+uint32_t pointDataSize(uint8_t dataType)
+{
+    switch (dataType) {
+        case kLivoxLidarCartesianCoordinateHighData: return sizeof(LivoxLidarCartesianHighRawPoint);
+        case kLivoxLidarCartesianCoordinateLowData: return sizeof(LivoxLidarCartesianLowRawPoint);
+        case kLivoxLidarSphericalCoordinateData: return sizeof(LivoxLidarSpherPoint);
+        default: return 0;
+    }
+}
+
+bool packetLengthValid(const LivoxLidarEthernetPacket* packet)
+{
+    if (!packet) return false;
+    const uint32_t unit = packet->data_type == kLivoxLidarImuData ? uint32_t(sizeof(LivoxLidarImuRawPoint))
+                                                                  : pointDataSize(packet->data_type);
+    const size_t needed = offsetof(LivoxLidarEthernetPacket, data) + size_t(packet->dot_num) * unit;
+    return needed <= packet->length;
+}
+
+namespace {
+
+// 笛卡尔坐标解码：有外参时将单位换算并入旋转列，x' = M·raw + t，仍为单次循环
+template <typename RawPoint>
+void decodeCartesian(const RawPoint* src, uint32_t dotNum, float unitScale,
+                     const PointExtrinsic* extrinsic, Point3D* dst)
+{
+    if (!extrinsic) {
+        for (uint32_t i = 0; i < dotNum; i++) {
+            Point3D& point = dst[i];
+            point.x = src[i].x / unitScale; // 转换为米
+            point.y = src[i].y / unitScale;
+            point.z = src[i].z / unitScale;
+            point.r = point.g = point.b = 0.0f;
+            point.reflectivity = src[i].reflectivity;
+            point.tag = src[i].tag;
+        }
+        return;
+    }
+
+    const float* e = extrinsic->m;
+    const float s = 1.0f / unitScale;
+    const float m00 = e[0] * s, m01 = e[1] * s, m02 = e[2] * s, tx = e[3];
+    const float m10 = e[4] * s, m11 = e[5] * s, m12 = e[6] * s, ty = e[7];
+    const float m20 = e[8] * s, m21 = e[9] * s, m22 = e[10] * s, tz = e[11];
+    for (uint32_t i = 0; i < dotNum; i++) {
+        Point3D& point = dst[i];
+        const float x = float(src[i].x), y = float(src[i].y), z = float(src[i].z);
+        point.x = m00 * x + m01 * y + m02 * z + tx;
+        point.y = m10 * x + m11 * y + m12 * z + ty;
+        point.z = m20 * x + m21 * y + m22 * z + tz;
+        point.r = point.g = point.b = 0.0f;
+        point.reflectivity = src[i].reflectivity;
+        point.tag = src[i].tag;
+    }
+}
+
+} // namespace
+
+PointExtrinsic pointExtrinsicFromParams(const ExtrinsicParams& params)
+{
+    const double d2r = M_PI / 180.0;
+    const double cr = std::cos(params.roll * d2r), sr = std::sin(params.roll * d2r);
+    const double cp = std::cos(params.pitch * d2r), sp = std::sin(params.pitch * d2r);
+    const double cy = std::cos(params.yaw * d2r), sy = std::sin(params.yaw * d2r);
+
+    // R = Rz(yaw)·Ry(pitch)·Rx(roll)
+    PointExtrinsic e;
+    e.m[0] = float(cy * cp);
+    e.m[1] = float(cy * sp * sr - sy * cr);
+    e.m[2] = float(cy * sp * cr + sy * sr);
+    e.m[3] = params.x;
+    e.m[4] = float(sy * cp);
+    e.m[5] = float(sy * sp * sr + cy * cr);
+    e.m[6] = float(sy * sp * cr - cy * sr);
+    e.m[7] = params.y;
+    e.m[8] = float(-sp);
+    e.m[9] = float(cp * sr);
+    e.m[10] = float(cp * cr);
+    e.m[11] = params.z;
+    return e;
+}
+
+bool isIdentityExtrinsic(const PointExtrinsic& extrinsic)
+{
+    static const PointExtrinsic identity;
+    for (int i = 0; i < 12; ++i) {
+        if (std::fabs(extrinsic.m[i] - identity.m[i]) > 1e-7f) return false;
+    }
+    return true;
+}
+
+int decodePointData(uint8_t dataType, const uint8_t* data, uint32_t dotNum,
+                    const PointDecodeOptions& options, QVector<Point3D>& out,
+                    const PointExtrinsic* extrinsic)
+{
+    if (!data || dotNum == 0 || pointDataSize(dataType) == 0) {
+        return 0;
+    }
+
+    const int base = out.size();
+    out.resize(base + int(dotNum));
+    Point3D* dst = out.data() + base;
+
+    // 根据数据类型解析点云数据
+    if (dataType == kLivoxLidarCartesianCoordinateHighData) {
+        decodeCartesian(reinterpret_cast<const LivoxLidarCartesianHighRawPoint*>(data), dotNum, 1000.0f, extrinsic, dst);
+    }
+    else if (dataType == kLivoxLidarCartesianCoordinateLowData) {
+        decodeCartesian(reinterpret_cast<const LivoxLidarCartesianLowRawPoint*>(data), dotNum, 100.0f, extrinsic, dst);
+    }
+    else {
+        const LivoxLidarSpherPoint* p_point_data = reinterpret_cast<const LivoxLidarSpherPoint*>(data);
+        // 平面投影为展开图，不应用外参；其余情况外参在同一循环内完成，不再单独遍历
+        const float* e = (extrinsic && !options.planarProjectionEnabled) ? extrinsic->m : nullptr;
+        for (uint32_t i = 0; i < dotNum; i++) {
+            Point3D& point = dst[i];
+
+            // 球坐标转笛卡尔坐标
+            float depth = p_point_data[i].depth / 1000.0f; // 转换为米
+            float theta = p_point_data[i].theta / 100.0f * M_PI / 180.0f; // 转换为弧度
+            float phi = p_point_data[i].phi / 100.0f * M_PI / 180.0f; // 转换为弧度
+
+            // 深度投影：启用且设置了投影距离（>0）时，使用该距离替换 depth
+            if (options.projectionDepthEnabled && options.projectionDepthMeters > 0.0f) {
+                depth = options.projectionDepthMeters;
+            }
+
+            // 平面投影模式时，设置投影深度为平面投影半径
+            if (options.planarProjectionEnabled && options.projectionDepthMeters <= 0.0f) {
+                depth = options.planarProjectionRadius;
+            }
+
+            // 平面投影：如果启用平面投影，将球坐标转换为平面坐标
+            if (options.planarProjectionEnabled) {
+                // 等距圆柱投影：将球面展开为平面
+                // phi (方位角) 映射到 X 轴，theta (仰角) 映射到 Y 轴
+                float phi_deg = phi * 180.0f / M_PI;  // 转换为度
+                float theta_deg = theta * 180.0f / M_PI;  // 转换为度
+
+                // 将方位角映射到 [-180, 180] 度范围
+                if (phi_deg > 180.0f) phi_deg -= 360.0f;
+
+                // 将仰角映射到 [-90, 90] 度范围（完整球面）
+                theta_deg = 90.0f - theta_deg; // 转换坐标系，使0°为水平，正值为上方，负值为下方
+
+                // 计算平面坐标
+                point.x = options.planarProjectionRadius * phi_deg / 180.0f;  // X轴：方位角
+                point.y = options.planarProjectionRadius * theta_deg / 90.0f;  // Y轴：仰角
+                point.z = 0.0f;  // 平面投影时Z设为0
+            } else {
+                // 原始球坐标转笛卡尔坐标
+                const float x = depth * sin(theta) * cos(phi);
+                const float y = depth * sin(theta) * sin(phi);
+                const float z = depth * cos(theta);
+                if (e) {
+                    point.x = e[0] * x + e[1] * y + e[2] * z + e[3];
+                    point.y = e[4] * x + e[5] * y + e[6] * z + e[7];
+                    point.z = e[8] * x + e[9] * y + e[10] * z + e[11];
+                } else {
+                    point.x = x;
+                    point.y = y;
+                    point.z = z;
+                }
+            }
+            point.r = point.g = point.b = 0.0f;
+            point.reflectivity = p_point_data[i].reflectivity;
+            point.tag = p_point_data[i].tag;
+        }
+    }
+
+    return int(dotNum);
+}
+
+int decodePointPacket(const LivoxLidarEthernetPacket* packet,
+                      const PointDecodeOptions& options, QVector<Point3D>& out,
+                      const PointExtrinsic* extrinsic)
+{
+    if (!packet || packet->dot_num == 0 || !packetLengthValid(packet)) {
+        return 0;
+    }
+    return decodePointData(packet->data_type, packet->data, packet->dot_num, options, out, extrinsic);
+}
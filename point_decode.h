@@ -0,0 +1,61 @@
+#ifndef POINT_DECODE_H
+#define POINT_DECODE_H
+
+#include "point_types.h"
+
+extern "C" {
+    #include "livox_lidar_def.h"
+}
+
+// 点云解码参数（与界面上的投影选项对应）
+struct PointDecodeOptions {
+    bool projectionDepthEnabled = false;  // 球坐标深度投影
+    float projectionDepthMeters = 1.0f;   // 投影深度（m），0 表示使用原始深度
+    bool planarProjectionEnabled = false; // 平面投影
+    float planarProjectionRadius = 10.0f; // 平面投影半径（m）
+};
+
+// 主机侧外参（多雷达拼接）：3×4 行主序 [R|t]，p' = R·p + t（米）
+struct PointExtrinsic {
+    float m[12] = { 1.0f, 0.0f, 0.0f, 0.0f,
+                    0.0f, 1.0f, 0.0f, 0.0f,
+                    0.0f, 0.0f, 1.0f, 0.0f };
+};
+
+// 外参参数，与 LVX2DeviceInfo 一致：角度为度，平移为米
+// 旋转顺序 R = Rz(yaw)·Ry(pitch)·Rx(roll)
+struct ExtrinsicParams {
+    float roll = 0.0f;
+    float pitch = 0.0f;
+    float yaw = 0.0f;
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+PointExtrinsic pointExtrinsicFromParams(const ExtrinsicParams& params);
+bool isIdentityExtrinsic(const PointExtrinsic& extrinsic);
+
+// 按小端序解析 8 字节时间戳
+uint64_t parsePacketTimestamp(const uint8_t* timestamp);
+
+// 单点字节数（高精度 14 / 低精度 8 / 球坐标 10），未知类型返回 0
+uint32_t pointDataSize(uint8_t dataType);
+
+// 包头 length（整个 UDP 负载，含包头）能否容纳 dot_num 个点；dot_num 损坏的包不得解码或计算 CRC
+bool packetLengthValid(const LivoxLidarEthernetPacket* packet);
+
+// 解码原始点数据并追加到 out，返回追加的点数
+// 在线（processPointCloudPacket）与离线（LVX2/原始包转换）共用此实现，保证结果一致
+// extrinsic 非空时在解码循环内一并变换（与单位换算合并为一次 3×4 乘法，无额外遍历）；
+// 平面投影模式下输出为展开图，不应用外参
+int decodePointData(uint8_t dataType, const uint8_t* data, uint32_t dotNum,
+                    const PointDecodeOptions& options, QVector<Point3D>& out,
+                    const PointExtrinsic* extrinsic = nullptr);
+
+// 解码完整以太网数据包；length 不足以容纳 dot_num 个点时不解码，返回 0
+int decodePointPacket(const LivoxLidarEthernetPacket* packet,
+                      const PointDecodeOptions& options, QVector<Point3D>& out,
+                      const PointExtrinsic* extrinsic = nullptr);
+
+#endif // POINT_DECODE_H
@@ -0,0 +1,264 @@
+#include "point_deskew.h"
+#include <QMutexLocker>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+struct Quat {
+    double w = 1.0, x = 0.0, y = 0.0, z = 0.0;
+};
+
+// q ⊗ exp(θ/2)，θ 为本步转角向量（rad）
+Quat integrate(const Quat& q, double tx, double ty, double tz)
+{
+    const double angle = std::sqrt(tx * tx + ty * ty + tz * tz);
+    double dw, dx, dy, dz;
+    if (angle < 1e-12) {
+        dw = 1.0; dx = 0.5 * tx; dy = 0.5 * ty; dz = 0.5 * tz;
+    } else {
+        const double s = std::sin(0.5 * angle) / angle;
+        dw = std::cos(0.5 * angle); dx = tx * s; dy = ty * s; dz = tz * s;
+    }
+    Quat r;
+    r.w = q.w * dw - q.x * dx - q.y * dy - q.z * dz;
+    r.x = q.w * dx + q.x * dw + q.y * dz - q.z * dy;
+    r.y = q.w * dy - q.x * dz + q.y * dw + q.z * dx;
+    r.z = q.w * dz + q.x * dy - q.y * dx + q.z * dw;
+    const double n = 1.0 / std::sqrt(r.w * r.w + r.x * r.x + r.y * r.y + r.z * r.z);
+    r.w *= n; r.x *= n; r.y *= n; r.z *= n;
+    return r;
+}
+
+void toMatrix(const Quat& q, double m[9])
+{
+    m[0] = 1 - 2 * (q.y * q.y + q.z * q.z); m[1] = 2 * (q.x * q.y - q.w * q.z); m[2] = 2 * (q.x * q.z + q.w * q.y);
+    m[3] = 2 * (q.x * q.y + q.w * q.z); m[4] = 1 - 2 * (q.x * q.x + q.z * q.z); m[5] = 2 * (q.y * q.z - q.w * q.x);
+    m[6] = 2 * (q.x * q.z - q.w * q.y); m[7] = 2 * (q.y * q.z + q.w * q.x); m[8] = 1 - 2 * (q.x * q.x + q.y * q.y);
+}
+
+// c = a · b（3×3）
+void mul3(const double a[9], const double b[9], double c[9])
+{
+    for (int r = 0; r < 3; ++r) {
+        for (int k = 0; k < 3; ++k) {
+            c[r * 3 + k] = a[r * 3] * b[k] + a[r * 3 + 1] * b[3 + k] + a[r * 3 + 2] * b[6 + k];
+        }
+    }
+}
+
+// 同一矩阵作用于连续一段点（编译器可向量化）
+void transformRun(Point3D* p, int n, const float* m)
+{
+    const float m00 = m[0], m01 = m[1], m02 = m[2], tx = m[3];
+    const float m10 = m[4], m11 = m[5], m12 = m[6], ty = m[7];
+    const float m20 = m[8], m21 = m[9], m22 = m[10], tz = m[11];
+    for (int i = 0; i < n; ++i) {
+        const float x = p[i].x, y = p[i].y, z = p[i].z;
+        p[i].x = m00 * x + m01 * y + m02 * z + tx;
+        p[i].y = m10 * x + m11 * y + m12 * z + ty;
+        p[i].z = m20 * x + m21 * y + m22 * z + tz;
+    }
+}
+
+} // namespace
+
+void PointDeskew::pushImuPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet)
+{
+    if (!isEnabled() || !packet || packet->data_type != kLivoxLidarImuData || packet->dot_num == 0) return;
+    const LivoxLidarImuRawPoint* imu = reinterpret_cast<const LivoxLidarImuRawPoint*>(packet->data);
+    const uint64_t ts = parsePacketTimestamp(packet->timestamp);
+    const uint64_t step = packet->dot_num > 1 ? uint64_t(packet->time_interval) * 100ULL / packet->dot_num : 0;
+
+    QMutexLocker locker(&m_mutex);
+    ImuRing& ring = m_imu[handle];
+    for (uint32_t i = 0; i < packet->dot_num; ++i) {
+        ImuGyroSample& s = ring.samples[ring.head];
+        s.timestamp = ts + i * step;
+        s.gx = imu[i].gyro_x;
+        s.gy = imu[i].gyro_y;
+        s.gz = imu[i].gyro_z;
+        ring.head = (ring.head + 1) % kImuCapacity;
+        if (ring.size < kImuCapacity) ring.size++;
+    }
+}
+
+void PointDeskew::pushImuSample(uint32_t handle, const ImuGyroSample& sample)
+{
+    if (!isEnabled()) return;
+    QMutexLocker locker(&m_mutex);
+    ImuRing& ring = m_imu[handle];
+    ring.samples[ring.head] = sample;
+    ring.head = (ring.head + 1) % kImuCapacity;
+    if (ring.size < kImuCapacity) ring.size++;
+}
+
+bool PointDeskew::buildTable(uint32_t handle, uint64_t begin, uint64_t end, const PointExtrinsic* extrinsic,
+                             uint64_t* slotNs, QVector<float>& table)
+{
+    // 取出覆盖窗口的样本（环形缓冲按到达顺序，即时间顺序）
+    m_scratch.clear();
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_imu.constFind(handle);
+        if (it == m_imu.constEnd()) return false;
+        const ImuRing& ring = it.value();
+        const uint64_t from = begin > kMaxImuGapNs ? begin - kMaxImuGapNs : 0;
+        const int first = (ring.head - ring.size + kImuCapacity) % kImuCapacity;
+        for (int n = 0; n < ring.size; ++n) {
+            const ImuGyroSample& s = ring.samples[(first + n) % kImuCapacity];
+            if (s.timestamp < from) continue;
+            if (s.timestamp > end + kMaxImuGapNs) break;
+            m_scratch.append(s);
+        }
+    }
+    if (m_scratch.isEmpty() || m_scratch.first().timestamp > begin + kMaxImuGapNs ||
+        m_scratch.last().timestamp + kMaxImuGapNs < end) {
+        return false;
+    }
+
+    uint64_t slot = kSlotNs;
+    if ((end - begin) / slot + 2 > uint64_t(kMaxSlots)) slot = (end - begin) / (kMaxSlots - 2) + 1;
+    const int slots = int((end - begin + slot - 1) / slot) + 1;
+    *slotNs = slot;
+
+    // 从 begin 开始积分各 slot 时刻的姿态（角速度取 slot 中点的线性插值）
+    QVector<double> rot(slots * 9);
+    Quat q;
+    toMatrix(q, rot.data());
+    int idx = 0;
+    const double dt = double(slot) * 1e-9;
+    for (int k = 1; k < slots; ++k) {
+        const uint64_t mid = begin + uint64_t(k - 1) * slot + slot / 2;
+        while (idx + 1 < m_scratch.size() && m_scratch[idx + 1].timestamp <= mid) ++idx;
+        const ImuGyroSample& a = m_scratch[idx];
+        float gx = a.gx, gy = a.gy, gz = a.gz;
+        if (idx + 1 < m_scratch.size() && mid > a.timestamp) {
+            const ImuGyroSample& b = m_scratch[idx + 1];
+            const float f = float(double(mid - a.timestamp) / double(b.timestamp - a.timestamp));
+            gx += (b.gx - a.gx) * f;
+            gy += (b.gy - a.gy) * f;
+            gz += (b.gz - a.gz) * f;
+        }
+        q = integrate(q, gx * dt, gy * dt, gz * dt);
+        toMatrix(q, rot.data() + k * 9);
+    }
+
+    // M_k = R_end^T · R_k；有主机外参 [Re|te] 时换算到外参坐标系：Re·M_k·Re^T，平移 te - M'·te
+    const double* rEnd = rot.constData() + (slots - 1) * 9;
+    const double rEndT[9] = { rEnd[0], rEnd[3], rEnd[6], rEnd[1], rEnd[4], rEnd[7], rEnd[2], rEnd[5], rEnd[8] };
+    double re[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+    double reT[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+    double te[3] = { 0, 0, 0 };
+    if (extrinsic) {
+        const float* e = extrinsic->m;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                re[r * 3 + c] = e[r * 4 + c];
+                reT[c * 3 + r] = e[r * 4 + c];
+            }
+            te[r] = e[r * 4 + 3];
+        }
+    }
+
+    table.resize(slots * 12);
+    for (int k = 0; k < slots; ++k) {
+        double m[9], tmp[9];
+        mul3(rEndT, rot.constData() + k * 9, m);
+        if (extrinsic) {
+            mul3(re, m, tmp);
+            mul3(tmp, reT, m);
+        }
+        float* out = table.data() + k * 12;
+        for (int r = 0; r < 3; ++r) {
+            out[r * 4 + 0] = float(m[r * 3 + 0]);
+            out[r * 4 + 1] = float(m[r * 3 + 1]);
+            out[r * 4 + 2] = float(m[r * 3 + 2]);
+            out[r * 4 + 3] = float(te[r] - (m[r * 3] * te[0] + m[r * 3 + 1] * te[1] + m[r * 3 + 2] * te[2]));
+        }
+    }
+    return true;
+}
+
+void PointDeskew::apply(QVector<Point3D>& points, const QVector<PointDeskewSpan>& spans,
+                        const QMap<uint32_t, PointExtrinsic>& extrinsics, uint64_t targetNs)
+{
+    if (!isEnabled() || spans.isEmpty()) return;
+
+    // 每设备时间范围：首点 ~ 最后一个点，记下最新包的 合并时基 - 设备时钟 差值
+    struct Range { uint64_t begin; uint64_t last; uint64_t latest; int64_t toWindowNs; };
+    QMap<uint32_t, Range> ranges;
+    for (const PointDeskewSpan& s : spans) {
+        const uint64_t last = s.timestamp + (s.count > 1 ? uint64_t(s.spanNs) * uint64_t(s.count - 1) / uint64_t(s.count) : 0);
+        const int64_t toWindow = s.windowTime ? int64_t(s.windowTime - s.timestamp) : 0;
+        auto it = ranges.find(s.handle);
+        if (it == ranges.end()) {
+            ranges.insert(s.handle, Range{ s.timestamp, last, s.timestamp, toWindow });
+        } else {
+            it.value().begin = std::min(it.value().begin, s.timestamp);
+            it.value().last = std::max(it.value().last, last);
+            if (s.timestamp >= it.value().latest) {
+                it.value().latest = s.timestamp;
+                it.value().toWindowNs = toWindow;
+            }
+        }
+    }
+
+    uint64_t deskewed = 0;
+    uint64_t skipped = 0;
+    Point3D* base = points.data();
+    for (auto r = ranges.constBegin(); r != ranges.constEnd(); ++r) {
+        const uint32_t handle = r.key();
+        const uint64_t begin = r.value().begin;
+        // 统一目标时刻换算到该设备时钟；窗口末尾取自各设备最新时间，不早于本设备最后一个点
+        uint64_t end = r.value().last;
+        if (targetNs) end = std::max(end, targetNs - uint64_t(r.value().toWindowNs));
+        auto ext = extrinsics.constFind(handle);
+        uint64_t slotNs = kSlotNs;
+        const bool ok = buildTable(handle, begin, end, ext != extrinsics.constEnd() ? &ext.value() : nullptr,
+                                   &slotNs, m_table);
+        const int slots = m_table.size() / 12;
+
+        for (const PointDeskewSpan& s : spans) {
+            if (s.handle != handle || s.count <= 0) continue;
+            if (!ok || s.offset < 0 || s.offset + s.count > points.size()) {
+                skipped += uint64_t(s.count);
+                continue;
+            }
+            // 包内点按时间均匀分布，按 slot 切成若干连续段，每段共用一个矩阵
+            const double step = double(s.spanNs) / double(s.count);
+            const double t0 = double(int64_t(s.timestamp - begin));
+            Point3D* p = base + s.offset;
+            int i = 0;
+            while (i < s.count) {
+                const double t = t0 + step * i;
+                const int slot = std::min(slots - 1, std::max(0, int(std::floor(t / double(slotNs) + 0.5))));
+                int j = s.count;
+                if (step > 0.0 && slot < slots - 1) {
+                    const double boundary = (double(slot) + 0.5) * double(slotNs);
+                    j = std::min(s.count, std::max(i + 1, int(std::ceil((boundary - t0) / step))));
+                }
+                transformRun(p + i, j - i, m_table.constData() + slot * 12);
+                i = j;
+            }
+            deskewed += uint64_t(s.count);
+        }
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_counters.deskewedPoints += deskewed;
+    m_counters.skippedPoints += skipped;
+}
+
+PointDeskewCounters PointDeskew::counters() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_counters;
+}
+
+void PointDeskew::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_imu.clear();
+    m_counters = PointDeskewCounters();
+}
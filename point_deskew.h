@@ -0,0 +1,86 @@
+#ifndef POINT_DESKEW_H
+#define POINT_DESKEW_H
+
+#include "point_types.h"
+#include "point_decode.h"
+#include <QMap>
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+
+extern "C" {
+    #include "livox_lidar_def.h"
+}
+
+// 陀螺仪样本（设备时间戳 ns，角速度 rad/s）
+struct ImuGyroSample {
+    uint64_t timestamp = 0;
+    float gx = 0.0f;
+    float gy = 0.0f;
+    float gz = 0.0f;
+};
+
+// 合并窗口中来自同一数据包的一段点：点 i 的时间为 timestamp + i·spanNs/count
+struct PointDeskewSpan {
+    uint32_t handle = 0;
+    int offset = 0;             // 在合并点集中的起始下标
+    int count = 0;
+    uint64_t timestamp = 0;     // 包时间戳（首点，设备时钟）
+    uint32_t spanNs = 0;        // 包的时间跨度（time_interval × 100ns）
+    uint64_t windowTime = 0;    // 同一时刻在合并时基中的时间（时钟对齐后的时间戳），0 表示与 timestamp 相同
+};
+
+struct PointDeskewCounters {
+    uint64_t deskewedPoints = 0;
+    uint64_t skippedPoints = 0;     // IMU 覆盖不足，保持原样
+};
+
+// 运动去畸变：按包内插值的逐点时间，用 IMU 陀螺仪积分的旋转把窗口内每个点
+// 校正到窗口末尾时刻的传感器姿态（仅旋转，IMU 无法可靠给出平移）。
+// 给定合并时基的目标时刻时，所有设备校正到同一时刻，多雷达拼接不会因各自末尾不同而错位。
+// pushImuPacket() 可在任意线程调用；apply() 在组帧线程调用。
+class PointDeskew
+{
+public:
+    static const int kImuCapacity = 4096;           // 每设备保留的 IMU 样本（200Hz 约 20s）
+    static const uint64_t kSlotNs = 250000;         // 旋转查找表分辨率
+    static const int kMaxSlots = 8192;              // 超长窗口时放大 slot
+    static const uint64_t kMaxImuGapNs = 50000000;  // 窗口末尾允许的 IMU 缺口（保持最后角速度外推）
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // 追加 IMU 包内样本（关闭时直接返回）
+    void pushImuPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet);
+    void pushImuSample(uint32_t handle, const ImuGyroSample& sample);
+
+    // 对合并点集逐段去畸变；extrinsics 为解码时已应用的主机外参（旋转在传感器坐标系中进行）
+    // 时间均为设备自身时钟，每设备的时间范围取自 spans；targetNs 为合并时基中的目标时刻
+    // （窗口末尾），经各设备 windowTime - timestamp 换算回设备时钟；为 0 时校正到各设备最后一个点
+    void apply(QVector<Point3D>& points, const QVector<PointDeskewSpan>& spans,
+               const QMap<uint32_t, PointExtrinsic>& extrinsics, uint64_t targetNs = 0);
+
+    PointDeskewCounters counters() const;
+    void reset();
+
+private:
+    struct ImuRing {
+        QVector<ImuGyroSample> samples = QVector<ImuGyroSample>(kImuCapacity);
+        int head = 0;       // 下一个写入位置
+        int size = 0;
+    };
+
+    // 构建 [begin, end] 的查找表：slot k 为把 begin + k·slotNs 时刻的点变换到 end 时刻的 3×4 矩阵
+    bool buildTable(uint32_t handle, uint64_t begin, uint64_t end, const PointExtrinsic* extrinsic,
+                    uint64_t* slotNs, QVector<float>& table);
+
+    std::atomic<bool> m_enabled{false};
+    mutable QMutex m_mutex;
+    QMap<uint32_t, ImuRing> m_imu;
+    QVector<ImuGyroSample> m_scratch;
+    QVector<float> m_table;
+    PointDeskewCounters m_counters;
+};
+
+#endif // POINT_DESKEW_H
@@ -0,0 +1,196 @@
+#include "point_export.h"
+#include <QFile>
+#include <QTextStream>
+#include <QByteArray>
+#include <QtEndian>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+static inline quint16 clampU16(int v) { return quint16(std::max(0, std::min(65535, v))); }
+
+bool savePointsAsLAS(const QString& filePath, const QVector<Point3D>& points)
+{
+    QFile f(filePath);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+
+    // LAS 1.2 header (little-endian), Point Data Record Format 0
+    // We will use scale (0.001) and offset 0 for simplicity; compute bbox
+    double scaleX = 0.001, scaleY = 0.001, scaleZ = 0.001;
+    double minX = std::numeric_limits<double>::max();
+    double minY = std::numeric_limits<double>::max();
+    double minZ = std::numeric_limits<double>::max();
+    double maxX = -std::numeric_limits<double>::max();
+    double maxY = -std::numeric_limits<double>::max();
+    double maxZ = -std::numeric_limits<double>::max();
+    for (const Point3D& p : points) {
+        if (p.x < minX) minX = p.x; if (p.x > maxX) maxX = p.x;
+        if (p.y < minY) minY = p.y; if (p.y > maxY) maxY = p.y;
+        if (p.z < minZ) minZ = p.z; if (p.z > maxZ) maxZ = p.z;
+    }
+    double offX = 0.0, offY = 0.0, offZ = 0.0; // offsets set to 0
+
+    QByteArray header(227, 0); // LAS 1.2 header size
+    // File Signature "LASF"
+    header[0] = 'L'; header[1] = 'A'; header[2] = 'S'; header[3] = 'F';
+    // File Source ID, Global Encoding -> leave 0
+    // Project ID GUIDs -> zeros
+    // Version Major/Minor
+    header[24] = 1; // version major
+    header[25] = 2; // version minor
+    // System Identifier (32 bytes)
+    QByteArray sys = QByteArray("LivoxViewerQT"); sys = sys.leftJustified(32, '\0', true);
+    std::copy(sys.begin(), sys.end(), header.begin() + 26);
+    // Generating Software (32 bytes)
+    QByteArray gen = QByteArray("LVX"); gen = gen.leftJustified(32, '\0', true);
+    std::copy(gen.begin(), gen.end(), header.begin() + 58);
+    // File Creation Day/Year -> leave 0
+    // Header Size
+    qToLittleEndian<quint16>(227, reinterpret_cast<uchar*>(header.data() + 94));
+    // Offset to point data: header (227) + no VLRs (0)
+    qToLittleEndian<quint32>(227, reinterpret_cast<uchar*>(header.data() + 96));
+    // Number of Variable Length Records
+    qToLittleEndian<quint32>(0, reinterpret_cast<uchar*>(header.data() + 100));
+    // Point Data Format
+    header[104] = 0; // format 0
+    // Point Data Record Length (bytes) -> 20 for format 0
+    qToLittleEndian<quint16>(20, reinterpret_cast<uchar*>(header.data() + 105));
+    // Legacy number of point records
+    qToLittleEndian<quint32>(static_cast<quint32>(points.size()), reinterpret_cast<uchar*>(header.data() + 107));
+    // Legacy number of points by return (5 x uint32) -> set first = count
+    qToLittleEndian<quint32>(static_cast<quint32>(points.size()), reinterpret_cast<uchar*>(header.data() + 111));
+    // Scale Factors (X,Y,Z) at offsets 131,139,147 as doubles
+    qToLittleEndian<double>(scaleX, reinterpret_cast<uchar*>(header.data() + 131));
+    qToLittleEndian<double>(scaleY, reinterpret_cast<uchar*>(header.data() + 139));
+    qToLittleEndian<double>(scaleZ, reinterpret_cast<uchar*>(header.data() + 147));
+    // Offsets (X,Y,Z) as doubles
+    qToLittleEndian<double>(offX, reinterpret_cast<uchar*>(header.data() + 155));
+    qToLittleEndian<double>(offY, reinterpret_cast<uchar*>(header.data() + 163));
+    qToLittleEndian<double>(offZ, reinterpret_cast<uchar*>(header.data() + 171));
+    // Max/Min (X,Y,Z) as doubles
+    qToLittleEndian<double>(maxX, reinterpret_cast<uchar*>(header.data() + 179));
+    qToLittleEndian<double>(minX, reinterpret_cast<uchar*>(header.data() + 187));
+    qToLittleEndian<double>(maxY, reinterpret_cast<uchar*>(header.data() + 195));
+    qToLittleEndian<double>(minY, reinterpret_cast<uchar*>(header.data() + 203));
+    qToLittleEndian<double>(maxZ, reinterpret_cast<uchar*>(header.data() + 211));
+    qToLittleEndian<double>(minZ, reinterpret_cast<uchar*>(header.data() + 219));
+
+    if (f.write(header) != header.size()) { f.close(); return false; }
+
+    // Write points (Format 0): X,Y,Z as int32, Intensity uint16, flags+classification etc.
+    // 记录先组装到整块缓冲区再一次写入，避免逐点 write 的系统调用开销
+    QByteArray body(points.size() * 20, 0);
+    uchar* rec = reinterpret_cast<uchar*>(body.data());
+    for (const Point3D& p : points) {
+        // Convert to scaled integer: integer = round((coord - offset)/scale)
+        qint32 xi = qint32(std::llround((p.x - offX) / scaleX));
+        qint32 yi = qint32(std::llround((p.y - offY) / scaleY));
+        qint32 zi = qint32(std::llround((p.z - offZ) / scaleZ));
+        qToLittleEndian<qint32>(xi, rec + 0);
+        qToLittleEndian<qint32>(yi, rec + 4);
+        qToLittleEndian<qint32>(zi, rec + 8);
+        // Intensity
+        qToLittleEndian<quint16>(clampU16(int(p.reflectivity)), rec + 12);
+        // Return flags (1), classification (1), scan angle (1), user data (1) -> put tag into user data
+        rec[14] = 1;             // return number bits -> 1
+        rec[15] = 1;             // classification -> unclassified
+        rec[16] = 0;             // scan angle rank
+        rec[17] = p.tag;         // user data stores tag
+        // Point source ID (uint16)
+        qToLittleEndian<quint16>(0, rec + 18);
+        rec += 20;
+    }
+    if (f.write(body) != body.size()) { f.close(); return false; }
+
+    f.close();
+    return true;
+}
+
+bool savePointsAsPCD(const QString& filePath, const QVector<Point3D>& points, bool binary)
+{
+    QFile f(filePath);
+    QIODevice::OpenMode mode = QIODevice::WriteOnly | QIODevice::Truncate;
+    if (!binary) mode |= QIODevice::Text;
+    if (!f.open(mode)) {
+        return false;
+    }
+    QByteArray header;
+    {
+        QTextStream out(&header);
+        // PCD header with reflectivity(intensity) and tag
+        out << "# .PCD v0.7 - Point Cloud Data file\n";
+        out << "VERSION 0.7\n";
+        out << "FIELDS x y z intensity tag\n";
+        out << "SIZE 4 4 4 4 4\n";
+        out << "TYPE F F F F F\n";
+        out << "COUNT 1 1 1 1 1\n";
+        out << "WIDTH " << points.size() << "\n";
+        out << "HEIGHT 1\n";
+        out << "VIEWPOINT 0 0 0 1 0 0 0\n";
+        out << "POINTS " << points.size() << "\n";
+        out << (binary ? "DATA binary\n" : "DATA ascii\n");
+    }
+    if (f.write(header) != header.size()) { f.close(); return false; }
+
+    if (binary) {
+        // 二进制：每点 5 个 float，一次性组装后写入
+        QByteArray body(points.size() * 5 * int(sizeof(float)), Qt::Uninitialized);
+        float* dst = reinterpret_cast<float*>(body.data());
+        for (const Point3D& p : points) {
+            *dst++ = p.x;
+            *dst++ = p.y;
+            *dst++ = p.z;
+            *dst++ = float(p.reflectivity);
+            *dst++ = float(p.tag);
+        }
+        const bool ok = f.write(body) == body.size();
+        f.close();
+        return ok;
+    }
+
+    QTextStream out(&f);
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(6);
+    for (const Point3D& p : points) {
+        out << p.x << ' ' << p.y << ' ' << p.z << ' ' << int(p.reflectivity) << ' ' << int(p.tag) << "\n";
+    }
+    f.close();
+    return true;
+}
+
+bool savePointsAsPLY(const QString& filePath, const QVector<Point3D>& points)
+{
+    QFile f(filePath);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    // binary_little_endian，x/y/z 为 float，intensity/tag 为 uchar
+    QByteArray header;
+    header += "ply\n";
+    header += "format binary_little_endian 1.0\n";
+    header += "comment generated by LivoxViewerQT\n";
+    header += "element vertex " + QByteArray::number(points.size()) + "\n";
+    header += "property float x\n";
+    header += "property float y\n";
+    header += "property float z\n";
+    header += "property uchar intensity\n";
+    header += "property uchar tag\n";
+    header += "end_header\n";
+    if (f.write(header) != header.size()) { f.close(); return false; }
+
+    const int recSize = 3 * int(sizeof(float)) + 2;
+    QByteArray body(points.size() * recSize, Qt::Uninitialized);
+    uchar* dst = reinterpret_cast<uchar*>(body.data());
+    for (const Point3D& p : points) {
+        qToLittleEndian<float>(p.x, dst + 0);
+        qToLittleEndian<float>(p.y, dst + 4);
+        qToLittleEndian<float>(p.z, dst + 8);
+        dst[12] = p.reflectivity;
+        dst[13] = p.tag;
+        dst += recSize;
+    }
+    const bool ok = f.write(body) == body.size();
+    f.close();
+    return ok;
+}
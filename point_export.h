@@ -0,0 +1,12 @@
+#ifndef POINT_EXPORT_H
+#define POINT_EXPORT_H
+
+#include "point_types.h"
+#include <QString>
+
+// 点云文件导出（PCD/LAS/PLY），GUI 保存与离线转换工具共用
+bool savePointsAsPCD(const QString& filePath, const QVector<Point3D>& points, bool binary = false);
+bool savePointsAsLAS(const QString& filePath, const QVector<Point3D>& points);
+bool savePointsAsPLY(const QString& filePath, const QVector<Point3D>& points);
+
+#endif // POINT_EXPORT_H
@@ -0,0 +1,34 @@
+#include "point_filter.h"
+
+void applyTagNoiseFilter(QVector<Point3D>& points, const QVector<uint8_t>& tags,
+                         bool highlight, bool remove)
+{
+    if (points.isEmpty() || tags.isEmpty() || (!highlight && !remove)) {
+        return;
+    }
+
+    // tag 只有 256 种取值，先建查找表
+    bool isNoiseTag[256] = {};
+    for (uint8_t t : tags) isNoiseTag[t] = true;
+
+    if (!remove) {
+        for (Point3D& p : points) {
+            if (isNoiseTag[p.tag]) {
+                // 高亮噪点（红色）
+                p.r = 1.0f; p.g = 0.0f; p.b = 0.0f;
+            }
+        }
+        return;
+    }
+
+    // 剔除噪点：原地压缩，保持点的相对顺序
+    Point3D* data = points.data();
+    int kept = 0;
+    for (int i = 0; i < points.size(); ++i) {
+        if (!isNoiseTag[data[i].tag]) {
+            if (kept != i) data[kept] = data[i];
+            kept++;
+        }
+    }
+    points.resize(kept);
+}
@@ -0,0 +1,10 @@
+#ifndef POINT_FILTER_H
+#define POINT_FILTER_H
+
+#include "point_types.h"
+
+// 基于 tag 的噪点处理：命中 tags 的点可高亮（红色）或剔除，原地修改
+void applyTagNoiseFilter(QVector<Point3D>& points, const QVector<uint8_t>& tags,
+                         bool highlight, bool remove);
+
+#endif // POINT_FILTER_H
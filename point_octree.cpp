@@ -0,0 +1,209 @@
+#include "point_octree.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+namespace {
+
+const int kWords = PointOctree::kGrid * PointOctree::kGrid * PointOctree::kGrid / 32;
+
+// 从 MVP 提取六个裁剪平面（a,b,c,d），点在平面内侧时 a·x+b·y+c·z+d >= 0
+void frustumPlanes(const float* m, float planes[6][4])
+{
+    for (int i = 0; i < 3; ++i) {
+        for (int k = 0; k < 4; ++k) {
+            const float row3 = m[k * 4 + 3];
+            const float rowI = m[k * 4 + i];
+            planes[i * 2][k] = row3 + rowI;
+            planes[i * 2 + 1][k] = row3 - rowI;
+        }
+    }
+}
+
+bool boxOutside(const float planes[6][4], const float center[3], float half)
+{
+    for (int i = 0; i < 6; ++i) {
+        const float* p = planes[i];
+        // 盒子在平面法向上最靠外的顶点
+        const float x = center[0] + (p[0] >= 0.0f ? half : -half);
+        const float y = center[1] + (p[1] >= 0.0f ? half : -half);
+        const float z = center[2] + (p[2] >= 0.0f ? half : -half);
+        if (p[0] * x + p[1] * y + p[2] * z + p[3] < 0.0f) return true;
+    }
+    return false;
+}
+
+// 节点点间距（网格边长）在屏幕上的像素数
+float projectedSpacing(const OctreeView& view, const float center[3], float half)
+{
+    const float dx = center[0] - view.eye[0];
+    const float dy = center[1] - view.eye[1];
+    const float dz = center[2] - view.eye[2];
+    const float radius = half * 1.7320508f;
+    const float distance = std::max(std::sqrt(dx * dx + dy * dy + dz * dz) - radius, 0.01f);
+    return 2.0f * half / float(PointOctree::kGrid) * view.projScale / distance;
+}
+
+} // namespace
+
+PointOctree::PointOctree(float halfSize)
+    : m_halfSize(halfSize)
+{
+    clear();
+}
+
+int PointOctree::addNode(const float center[3], float halfSize, int depth)
+{
+    Node n;
+    n.center[0] = center[0];
+    n.center[1] = center[1];
+    n.center[2] = center[2];
+    n.halfSize = halfSize;
+    n.depth = depth;
+    if (depth >= kMaxDepth) n.occupied.fill(0, kWords);
+    m_nodes.append(n);
+    return m_nodes.size() - 1;
+}
+
+int PointOctree::child(int node, int octant)
+{
+    int c = m_nodes[node].children[octant];
+    if (c >= 0) return c;
+    const Node& parent = m_nodes[node];
+    const float h = parent.halfSize * 0.5f;
+    const float center[3] = {
+        parent.center[0] + ((octant & 1) ? h : -h),
+        parent.center[1] + ((octant & 2) ? h : -h),
+        parent.center[2] + ((octant & 4) ? h : -h)
+    };
+    const int depth = parent.depth + 1;
+    c = addNode(center, h, depth);     // 可能使 parent 引用失效
+    m_nodes[node].children[octant] = c;
+    return c;
+}
+
+bool PointOctree::insertPoint(int node, const Point3D& p)
+{
+    for (;;) {
+        Node& n = m_nodes[node];
+        if (n.leaf && n.depth < kMaxDepth) {
+            n.points.append(p);
+            n.version++;
+            if (n.points.size() > kSplitThreshold) split(node);
+            return true;
+        }
+        const float scale = float(kGrid) / (2.0f * n.halfSize);
+        const int cx = std::min(kGrid - 1, std::max(0, int((p.x - n.center[0] + n.halfSize) * scale)));
+        const int cy = std::min(kGrid - 1, std::max(0, int((p.y - n.center[1] + n.halfSize) * scale)));
+        const int cz = std::min(kGrid - 1, std::max(0, int((p.z - n.center[2] + n.halfSize) * scale)));
+        const int cell = (cz * kGrid + cy) * kGrid + cx;
+        uint32_t& word = n.occupied[cell >> 5];
+        const uint32_t bit = 1u << (cell & 31);
+        if (!(word & bit)) {
+            word |= bit;
+            n.points.append(p);
+            n.version++;
+            return true;
+        }
+        if (n.depth >= kMaxDepth) return false;
+        const int octant = (cx >= kGrid / 2 ? 1 : 0) | (cy >= kGrid / 2 ? 2 : 0) | (cz >= kGrid / 2 ? 4 : 0);
+        node = child(node, octant);
+    }
+}
+
+// 叶子转为内部节点：按到达顺序重新插入，先占网格的留下，其余下沉到子节点
+void PointOctree::split(int node)
+{
+    QVector<Point3D> points;
+    {
+        Node& n = m_nodes[node];
+        points.swap(n.points);
+        n.points.reserve(points.size() / 4);
+        n.occupied.fill(0, kWords);
+        n.leaf = false;
+        n.version++;
+    }
+    for (const Point3D& p : points) {
+        if (!insertPoint(node, p)) {
+            m_points--;
+            m_duplicates++;
+        }
+    }
+}
+
+void PointOctree::insert(const Point3D* points, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        const Point3D& p = points[i];
+        if (!(std::fabs(p.x) < m_halfSize && std::fabs(p.y) < m_halfSize && std::fabs(p.z) < m_halfSize)) {
+            m_dropped++;
+            continue;
+        }
+        if (m_points >= m_pointLimit) {
+            m_dropped += uint64_t(count - i);
+            return;
+        }
+        if (insertPoint(0, p)) {
+            m_points++;
+        } else {
+            m_duplicates++;
+        }
+    }
+}
+
+void PointOctree::clear()
+{
+    m_nodes.clear();
+    m_points = 0;
+    m_duplicates = 0;
+    m_dropped = 0;
+    const float center[3] = { 0.0f, 0.0f, 0.0f };
+    addNode(center, m_halfSize, 0);
+}
+
+void PointOctree::select(const OctreeView& view, OctreeSelection& out) const
+{
+    out.nodes.clear();
+    out.points = 0;
+    out.culled = 0;
+    if (!view.mvp || m_points == 0) return;
+
+    float planes[6][4];
+    frustumPlanes(view.mvp, planes);
+
+    // 投影间距大（离相机近、节点粗）的优先
+    std::priority_queue<std::pair<float, int>> queue;
+    queue.push(std::make_pair(projectedSpacing(view, m_nodes[0].center, m_nodes[0].halfSize), 0));
+    while (!queue.empty()) {
+        const float spacing = queue.top().first;
+        const int index = queue.top().second;
+        queue.pop();
+        const Node& n = m_nodes[index];
+        if (boxOutside(planes, n.center, n.halfSize)) {
+            out.culled++;
+            continue;
+        }
+        if (view.pointBudget > 0 && out.points + n.points.size() > view.pointBudget) break;
+        if (!n.points.isEmpty()) {
+            out.nodes.append(index);
+            out.points += n.points.size();
+        }
+        if (spacing <= view.minSpacingPx) continue;
+        for (int c : n.children) {
+            if (c < 0) continue;
+            const Node& ch = m_nodes[c];
+            queue.push(std::make_pair(projectedSpacing(view, ch.center, ch.halfSize), c));
+        }
+    }
+}
+
+OctreeCounters PointOctree::counters() const
+{
+    OctreeCounters c;
+    c.nodes = m_nodes.size();
+    c.points = m_points;
+    c.duplicates = m_duplicates;
+    c.dropped = m_dropped;
+    return c;
+}
@@ -0,0 +1,85 @@
+#ifndef POINT_OCTREE_H
+#define POINT_OCTREE_H
+
+#include "point_types.h"
+#include <QVector>
+#include <cstdint>
+
+// 节点选择的视图参数
+struct OctreeView {
+    const float* mvp = nullptr;     // 列主序 4×4（QMatrix4x4::constData）
+    float eye[3] = { 0.0f, 0.0f, 0.0f };    // 相机世界坐标
+    float projScale = 1.0f;         // 视口高度 / (2·tan(fovy/2))：距离 1m 处 1m 对应的像素数
+    float minSpacingPx = 1.5f;      // 节点点间距的投影小于此值时不再细分
+    int pointBudget = 0;            // 选中节点的总点数上限（0 不限）
+};
+
+struct OctreeSelection {
+    QVector<int> nodes;             // 按投影点间距从大到小（粗到细）
+    int points = 0;
+    int culled = 0;                 // 视锥外的节点
+};
+
+struct OctreeCounters {
+    int nodes = 0;
+    uint64_t points = 0;
+    uint64_t duplicates = 0;        // 落在最深层已占用网格（重复扫描同一位置）
+    uint64_t dropped = 0;           // 超出范围或超出点数上限
+};
+
+// 累积点云的八叉树 LOD：内部节点按 kGrid³ 网格抽样，每格保留首个到达的点，
+// 已占用的点下沉到子节点，因此父节点是子树的均匀稀疏版本，绘制时选中节点的并集即为某一密度的点云。
+// 叶子节点不抽样，超过 kSplitThreshold 个点时分裂为内部节点（保证每个节点点数足够多，GPU 绘制批次少）。
+// 数据块到达时增量插入，无需重建；最深层网格已占用的点视为重复扫描丢弃，静止场景的内存有上界。
+// 根节点为以原点为中心的固定立方体（雷达量程内），范围外的点丢弃。非线程安全。
+class PointOctree
+{
+public:
+    static const int kGrid = 32;            // 节点抽样网格（每轴）
+    static const int kMaxDepth = 13;        // 半边长 1024m 时最深层节点 0.25m、网格约 8mm
+    static const int kSplitThreshold = 20000;
+    static const uint64_t kDefaultPointLimit = 30000000ULL;
+
+    explicit PointOctree(float halfSize = 1024.0f);
+
+    void setPointLimit(uint64_t limit) { m_pointLimit = limit; }
+    uint64_t pointLimit() const { return m_pointLimit; }
+    void insert(const Point3D* points, int count);
+    void insert(const QVector<Point3D>& points) { insert(points.constData(), points.size()); }
+    void clear();
+
+    // 视锥剔除 + 屏幕空间误差：从根开始按投影点间距优先细分，直到间距足够小或达到点数上限
+    void select(const OctreeView& view, OctreeSelection& out) const;
+
+    int nodeCount() const { return m_nodes.size(); }
+    const QVector<Point3D>& nodePoints(int node) const { return m_nodes[node].points; }
+    // 节点点集变化时递增（GPU 缓冲据此判断是否需要重新上传）
+    uint32_t nodeVersion(int node) const { return m_nodes[node].version; }
+    OctreeCounters counters() const;
+
+private:
+    struct Node {
+        float center[3] = { 0.0f, 0.0f, 0.0f };
+        float halfSize = 0.0f;
+        int depth = 0;
+        int children[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+        bool leaf = true;               // 叶子不抽样；最深层节点始终按网格去重
+        QVector<Point3D> points;
+        QVector<uint32_t> occupied;     // kGrid³ 位图（内部节点与最深层节点）
+        uint32_t version = 0;
+    };
+
+    int addNode(const float center[3], float halfSize, int depth);
+    int child(int node, int octant);
+    bool insertPoint(int node, const Point3D& p);   // 返回 false 表示为重复点
+    void split(int node);
+
+    float m_halfSize;
+    uint64_t m_pointLimit = kDefaultPointLimit;
+    QVector<Node> m_nodes;
+    uint64_t m_points = 0;
+    uint64_t m_duplicates = 0;
+    uint64_t m_dropped = 0;
+};
+
+#endif // POINT_OCTREE_H
@@ -0,0 +1,47 @@
+#include "point_select.h"
+#include <algorithm>
+
+QVector<Point3D> selectPointsInAabb(const QVector<Point3D>& points, const float min[3], const float max[3], int maxPoints)
+{
+    QVector<Point3D> result;
+    result.reserve(std::min(maxPoints, int(points.size())));
+    for (const Point3D& p : points) {
+        if (p.x >= min[0] && p.x <= max[0] &&
+            p.y >= min[1] && p.y <= max[1] &&
+            p.z >= min[2] && p.z <= max[2]) {
+            result.push_back(p);
+            if (result.size() >= maxPoints) break;
+        }
+    }
+    return result;
+}
+
+QVector<Point3D> selectPointsInScreenRect(const QVector<Point3D>& points, const ScreenSelection& sel, int maxPoints)
+{
+    QVector<Point3D> result;
+    if (!sel.mvp) return result;
+    const float* m = sel.mvp;
+    const float* mv = sel.modelView;
+    result.reserve(std::min(maxPoints, int(points.size())));
+    for (const Point3D& p : points) {
+        // clip = mvp * (x, y, z, 1)
+        const float cw = m[3] * p.x + m[7] * p.y + m[11] * p.z + m[15];
+        if (cw == 0.0f) continue;
+        const float cx = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
+        const float cy = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
+        float sx = (cx / cw * 0.5f + 0.5f) * sel.viewportW;
+        float sy = (1.0f - (cy / cw * 0.5f + 0.5f)) * sel.viewportH;
+        if (sel.pixelSnap) {
+            sx = float(int(sx));
+            sy = float(int(sy));
+        }
+        if (sx < sel.left || sx > sel.right || sy < sel.top || sy > sel.bottom) continue;
+        if (mv) {
+            const float vz = mv[2] * p.x + mv[6] * p.y + mv[10] * p.z + mv[14];
+            if (vz < sel.viewZMin || vz > sel.viewZMax) continue;
+        }
+        result.push_back(p);
+        if (result.size() >= maxPoints) break;
+    }
+    return result;
+}
@@ -0,0 +1,26 @@
+#ifndef POINT_SELECT_H
+#define POINT_SELECT_H
+
+#include "point_types.h"
+
+// 框选查询（不依赖 OpenGL），PointCloudWidget 与基准测试共用
+
+// 屏幕矩形选择参数；矩阵为列主序 4x4，与 QMatrix4x4::constData() 布局一致
+struct ScreenSelection {
+    const float* mvp = nullptr;
+    const float* modelView = nullptr;   // 非空时按视空间深度 [viewZMin, viewZMax] 裁剪
+    float viewportW = 0.0f;
+    float viewportH = 0.0f;
+    float left = 0.0f, top = 0.0f, right = 0.0f, bottom = 0.0f;  // 含边界
+    float viewZMin = 0.0f;
+    float viewZMax = 0.0f;
+    bool pixelSnap = false;             // 屏幕坐标先取整再判断（与 QRect::contains 一致）
+};
+
+// 世界坐标包围盒内的点，最多返回 maxPoints 个
+QVector<Point3D> selectPointsInAabb(const QVector<Point3D>& points, const float min[3], const float max[3], int maxPoints);
+
+// 投影后落在屏幕矩形内的点，最多返回 maxPoints 个
+QVector<Point3D> selectPointsInScreenRect(const QVector<Point3D>& points, const ScreenSelection& selection, int maxPoints);
+
+#endif // POINT_SELECT_H
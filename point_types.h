@@ -0,0 +1,78 @@
+#ifndef POINT_TYPES_H
+#define POINT_TYPES_H
+
+#include <QVector>
+#include <cstdint>
+
+// 点云数据与文件格式的公共定义（不依赖 Widgets/OpenGL，供离线工具复用）
+
+#pragma pack(push, 1)
+struct LVX2PublicHeader {
+    char signature[16] = "livox_tech";
+    uint8_t version_a = 2;
+    uint8_t version_b = 0;
+    uint8_t version_c = 0;
+    uint8_t version_d = 0;
+    uint32_t magic_code = 0xAC0EA767;
+};
+
+struct LVX2PrivateHeader {
+    uint32_t frame_duration = 50;  // ms
+    uint8_t device_count = 1;
+};
+
+struct LVX2DeviceInfo {
+    char lidar_sn[16] = {};
+    char hub_sn[16] = {};
+    uint32_t lidar_id = 0;
+    uint8_t lidar_type = 247;
+    uint8_t device_type = 9;
+    uint8_t extrinsic_enable = 1;
+    float roll = 0.0f;
+    float pitch = 0.0f;
+    float yaw = 0.0f;
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+struct LVX2FrameHeader {
+    uint64_t current_offset = 0;
+    uint64_t next_offset = 0;
+    uint64_t frame_index = 0;
+};
+
+struct LVX2PackageHeader {
+    uint8_t version = 0;
+    uint32_t lidar_id = 0;
+    uint8_t lidar_type = 8;
+    uint8_t timestamp_type = 0;
+    uint64_t timestamp = 0;
+    uint16_t udp_counter = 0;
+    uint8_t data_type = 0;
+    uint32_t data_length = 0;
+    uint8_t frame_counter = 0;
+    uint8_t reserve[4] = {0};
+};
+#pragma pack(pop)
+
+// 点云数据结构（tag 为雷达原始值，原样写入导出文件）
+struct Point3D {
+    float x, y, z;
+    float r, g, b;
+    uint8_t reflectivity;
+    uint8_t tag;
+};
+
+struct PointCloudFrame {
+    QVector<Point3D> points;
+    uint64_t timestamp;
+    uint32_t device_handle;
+    uint32_t timeSpanNs = 0;        // 包内点的时间跨度（time_interval），点按序号均匀分布
+    uint64_t alignedTimestamp = 0;  // 映射到统一时基后的时间戳（ClockAligner），0 表示与 timestamp 相同
+    uint64_t hostArrivalNs = 0;     // 主机收到数据包的时间（hostMonotonicNs），0 表示未知
+    uint64_t hostDecodedNs = 0;     // 解码完成时间
+    bool crcFailed = false;         // 数据包 CRC 校验失败（PacketCrcTag 模式下保留的包）
+};
+
+#endif // POINT_TYPES_H
@@ -1,4 +1,7 @@
 #include "mainwindow.h"
+#include "point_export.h"
+#include "point_filter.h"
+#include "raw_capture.h"
 #include <algorithm>
 #include <limits>
 #include <QColorDialog>
@@ -17,6 +20,9 @@
 #include <QSpinBox>
 #include <QMessageBox>
 #include <QDateTime>
+#include <QtCharts/QLogValueAxis>
+#include <QFileInfo>
+#include <QHeaderView>
 #include <QtEndian>
 #include <cstring>
 
@@ -95,6 +101,7 @@ void MainWindow::onCaptureTick()
         } else if (currentCapture == CaptureLVX2) {
             stopLvx2Recording(true);
         } else if (currentCapture == CaptureIMU) {
+            drainImuCsv();
             {
                 QMutexLocker lk(&imuCsvMutex);
                 if (imuCsvFile.isOpen()) imuCsvFile.flush();
@@ -112,6 +119,7 @@ void MainWindow::onCaptureTick()
         return;
     }
     //statusLabelBar->setText("数据采集中");
+    if (currentCapture == CaptureIMU) drainImuCsv();
 
     int total = captureTotalSeconds > 0 ? captureTotalSeconds : (captureDurationSpin ? captureDurationSpin->value() : 1);
     int done = total - captureSecondsRemaining;
@@ -158,7 +166,7 @@ void MainWindow::onGpsTick()
     QString payload = QString("GPRMC,%1,A,%2,N,%3,E,0.0,0.0,%4,,,").arg(timeStr).arg(lat).arg(lon).arg(dateStr);
     QString sentence = "$" + payload + nmeaChecksum(payload) + "\r\n";
     // 打印到日志区域
-    logMessage(QString("GPS模拟报文: %1").arg(sentence.trimmed()));
+    logMessage(QString("GPS模拟报文: %1").arg(sentence.trimmed()), LogInfo, "gps-sim");
     QByteArray rmc = sentence.toLatin1();
     SetLivoxLidarRmcSyncTime(currentDevice->handle, rmc.constData(), static_cast<uint16_t>(rmc.size()), nullptr, nullptr);
 }
@@ -180,11 +188,12 @@ QString MainWindow::buildImuAscii(double gx, double gy, double gz, double ax, do
 void MainWindow::onImuDisplayButtonClicked()
 {
     // Toggle 2 Hz text-only updater
-    if (imuDisplayRunning.exchange(!imuDisplayRunning.load())) {
-        // turned off
-        if (imuDisplayThread.joinable()) {
-            imuDisplayThread.detach(); // avoid blocking GUI
-        }
+    if (!imuDisplayTimer) {
+        imuDisplayTimer = new QTimer(this);
+        connect(imuDisplayTimer, &QTimer::timeout, this, &MainWindow::onImuDisplayTick);
+    }
+    if (imuDisplayTimer->isActive()) {
+        imuDisplayTimer->stop();
         if (imuAsciiLabel) {
             imuAsciiLabel->setText(buildImuAscii(0.0,0.0,0.0,0.0,0.0,0.0));
         }
@@ -193,33 +202,23 @@ void MainWindow::onImuDisplayButtonClicked()
     }
 
     if (imuDisplayButton) imuDisplayButton->setText("停止IMU显示");
+    imuDisplayTimer->start(500);
+    onImuDisplayTick();
+}
 
-    // Start or restart text updater thread (2 Hz)
-    if (imuDisplayThread.joinable()) {
-        imuDisplayThread.detach();
+void MainWindow::onImuDisplayTick()
+{
+    // 当前设备的最新样本（无锁读取）；未选中设备时取第一个有 IMU 数据的设备
+    uint32_t handle = currentDevice ? currentDevice->handle : 0;
+    if (!imuHistory.ring(handle)) {
+        const QVector<uint32_t> handles = imuHistory.devices();
+        if (handles.isEmpty()) return;
+        handle = handles.first();
     }
-    imuDisplayThread = std::thread([this]() {
-        while (imuDisplayRunning.load()) {
-            float gx=0, gy=0, gz=0, ax=0, ay=0, az=0; bool have=false;
-            {
-                QMutexLocker lk(&imuSampleMutex);
-                if (latestImu.have) {
-                    gx = latestImu.gx; gy = latestImu.gy; gz = latestImu.gz;
-                    ax = latestImu.ax; ay = latestImu.ay; az = latestImu.az;
-                    have = true;
-                }
-            }
-            if (have) {
-                QString text = buildImuAscii(gx, gy, gz, ax, ay, az);
-                QMetaObject::invokeMethod(this, [this, text]() {
-                    if (imuAsciiLabel) imuAsciiLabel->setText(text);
-                });
-            }
-            for (int i=0; i<10 && imuDisplayRunning.load(); ++i) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(50));
-            }
-        }
-    });
+    ImuSample s;
+    if (!imuHistory.latest(handle, &s) || !imuAsciiLabel) return;
+    imuAsciiLabel->setText(buildImuAscii(s.value[ImuGyroX], s.value[ImuGyroY], s.value[ImuGyroZ],
+                                         s.value[ImuAccX], s.value[ImuAccY], s.value[ImuAccZ]));
 }
 
 void MainWindow::onActionShowImuCharts()
@@ -235,36 +234,40 @@ void MainWindow::onActionShowImuCharts()
     imuChartWindow->setWindowTitle("IMU数据曲线");
     QVBoxLayout* layout = new QVBoxLayout(imuChartWindow);
 
+    // 时间窗口（缓冲保留约 10 分钟）
+    QSettings settings("Livox", "LivoxViewerQT");
+    QHBoxLayout* top = new QHBoxLayout();
+    top->addWidget(new QLabel("时间窗口(s):", imuChartWindow));
+    imuWindowSpin = new QSpinBox(imuChartWindow);
+    imuWindowSpin->setRange(5, 600);
+    imuWindowSpin->setSingleStep(10);
+    imuWindowSpin->setValue(settings.value("imu/chartWindow", 10).toInt());
+    top->addWidget(imuWindowSpin);
+    top->addSpacing(16);
+    imuChartInfoLabel = new QLabel(imuChartWindow);
+    top->addWidget(imuChartInfoLabel);
+    top->addStretch();
+    layout->addLayout(top);
+    connect(imuWindowSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [](int v) {
+        QSettings("Livox", "LivoxViewerQT").setValue("imu/chartWindow", v);
+    });
+
     // Gyro chart
     gyroChart = new QChart();
-    gyroSeriesX = new QLineSeries(); gyroSeriesX->setName("gx");
-    gyroSeriesY = new QLineSeries(); gyroSeriesY->setName("gy");
-    gyroSeriesZ = new QLineSeries(); gyroSeriesZ->setName("gz");
-    gyroChart->addSeries(gyroSeriesX);
-    gyroChart->addSeries(gyroSeriesY);
-    gyroChart->addSeries(gyroSeriesZ);
     gyroAxisX = new QValueAxis(); gyroAxisX->setTitleText("时间 (s)");
     gyroAxisY = new QValueAxis(); gyroAxisY->setTitleText("角速度 (rad/s)"); gyroAxisY->setRange(-50, 50);
     gyroChart->addAxis(gyroAxisX, Qt::AlignBottom);
     gyroChart->addAxis(gyroAxisY, Qt::AlignLeft);
-    for (auto s : {gyroSeriesX, gyroSeriesY, gyroSeriesZ}) { s->attachAxis(gyroAxisX); s->attachAxis(gyroAxisY); }
     gyroChart->legend()->setVisible(true);
     gyroChartView = new QChartView(gyroChart, imuChartWindow);
     gyroChartView->setRenderHint(QPainter::Antialiasing);
 
     // Acc chart
     accChart = new QChart();
-    accSeriesX = new QLineSeries(); accSeriesX->setName("ax");
-    accSeriesY = new QLineSeries(); accSeriesY->setName("ay");
-    accSeriesZ = new QLineSeries(); accSeriesZ->setName("az");
-    accChart->addSeries(accSeriesX);
-    accChart->addSeries(accSeriesY);
-    accChart->addSeries(accSeriesZ);
     accAxisX = new QValueAxis(); accAxisX->setTitleText("时间 (s)");
     accAxisY = new QValueAxis(); accAxisY->setTitleText("加速度 (g)"); accAxisY->setRange(-4, 4);
     accChart->addAxis(accAxisX, Qt::AlignBottom);
     accChart->addAxis(accAxisY, Qt::AlignLeft);
-    for (auto s : {accSeriesX, accSeriesY, accSeriesZ}) { s->attachAxis(accAxisX); s->attachAxis(accAxisY); }
     accChart->legend()->setVisible(true);
     accChartView = new QChartView(accChart, imuChartWindow);
     accChartView->setRenderHint(QPainter::Antialiasing);
@@ -273,52 +276,446 @@ void MainWindow::onActionShowImuCharts()
     layout->addWidget(accChartView);
     imuChartWindow->setLayout(layout);
 
-    // Start or restart chart updater (20 Hz) without blocking GUI
-    if (imuChartRunning.exchange(true)) {
-        if (imuChartThread.joinable()) imuChartThread.detach();
-    }
-    imuChartThread = std::thread([this]() {
-        double t = 0.0;
-        const double dt = 0.05; // 20 Hz
-        const double windowSec = 10.0;
-        const int maxPoints = static_cast<int>(windowSec / dt);
-        while (imuChartRunning.load()) {
-            float gx=0, gy=0, gz=0, ax=0, ay=0, az=0; bool have=false;
-            {
-                QMutexLocker lk(&imuSampleMutex);
-                if (latestImu.have) {
-                    gx = latestImu.gx; gy = latestImu.gy; gz = latestImu.gz;
-                    ax = latestImu.ax; ay = latestImu.ay; az = latestImu.az;
-                    have = true;
-                }
-            }
-            if (have) {
-                QMetaObject::invokeMethod(this, [this, gx, gy, gz, ax, ay, az, t, maxPoints, dt]() {
-                    auto pushPoint = [&](QLineSeries* s, double x, double y){ if (!s) return; s->append(x, y); if (s->count() > maxPoints) s->removePoints(0, s->count() - maxPoints); };
-                    pushPoint(gyroSeriesX, t, gx); pushPoint(gyroSeriesY, t, gy); pushPoint(gyroSeriesZ, t, gz);
-                    pushPoint(accSeriesX, t, ax); pushPoint(accSeriesY, t, ay); pushPoint(accSeriesZ, t, az);
-                    if (gyroAxisX) gyroAxisX->setRange(std::max(0.0, t - (maxPoints - 1) * dt), t);
-                    if (accAxisX) accAxisX->setRange(std::max(0.0, t - (maxPoints - 1) * dt), t);
-                });
-            }
-            t += dt;
-            for (int i=0; i<5 && imuChartRunning.load(); ++i) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            }
-        }
-    });
+    // 按显示刷新率重绘；定时器随窗口销毁
+    QTimer* chartTimer = new QTimer(imuChartWindow);
+    connect(chartTimer, &QTimer::timeout, this, &MainWindow::refreshImuCharts);
+    chartTimer->start(33);
 
     // Stop chart when window closed
     connect(imuChartWindow, &QObject::destroyed, this, [this]() {
-        imuChartRunning.store(false);
-        if (imuChartThread.joinable()) imuChartThread.detach();
-        gyroChart = nullptr; gyroChartView = nullptr; gyroSeriesX = gyroSeriesY = gyroSeriesZ = nullptr; gyroAxisX = gyroAxisY = nullptr;
-        accChart = nullptr; accChartView = nullptr; accSeriesX = accSeriesY = accSeriesZ = nullptr; accAxisX = accAxisY = nullptr;
+        gyroChart = nullptr; gyroChartView = nullptr; gyroAxisX = gyroAxisY = nullptr;
+        accChart = nullptr; accChartView = nullptr; accAxisX = accAxisY = nullptr;
+        imuChartSeries.clear();
+        imuDecimators.clear();
+        imuWindowSpin = nullptr;
+        imuChartInfoLabel = nullptr;
         imuChartWindow = nullptr;
     });
 
     imuChartWindow->resize(900, 600);
     imuChartWindow->show();
+    refreshImuCharts();
+}
+
+void MainWindow::addImuChartDevice(uint32_t handle)
+{
+    static const char* const names[ImuChannelCount] = { "gx", "gy", "gz", "ax", "ay", "az" };
+    const QString device = statsDeviceName(handle);
+    QVector<QLineSeries*> series;
+    for (int ch = 0; ch < ImuChannelCount; ++ch) {
+        const bool gyro = ch < ImuAccX;
+        QChart* chart = gyro ? gyroChart : accChart;
+        QLineSeries* s = new QLineSeries();
+        s->setName(QString("%1 %2").arg(device, names[ch]));
+        chart->addSeries(s);
+        s->attachAxis(gyro ? gyroAxisX : accAxisX);
+        s->attachAxis(gyro ? gyroAxisY : accAxisY);
+        series.append(s);
+    }
+    imuChartSeries.insert(handle, series);
+    imuDecimators.insert(handle, ImuMinMaxDecimator());
+}
+
+void MainWindow::refreshImuCharts()
+{
+    if (!gyroChart || !accChart || !imuWindowSpin) return;
+    for (uint32_t handle : imuHistory.devices()) {
+        if (!imuChartSeries.contains(handle)) addImuChartDevice(handle);
+    }
+
+    // 每像素一列；窗口或宽度变化时从缓冲回填
+    const uint64_t windowNs = uint64_t(imuWindowSpin->value()) * 1000000000ULL;
+    const int columns = std::max(100, int(gyroChart->plotArea().width()));
+    const bool align = clockAligner.isEnabled();
+    uint64_t commonEnd = 0;
+    uint64_t samples = 0;
+    for (auto it = imuDecimators.begin(); it != imuDecimators.end(); ++it) {
+        const ImuSampleRing* ring = imuHistory.ring(it.key());
+        if (!ring) continue;
+        ImuMinMaxDecimator& dec = it.value();
+        dec.configure(windowNs, columns);
+        dec.update(*ring);
+        if (dec.isEmpty()) continue;
+        const uint64_t latest = align ? clockAligner.toCommon(it.key(), dec.latestTimestamp()) : dec.latestTimestamp();
+        commonEnd = std::max(commonEnd, latest);
+        samples += ring->head();
+    }
+
+    for (auto it = imuDecimators.constBegin(); it != imuDecimators.constEnd(); ++it) {
+        const ImuMinMaxDecimator& dec = it.value();
+        const QVector<QLineSeries*>& series = imuChartSeries[it.key()];
+        // 多设备按统一时基对齐右端；未对齐时各设备以自身最新样本为右端
+        uint64_t endTs = dec.latestTimestamp();
+        if (align && !dec.isEmpty()) {
+            endTs += commonEnd - clockAligner.toCommon(it.key(), endTs);
+        }
+        for (int ch = 0; ch < ImuChannelCount && ch < series.size(); ++ch) {
+            dec.build(ch, endTs, imuChartPoints);
+            series[ch]->replace(imuChartPoints);
+        }
+    }
+
+    const double windowSec = double(imuWindowSpin->value());
+    gyroAxisX->setRange(-windowSec, 0.0);
+    accAxisX->setRange(-windowSec, 0.0);
+    if (imuChartInfoLabel) {
+        imuChartInfoLabel->setText(QString("设备 %1  已接收样本 %2  每列 %3 ms")
+            .arg(imuDecimators.size())
+            .arg(samples)
+            .arg(double(windowNs) / 1e6 / columns, 0, 'f', 1));
+    }
+}
+
+void MainWindow::onActionImuAnalysis()
+{
+    if (imuAnalysisWindow && imuAnalysisWindow->isVisible()) {
+        imuAnalysisWindow->raise();
+        imuAnalysisWindow->activateWindow();
+        return;
+    }
+    imuAnalysisWindow = new QWidget(this, Qt::Window);
+    imuAnalysisWindow->setAttribute(Qt::WA_DeleteOnClose);
+    imuAnalysisWindow->setWindowTitle("IMU噪声分析（Allan偏差）");
+    QVBoxLayout* layout = new QVBoxLayout(imuAnalysisWindow);
+
+    QHBoxLayout* top = new QHBoxLayout();
+    top->addWidget(new QLabel("实时数据源:", imuAnalysisWindow));
+    imuAnalysisSourceCombo = new QComboBox(imuAnalysisWindow);
+    imuAnalysisSourceCombo->setMinimumWidth(160);
+    top->addWidget(imuAnalysisSourceCombo);
+    imuAnalysisLiveButton = new QPushButton("开始实时分析", imuAnalysisWindow);
+    top->addWidget(imuAnalysisLiveButton);
+    top->addSpacing(16);
+    imuAnalysisFileButton = new QPushButton("分析录制文件...", imuAnalysisWindow);
+    imuAnalysisFileButton->setToolTip("原始数据录制（.lvxraw）中的 IMU 数据包，或 IMU 采集导出的 CSV");
+    top->addWidget(imuAnalysisFileButton);
+    top->addStretch();
+    layout->addLayout(top);
+
+    imuAnalysisStatusLabel = new QLabel("未开始", imuAnalysisWindow);
+    layout->addWidget(imuAnalysisStatusLabel);
+
+    // 双对数坐标的 Allan 偏差曲线
+    auto makeChart = [this](const QString& title, const QString& unit, int firstChannel) {
+        static const char* const names[ImuChannelCount] = { "gx", "gy", "gz", "ax", "ay", "az" };
+        QChart* chart = new QChart();
+        chart->setTitle(title);
+        QLogValueAxis* axisX = new QLogValueAxis();
+        axisX->setTitleText("τ (s)");
+        axisX->setBase(10.0);
+        axisX->setLabelFormat("%g");
+        axisX->setMinorTickCount(8);
+        QLogValueAxis* axisY = new QLogValueAxis();
+        axisY->setTitleText(QString("σ(τ) (%1)").arg(unit));
+        axisY->setBase(10.0);
+        axisY->setLabelFormat("%.0e");
+        axisY->setMinorTickCount(8);
+        chart->addAxis(axisX, Qt::AlignBottom);
+        chart->addAxis(axisY, Qt::AlignLeft);
+        for (int ch = firstChannel; ch < firstChannel + 3; ++ch) {
+            QLineSeries* s = new QLineSeries();
+            s->setName(names[ch]);
+            s->setPointsVisible(true);
+            chart->addSeries(s);
+            s->attachAxis(axisX);
+            s->attachAxis(axisY);
+        }
+        chart->legend()->setVisible(true);
+        QChartView* view = new QChartView(chart, imuAnalysisWindow);
+        view->setRenderHint(QPainter::Antialiasing);
+        return view;
+    };
+    QHBoxLayout* charts = new QHBoxLayout();
+    QChartView* gyroView = makeChart("陀螺仪", "rad/s", ImuGyroX);
+    QChartView* accView = makeChart("加速度计", "g", ImuAccX);
+    allanGyroChart = gyroView->chart();
+    allanAccChart = accView->chart();
+    charts->addWidget(gyroView);
+    charts->addWidget(accView);
+    layout->addLayout(charts, 1);
+
+    imuAnalysisTable = new QTableWidget(ImuChannelCount, 4, imuAnalysisWindow);
+    imuAnalysisTable->setHorizontalHeaderLabels({ "轴", "随机游走 (ARW/VRW)", "零偏不稳定性", "最小值处 τ (s)" });
+    imuAnalysisTable->verticalHeader()->setVisible(false);
+    imuAnalysisTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    imuAnalysisTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    imuAnalysisTable->setMaximumHeight(200);
+    layout->addWidget(imuAnalysisTable);
+
+    imuAnalysisTimer = new QTimer(imuAnalysisWindow);
+    connect(imuAnalysisTimer, &QTimer::timeout, this, &MainWindow::onImuAnalysisTick);
+
+    connect(imuAnalysisLiveButton, &QPushButton::clicked, this, [this]() {
+        if (imuAnalysisTimer->isActive()) {
+            imuAnalysisTimer->stop();
+            imuAnalysisLiveButton->setText("开始实时分析");
+            imuAnalysisFileButton->setEnabled(true);
+            return;
+        }
+        if (imuAnalysisSourceCombo->currentIndex() < 0) {
+            QMessageBox::warning(imuAnalysisWindow, "IMU噪声分析", "没有收到IMU数据");
+            return;
+        }
+        // 从环形缓冲中最旧的样本开始（约最近 10 分钟），之后持续累积
+        imuAllan.reset();
+        imuAllanHandle = imuAnalysisSourceCombo->currentData().toUInt();
+        imuAllanNext = 0;
+        imuAnalysisTimer->start(1000);
+        imuAnalysisLiveButton->setText("停止实时分析");
+        imuAnalysisFileButton->setEnabled(false);
+        onImuAnalysisTick();
+    });
+    connect(imuAnalysisFileButton, &QPushButton::clicked, this, [this]() {
+        if (imuAnalysisThread.joinable() && !imuAnalysisCancel.load()) {
+            stopImuFileAnalysis();
+            return;
+        }
+        const QString path = QFileDialog::getOpenFileName(imuAnalysisWindow, "选择IMU数据文件", QDir::homePath(),
+                                                          "IMU数据 (*.lvxraw *.csv);;所有文件 (*)");
+        if (!path.isEmpty()) startImuFileAnalysis(path);
+    });
+
+    connect(imuAnalysisWindow, &QObject::destroyed, this, [this]() {
+        stopImuFileAnalysis();
+        imuAnalysisWindow = nullptr;
+        imuAnalysisSourceCombo = nullptr;
+        imuAnalysisLiveButton = nullptr;
+        imuAnalysisFileButton = nullptr;
+        imuAnalysisStatusLabel = nullptr;
+        imuAnalysisTable = nullptr;
+        allanGyroChart = nullptr;
+        allanAccChart = nullptr;
+        imuAnalysisTimer = nullptr;
+    });
+
+    refreshImuAnalysisSources();
+    imuAnalysisWindow->resize(1100, 750);
+    imuAnalysisWindow->show();
+}
+
+void MainWindow::refreshImuAnalysisSources()
+{
+    if (!imuAnalysisSourceCombo) return;
+    for (uint32_t handle : imuHistory.devices()) {
+        if (imuAnalysisSourceCombo->findData(handle) < 0) {
+            imuAnalysisSourceCombo->addItem(statsDeviceName(handle), handle);
+        }
+    }
+}
+
+void MainWindow::onImuAnalysisTick()
+{
+    refreshImuAnalysisSources();
+    const ImuSampleRing* ring = imuHistory.ring(imuAllanHandle);
+    if (!ring) return;
+    if (imuAllanScratch.size() < 4096) imuAllanScratch.resize(4096);
+    const uint64_t head = ring->head();
+    uint64_t lost = 0;
+    while (imuAllanNext < head) {
+        uint64_t first = 0;
+        const int n = ring->read(imuAllanNext, head, imuAllanScratch.data(), imuAllanScratch.size(), &first);
+        // 首次读取跳过的是开始前已被覆盖的样本，之后出现说明分析跟不上（不应发生）
+        if (imuAllan.samples() > 0 && first > imuAllanNext) lost += first - imuAllanNext;
+        imuAllan.addSamples(imuAllanScratch.constData(), n);
+        const uint64_t next = first + uint64_t(n);
+        if (next <= imuAllanNext) break;
+        imuAllanNext = next;
+    }
+
+    QVector<QVector<AllanPoint>> curves;
+    for (int ch = 0; ch < ImuChannelCount; ++ch) curves.append(imuAllan.curve(ch));
+    const double hours = double(imuAllan.samples()) * imuAllan.sampleInterval() / 3600.0;
+    QString status = QString("实时 %1：%2 样本（%3 h），采样间隔 %4 ms，丢包 %5")
+        .arg(statsDeviceName(imuAllanHandle))
+        .arg(imuAllan.samples())
+        .arg(hours, 0, 'f', 2)
+        .arg(imuAllan.sampleInterval() * 1000.0, 0, 'f', 2)
+        .arg(imuAllan.gaps());
+    if (lost > 0) status += QString("，%1 个样本未及读取已被覆盖").arg(lost);
+    showAllanCurves(curves, status);
+}
+
+void MainWindow::startImuFileAnalysis(const QString& filePath)
+{
+    stopImuFileAnalysis();
+    imuAnalysisCancel.store(false);
+    imuAnalysisFileButton->setText("停止文件分析");
+    imuAnalysisLiveButton->setEnabled(false);
+    imuAnalysisStatusLabel->setText("正在读取 " + QDir::toNativeSeparators(filePath));
+
+    // 文件按块读取（有界内存），每块各轴并行累积，并把阶段性曲线送回界面
+    imuAnalysisThread = std::thread([this, filePath]() {
+        const int kBlock = 65536;
+        AllanDeviation allan;
+        QVector<ImuSample> block;
+        block.reserve(kBlock);
+        QString error;
+        qint64 total = 0;
+        qint64 position = 0;
+        bool haveHandle = false;
+        uint32_t handle = 0;
+        QElapsedTimer postTimer;
+        postTimer.start();
+
+        auto post = [this, &allan, &filePath](const QString& state) {
+            QVector<QVector<AllanPoint>> curves;
+            for (int ch = 0; ch < ImuChannelCount; ++ch) curves.append(allan.curve(ch));
+            const QString status = QString("%1 %2：%3 样本（%4 h），采样间隔 %5 ms，丢包 %6")
+                .arg(state, QFileInfo(filePath).fileName())
+                .arg(allan.samples())
+                .arg(double(allan.samples()) * allan.sampleInterval() / 3600.0, 0, 'f', 2)
+                .arg(allan.sampleInterval() * 1000.0, 0, 'f', 2)
+                .arg(allan.gaps());
+            QMetaObject::invokeMethod(this, [this, curves, status]() {
+                showAllanCurves(curves, status);
+            }, Qt::QueuedConnection);
+        };
+        auto flush = [&]() {
+            allan.addSamples(block);
+            block.clear();
+            if (postTimer.elapsed() >= 500) {
+                postTimer.restart();
+                post(QString("分析中 %1%").arg(total > 0 ? int(position * 100 / total) : 0));
+            }
+        };
+
+        if (filePath.endsWith(".csv", Qt::CaseInsensitive)) {
+            QFile file(filePath);
+            if (!file.open(QIODevice::ReadOnly)) {
+                error = "无法打开文件";
+            } else {
+                total = file.size();
+                while (!imuAnalysisCancel.load() && !file.atEnd()) {
+                    const QList<QByteArray> fields = file.readLine().trimmed().split(',');
+                    if (fields.size() < 1 + ImuChannelCount) continue;
+                    ImuSample s;
+                    bool ok = false;
+                    s.timestamp = fields[0].toULongLong(&ok);
+                    if (!ok) continue;      // 表头
+                    for (int ch = 0; ch < ImuChannelCount; ++ch) s.value[ch] = fields[1 + ch].toFloat();
+                    block.append(s);
+                    if (block.size() >= kBlock) {
+                        position = file.pos();
+                        flush();
+                    }
+                }
+            }
+        } else {
+            // 多设备录制只分析第一个出现的 IMU
+            RawCaptureReader reader;
+            if (!reader.open(filePath)) {
+                error = reader.errorString();
+            } else {
+                total = reader.fileSize();
+                RawCaptureRecord record;
+                ImuSample samples[100];
+                while (!imuAnalysisCancel.load() && reader.next(record)) {
+                    if (record.header.kind != RawCaptureImu) continue;
+                    if (!haveHandle) {
+                        handle = record.header.handle;
+                        haveHandle = true;
+                    } else if (record.header.handle != handle) {
+                        continue;
+                    }
+                    const int n = imuSamplesFromPacket(record.ethernetPacket(), samples, 100);
+                    for (int i = 0; i < n; ++i) block.append(samples[i]);
+                    if (block.size() >= kBlock) {
+                        position = reader.position();
+                        flush();
+                    }
+                }
+            }
+        }
+        allan.addSamples(block);
+
+        if (!error.isEmpty()) {
+            QMetaObject::invokeMethod(this, [this, error]() {
+                if (imuAnalysisStatusLabel) imuAnalysisStatusLabel->setText("读取失败：" + error);
+            }, Qt::QueuedConnection);
+        } else {
+            post(imuAnalysisCancel.load() ? "已停止" : "完成");
+        }
+        QMetaObject::invokeMethod(this, [this]() {
+            if (imuAnalysisFileButton) imuAnalysisFileButton->setText("分析录制文件...");
+            if (imuAnalysisLiveButton) imuAnalysisLiveButton->setEnabled(true);
+        }, Qt::QueuedConnection);
+        imuAnalysisCancel.store(true);
+    });
+}
+
+void MainWindow::stopImuFileAnalysis()
+{
+    imuAnalysisCancel.store(true);
+    if (imuAnalysisThread.joinable()) imuAnalysisThread.join();
+}
+
+void MainWindow::showAllanCurves(const QVector<QVector<AllanPoint>>& curves, const QString& status)
+{
+    if (!imuAnalysisWindow || !allanGyroChart || !allanAccChart) return;
+    imuAnalysisStatusLabel->setText(status);
+
+    static const char* const names[ImuChannelCount] = { "gx", "gy", "gz", "ax", "ay", "az" };
+    const double radToDeg = 57.29577951308232;     // 180/π
+    for (int ch = 0; ch < ImuChannelCount && ch < curves.size(); ++ch) {
+        const bool gyro = ch < ImuAccX;
+        QChart* chart = gyro ? allanGyroChart : allanAccChart;
+        const QList<QAbstractSeries*> series = chart->series();
+        QLineSeries* line = qobject_cast<QLineSeries*>(series.value(ch % 3));
+        double minX = 0.0, maxX = 0.0, minY = 0.0, maxY = 0.0;
+        QVector<QPointF> points;
+        for (const AllanPoint& p : curves[ch]) {
+            if (p.adev <= 0.0) continue;
+            points.append(QPointF(p.tau, p.adev));
+        }
+        if (line) line->replace(points);
+
+        // 同一图表三轴共用坐标范围（按十倍程取整）
+        if (ch % 3 == 2) {
+            bool first = true;
+            for (QAbstractSeries* a : series) {
+                QLineSeries* l = qobject_cast<QLineSeries*>(a);
+                if (!l) continue;
+                for (const QPointF& p : l->points()) {
+                    if (first || p.x() < minX) minX = p.x();
+                    if (first || p.x() > maxX) maxX = p.x();
+                    if (first || p.y() < minY) minY = p.y();
+                    if (first || p.y() > maxY) maxY = p.y();
+                    first = false;
+                }
+            }
+            if (!first) {
+                const QList<QAbstractAxis*> axesX = chart->axes(Qt::Horizontal);
+                const QList<QAbstractAxis*> axesY = chart->axes(Qt::Vertical);
+                auto decadeFloor = [](double v) { return std::pow(10.0, std::floor(std::log10(v))); };
+                auto decadeCeil = [](double v) { return std::pow(10.0, std::ceil(std::log10(v))); };
+                if (!axesX.isEmpty()) axesX.first()->setRange(decadeFloor(minX), decadeCeil(maxX));
+                if (!axesY.isEmpty()) axesY.first()->setRange(decadeFloor(minY), decadeCeil(maxY));
+            }
+        }
+
+        // 噪声参数：陀螺 °/√h、°/h；加速度计 m/s/√h、mg
+        const AllanNoise noise = AllanDeviation::characterize(curves[ch]);
+        QString rw = "-", bi = "-", tau = "-";
+        if (noise.valid) {
+            if (gyro) {
+                rw = QString("%1 °/√h").arg(noise.randomWalk * radToDeg * 60.0, 0, 'g', 4);
+                bi = QString("%1 °/h").arg(noise.biasInstability * radToDeg * 3600.0, 0, 'g', 4);
+            } else {
+                rw = QString("%1 m/s/√h").arg(noise.randomWalk * 9.80665 * 60.0, 0, 'g', 4);
+                bi = QString("%1 mg").arg(noise.biasInstability * 1000.0, 0, 'g', 4);
+            }
+            tau = QString::number(noise.biasTau, 'g', 4);
+        }
+        const QString cells[4] = { names[ch], rw, bi, tau };
+        for (int c = 0; c < 4; ++c) {
+            QTableWidgetItem* item = imuAnalysisTable->item(ch, c);
+            if (!item) {
+                item = new QTableWidgetItem();
+                imuAnalysisTable->setItem(ch, c, item);
+            }
+            item->setText(cells[c]);
+        }
+    }
 }
 
 void MainWindow::onActionCaptureImuTriggered()
@@ -409,6 +806,10 @@ void MainWindow::onActionCaptureImuTriggered()
     captureSecondsRemaining = spinSec->value();
     captureTotalSeconds = captureSecondsRemaining;
     currentCapture = CaptureIMU;
+    // 从当前位置开始写入该设备环形缓冲中的样本（每秒随进度刷新一次）
+    imuCsvHandle = currentDevice->handle;
+    const ImuSampleRing* imuRing = imuHistory.ring(imuCsvHandle);
+    imuCsvNext = imuRing ? imuRing->head() : 0;
     imuSaveActive = true;
     statusLabelBar->setText("正在保存IMU数据...");
     logMessage(QString("IMU保存路径: %1").arg(QDir::toNativeSeparators(filePath)));
@@ -425,6 +826,26 @@ void MainWindow::appendImuCsvRow(quint64 timestamp_ns, float gx, float gy, float
     ts << timestamp_ns << ',' << gx << ',' << gy << ',' << gz << ',' << ax << ',' << ay << ',' << az << '\n';
 }
 
+void MainWindow::drainImuCsv()
+{
+    const ImuSampleRing* ring = imuHistory.ring(imuCsvHandle);
+    if (!imuSaveActive || !ring) return;
+    ImuSample chunk[256];
+    const uint64_t head = ring->head();
+    while (imuCsvNext < head) {
+        uint64_t first = 0;
+        const int n = ring->read(imuCsvNext, head, chunk, 256, &first);
+        for (int i = 0; i < n; ++i) {
+            const ImuSample& s = chunk[i];
+            appendImuCsvRow(s.timestamp, s.value[ImuGyroX], s.value[ImuGyroY], s.value[ImuGyroZ],
+                            s.value[ImuAccX], s.value[ImuAccY], s.value[ImuAccZ]);
+        }
+        const uint64_t next = first + uint64_t(n);
+        if (next <= imuCsvNext) break;
+        imuCsvNext = next;
+    }
+}
+
 void MainWindow::refreshSerialPorts()
 {
     serialPortCombo->clear();
@@ -477,9 +898,9 @@ void MainWindow::onSerialEnableToggled(bool enabled)
         serial.setParity(QSerialPort::NoParity);
         serial.setStopBits(QSerialPort::OneStop);
         if (!serial.open(QIODevice::ReadOnly)) {
+            logMessage(QString("串口转发GPS启动失败，无法打开端口: %1").arg(portName), LogError);
             QMetaObject::invokeMethod(this, [this, portName]() { 
                 serialEnableCheck->setChecked(false); 
-                logMessage(QString("串口转发GPS启动失败，无法打开端口: %1").arg(portName));
                 statusLabelBar->setText(QString("串口转发GPS启动失败，端口: %1").arg(portName));
             }, Qt::QueuedConnection);
             serialRunning.store(false);
@@ -503,17 +924,15 @@ void MainWindow::onSerialEnableToggled(bool enabled)
                         // 对于RMC报文，进行时间同步
                         if (line.startsWith("$GPRMC") || line.startsWith("$GNRMC")) {
                             // 打印GPS同步报文到日志并更新状态栏
-                            QMetaObject::invokeMethod(this, [this, gpsMessage, portName]() {
-                                logMessage(QString("串口转发GPS同步: %1").arg(gpsMessage));
+                            logMessage(QString("串口转发GPS同步: %1").arg(gpsMessage), LogInfo, "serial-gps-rmc");
+                            QMetaObject::invokeMethod(this, [this, portName]() {
                                 statusLabelBar->setText(QString("串口转发GPS同步中... 端口: %1").arg(portName));
                             }, Qt::QueuedConnection);
                             
                             SetLivoxLidarRmcSyncTime(currentDevice->handle, line.constData(), static_cast<uint16_t>(line.size()), nullptr, nullptr);
                         } else {
                             // 打印其他GPS报文到日志
-                            QMetaObject::invokeMethod(this, [this, gpsMessage]() {
-                                logMessage(QString("串口转发GPS报文: %1").arg(gpsMessage));
-                            }, Qt::QueuedConnection);
+                            logMessage(QString("串口转发GPS报文: %1").arg(gpsMessage), LogInfo, "serial-gps");
                         }
                     }
                 }
@@ -526,321 +945,82 @@ void MainWindow::onSerialEnableToggled(bool enabled)
 void MainWindow::onFrameIntervalChanged(int ms)
 {
     if (ms < 50) ms = 50;
-    frameIntervalMs = static_cast<uint64_t>(ms);
+    pipeline.setWindowMs(static_cast<uint64_t>(ms));
     logMessage(QString("点云积分时间已设置为 %1 ms").arg(ms));
 }
 
-void MainWindow::processPointCloudPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet)
-{
-    if (!packet || packet->dot_num == 0) {
-        return;
-    }
-    
-    // 解析时间戳
-    uint64_t timestamp = parseTimestamp(packet->timestamp);
-    
-    // 创建点云帧
-    PointCloudFrame frame;
-    frame.timestamp = timestamp;
-    frame.device_handle = handle;
-    
-    // 根据数据类型解析点云数据
-    if (packet->data_type == kLivoxLidarCartesianCoordinateHighData) {
-        LivoxLidarCartesianHighRawPoint *p_point_data = (LivoxLidarCartesianHighRawPoint *)packet->data;
-        for (uint32_t i = 0; i < packet->dot_num; i++) {
-            Point3D point;
-            point.x = p_point_data[i].x / 1000.0f; // 转换为米
-            point.y = p_point_data[i].y / 1000.0f;
-            point.z = p_point_data[i].z / 1000.0f;
-            point.reflectivity = p_point_data[i].reflectivity;
-            point.tag = p_point_data[i].tag;
-            
-            frame.points.append(point);
-        }
-    }
-    else if (packet->data_type == kLivoxLidarCartesianCoordinateLowData) {
-        LivoxLidarCartesianLowRawPoint *p_point_data = (LivoxLidarCartesianLowRawPoint *)packet->data;
-        for (uint32_t i = 0; i < packet->dot_num; i++) {
-            Point3D point;
-            point.x = p_point_data[i].x / 100.0f; // 转换为米
-            point.y = p_point_data[i].y / 100.0f;
-            point.z = p_point_data[i].z / 100.0f;
-            point.reflectivity = p_point_data[i].reflectivity;
-            point.tag = p_point_data[i].tag;
-            
-            frame.points.append(point);
-        }
-    }
-    else if (packet->data_type == kLivoxLidarSphericalCoordinateData) {
-        LivoxLidarSpherPoint* p_point_data = (LivoxLidarSpherPoint *)packet->data;
-        for (uint32_t i = 0; i < packet->dot_num; i++) {
-            Point3D point;
-            
-            // 球坐标转笛卡尔坐标
-            float depth = p_point_data[i].depth / 1000.0f; // 转换为米
-            float theta = p_point_data[i].theta / 100.0f * M_PI / 180.0f; // 转换为弧度
-            float phi = p_point_data[i].phi / 100.0f * M_PI / 180.0f; // 转换为弧度
-            
-            // 深度投影：启用且设置了投影距离（>0）时，使用该距离替换 depth
-            if (projectionDepthEnabled && projectionDepthMeters > 0.0f) {
-                depth = projectionDepthMeters;
-            }
-            
-            // 平面投影模式时，设置投影深度为平面投影半径
-            if (planarProjectionEnabled && projectionDepthMeters <= 0.0f) {
-                depth = planarProjectionRadius;
-            }
-            
-            // 平面投影：如果启用平面投影，将球坐标转换为平面坐标
-            if (planarProjectionEnabled) {
-                // 等距圆柱投影：将球面展开为平面
-                // phi (方位角) 映射到 X 轴，theta (仰角) 映射到 Y 轴
-                float phi_deg = phi * 180.0f / M_PI;  // 转换为度
-                float theta_deg = theta * 180.0f / M_PI;  // 转换为度
-                
-                // 将方位角映射到 [-180, 180] 度范围
-                if (phi_deg > 180.0f) phi_deg -= 360.0f;
-                
-                // 将仰角映射到 [-90, 90] 度范围（完整球面）
-                theta_deg = 90.0f - theta_deg; // 转换坐标系，使0°为水平，正值为上方，负值为下方
-                
-                // 计算平面坐标
-                point.x = planarProjectionRadius * phi_deg / 180.0f;  // X轴：方位角
-                point.y = planarProjectionRadius * theta_deg / 90.0f;  // Y轴：仰角
-                point.z = 0.0f;  // 平面投影时Z设为0
-            } else {
-                // 原始球坐标转笛卡尔坐标
-                point.x = depth * sin(theta) * cos(phi);
-                point.y = depth * sin(theta) * sin(phi);
-                point.z = depth * cos(theta);
-            }
-            point.reflectivity = p_point_data[i].reflectivity;
-            point.tag = p_point_data[i].tag;
-            
-            frame.points.append(point);
-        }
-    }
-    
-    // 推入待处理队列，记录最新时间戳
-    {
-        QMutexLocker locker(&frameMutex);
-        pendingFrames[handle].enqueue(frame);
-        lastSeenTimestamp[handle] = timestamp;
-    }
-}
-
-uint64_t MainWindow::parseTimestamp(const uint8_t* timestamp)
+bool MainWindow::processPointCloudPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t hostArrivalNs)
 {
-    // 按小端序解析时间戳
-    uint64_t result = 0;
-    for (int i = 7; i >= 0; --i) {
-        result = (result << 8) | timestamp[i];
-    }
-    return result;
-}
-
-void MainWindow::publishPointCloudFrame(const PointCloudFrame& frame)
-{
-    // 在主线程中更新点云显示
-    QMetaObject::invokeMethod(this, [this, frame]() {
-        pointCloudWidget->updatePointCloud(frame);
-    }, Qt::QueuedConnection);
+    TraceZone trace("processPointCloudPacket");
+    // 解码并推入流水线待处理队列（与离线转换工具共用同一解码实现）
+    return pipeline.pushPacket(handle, packet, hostArrivalNs);
 }
 
-void MainWindow::calculatePointColor(uint8_t reflectivity, uint8_t tag, float& r, float& g, float& b)
+void MainWindow::handleFleetPacket(uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t hostArrivalNs, bool render)
 {
-    // 参考Livox Viewer的着色逻辑（Livox color-coding strategy）
-    uint8_t cur_reflectivity = reflectivity;
-    uint8_t tag_value = tag;
-    
-    if (cur_reflectivity < 30) {
-        r = 0;
-        g = static_cast<float>(cur_reflectivity * 255 / 30) / 255.0f;
-        b = 1.0f;
-    }
-    else if (cur_reflectivity < 90) {
-        r = 0;
-        g = 1.0f;
-        b = static_cast<float>((90 - cur_reflectivity) * 255 / 60) / 255.0f;
-    }
-    else if (cur_reflectivity < 150) {
-        r = static_cast<float>((cur_reflectivity - 90) * 255 / 60) / 255.0f;
-        g = 1.0f;
-        b = 0;
+    // 车队模式工作线程：未显示的设备不解码，仍写入录制文件。
+    // 只用 decodePacket/pushFrame（各设备独立的队列与时钟状态），统计由批处理回调按批记录
+    bool accepted = true;
+    if (render) {
+        PointCloudFrame frame;
+        accepted = pipeline.decodePacket(handle, packet, hostArrivalNs, frame);
+        if (accepted && !frame.points.isEmpty()) pipeline.pushFrame(frame);
     }
-    else {
-        r = 1.0f;
-        g = static_cast<float>((255 - cur_reflectivity) * 255 / (256 - 150)) / 255.0f;
-        b = 0;
+    if (accepted && lvx2SaveActive.load(std::memory_order_relaxed) && packet->data_type == 0x01) {
+        TraceZone lvx2Trace("lvx2Write");
+        QMutexLocker lk(&lvx2Mutex);
+        if (lvx2SaveActive) lvx2Writer.writePacket(handle, packet);
     }
 }
 
-static inline void calcColorDistance(const Point3D& p, float minD, float maxD, float& r, float& g, float& b)
+void MainWindow::syncPipelineOptions()
 {
-    const float dx = p.x, dy = p.y, dz = p.z;
-    float d = std::sqrt(dx*dx + dy*dy + dz*dz);
-    float t = 0.0f;
-    if (maxD > minD) t = (d - minD) / (maxD - minD);
-    t = std::clamp(t, 0.0f, 1.0f);
-    // 蓝->青->绿->黄->红
-    if (t < 0.25f)      { r = 0.0f;           g = t/0.25f;     b = 1.0f; }
-    else if (t < 0.5f)  { r = 0.0f;           g = 1.0f;        b = 1.0f - (t-0.25f)/0.25f; }
-    else if (t < 0.75f) { r = (t-0.5f)/0.25f; g = 1.0f;        b = 0.0f; }
-    else                { r = 1.0f;           g = 1.0f-(t-0.75f)/0.25f; b = 0.0f; }
+    PointDecodeOptions decode;
+    decode.projectionDepthEnabled = projectionDepthEnabled;
+    decode.projectionDepthMeters = projectionDepthMeters;
+    decode.planarProjectionEnabled = planarProjectionEnabled;
+    decode.planarProjectionRadius = planarProjectionRadius;
+    pipeline.setDecodeOptions(decode);
+
+    PointColorOptions color;
+    color.mode = colorMode;
+    color.solidR = float(solidColor.redF());
+    color.solidG = float(solidColor.greenF());
+    color.solidB = float(solidColor.blueF());
+    color.planarRadius = planarProjectionRadius;
+    pipeline.setColorOptions(color);
 }
 
-static inline void calcColorElevation(const Point3D& p, float minZ, float maxZ, float& r, float& g, float& b)
+uint64_t MainWindow::parseTimestamp(const uint8_t* timestamp)
 {
-    float t = 0.0f;
-    if (maxZ > minZ) t = (p.z - minZ) / (maxZ - minZ);
-    t = std::clamp(t, 0.0f, 1.0f);
-    // 低->高: 蓝->红
-    r = t;
-    g = 0.0f;
-    b = 1.0f - t;
+    return parsePacketTimestamp(timestamp);
 }
 
-static inline void calcColorSolid(const QColor& color, float& r, float& g, float& b)
+void MainWindow::publishPointCloudFrame(const PointCloudFrame& frame, uint64_t latencyFrameId)
 {
-    r = color.redF();
-    g = color.greenF();
-    b = color.blueF();
+    // 在主线程中更新点云显示
+    QMetaObject::invokeMethod(this, [this, frame, latencyFrameId]() {
+        pointCloudWidget->updatePointCloud(frame);
+        latencyTracker.frameUploaded(latencyFrameId, hostMonotonicNs());
+    }, Qt::QueuedConnection);
 }
 
-static inline quint16 clampU16(int v) { return quint16(std::max(0, std::min(65535, v))); }
-
 bool MainWindow::savePointCloudAsLAS(const QString& filePath, const QVector<Point3D>& points)
 {
-    QFile f(filePath);
-    if (!f.open(QIODevice::WriteOnly)) return false;
-
-    // LAS 1.2 header (little-endian), Point Data Record Format 0
-    // We will use scale (0.001) and offset 0 for simplicity; compute bbox
-    double scaleX = 0.001, scaleY = 0.001, scaleZ = 0.001;
-    double minX = std::numeric_limits<double>::max();
-    double minY = std::numeric_limits<double>::max();
-    double minZ = std::numeric_limits<double>::max();
-    double maxX = -std::numeric_limits<double>::max();
-    double maxY = -std::numeric_limits<double>::max();
-    double maxZ = -std::numeric_limits<double>::max();
-    for (const Point3D& p : points) {
-        if (p.x < minX) minX = p.x; if (p.x > maxX) maxX = p.x;
-        if (p.y < minY) minY = p.y; if (p.y > maxY) maxY = p.y;
-        if (p.z < minZ) minZ = p.z; if (p.z > maxZ) maxZ = p.z;
-    }
-    double offX = 0.0, offY = 0.0, offZ = 0.0; // offsets set to 0
-
-    QByteArray header(227, 0); // LAS 1.2 header size
-    // File Signature "LASF"
-    header[0] = 'L'; header[1] = 'A'; header[2] = 'S'; header[3] = 'F';
-    // File Source ID, Global Encoding -> leave 0
-    // Project ID GUIDs -> zeros
-    // Version Major/Minor
-    header[24] = 1; // version major
-    header[25] = 2; // version minor
-    // System Identifier (32 bytes)
-    QByteArray sys = QByteArray("LivoxViewerQT"); sys = sys.leftJustified(32, '\0', true);
-    std::copy(sys.begin(), sys.end(), header.begin() + 26);
-    // Generating Software (32 bytes)
-    QByteArray gen = QByteArray("LVX"); gen = gen.leftJustified(32, '\0', true);
-    std::copy(gen.begin(), gen.end(), header.begin() + 58);
-    // File Creation Day/Year -> leave 0
-    // Header Size
-    qToLittleEndian<quint16>(227, reinterpret_cast<uchar*>(header.data() + 94));
-    // Offset to point data: header (227) + no VLRs (0)
-    qToLittleEndian<quint32>(227, reinterpret_cast<uchar*>(header.data() + 96));
-    // Number of Variable Length Records
-    qToLittleEndian<quint32>(0, reinterpret_cast<uchar*>(header.data() + 100));
-    // Point Data Format
-    header[104] = 0; // format 0
-    // Point Data Record Length (bytes) -> 20 for format 0
-    qToLittleEndian<quint16>(20, reinterpret_cast<uchar*>(header.data() + 105));
-    // Legacy number of point records
-    qToLittleEndian<quint32>(static_cast<quint32>(points.size()), reinterpret_cast<uchar*>(header.data() + 107));
-    // Legacy number of points by return (5 x uint32) -> set first = count
-    qToLittleEndian<quint32>(static_cast<quint32>(points.size()), reinterpret_cast<uchar*>(header.data() + 111));
-    // Scale Factors (X,Y,Z) at offsets 131,139,147 as doubles
-    qToLittleEndian<double>(scaleX, reinterpret_cast<uchar*>(header.data() + 131));
-    qToLittleEndian<double>(scaleY, reinterpret_cast<uchar*>(header.data() + 139));
-    qToLittleEndian<double>(scaleZ, reinterpret_cast<uchar*>(header.data() + 147));
-    // Offsets (X,Y,Z) as doubles
-    qToLittleEndian<double>(offX, reinterpret_cast<uchar*>(header.data() + 155));
-    qToLittleEndian<double>(offY, reinterpret_cast<uchar*>(header.data() + 163));
-    qToLittleEndian<double>(offZ, reinterpret_cast<uchar*>(header.data() + 171));
-    // Max/Min (X,Y,Z) as doubles
-    qToLittleEndian<double>(maxX, reinterpret_cast<uchar*>(header.data() + 179));
-    qToLittleEndian<double>(minX, reinterpret_cast<uchar*>(header.data() + 187));
-    qToLittleEndian<double>(maxY, reinterpret_cast<uchar*>(header.data() + 195));
-    qToLittleEndian<double>(minY, reinterpret_cast<uchar*>(header.data() + 203));
-    qToLittleEndian<double>(maxZ, reinterpret_cast<uchar*>(header.data() + 211));
-    qToLittleEndian<double>(minZ, reinterpret_cast<uchar*>(header.data() + 219));
-
-    if (f.write(header) != header.size()) { f.close(); return false; }
-
-    // Write points (Format 0): X,Y,Z as int32, Intensity uint16, flags+classification etc.
-    QByteArray rec(20, 0);
-    for (const Point3D& p : points) {
-        // Convert to scaled integer: integer = round((coord - offset)/scale)
-        qint32 xi = qint32(std::llround((p.x - offX) / scaleX));
-        qint32 yi = qint32(std::llround((p.y - offY) / scaleY));
-        qint32 zi = qint32(std::llround((p.z - offZ) / scaleZ));
-        qToLittleEndian<qint32>(xi, reinterpret_cast<uchar*>(rec.data() + 0));
-        qToLittleEndian<qint32>(yi, reinterpret_cast<uchar*>(rec.data() + 4));
-        qToLittleEndian<qint32>(zi, reinterpret_cast<uchar*>(rec.data() + 8));
-        // Intensity
-        qToLittleEndian<quint16>(clampU16(int(p.reflectivity)), reinterpret_cast<uchar*>(rec.data() + 12));
-        // Return flags (1), classification (1), scan angle (1), user data (1) -> put tag into user data
-        rec[14] = 1;             // return number bits -> 1
-        rec[15] = 1;             // classification -> unclassified
-        rec[16] = 0;             // scan angle rank
-        rec[17] = static_cast<char>(p.tag); // user data stores tag
-        // Point source ID (uint16)
-        qToLittleEndian<quint16>(0, reinterpret_cast<uchar*>(rec.data() + 18));
-        if (f.write(rec) != rec.size()) { f.close(); return false; }
-    }
-
-    f.close();
-    return true;
+    return savePointsAsLAS(filePath, points);
 }
 
 bool MainWindow::savePointCloudAsPCD(const QString& filePath, const QVector<Point3D>& points)
 {
-    QFile f(filePath);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
-        return false;
-    }
-    QTextStream out(&f);
-    out.setRealNumberNotation(QTextStream::FixedNotation);
-    out.setRealNumberPrecision(6);
-    // ASCII PCD header with reflectivity(intensity) and tag
-    out << "# .PCD v0.7 - Point Cloud Data file\n";
-    out << "VERSION 0.7\n";
-    out << "FIELDS x y z intensity tag\n";
-    out << "SIZE 4 4 4 4 4\n";
-    out << "TYPE F F F F F\n";
-    out << "COUNT 1 1 1 1 1\n";
-    out << "WIDTH " << points.size() << "\n";
-    out << "HEIGHT 1\n";
-    out << "VIEWPOINT 0 0 0 1 0 0 0\n";
-    out << "POINTS " << points.size() << "\n";
-    out << "DATA ascii\n";
-    for (const Point3D& p : points) {
-        out << p.x << ' ' << p.y << ' ' << p.z << ' ' << int(p.reflectivity) << ' ' << int(p.tag) << "\n";
-    }
-    f.close();
-    return true;
+    return savePointsAsPCD(filePath, points, false);
 }
 
 void MainWindow::onRenderTick()
 {
+	TraceZone trace("onRenderTick");
 	// 暂停可视化模式：停止更新点云缓冲，但仍按固定刷新率重绘以跟随相机/叠加层
 	if (!pointCloudVisualizationEnabled) {
-		{
-			QMutexLocker locker(&frameMutex);
-			for (auto it = pendingFrames.begin(); it != pendingFrames.end(); ++it) {
-				it.value().clear();
-			}
-		}
+		pipeline.clearPending();
 		if (pointCloudWidget) {
 			pointCloudWidget->update();
 		}
@@ -849,208 +1029,69 @@ void MainWindow::onRenderTick()
 	
 	// 测距模式：暂停点云可视化播放（停止更新点云缓冲），但仍按固定刷新率重绘以跟随相机/叠加层
 	if (pointCloudWidget && pointCloudWidget->isMeasurementModeEnabled()) {
-		{
-			QMutexLocker locker(&frameMutex);
-			for (auto it = pendingFrames.begin(); it != pendingFrames.end(); ++it) {
-				it.value().clear();
-			}
-		}
+		pipeline.clearPending();
 		pointCloudWidget->update();
 		return;
 	}
-	// 以固定刷新率合并滑动窗口内的点并渲染
-	uint64_t now_ns = 0;
-	{
-		QMutexLocker locker(&frameMutex);
-		for (auto it = lastSeenTimestamp.begin(); it != lastSeenTimestamp.end(); ++it) {
-			if (it.value() > now_ns) now_ns = it.value();
-		}
+	// 以固定刷新率合并滑动窗口内的点，着色、滤波后交给 onPipelineFrame 保存与渲染
+	pipeline.process();
+
+	if (selectionRealtimeEnabled && pointCloudWidget && (attrTable || selectionTable)) {
+		TraceZone selectionTrace("selectionUpdate");
+		updateSelectionTableAndLog();
 	}
-	if (now_ns == 0) return;
-
-	uint64_t window_ns = frameIntervalMs * 1000000ULL;
-	uint64_t window_begin = (now_ns > window_ns) ? (now_ns - window_ns) : 0ULL;
-
-	PointCloudFrame merged;
-	merged.timestamp = now_ns;
-	merged.device_handle = 0;
-
-	bool hasAnyPoint = false;
-	{
-		QMutexLocker locker(&frameMutex);
-		for (auto it = pendingFrames.begin(); it != pendingFrames.end(); ++it) {
-			QQueue<PointCloudFrame>& q = it.value();
-			while (!q.isEmpty() && q.head().timestamp < window_begin) {
-				q.dequeue();
-			}
-			for (int i = 0; i < q.size(); ++i) {
-				const PointCloudFrame& f = q.at(i);
-				if (f.timestamp >= window_begin && f.timestamp <= now_ns) {
-					merged.points += f.points;
-					hasAnyPoint = true;
-				}
-			}
-		}
+}
+
+void MainWindow::onPipelineFrame(const PointCloudFrame& merged, const PipelineOutput& info)
+{
+	const uint64_t now_ns = info.windowEnd;
+	if (pointCloudWidget) {
+		pointCloudWidget->setLegend(info.colorMode, info.legend.minVal, info.legend.maxVal, info.legend.visible);
 	}
 
-	if (hasAnyPoint) {
-		if (colorMode == ColorByReflectivity) {
-			for (Point3D& p : merged.points) {
-				calculatePointColor(p.reflectivity, p.tag, p.r, p.g, p.b);
-			}
-			if (pointCloudWidget) pointCloudWidget->setLegend(ColorByReflectivity, 0.0f, 255.0f, true);
-		} else if (colorMode == ColorByDistance) {
-			float minD = std::numeric_limits<float>::max();
-			float maxD = 0.0f;
-			for (const Point3D& p : merged.points) {
-				float d = std::sqrt(p.x*p.x + p.y*p.y + p.z*p.z);
-				if (d < minD) minD = d;
-				if (d > maxD) maxD = d;
-			}
-			if (!(maxD > minD)) { minD = 0.0f; maxD = 1.0f; }
-			for (Point3D& p : merged.points) {
-				float r, g, b; (void)r; (void)g; (void)b;
-				const float dx = p.x, dy = p.y, dz = p.z;
-				float d = std::sqrt(dx*dx + dy*dy + dz*dz);
-				float t = 0.0f;
-				if (maxD > minD) t = (d - minD) / (maxD - minD);
-				t = std::clamp(t, 0.0f, 1.0f);
-				if (t < 0.25f)      { p.r = 0.0f;           p.g = t/0.25f;     p.b = 1.0f; }
-				else if (t < 0.5f)  { p.r = 0.0f;           p.g = 1.0f;        p.b = 1.0f - (t-0.25f)/0.25f; }
-				else if (t < 0.75f) { p.r = (t-0.5f)/0.25f; p.g = 1.0f;        p.b = 0.0f; }
-				else                { p.r = 1.0f;           p.g = 1.0f-(t-0.75f)/0.25f; p.b = 0.0f; }
-			}
-			if (pointCloudWidget) pointCloudWidget->setLegend(ColorByDistance, minD, maxD, true);
-		} else if (colorMode == ColorByElevation) {
-			float minZ = std::numeric_limits<float>::max();
-			float maxZ = std::numeric_limits<float>::lowest();
-			for (const Point3D& p : merged.points) {
-				if (p.z < minZ) minZ = p.z;
-				if (p.z > maxZ) maxZ = p.z;
-			}
-			if (!(maxZ > minZ)) { minZ = -1.0f; maxZ = 1.0f; }
-			for (Point3D& p : merged.points) {
-				float t = 0.0f;
-				if (maxZ > minZ) t = (p.z - minZ) / (maxZ - minZ);
-				t = std::clamp(t, 0.0f, 1.0f);
-				p.r = t; p.g = 0.0f; p.b = 1.0f - t;
-			}
-			if (pointCloudWidget) pointCloudWidget->setLegend(ColorByElevation, minZ, maxZ, true);
-		        } else if (colorMode == ColorSolid) {
-            for (Point3D& p : merged.points) {
-                p.r = solidColor.redF();
-                p.g = solidColor.greenF();
-                p.b = solidColor.blueF();
-            }
-            if (pointCloudWidget) pointCloudWidget->setLegend(ColorSolid, 0.0f, 1.0f, false);
-        } else if (colorMode == ColorByPlanarProjection) {
-            // 平面投影模式：根据点在平面上的位置着色
-            float minX = std::numeric_limits<float>::max();
-            float maxX = std::numeric_limits<float>::lowest();
-            float minY = std::numeric_limits<float>::max();
-            float maxY = std::numeric_limits<float>::lowest();
-            
-            // 计算平面坐标范围
-            for (const Point3D& p : merged.points) {
-                if (p.x < minX) minX = p.x;
-                if (p.x > maxX) maxX = p.x;
-                if (p.y < minY) minY = p.y;
-                if (p.y > maxY) maxY = p.y;
-            }
-            
-            if (!(maxX > minX)) { minX = -planarProjectionRadius; maxX = planarProjectionRadius; }
-            if (!(maxY > minY)) { minY = 0.0f; maxY = planarProjectionRadius; }
-            
-            for (Point3D& p : merged.points) {
-                // 根据平面位置着色
-                float tx = (p.x - minX) / (maxX - minX);
-                float ty = (p.y - minY) / (maxY - minY);
-                tx = std::clamp(tx, 0.0f, 1.0f);
-                ty = std::clamp(ty, 0.0f, 1.0f);
-                
-                // 使用HSV颜色空间创建渐变效果
-                float hue = tx * 360.0f;  // X轴对应色相
-                float saturation = 0.8f;  // 固定饱和度
-                float value = 0.5f + ty * 0.5f;  // Y轴对应明度
-                
-                // HSV转RGB
-                float c = value * saturation;
-                float x = c * (1.0f - std::abs(std::fmod(hue / 60.0f, 2.0f) - 1.0f));
-                float m = value - c;
-                
-                if (hue < 60.0f) {
-                    p.r = c + m; p.g = x + m; p.b = m;
-                } else if (hue < 120.0f) {
-                    p.r = x + m; p.g = c + m; p.b = m;
-                } else if (hue < 180.0f) {
-                    p.r = m; p.g = c + m; p.b = x + m;
-                } else if (hue < 240.0f) {
-                    p.r = m; p.g = x + m; p.b = c + m;
-                } else if (hue < 300.0f) {
-                    p.r = x + m; p.g = m; p.b = c + m;
-                } else {
-                    p.r = c + m; p.g = m; p.b = x + m;
-                }
-                
-                // 确保RGB值在[0,1]范围内
-                p.r = std::clamp(p.r, 0.0f, 1.0f);
-                p.g = std::clamp(p.g, 0.0f, 1.0f);
-                p.b = std::clamp(p.b, 0.0f, 1.0f);
-            }
-            if (pointCloudWidget) pointCloudWidget->setLegend(ColorByPlanarProjection, 0.0f, 1.0f, true);
-        }
-		        // 点云滤波处理
-        merged.points = applyPointCloudFilters(merged.points);
-        
-
-		// 保存PCD：在渲染循环中，当开启保存任务时按帧保存
-		if (pcdSaveActive && pcdFramesRemaining > 0) {
-			// 用合并窗口末尾时间戳作为文件名（纳秒）
-			if (pcdLastSavedTimestamp != now_ns) {
-				QString fileName = QString::number(now_ns) + ".pcd";
-				QString filePath = QDir(pcdSaveDir).filePath(fileName);
-				if (savePointCloudAsPCD(filePath, merged.points)) {
-					logMessage(QString("PCD保存: %1").arg(QDir::toNativeSeparators(filePath)));
-					pcdLastSavedTimestamp = now_ns;
-					pcdFramesRemaining--;
-					if (pcdFramesRemaining <= 0) {
-						pcdSaveActive = false;
-						statusLabelBar->setText("PCD保存完成");
-					}
-				} else {
-					logMessage(QString("PCD保存失败: %1").arg(QDir::toNativeSeparators(filePath)));
-					// 即使失败也避免卡住
-					pcdLastSavedTimestamp = now_ns;
-					pcdFramesRemaining--;
+	// 保存PCD：在渲染循环中，当开启保存任务时按帧保存
+	if (pcdSaveActive && pcdFramesRemaining > 0) {
+		// 用合并窗口末尾时间戳作为文件名（纳秒）
+		if (pcdLastSavedTimestamp != now_ns) {
+			QString fileName = QString::number(now_ns) + ".pcd";
+			QString filePath = QDir(pcdSaveDir).filePath(fileName);
+			if (savePointCloudAsPCD(filePath, merged.points)) {
+				logMessage(QString("PCD保存: %1").arg(QDir::toNativeSeparators(filePath)), LogInfo, "pcd-save");
+				pcdLastSavedTimestamp = now_ns;
+				pcdFramesRemaining--;
+				if (pcdFramesRemaining <= 0) {
+					pcdSaveActive = false;
+					statusLabelBar->setText("PCD保存完成");
 				}
+			} else {
+				logMessage(QString("PCD保存失败: %1").arg(QDir::toNativeSeparators(filePath)), LogError, "pcd-save-failed");
+				// 即使失败也避免卡住
+				pcdLastSavedTimestamp = now_ns;
+				pcdFramesRemaining--;
 			}
 		}
-		// 保存LAS：与PCD一致的触发策略
-		if (lasSaveActive && lasFramesRemaining > 0) {
-			if (lasLastSavedTimestamp != now_ns) {
-				QString fileName = QString::number(now_ns) + ".las";
-				QString filePath = QDir(lasSaveDir).filePath(fileName);
-				if (savePointCloudAsLAS(filePath, merged.points)) {
-					logMessage(QString("LAS保存: %1").arg(QDir::toNativeSeparators(filePath)));
-					lasLastSavedTimestamp = now_ns;
-					lasFramesRemaining--;
-					if (lasFramesRemaining <= 0) {
-						lasSaveActive = false;
-						statusLabelBar->setText("LAS保存完成");
-					}
-				} else {
-					logMessage(QString("LAS保存失败: %1").arg(QDir::toNativeSeparators(filePath)));
-					lasLastSavedTimestamp = now_ns;
-					lasFramesRemaining--;
+	}
+	// 保存LAS：与PCD一致的触发策略
+	if (lasSaveActive && lasFramesRemaining > 0) {
+		if (lasLastSavedTimestamp != now_ns) {
+			QString fileName = QString::number(now_ns) + ".las";
+			QString filePath = QDir(lasSaveDir).filePath(fileName);
+			if (savePointCloudAsLAS(filePath, merged.points)) {
+				logMessage(QString("LAS保存: %1").arg(QDir::toNativeSeparators(filePath)), LogInfo, "las-save");
+				lasLastSavedTimestamp = now_ns;
+				lasFramesRemaining--;
+				if (lasFramesRemaining <= 0) {
+					lasSaveActive = false;
+					statusLabelBar->setText("LAS保存完成");
 				}
+			} else {
+				logMessage(QString("LAS保存失败: %1").arg(QDir::toNativeSeparators(filePath)), LogError, "las-save-failed");
+				lasLastSavedTimestamp = now_ns;
+				lasFramesRemaining--;
 			}
 		}
-		publishPointCloudFrame(merged);
-	}
-
-	if (selectionRealtimeEnabled && pointCloudWidget && (attrTable || selectionTable)) {
-		updateSelectionTableAndLog();
 	}
+	publishPointCloudFrame(merged, latencyTracker.frameMerged(info.latency, info.mergedNs));
 }
 
 void MainWindow::onMeasurementUpdated()
@@ -1076,6 +1117,7 @@ void MainWindow::onPointSizeChanged(int px)
 void MainWindow::onColorModeChanged(int index)
 {
     colorMode = index;
+    syncPipelineOptions();
     if (solidColorRow) {
         solidColorRow->setEnabled(colorMode == ColorSolid);
     }
@@ -1099,6 +1141,7 @@ void MainWindow::onSolidColorClicked()
     QColor c = QColorDialog::getColor(solidColor, this, "选择点云颜色");
     if (!c.isValid()) return;
     solidColor = c;
+    syncPipelineOptions();
     if (solidColorPreview) {
         solidColorPreview->setStyleSheet(QString("background-color: %1;").arg(solidColor.name()));
     }
@@ -1108,11 +1151,13 @@ void MainWindow::onProjectionDepthChanged(double meters)
 {
     if (meters < 0.0) meters = 0.0;
     projectionDepthMeters = static_cast<float>(meters);
+    syncPipelineOptions();
 }
 
 void MainWindow::onProjectionDepthToggled(bool enabled)
 {
     projectionDepthEnabled = enabled;
+    syncPipelineOptions();
     if (projectionDepthSpin) {
         projectionDepthSpin->setEnabled(enabled);
     }
@@ -1122,6 +1167,7 @@ void MainWindow::onProjectionDepthToggled(bool enabled)
 void MainWindow::onPlanarProjectionToggled(bool enabled)
 {
     planarProjectionEnabled = enabled;
+    syncPipelineOptions();
     if (enabled) {
         logMessage("平面投影模式已启用");
         statusLabelBar->setText("平面投影模式已启用");
@@ -1148,6 +1194,7 @@ void MainWindow::onPlanarProjectionRadiusChanged(double radius)
 {
     if (radius < 1.0) radius = 1.0;
     planarProjectionRadius = static_cast<float>(radius);
+    syncPipelineOptions();
     logMessage(QString("平面投影半径已设置为 %1 m").arg(radius));
 }
 
@@ -1218,31 +1265,53 @@ void MainWindow::onSelectionFinished()
     updateSelectionTableAndLog();
 } 
 
-void MainWindow::startLvx2Recording(const QString& filePath, int durationSec)
+void MainWindow::startLvx2Recording(const QString& filePath, int durationSec, bool rawPackets)
 {
     QMutexLocker lk(&lvx2Mutex);
     if (lvx2SaveActive) return;
-    lvx2File.setFileName(filePath);
-    if (!lvx2File.open(QIODevice::WriteOnly)) {
+    // 所有在线设备的包都会写入，设备表逐一列出并带上主机外参（点数据仍为雷达坐标系）
+    QVector<LVX2DeviceInfo> infos;
+    {
+        QMutexLocker deviceLocker(&deviceMutex);
+        for (const DeviceInfo& d : devices) {
+            LVX2DeviceInfo dev{};
+            const QByteArray snb = d.sn.left(15).toLatin1();
+            std::memcpy(dev.lidar_sn, snb.constData(), std::min<size_t>(size_t(snb.size()), sizeof(dev.lidar_sn)));
+            dev.lidar_id = d.handle;
+            dev.device_type = d.dev_type;
+            auto ext = hostExtrinsics.constFind(d.handle);
+            if (ext != hostExtrinsics.constEnd()) {
+                dev.roll = ext->roll;
+                dev.pitch = ext->pitch;
+                dev.yaw = ext->yaw;
+                dev.x = ext->x;
+                dev.y = ext->y;
+                dev.z = ext->z;
+            }
+            infos.append(dev);
+        }
+    }
+    if (infos.isEmpty()) {
+        LVX2DeviceInfo dev{};
+        std::memcpy(dev.lidar_sn, "Unknown", 7);
+        infos.append(dev);
+    }
+    if (!lvx2Writer.open(filePath, infos)) {
         logMessage("打开LVX2文件失败");
         currentCapture = CaptureNone;
         return;
     }
-    // 写头
-    LVX2PublicHeader pub;
-    lvx2File.write(reinterpret_cast<const char*>(&pub), sizeof(pub));
-    LVX2PrivateHeader pri;
-    lvx2File.write(reinterpret_cast<const char*>(&pri), sizeof(pri));
-    LVX2DeviceInfo dev{};
-    QByteArray snb = currentDevice ? currentDevice->sn.left(15).toLatin1() : QByteArray("Unknown");
-    std::memset(dev.lidar_sn, 0, sizeof(dev.lidar_sn));
-    std::memcpy(dev.lidar_sn, snb.constData(), std::min<size_t>(size_t(snb.size()), sizeof(dev.lidar_sn)));
-    dev.lidar_id = currentDevice ? currentDevice->handle : 0;
-    lvx2File.write(reinterpret_cast<const char*>(&dev), sizeof(dev));
 
     lvx2SaveActive = true;
-    lvx2FrameStartNs = 0;
-    lvx2FrameIndex = 0;
+    if (rawPackets) {
+        const QString rawPath = QFileInfo(filePath).path() + "/" + QFileInfo(filePath).completeBaseName() + ".lvxraw";
+        if (rawCaptureWriter.open(rawPath)) {
+            rawCaptureActive = true;
+            logMessage(QString("原始数据包保存路径: %1").arg(QDir::toNativeSeparators(rawPath)));
+        } else {
+            logMessage("打开原始数据包文件失败，仅录制LVX2", LogWarning);
+        }
+    }
     // 借用采集计时器
     captureSecondsRemaining = durationSec;
     captureProgress->setValue(0);
@@ -1253,42 +1322,13 @@ void MainWindow::stopLvx2Recording(bool flushPending)
 {
     QMutexLocker lk(&lvx2Mutex);
     if (!lvx2SaveActive) return;
-    Q_UNUSED(flushPending);
     lvx2SaveActive = false;
-    if (lvx2File.isOpen()) lvx2File.close();
+    lvx2Writer.close(flushPending);
+    if (rawCaptureActive.exchange(false)) rawCaptureWriter.close();
 }
 
-QVector<Point3D> MainWindow::applyPointCloudFilters(const QVector<Point3D>& inputPoints)
+void MainWindow::applyPointCloudFilters(QVector<Point3D>& points)
 {
-    if (inputPoints.isEmpty()) {
-        return inputPoints;
-    }
-
-    QVector<Point3D> filteredPoints = inputPoints;
-
-    // 噪点处理（基于tag值识别）
-    if (showNoisePoints || removeNoisePoints) {
-        QVector<Point3D> processedPoints;
-        for (const Point3D& p : filteredPoints) {
-            bool isNoise = filterTagMatches(p.tag);
-            Point3D processedPoint = p;
-            
-            if (showNoisePoints && isNoise) {
-                // 高亮噪点（红色）
-                processedPoint.r = 1.0f;
-                processedPoint.g = 0.0f;
-                processedPoint.b = 0.0f;
-            }
-            
-            if (!removeNoisePoints || !isNoise) {
-                // 根据设置决定是否保留噪点
-                processedPoints.append(processedPoint);
-            }
-        }
-        filteredPoints = processedPoints;
-    }
-
-
-
-    return filteredPoints;
+    // 噪点处理（基于tag值识别）：高亮为红色或直接剔除
+    applyTagNoiseFilter(points, noiseFilterTags, showNoisePoints, removeNoisePoints);
 }
@@ -1,4 +1,5 @@
 #include "mainwindow.h"
+#include "point_select.h"
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -6,6 +7,10 @@
 #include <QLinearGradient>
 #include <QOpenGLFunctions>
 
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
 // PointCloudWidget 实现
 PointCloudWidget::PointCloudWidget(QWidget *parent)
     : QOpenGLWidget(parent)
@@ -29,6 +34,13 @@ PointCloudWidget::PointCloudWidget(QWidget *parent)
 
 PointCloudWidget::~PointCloudWidget()
 {
+    if (m_gpuQueries[0] != 0 && context()) {
+        makeCurrent();
+        glDeleteQueries(kGpuQueryCount, m_gpuQueries);
+        releaseLodBuffers(true);
+        m_lodVao.destroy();
+        doneCurrent();
+    }
     if (m_program) {
         delete m_program;
     }
@@ -80,6 +92,14 @@ void PointCloudWidget::initializeGL()
     setupShaders();
     setupBuffers();
     setupAxesBuffers();
+    glGenQueries(kGpuQueryCount, m_gpuQueries);
+
+    // 累积地图节点共用一个 VAO，绘制每个节点前重新指向其 VBO
+    m_lodVao.create();
+    m_lodVao.bind();
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    m_lodVao.release();
 }
 
 void PointCloudWidget::setupShaders()
@@ -239,6 +259,8 @@ QVector3D PointCloudWidget::mapToArcball(const QPoint& p) const
 
 void PointCloudWidget::paintGL()
 {
+    TraceZone trace("paintGL");
+    ScopedStageTimer paintTimer(m_stats, StagePaint);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
     if (!m_program) {
@@ -305,11 +327,41 @@ void PointCloudWidget::paintGL()
         }
     }
     
-    // 绘制点云
-    if (!m_points.isEmpty()) {
-        m_vao.bind();
-        glDrawArrays(GL_POINTS, 0, m_points.size());
-        m_vao.release();
+    // 绘制点云（统计或自适应预算开启时用 GPU 计时查询测量绘制耗时）
+    if (m_lodEnabled || !m_points.isEmpty()) {
+        int drawCount = m_points.size();
+        if (!m_lodEnabled && m_vboStale) {
+            QMutexLocker locker(&m_pointsMutex);
+            m_vbo.bind();
+            m_vbo.allocate(m_points.constData(), m_points.size() * int(sizeof(Point3D)));
+            m_vbo.release();
+            m_pointsStratified = false;
+            m_vboStale = false;
+        }
+        if (!m_lodEnabled && m_renderBudget.isEnabled()) {
+            drawCount = m_renderBudget.pointsToDraw(m_points.size(), hostMonotonicNs());
+            if (drawCount < m_points.size()) ensureStratifiedOrder();
+        }
+        bool timing = false;
+        const bool measure = (m_stats && m_stats->isEnabled()) || m_renderBudget.isEnabled();
+        if (measure && m_gpuQueries[0] != 0) {
+            collectGpuQueries();
+            timing = !m_gpuQueryPending[m_gpuQueryIndex];
+            if (timing) glBeginQuery(GL_TIME_ELAPSED, m_gpuQueries[m_gpuQueryIndex]);
+        }
+        if (m_lodEnabled) {
+            drawCount = drawLod();
+        } else {
+            m_vao.bind();
+            glDrawArrays(GL_POINTS, 0, drawCount);
+            m_vao.release();
+        }
+        if (timing) {
+            glEndQuery(GL_TIME_ELAPSED);
+            m_gpuQueryPending[m_gpuQueryIndex] = true;
+            m_gpuQueryPoints[m_gpuQueryIndex] = drawCount;
+            m_gpuQueryIndex = (m_gpuQueryIndex + 1) % kGpuQueryCount;
+        }
     }
     
     m_program->release();
@@ -466,6 +518,189 @@ void PointCloudWidget::paintGL()
         painter.setPen(pen);
         painter.drawRect(r.adjusted(0,0,-1,-1));
     }
+
+    // 左上角性能叠加层
+    if (m_statsOverlayVisible && !m_statsOverlayLines.isEmpty()) {
+        QPainter painter(this);
+        QFont mono = painter.font();
+        mono.setFamily("Consolas");
+        mono.setStyleHint(QFont::Monospace);
+        mono.setPointSizeF(mono.pointSizeF() * 0.9);
+        painter.setFont(mono);
+        QFontMetrics fm(mono);
+        int textWidth = 0;
+        for (const QString& line : m_statsOverlayLines) textWidth = std::max(textWidth, fm.horizontalAdvance(line));
+        const int lineHeight = fm.height();
+        QRect box(8, 8, textWidth + 16, lineHeight * m_statsOverlayLines.size() + 12);
+        painter.fillRect(box, QColor(0, 0, 0, 160));
+        painter.setPen(QColor(220, 220, 220));
+        int y = box.top() + 6 + fm.ascent();
+        for (const QString& line : m_statsOverlayLines) {
+            painter.drawText(box.left() + 8, y, line);
+            y += lineHeight;
+        }
+    }
+}
+
+void PointCloudWidget::collectGpuQueries()
+{
+    for (int i = 0; i < kGpuQueryCount; ++i) {
+        if (!m_gpuQueryPending[i]) continue;
+        GLuint available = 0;
+        glGetQueryObjectuiv(m_gpuQueries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(m_gpuQueries[i], GL_QUERY_RESULT, &ns);
+        m_gpuQueryPending[i] = false;
+        if (m_stats && m_stats->isEnabled()) m_stats->recordStage(StageGpuDraw, ns);
+        m_renderBudget.recordFrame(m_gpuQueryPoints[i], ns);
+    }
+}
+
+void PointCloudWidget::setAdaptiveBudgetEnabled(bool enabled)
+{
+    m_renderBudget.setEnabled(enabled);
+    update();
+}
+
+RenderBudgetStatus PointCloudWidget::renderBudgetStatus() const
+{
+    return m_renderBudget.status(m_points.size(), hostMonotonicNs());
+}
+
+void PointCloudWidget::noteCameraMotion()
+{
+    m_renderBudget.noteCameraMotion(hostMonotonicNs());
+}
+
+// 选出可见节点并绘制：无 GPU 缓冲或点集已变化的节点在每帧上传上限内（重新）上传，
+// 超出上限时已有缓冲的节点先用旧数据绘制，新节点顺延到后续帧
+int PointCloudWidget::drawLod()
+{
+    const QMatrix4x4 mvp = m_projection * m_modelView;
+    const QVector3D eye = m_modelView.inverted().map(QVector3D(0.0f, 0.0f, 0.0f));
+    const float dpr = devicePixelRatioF();
+    OctreeView view;
+    view.mvp = mvp.constData();
+    view.eye[0] = eye.x();
+    view.eye[1] = eye.y();
+    view.eye[2] = eye.z();
+    view.projScale = float(height()) * dpr / (2.0f * std::tan(45.0f * float(M_PI) / 360.0f));
+    view.minSpacingPx = m_pointSize;
+    view.pointBudget = kLodMaxPoints;
+    if (m_renderBudget.isEnabled()) view.pointBudget = m_renderBudget.pointsToDraw(kLodMaxPoints, hostMonotonicNs());
+    m_octree.select(view, m_lodSelection);
+
+    m_lodFrame++;
+    qint64 uploaded = 0;
+    int uploads = 0;
+    int drawn = 0;
+    m_lodVao.bind();
+    for (int node : m_lodSelection.nodes) {
+        const QVector<Point3D>& points = m_octree.nodePoints(node);
+        const uint32_t version = m_octree.nodeVersion(node);
+        LodBuffer& b = m_lodBuffers[node];
+        if (b.vbo == 0 || b.version != version) {
+            const qint64 bytes = qint64(points.size()) * qint64(sizeof(Point3D));
+            if (uploaded == 0 || uploaded + bytes <= kLodUploadBytesPerFrame) {
+                if (b.vbo == 0) glGenBuffers(1, &b.vbo);
+                glBindBuffer(GL_ARRAY_BUFFER, b.vbo);
+                glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(bytes), points.constData(), GL_DYNAMIC_DRAW);
+                m_lodGpuBytes += bytes - qint64(b.count) * qint64(sizeof(Point3D));
+                b.version = version;
+                b.count = points.size();
+                uploaded += bytes;
+                uploads++;
+            } else if (b.vbo == 0) {
+                m_lodBuffers.remove(node);
+                continue;
+            }
+        }
+        b.lastUsedFrame = m_lodFrame;
+        glBindBuffer(GL_ARRAY_BUFFER, b.vbo);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Point3D), reinterpret_cast<const void*>(offsetof(Point3D, x)));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Point3D), reinterpret_cast<const void*>(offsetof(Point3D, r)));
+        glDrawArrays(GL_POINTS, 0, b.count);
+        drawn += b.count;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_lodVao.release();
+    if (m_lodGpuBytes > kLodGpuBudgetBytes) releaseLodBuffers(false);
+
+    m_lodStats.visibleNodes = m_lodSelection.nodes.size();
+    m_lodStats.culledNodes = m_lodSelection.culled;
+    m_lodStats.cachedNodes = m_lodBuffers.size();
+    m_lodStats.uploads = uploads;
+    m_lodStats.drawnPoints = drawn;
+    m_lodStats.gpuBytes = m_lodGpuBytes;
+    m_lodStats.tree = m_octree.counters();
+    return drawn;
+}
+
+// all 为 false 时按最近使用时间淘汰本帧未用到的节点，直到低于显存上限
+void PointCloudWidget::releaseLodBuffers(bool all)
+{
+    QVector<QPair<uint64_t, int>> candidates;
+    for (auto it = m_lodBuffers.constBegin(); it != m_lodBuffers.constEnd(); ++it) {
+        if (all || it.value().lastUsedFrame < m_lodFrame) candidates.append(qMakePair(it.value().lastUsedFrame, it.key()));
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto& c : candidates) {
+        if (!all && m_lodGpuBytes <= kLodGpuBudgetBytes) break;
+        LodBuffer b = m_lodBuffers.take(c.second);
+        if (b.vbo != 0) glDeleteBuffers(1, &b.vbo);
+        m_lodGpuBytes -= qint64(b.count) * qint64(sizeof(Point3D));
+    }
+}
+
+void PointCloudWidget::setAccumulationEnabled(bool enabled)
+{
+    if (m_lodEnabled == enabled) return;
+    m_lodEnabled = enabled;
+    clearAccumulated();
+}
+
+void PointCloudWidget::appendAccumulated(const QVector<Point3D>& points)
+{
+    if (!m_lodEnabled) return;
+    TraceZone trace("octreeInsert");
+    m_octree.insert(points);
+    update();
+}
+
+void PointCloudWidget::clearAccumulated()
+{
+    m_octree.clear();
+    m_lodSelection = OctreeSelection();
+    m_lodStats = LodRenderStats();
+    if (!m_lodBuffers.isEmpty() && context()) {
+        makeCurrent();
+        releaseLodBuffers(true);
+        doneCurrent();
+    }
+    m_lodBuffers.clear();
+    m_lodGpuBytes = 0;
+    update();
+}
+
+// 暂停可视化时点集不再更新，预算开始生效时就地重排并重新上传一次
+void PointCloudWidget::ensureStratifiedOrder()
+{
+    if (m_pointsStratified) return;
+    QMutexLocker locker(&m_pointsMutex);
+    stratifyPointOrder(m_points, m_stratifyScratch);
+    m_points.swap(m_stratifyScratch);
+    m_vbo.bind();
+    m_vbo.allocate(m_points.constData(), m_points.size() * int(sizeof(Point3D)));
+    m_vbo.release();
+    m_pointsStratified = true;
+}
+
+void PointCloudWidget::setStatsOverlay(bool visible, const QStringList& lines)
+{
+    m_statsOverlayVisible = visible;
+    m_statsOverlayLines = lines;
+    update();
 }
 
 void PointCloudWidget::resizeGL(int w, int h)
@@ -528,6 +763,7 @@ void PointCloudWidget::mouseMoveEvent(QMouseEvent *event)
         if (axis.lengthSquared() > 1e-6f && angle > 1e-6f) {
             QQuaternion dq = QQuaternion::fromAxisAndAngle(axis.normalized(), angle * 180.0f / float(M_PI));
             m_orientation = dq * m_orientation;
+            noteCameraMotion();
         }
     } else if (m_activeButton == Qt::MiddleButton || m_activeButton == Qt::RightButton) {
         float aspect = (float)qMax(1, width()) / (float)qMax(1, height());
@@ -536,6 +772,7 @@ void PointCloudWidget::mouseMoveEvent(QMouseEvent *event)
         float worldPerPixelX = worldPerPixelY * aspect;
         m_panOffset.setX(m_panOffset.x() + delta.x() * worldPerPixelX);
         m_panOffset.setY(m_panOffset.y() - delta.y() * worldPerPixelY);
+        noteCameraMotion();
     }
     
     m_lastMousePos = event->pos();
@@ -597,16 +834,36 @@ void PointCloudWidget::wheelEvent(QWheelEvent *event)
 {
     m_distance -= event->angleDelta().y() * 0.01f;
     m_distance = qMax(1.0f, m_distance);
+    noteCameraMotion();
     update();
 }
 
 void PointCloudWidget::updatePointCloud(const PointCloudFrame& frame)
 {
+    TraceZone trace("updatePointCloud");
+    ScopedStageTimer uploadTimer(m_stats, StageUpload);
     QMutexLocker locker(&m_pointsMutex);
-    m_points = frame.points;
+    if (m_lodEnabled) {
+        // 累积模式只绘制八叉树，窗口点仅用于选点与框选
+        m_points = frame.points;
+        m_pointsStratified = false;
+        m_vboStale = true;
+        if (m_stats) m_stats->recordUpload(0);  // 节点上传在 paintGL 中进行，这里只计帧
+        update();
+        return;
+    }
+    // 预算会抽稀时按分层顺序上传，绘制范围取前缀即为均匀子集
+    m_pointsStratified = m_renderBudget.wouldLimit(frame.points.size());
+    if (m_pointsStratified) {
+        stratifyPointOrder(frame.points, m_points);
+    } else {
+        m_points = frame.points;
+    }
+    const int bytes = m_points.size() * int(sizeof(Point3D));
     m_vbo.bind();
-    m_vbo.allocate(m_points.constData(), m_points.size() * sizeof(Point3D));
+    m_vbo.allocate(m_points.constData(), bytes);
     m_vbo.release();
+    if (m_stats) m_stats->recordUpload(uint64_t(bytes));
     update();
 }
 
@@ -614,6 +871,7 @@ void PointCloudWidget::clearPointCloud()
 {
     QMutexLocker locker(&m_pointsMutex);
     m_points.clear();
+    m_pointsStratified = false;
     printf("PointCloudWidget: cleared all points\n");
     update();
 }
@@ -625,6 +883,7 @@ void PointCloudWidget::resetView()
     // 重置视角：X 向上、Y 向左、Z 向外（绕 Z 轴 +90°）
     m_orientation = QQuaternion::fromAxisAndAngle(QVector3D(0, 0, 1), 90.0f);
     m_panOffset = QVector3D(0, 0, 0);
+    noteCameraMotion();
     update();
 }
 
@@ -649,6 +908,7 @@ void PointCloudWidget::setTopDownView()
     m_orientation = QQuaternion::fromAxisAndAngle(QVector3D(1, 0, 0), 0.0f);
     m_distance = 15.0f;  // 稍微拉远一点以便观察整个平面
     m_panOffset = QVector3D(0, 0, 0);
+    noteCameraMotion();
     update();
 } 
 
@@ -671,61 +931,40 @@ void PointCloudWidget::setSelectionModeEnabled(bool enabled)
 
 QVector<Point3D> PointCloudWidget::pointsInRect(const QRect& rect, int maxPoints)
 {
-    QVector<Point3D> result;
-    if (rect.isEmpty()) return result;
-    QMatrix4x4 mvp = m_projection * m_modelView;
+    if (rect.isEmpty()) return QVector<Point3D>();
+    const QMatrix4x4 mvp = m_projection * m_modelView;
+    ScreenSelection sel;
+    sel.mvp = mvp.constData();
+    sel.viewportW = float(width());
+    sel.viewportH = float(height());
+    sel.left = rect.left(); sel.top = rect.top();
+    sel.right = rect.right(); sel.bottom = rect.bottom();
+    sel.pixelSnap = true;
     QMutexLocker locker(&m_pointsMutex);
-    result.reserve(qMin(maxPoints, m_points.size()));
-    for (const Point3D& p : m_points) {
-        QVector4D hp(p.x, p.y, p.z, 1.0f);
-        QVector4D clip = mvp * hp;
-        if (clip.w() == 0.0f) continue;
-        QVector3D ndc = clip.toVector3DAffine();
-        float sx = (ndc.x() * 0.5f + 0.5f) * width();
-        float sy = (1.0f - (ndc.y() * 0.5f + 0.5f)) * height();
-        if (rect.contains(QPoint(int(sx), int(sy)))) {
-            result.push_back(p);
-            if (result.size() >= maxPoints) break;
-        }
-    }
-    return result;
+    return selectPointsInScreenRect(m_points, sel, maxPoints);
 }
 
 QVector<Point3D> PointCloudWidget::pointsInAabb(const QVector3D& min, const QVector3D& max, int maxPoints)
 {
-    QVector<Point3D> result;
+    const float lo[3] = { min.x(), min.y(), min.z() };
+    const float hi[3] = { max.x(), max.y(), max.z() };
     QMutexLocker locker(&m_pointsMutex);
-    result.reserve(qMin(maxPoints, m_points.size()));
-    for (const Point3D& p : m_points) {
-        if (p.x >= min.x() && p.x <= max.x() &&
-            p.y >= min.y() && p.y <= max.y() &&
-            p.z >= min.z() && p.z <= max.z()) {
-            result.push_back(p);
-            if (result.size() >= maxPoints) break;
-        }
-    }
-    return result;
+    return selectPointsInAabb(m_points, lo, hi, maxPoints);
 }
 
 QVector<Point3D> PointCloudWidget::pointsInPersistSelection(int maxPoints)
 {
-    QVector<Point3D> result;
-    if (!m_selectionLocked) return result;
-    QMatrix4x4 mvp = m_selProjection * m_selModelView;
+    if (!m_selectionLocked) return QVector<Point3D>();
+    const QMatrix4x4 mvp = m_selProjection * m_selModelView;
+    ScreenSelection sel;
+    sel.mvp = mvp.constData();
+    sel.modelView = m_selModelView.constData();
+    sel.viewportW = float(m_selViewportW);
+    sel.viewportH = float(m_selViewportH);
+    sel.left = m_selRectLogical.left(); sel.top = m_selRectLogical.top();
+    sel.right = m_selRectLogical.right(); sel.bottom = m_selRectLogical.bottom();
+    sel.viewZMin = m_selViewZMin;
+    sel.viewZMax = m_selViewZMax;
     QMutexLocker locker(&m_pointsMutex);
-    result.reserve(qMin(maxPoints, m_points.size()));
-    for (const Point3D& p : m_points) {
-        QVector4D hp(p.x, p.y, p.z, 1.0f);
-        QVector4D clip = mvp * hp;
-        if (clip.w() == 0.0f) continue;
-        QVector3D ndc = clip.toVector3DAffine();
-        float sx = (ndc.x() * 0.5f + 0.5f) * float(m_selViewportW);
-        float sy = (1.0f - (ndc.y() * 0.5f + 0.5f)) * float(m_selViewportH);
-        float vz = (m_selModelView * hp).z();
-        if (sx >= m_selRectLogical.left() && sx <= m_selRectLogical.right() && sy >= m_selRectLogical.top() && sy <= m_selRectLogical.bottom() && vz >= m_selViewZMin && vz <= m_selViewZMax) {
-            result.push_back(p);
-            if (result.size() >= maxPoints) break;
-        }
-    }
-    return result;
+    return selectPointsInScreenRect(m_points, sel, maxPoints);
 } 
\ No newline at end of file
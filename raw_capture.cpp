@@ -0,0 +1,100 @@
+#include "raw_capture.h"
+#include "point_decode.h"
+#include <QMutexLocker>
+#include <cstddef>
+#include <cstring>
+
+static const char kRawCaptureMagic[8] = { 'L', 'V', 'X', 'R', 'A', 'W', '0', '1' };
+
+uint32_t ethernetPacketSize(const LivoxLidarEthernetPacket* packet)
+{
+    if (!packet) return 0;
+    uint32_t pointSize = packet->data_type == kLivoxLidarImuData
+        ? uint32_t(sizeof(LivoxLidarImuRawPoint))
+        : pointDataSize(packet->data_type);
+    return uint32_t(offsetof(LivoxLidarEthernetPacket, data)) + pointSize * packet->dot_num;
+}
+
+bool RawCaptureWriter::open(const QString& filePath)
+{
+    QMutexLocker lk(&m_mutex);
+    if (m_file.isOpen()) m_file.close();
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return m_file.write(kRawCaptureMagic, sizeof(kRawCaptureMagic)) == qint64(sizeof(kRawCaptureMagic));
+}
+
+void RawCaptureWriter::close()
+{
+    QMutexLocker lk(&m_mutex);
+    if (m_file.isOpen()) m_file.close();
+}
+
+bool RawCaptureWriter::write(uint32_t handle, uint8_t devType, RawCaptureKind kind,
+                             const LivoxLidarEthernetPacket* packet, uint64_t hostNs)
+{
+    if (!packet) return false;
+    RawCaptureRecordHeader hdr;
+    hdr.host_ns = hostNs;
+    hdr.handle = handle;
+    hdr.dev_type = devType;
+    hdr.kind = kind;
+    hdr.size = ethernetPacketSize(packet);
+
+    QMutexLocker lk(&m_mutex);
+    if (!m_file.isOpen()) return false;
+    if (m_file.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr)) != qint64(sizeof(hdr))) return false;
+    return m_file.write(reinterpret_cast<const char*>(packet), hdr.size) == qint64(hdr.size);
+}
+
+bool RawCaptureReader::open(const QString& filePath)
+{
+    close();
+    m_error.clear();
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = QString("无法打开文件: %1").arg(filePath);
+        return false;
+    }
+    char magic[sizeof(kRawCaptureMagic)] = {};
+    if (m_file.read(magic, sizeof(magic)) != qint64(sizeof(magic)) ||
+        memcmp(magic, kRawCaptureMagic, sizeof(magic)) != 0) {
+        m_error = "不是有效的原始数据包文件";
+        close();
+        return false;
+    }
+    return true;
+}
+
+void RawCaptureReader::close()
+{
+    if (m_file.isOpen()) m_file.close();
+}
+
+void RawCaptureReader::rewind()
+{
+    if (m_file.isOpen()) m_file.seek(sizeof(kRawCaptureMagic));
+}
+
+bool RawCaptureReader::next(RawCaptureRecord& record)
+{
+    if (!m_file.isOpen() || m_file.atEnd()) {
+        return false;
+    }
+    if (m_file.read(reinterpret_cast<char*>(&record.header), sizeof(record.header)) != qint64(sizeof(record.header))) {
+        return false;
+    }
+    // 至少包含完整包头，且不超过 UDP 报文上限
+    if (record.header.size < offsetof(LivoxLidarEthernetPacket, data) || record.header.size > 65535) {
+        m_error = QString("记录长度异常: %1").arg(record.header.size);
+        return false;
+    }
+    record.packet = m_file.read(record.header.size);
+    if (record.packet.size() != int(record.header.size)) {
+        m_error = "记录数据不完整";
+        return false;
+    }
+    return true;
+}
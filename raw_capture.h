@@ -0,0 +1,82 @@
+#ifndef RAW_CAPTURE_H
+#define RAW_CAPTURE_H
+
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QByteArray>
+#include <cstdint>
+
+extern "C" {
+    #include "livox_lidar_def.h"
+}
+
+// 原始数据包录制文件（.lvxraw）
+// 文件头为 8 字节魔数，随后是若干条记录：RawCaptureRecordHeader + 完整以太网数据包
+#pragma pack(push, 1)
+struct RawCaptureRecordHeader {
+    uint64_t host_ns = 0;   // 主机接收时间（ns）
+    uint32_t handle = 0;    // 设备句柄
+    uint8_t dev_type = 0;   // 设备类型
+    uint8_t kind = 0;       // 0 点云 / 1 IMU
+    uint32_t size = 0;      // 数据包字节数
+};
+#pragma pack(pop)
+
+enum RawCaptureKind : uint8_t {
+    RawCapturePointCloud = 0,
+    RawCaptureImu = 1
+};
+
+struct RawCaptureRecord {
+    RawCaptureRecordHeader header;
+    QByteArray packet;
+    const LivoxLidarEthernetPacket* ethernetPacket() const {
+        return reinterpret_cast<const LivoxLidarEthernetPacket*>(packet.constData());
+    }
+};
+
+// 以太网数据包实际字节数（包头 + dot_num 个点）
+uint32_t ethernetPacketSize(const LivoxLidarEthernetPacket* packet);
+
+class RawCaptureWriter
+{
+public:
+    RawCaptureWriter() = default;
+    ~RawCaptureWriter() { close(); }
+
+    bool open(const QString& filePath);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+    // 线程安全，可直接在 SDK 回调线程中调用
+    bool write(uint32_t handle, uint8_t devType, RawCaptureKind kind,
+               const LivoxLidarEthernetPacket* packet, uint64_t hostNs);
+
+private:
+    QFile m_file;
+    QMutex m_mutex;
+};
+
+class RawCaptureReader
+{
+public:
+    RawCaptureReader() = default;
+    ~RawCaptureReader() { close(); }
+
+    bool open(const QString& filePath);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+    QString errorString() const { return m_error; }
+    qint64 fileSize() const { return m_file.size(); }
+    qint64 position() const { return m_file.pos(); }
+    void rewind();
+
+    // 读取下一条记录；到达文件末尾或数据损坏时返回 false
+    bool next(RawCaptureRecord& record);
+
+private:
+    QFile m_file;
+    QString m_error;
+};
+
+#endif // RAW_CAPTURE_H
@@ -0,0 +1,98 @@
+#include "render_budget.h"
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+const int kStrata = 256;    // 分层数（2 的幂），层内为恒定步长读取，预取友好
+
+int reverseBits(int v, int bits)
+{
+    int r = 0;
+    for (int i = 0; i < bits; ++i) {
+        r = (r << 1) | (v & 1);
+        v >>= 1;
+    }
+    return r;
+}
+
+// 单点成本下可在目标帧间隔内绘制的点数
+int budgetFor(double nsPerPoint, int fps, int minBudget)
+{
+    const double points = 1e9 / double(fps) * RenderBudget::kDrawShare / nsPerPoint;
+    if (points >= double(INT_MAX)) return INT_MAX;
+    return points > double(minBudget) ? int(points) : minBudget;
+}
+
+} // namespace
+
+void stratifyPointOrder(const QVector<Point3D>& in, QVector<Point3D>& out)
+{
+    const int n = in.size();
+    out.resize(n);
+    if (n == 0) return;
+    // 第 r 层为序号 ≡ r (mod kStrata) 的点；层按位反转顺序输出，
+    // 前 k 层恰好是间隔 kStrata/k 的均匀层，前缀落在层内时也只偏向一层
+    int bits = 0;
+    while ((1 << bits) < kStrata) ++bits;
+    const Point3D* src = in.constData();
+    Point3D* dst = out.data();
+    for (int k = 0; k < kStrata; ++k) {
+        const int r = reverseBits(k, bits);
+        for (int i = r; i < n; i += kStrata) *dst++ = src[i];
+    }
+}
+
+void RenderBudget::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    reset();
+}
+
+void RenderBudget::setTargetFps(int fps)
+{
+    m_targetFps = std::max(1, fps);
+    // 单点成本不变，按新的帧间隔重新换算
+    if (m_nsPerPoint > 0.0) m_budget = budgetFor(m_nsPerPoint, m_targetFps, kMinBudget);
+}
+
+void RenderBudget::recordFrame(int drawnPoints, uint64_t drawNs)
+{
+    if (!m_enabled || drawnPoints < kMinSamplePoints || drawNs == 0) return;
+    const double sample = double(drawNs) / double(drawnPoints);
+    m_nsPerPoint = m_nsPerPoint > 0.0 ? m_nsPerPoint + (sample - m_nsPerPoint) * 0.2 : sample;
+
+    const int desired = budgetFor(m_nsPerPoint, m_targetFps, kMinBudget);
+    if (m_budget == 0 || desired < m_budget) {
+        m_budget = desired;
+    } else {
+        m_budget = int(std::min(double(desired), double(m_budget) * kGrowth));
+    }
+}
+
+int RenderBudget::pointsToDraw(int totalPoints, uint64_t nowNs) const
+{
+    if (!wouldLimit(totalPoints) || isCameraSettled(nowNs)) return totalPoints;
+    return m_budget;
+}
+
+RenderBudgetStatus RenderBudget::status(int totalPoints, uint64_t nowNs) const
+{
+    RenderBudgetStatus s;
+    s.enabled = m_enabled;
+    s.targetFps = m_targetFps;
+    s.budget = m_budget;
+    s.totalPoints = totalPoints;
+    s.drawnPoints = pointsToDraw(totalPoints, nowNs);
+    s.limiting = s.drawnPoints < totalPoints;
+    s.settled = wouldLimit(totalPoints) && !s.limiting;
+    s.nsPerPoint = m_nsPerPoint;
+    return s;
+}
+
+void RenderBudget::reset()
+{
+    m_budget = 0;
+    m_nsPerPoint = 0.0;
+}
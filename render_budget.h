@@ -0,0 +1,63 @@
+#ifndef RENDER_BUDGET_H
+#define RENDER_BUDGET_H
+
+#include "point_types.h"
+#include <QVector>
+#include <cstdint>
+
+// 把点重排为分层顺序：按序号分成 kStrata 层，层号按位反转顺序依次输出。
+// 合并点集按采集时间排列，任意前缀 [0, n) 都是在时间（各设备、整个扫描视场）上
+// 均匀分层的子集，而不是最早的 n 个点；调整预算只需改绘制范围，无需重新上传。
+void stratifyPointOrder(const QVector<Point3D>& in, QVector<Point3D>& out);
+
+struct RenderBudgetStatus {
+    bool enabled = false;
+    bool limiting = false;      // 本帧按预算抽稀
+    bool settled = false;       // 相机静止，恢复全密度
+    int targetFps = 30;
+    int budget = 0;             // 当前点数预算（0：尚未测得耗时，不限制）
+    int drawnPoints = 0;
+    int totalPoints = 0;
+    double nsPerPoint = 0.0;    // 估计的单点绘制耗时
+};
+
+// 自适应绘制点数预算：按实测绘制耗时估计单点成本，使点云绘制占用目标帧间隔的固定份额。
+// 预算下降立即生效、上升逐帧放宽，避免在阈值附近来回抖动；相机静止 kSettleNs 后按全密度绘制。
+// 仅在 GUI 线程使用。
+class RenderBudget
+{
+public:
+    static const int kMinBudget = 50000;            // 预算下限，避免点云过于稀疏
+    static const int kMinSamplePoints = 5000;       // 点数过少时耗时不稳定，不参与估计
+    static const uint64_t kSettleNs = 300000000;    // 相机静止多久后恢复全密度
+    static constexpr double kDrawShare = 0.6;       // 点云绘制可占用的帧间隔比例（其余留给合并、上传和界面）
+    static constexpr double kGrowth = 1.2;          // 每帧预算最多放宽的倍数
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+    void setTargetFps(int fps);
+    int targetFps() const { return m_targetFps; }
+
+    // 相机旋转、平移、缩放时调用
+    void noteCameraMotion(uint64_t nowNs) { m_lastMotionNs = nowNs; }
+    bool isCameraSettled(uint64_t nowNs) const { return nowNs - m_lastMotionNs >= kSettleNs; }
+
+    // 记录一帧点云绘制的 GPU 耗时（计时查询结果，通常滞后几帧）
+    void recordFrame(int drawnPoints, uint64_t drawNs);
+    // 本帧应绘制的点数（分层顺序的前缀长度）
+    int pointsToDraw(int totalPoints, uint64_t nowNs) const;
+    // 当前预算是否会对 totalPoints 个点抽稀（相机静止时也可能为 true，用于决定是否预先分层重排）
+    bool wouldLimit(int totalPoints) const { return m_enabled && m_budget > 0 && totalPoints > m_budget; }
+
+    RenderBudgetStatus status(int totalPoints, uint64_t nowNs) const;
+    void reset();
+
+private:
+    bool m_enabled = false;
+    int m_targetFps = 30;
+    int m_budget = 0;
+    double m_nsPerPoint = 0.0;
+    uint64_t m_lastMotionNs = 0;
+};
+
+#endif // RENDER_BUDGET_H
@@ -15,6 +15,10 @@
 #include <QTimer>
 #include <QProcess>
 
+static const int kDiscoveryTimeoutMs = 30000;  // 未发现任何雷达时停止扫描
+static const int kDiscoverySettleMs = 600;      // 首台可直连的雷达应答后，继续收集其余应答的时间
+static const int kFastStartupDeviceTimeoutMs = 5000;  // 快速启动后等待雷达上线的时间，超时回到设备发现
+
 // 添加网段检查的辅助函数
 bool isInSameSubnet(const QString &hostIP, const QString &currentIP, const QString &subnetMask)
 {
@@ -230,12 +234,18 @@ void MainWindow::setupLivoxSDK()
 {
     logMessage("开始初始化Livox SDK...");
 
-    if (sdk_initialized || sdk_started)
+    if (sdk_initialized || sdk_started || sdkInitPending.load())
     {
         logMessage("Livox SDK 已初始化，跳过");
         return;
     }
 
+#ifdef LIVOX_SDK_MOCK
+    // 模拟SDK：数据来自回放文件或合成数据，无需网口、SDK库文件与配置文件
+    logMessage("使用模拟 Livox SDK，跳过网口与配置文件检查");
+    const QString configPath;
+#else
+
     // 1) 优先检查有线网口是否有设备连接
     if (!hasWiredNetworkDeviceConnected())
     {
@@ -417,48 +427,231 @@ void MainWindow::setupLivoxSDK()
         }
     }
 
-    try
+#endif
+
+    startSdkInit(configPath);
+}
+
+void MainWindow::startSdkInit(const QString &configPath)
+{
+    if (sdkInitPending.exchange(true))
     {
-        if (!LivoxLidarSdkInit(configPath.toStdString().c_str()))
+        return;
+    }
+    if (sdkInitThread.joinable())
+    {
+        sdkInitThread.join();
+    }
+    sdkConfigPath = configPath;
+    sdkInitOk.store(false);
+
+    // LivoxLidarSdkInit 会读取配置、绑定端口，耗时数百毫秒，放到后台线程，不阻塞界面
+    sdkInitThread = std::thread([this, configPath]()
+                                {
+        const std::string path = configPath.toStdString();
+        bool ok = false;
+        try {
+            ok = LivoxLidarSdkInit(path.c_str());
+        } catch (...) {
+            ok = false;
+        }
+        sdkInitOk.store(ok);
+        QMetaObject::invokeMethod(this, [this, ok, configPath]() { onSdkInitFinished(ok, configPath); }, Qt::QueuedConnection); });
+}
+
+void MainWindow::onSdkInitFinished(bool ok, const QString &configPath)
+{
+    // cleanupLivoxSDK 已接管本次初始化结果
+    if (!sdkInitPending.exchange(false))
+    {
+        return;
+    }
+    if (sdkInitThread.joinable())
+    {
+        sdkInitThread.join();
+    }
+
+    if (!ok)
+    {
+        logMessage("错误: Livox SDK 初始化失败");
+        if (fastStartup)
         {
-            logMessage("错误: Livox SDK 初始化失败");
-            return;
+            fallbackToDiscovery("按缓存配置初始化 SDK 失败");
         }
+        return;
+    }
 
-        sdk_initialized = true;
-        logMessage("Livox SDK 初始化成功");
-        // 获取并打印 SDK 版本信息
-        LivoxLidarSdkVer sdkVersion;
-        GetLivoxLidarSdkVer(&sdkVersion);
-        logMessage(QString("Livox SDK 版本: v%1.%2.%3")
-                       .arg(sdkVersion.major)
-                       .arg(sdkVersion.minor)
-                       .arg(sdkVersion.patch));
-
-        // 设置回调函数
-        SetLivoxLidarInfoChangeCallback(onDeviceInfoChange, this);
-        SetLivoxLidarPointCloudCallBack(onPointCloudData, this);
-        SetLivoxLidarImuDataCallback(onImuData, this);
-        SetLivoxLidarInfoCallback(onStatusInfo, this);
-
-        sdk_started = true;
-        pointCloudCallbackEnabled = true; // 自动开始采样
-        statusLabelBar->setText("已连接 - 采样中");
-
-        QTimer::singleShot(5000, this, [this]()
+    sdk_initialized = true;
+    startupTimeline.mark(StartupSdkInit);
+    logMessage(QString("Livox SDK 初始化成功（启动后 %1 ms）").arg(startupTimeline.elapsedMs(StartupSdkInit)));
+    // 获取并打印 SDK 版本信息
+    LivoxLidarSdkVer sdkVersion;
+    GetLivoxLidarSdkVer(&sdkVersion);
+    logMessage(QString("Livox SDK 版本: v%1.%2.%3")
+                   .arg(sdkVersion.major)
+                   .arg(sdkVersion.minor)
+                   .arg(sdkVersion.patch));
+
+    // 设置回调函数
+    SetLivoxLidarInfoChangeCallback(onDeviceInfoChange, this);
+    SetLivoxLidarPointCloudCallBack(onPointCloudData, this);
+    SetLivoxLidarImuDataCallback(onImuData, this);
+    SetLivoxLidarInfoCallback(onStatusInfo, this);
+
+    sdk_started = true;
+    pointCloudCallbackEnabled = true; // 自动开始采样
+    statusLabelBar->setText("已连接 - 采样中");
+
+    if (fastStartup)
+    {
+        // 缓存配置下迟迟没有雷达上线，说明网络或设备已变化
+        QTimer::singleShot(kFastStartupDeviceTimeoutMs, this, [this, configPath]()
                            {
-            if (devices.isEmpty()) {
-            } else {
+            if (fastStartup && sdkConfigPath == configPath && devices.isEmpty()) {
+                fallbackToDiscovery(QString("%1 秒内未发现雷达").arg(kFastStartupDeviceTimeoutMs / 1000));
             } });
     }
-    catch (...)
+}
+
+bool MainWindow::tryFastStartup()
+{
+#ifdef LIVOX_SDK_MOCK
+    return false;
+#else
+    const StartupProfile profile = StartupProfile::load();
+    if (!profile.isValid())
+    {
+        return false;
+    }
+    if (!QFile::exists(profile.configPath))
+    {
+        logMessage("缓存的配置文件已不存在，使用完整启动流程");
+        StartupProfile::clear();
+        return false;
+    }
+
+    // 只做不涉及外部进程的快速检查：主机仍持有上次的 IP
+    bool hostIpPresent = false;
+    for (const QHostAddress &addr : QNetworkInterface::allAddresses())
+    {
+        if (addr.protocol() == QAbstractSocket::IPv4Protocol && addr.toString() == profile.hostIp)
+        {
+            hostIpPresent = true;
+            break;
+        }
+    }
+    if (!hostIpPresent)
+    {
+        logMessage(QString("主机已不再使用上次的IP %1，使用完整启动流程").arg(profile.hostIp));
+        return false;
+    }
+
+    fastStartup = true;
+    logMessage(QString("快速启动: 使用上次的网络配置（主机IP %1，雷达 %2）")
+                   .arg(profile.hostIp)
+                   .arg(profile.lidarSns.isEmpty() ? QString("未知") : profile.lidarSns.join(", ")));
+    startSdkInit(profile.configPath);
+
+    // 有线网口与配置文件 host_ip 的完整校验在后台进行，与界面构造、SDK 初始化并行
+    if (networkCheckThread.joinable())
+    {
+        networkCheckThread.join();
+    }
+    const QString configPath = profile.configPath;
+    networkCheckThread = std::thread([this, configPath]()
+                                     {
+        QString details;
+        const bool ok = hasWiredNetworkDeviceConnected() && checkConfigFileNetworkCompatibility(configPath, &details);
+        if (!ok && details.isEmpty()) details = "未检测到活动的有线网口";
+        QMetaObject::invokeMethod(this, [this, ok, details]() { onStartupNetworkChecked(ok, details); }, Qt::QueuedConnection); });
+    return true;
+#endif
+}
+
+void MainWindow::onStartupNetworkChecked(bool ok, const QString &details)
+{
+    if (networkCheckThread.joinable())
+    {
+        networkCheckThread.join();
+    }
+    if (!fastStartup)
+    {
+        return;
+    }
+    if (!ok)
     {
+        fallbackToDiscovery(details);
         return;
     }
+    startupTimeline.mark(StartupNetworkValidated);
+    logMessage(QString("后台网络校验通过（启动后 %1 ms）").arg(startupTimeline.elapsedMs(StartupNetworkValidated)));
+}
+
+void MainWindow::fallbackToDiscovery(const QString &reason)
+{
+    if (!fastStartup)
+    {
+        return;
+    }
+    fastStartup = false;
+    logMessage(QString("缓存的网络配置已失效（%1），改用设备发现流程").arg(reason), LogWarning);
+    StartupProfile::clear();
+    cleanupLivoxSDK();
+    startDeviceDiscovery();
+}
+
+void MainWindow::saveStartupProfile(const DeviceInfo &device)
+{
+    if (sdkConfigPath.isEmpty())
+    {
+        return;
+    }
+    if (fastStartup)
+    {
+        fastStartup = false;
+        logMessage(QString("快速启动成功，首台雷达于启动后 %1 ms 上线").arg(startupTimeline.elapsedMs(StartupFirstDevice)));
+    }
+
+    StartupProfile profile = StartupProfile::load();
+    const QString hostIp = getCurrentHostIP();
+    if (profile.hostIp != hostIp || profile.configPath != sdkConfigPath)
+    {
+        profile = StartupProfile();
+        profile.hostIp = hostIp;
+        profile.configPath = sdkConfigPath;
+    }
+    if (profile.hostIp.isEmpty())
+    {
+        return;
+    }
+    const int index = profile.lidarSns.indexOf(device.sn);
+    if (index >= 0 && index < profile.lidarIps.size() && profile.lidarIps[index] == device.lidar_ip)
+    {
+        return;
+    }
+    if (index >= 0)
+    {
+        profile.lidarSns.removeAt(index);
+        if (index < profile.lidarIps.size())
+            profile.lidarIps.removeAt(index);
+    }
+    profile.lidarSns.append(device.sn);
+    profile.lidarIps.append(device.lidar_ip);
+    profile.save();
 }
 
 void MainWindow::cleanupLivoxSDK()
 {
+    // 后台初始化尚未回到 GUI 线程：等待其结束并接管结果，之后到达的完成通知直接忽略
+    if (sdkInitThread.joinable())
+    {
+        sdkInitThread.join();
+    }
+    if (sdkInitPending.exchange(false) && sdkInitOk.load())
+    {
+        sdk_initialized = true;
+    }
+
     if (!sdk_started && !sdk_initialized)
     {
         return;
@@ -661,130 +854,149 @@ void MainWindow::startDeviceDiscovery()
 
     logMessage(QString("使用有线接口 IPv4 地址: %1").arg(hwIp));
 
-    // 创建UDP socket
-    discoverySocket = new QUdpSocket(this);
-
-    // 尝试绑定到有线 IP 的 56000 端口，重试10次，每次间隔1秒
-    int retryCount = 5;
-    bool bindOk = false;
-    for (int i = 0; i < retryCount; ++i)
+    // 每个在线 IPv4 网口一个套接字：多网口主机上各网口的雷达并行发现，应答从对应网口返回
+    discoveryInterfaces.clear();
+    discoveredLidars.clear();
+    discoverySettling = false;
+    for (const QNetworkInterface &iface : QNetworkInterface::allInterfaces())
     {
-        bindOk = discoverySocket->bind(QHostAddress(hwIp), 56000,
-                                       QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint);
-        if (bindOk)
+        const auto flags = iface.flags();
+        if (!(flags & QNetworkInterface::IsUp) ||
+            !(flags & QNetworkInterface::IsRunning) ||
+            (flags & QNetworkInterface::IsLoopBack) ||
+            !(flags & QNetworkInterface::CanBroadcast))
+            continue;
+        for (const QNetworkAddressEntry &entry : iface.addressEntries())
         {
-            break;
+            if (entry.ip().protocol() != QAbstractSocket::IPv4Protocol)
+                continue;
+            DiscoveryInterface di;
+            di.name = iface.humanReadableName();
+            di.ip = entry.ip();
+            di.netmask = entry.netmask();
+            di.broadcast = entry.broadcast().isNull() ? QHostAddress(QHostAddress::Broadcast) : entry.broadcast();
+            di.prefixLength = entry.prefixLength();
+            di.socket = new QUdpSocket(this);
+            // 优先绑定 56000（雷达应答到该端口）；被占用时该套接字只负责发送，应答由共享接收套接字接收
+            if (!di.socket->bind(di.ip, kDiscoveryPort, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint))
+            {
+                if (!di.socket->bind(di.ip, 0))
+                {
+                    logMessage(QString("警告: 网口 %1 (%2) 绑定失败，跳过: %3")
+                                   .arg(di.name, di.ip.toString(), di.socket->errorString()));
+                    delete di.socket;
+                    continue;
+                }
+                di.sendOnly = true;
+            }
+            discoveryInterfaces.append(di);
         }
-        else
+    }
+
+    // 有网口无法在 56000 接收、或一个网口都没有时，绑定一个 AnyIPv4:56000 的共享接收套接字
+    bool needReceiver = discoveryInterfaces.isEmpty();
+    for (const DiscoveryInterface &di : discoveryInterfaces)
+        needReceiver = needReceiver || di.sendOnly;
+    if (needReceiver)
+    {
+        discoveryReceiveSocket = new QUdpSocket(this);
+        if (!discoveryReceiveSocket->bind(QHostAddress::AnyIPv4, kDiscoveryPort, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint))
         {
-            logMessage(QString("警告: 绑定到 %1:56000 失败 (第%2次重试): %3")
-                           .arg(hwIp)
-                           .arg(i + 1)
-                           .arg(discoverySocket->errorString()));
-            // 等待1秒后重试
-            QThread::sleep(1);
+            logMessage(QString("警告: 无法绑定 AnyIPv4:%1 接收应答: %2").arg(kDiscoveryPort).arg(discoveryReceiveSocket->errorString()));
+            delete discoveryReceiveSocket;
+            discoveryReceiveSocket = nullptr;
+            // 收不到应答的网口发送也无意义
+            for (int i = discoveryInterfaces.size() - 1; i >= 0; --i)
+            {
+                if (!discoveryInterfaces[i].sendOnly)
+                    continue;
+                logMessage(QString("警告: 网口 %1 (%2) 无法接收发现应答，跳过")
+                               .arg(discoveryInterfaces[i].name, discoveryInterfaces[i].ip.toString()));
+                delete discoveryInterfaces[i].socket;
+                discoveryInterfaces.remove(i);
+            }
         }
     }
-    if (!bindOk)
+    if (discoveryInterfaces.isEmpty())
     {
-        logMessage(QString("警告: 绑定到 %1:56000 失败: %2")
-                       .arg(hwIp)
-                       .arg(discoverySocket->errorString()));
-        // 最小回退：尝试绑定到 AnyIPv4
-        if (!discoverySocket->bind(QHostAddress::AnyIPv4, 56000,
-                                   QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint))
+        if (!discoveryReceiveSocket)
         {
-            logMessage("警告: 回退绑定到 AnyIPv4 仍失败，无法启动设备发现");
-            delete discoverySocket;
-            discoverySocket = nullptr;
+            logMessage("警告: 没有可用于设备发现的网口，无法启动设备发现");
             return;
         }
-        else
-        {
-            logMessage("已回退绑定到 AnyIPv4:56000（注意：广播可能不会从有线接口发出）");
-        }
+        // 最小回退：由共享接收套接字发送全网广播
+        DiscoveryInterface di;
+        di.name = "any";
+        di.ip = QHostAddress(QHostAddress::AnyIPv4);
+        di.broadcast = QHostAddress(QHostAddress::Broadcast);
+        di.socket = discoveryReceiveSocket;
+        discoveryReceiveSocket = nullptr;
+        logMessage("已回退绑定到 AnyIPv4:56000（注意：广播可能不会从有线接口发出）");
+        discoveryInterfaces.append(di);
     }
-    else
-    {
-        logMessage(QString("已绑定 discovery socket 到 %1:56000（将使用该接口发送广播）")
-                       .arg(hwIp));
-    }
-
-    // 连接readyRead信号
-    connect(discoverySocket, &QUdpSocket::readyRead, this, [this]() {
-        while (discoverySocket->hasPendingDatagrams()) {
-            QByteArray datagram;
-            datagram.resize(discoverySocket->pendingDatagramSize());
-            QHostAddress sender;
-            quint16 senderPort = 0;
-            discoverySocket->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
-
-            QString senderIP = sender.toString();
-            QString localIP = discoverySocket->localAddress().toString();
-
-            // === Step 1: 构建本机所有IPv4地址集合 ===
-            static QSet<QString> localIPv4Set;
-            if (localIPv4Set.isEmpty()) {
-                for (const QNetworkInterface &iface : QNetworkInterface::allInterfaces()) {
-                    if (!(iface.flags() & QNetworkInterface::IsUp) ||
-                        !(iface.flags() & QNetworkInterface::IsRunning) ||
-                        (iface.flags() & QNetworkInterface::IsLoopBack))
-                        continue;
-                    for (const QNetworkAddressEntry &entry : iface.addressEntries()) {
-                        if (entry.ip().protocol() == QAbstractSocket::IPv4Protocol)
-                            localIPv4Set.insert(entry.ip().toString());
-                    }
-                }
-            }
-
-            // === Step 2: 判断是否“来自本机的包” ===
-            bool isTrulyLocal = localIPv4Set.contains(senderIP);
-
-            // === Step 3: 判断当前Socket是否绑定在特定接口上 ===
-            bool boundToValidInterface = !(localIP == "0.0.0.0" ||
-                                           localIP.startsWith("169.254."));
 
-            // === Step 4: 仅当Socket绑定在特定接口上，且包确实来自本机，才忽略 ===
-            if (boundToValidInterface && isTrulyLocal) {
-                logMessage(QString("忽略来自本机接口的数据包: %1 (绑定接口: %2)")
-                               .arg(senderIP)
-                               .arg(localIP));
-                continue;
+    QStringList names;
+    for (int i = 0; i < discoveryInterfaces.size(); ++i)
+    {
+        const DiscoveryInterface &di = discoveryInterfaces[i];
+        names << QString("%1 %2→%3%4").arg(di.name, di.ip.toString(), di.broadcast.toString(), di.sendOnly ? "（仅发送）" : "");
+        if (di.sendOnly)
+            continue;
+        QUdpSocket *socket = di.socket;
+        connect(socket, &QUdpSocket::readyRead, this, [this, socket, i]() {
+            while (socket->hasPendingDatagrams())
+            {
+                QByteArray datagram;
+                datagram.resize(int(socket->pendingDatagramSize()));
+                QHostAddress sender;
+                socket->readDatagram(datagram.data(), datagram.size(), &sender);
+                // 本机发出的请求会被自己收到，由 parseDiscoveryReply 按 cmd_type 过滤
+                onDeviceDiscoveryResponse(datagram, sender, i);
+                // 处理应答时可能已停止发现（套接字已释放）
+                if (!discoveryActive)
+                    break;
             }
-
-            // === Step 5: 额外防护：当主机与设备IP完全一致时，禁止忽略 ===
-            QString currentHostIP = getCurrentHostIP();
-            if (senderIP == currentHostIP) {
-                logMessage(QString("警告: 收到与主机相同IP(%1)的UDP包，可能是雷达设备冲突，仍尝试解析").arg(senderIP));
-                // 不continue，继续解析
+        });
+    }
+    if (discoveryReceiveSocket)
+    {
+        QUdpSocket *socket = discoveryReceiveSocket;
+        connect(socket, &QUdpSocket::readyRead, this, [this, socket]() {
+            while (socket->hasPendingDatagrams())
+            {
+                QByteArray datagram;
+                datagram.resize(int(socket->pendingDatagramSize()));
+                QHostAddress sender;
+                socket->readDatagram(datagram.data(), datagram.size(), &sender);
+                // 共享套接字收到的应答按发送方所在子网归到对应网口
+                onDeviceDiscoveryResponse(datagram, sender, discoveryInterfaceFor(sender));
+                if (!discoveryActive)
+                    break;
             }
+        });
+        names << QString("AnyIPv4:%1（共享接收）").arg(kDiscoveryPort);
+    }
+    logMessage(QString("设备发现网口: %1").arg(names.join("; ")));
 
-            // === Step 6: 正常解析 ===
-            onDeviceDiscoveryResponse(datagram, sender);
-        }
-    });
-
-
-    // 创建定时器，定期发送广播发现命令
+    // 发送节奏：立即发送，随后 100ms 起倍增重发，3s 封顶；30 秒内未发现设备则停止
     discoveryTimer = new QTimer(this);
-    connect(discoveryTimer, &QTimer::timeout, this, &MainWindow::sendBroadcastDiscovery);
-
-    // 创建超时定时器，30秒后自动停止设备发现
-    QTimer *timeoutTimer = new QTimer(this);
-    timeoutTimer->setSingleShot(true);
-    connect(timeoutTimer, &QTimer::timeout, this, [this]()
+    discoveryTimer->setSingleShot(true);
+    connect(discoveryTimer, &QTimer::timeout, this, [this]()
             {
-        if (discoveryActive) {
+        if (!discoveryActive) return;
+        if (discoveredLidars.isEmpty() && discoveryClock.elapsed() > kDiscoveryTimeoutMs) {
             logMessage("设备发现超时，未发现设备，停止扫描");
             stopDeviceDiscovery();
-        } });
-
-    // 立即发送一次，然后每3秒发送一次
-    sendBroadcastDiscovery();
-    discoveryTimer->start(3000);
-    timeoutTimer->start(30000);
+            return;
+        }
+        sendBroadcastDiscovery();
+        discoveryTimer->start(discoveryRetryDelayMs(++discoveryAttempt)); });
 
     discoveryActive = true;
+    discoveryAttempt = 0;
+    discoveryClock.start();
+    sendBroadcastDiscovery();
+    discoveryTimer->start(discoveryRetryDelayMs(0));
     logMessage("设备发现已启动，正在扫描网络中的Livox设备...");
 }
 
@@ -804,188 +1016,119 @@ void MainWindow::stopDeviceDiscovery()
         discoveryTimer = nullptr;
     }
 
-    if (discoverySocket)
+    for (DiscoveryInterface &di : discoveryInterfaces)
     {
         // 先断开信号连接，避免在关闭过程中触发回调
-        discoverySocket->disconnect();
-        discoverySocket->close();
-        discoverySocket->deleteLater();
-        discoverySocket = nullptr;
+        di.socket->disconnect();
+        di.socket->close();
+        di.socket->deleteLater();
+    }
+    discoveryInterfaces.clear();
+    if (discoveryReceiveSocket)
+    {
+        discoveryReceiveSocket->disconnect();
+        discoveryReceiveSocket->close();
+        discoveryReceiveSocket->deleteLater();
+        discoveryReceiveSocket = nullptr;
     }
 
     discoveryActive = false;
+    discoverySettling = false;
     logMessage("设备发现已停止");
 }
 
+int MainWindow::discoveryInterfaceFor(const QHostAddress& sender) const
+{
+    const QHostAddress ipv4(sender.toIPv4Address());
+    for (int i = 0; i < discoveryInterfaces.size(); ++i)
+    {
+        const DiscoveryInterface &di = discoveryInterfaces[i];
+        if (di.prefixLength >= 0 && ipv4.isInSubnet(di.ip, di.prefixLength))
+            return i;
+    }
+    return -1;
+}
+
 void MainWindow::sendBroadcastDiscovery()
 {
-    if (!discoverySocket || !discoveryActive)
+    if (!discoveryActive)
     {
         return;
     }
 
     // 广播发现命令
-    QByteArray discoveryCmd = QByteArray::fromHex("aa00180002000000000000000000000000000a9200000000");
-
-    // 诊断：打印当前 socket 本地地址（便于确认发送接口）
-    QHostAddress la = discoverySocket->localAddress();
-    quint16 lp = discoverySocket->localPort();
-    logMessage(QString("准备发送广播（socket local=%1:%2）").arg(la.toString()).arg(lp));
-
-    // 发送到广播地址255.255.255.255:56000
-    qint64 sent = discoverySocket->writeDatagram(discoveryCmd, QHostAddress::Broadcast, 56000);
-
-    if (sent == -1)
+    const QByteArray discoveryCmd = discoveryRequest();
+    int sent = 0;
+    for (const DiscoveryInterface &di : discoveryInterfaces)
     {
-        logMessage("错误: 广播发现命令发送失败: " + discoverySocket->errorString());
+        // 子网定向广播：只从该网口发出
+        if (di.socket->writeDatagram(discoveryCmd, di.broadcast, kDiscoveryPort) >= 0)
+            sent++;
+        else
+            logMessage(QString("错误: 经 %1 广播发现命令失败: %2").arg(di.name, di.socket->errorString()),
+                       LogWarning, "discovery-send");
+        // 与主机不在同一网段的雷达不响应子网广播，另发一份全网广播（用于自动修改主机IP）
+        if (di.broadcast != QHostAddress(QHostAddress::Broadcast))
+            di.socket->writeDatagram(discoveryCmd, QHostAddress::Broadcast, kDiscoveryPort);
     }
-    else
+
+    if (discoveryAttempt == 0)
     {
-        static int sendCount = 0;
-        sendCount++;
-        if (sendCount <= 3)
-        {
-            logMessage(QString("已发送广播发现命令 (%1 字节, UDP广播到255.255.255.255:56000)").arg(sent));
-        }
+        logMessage(QString("已向 %1/%2 个网口发送广播发现命令 (%3 字节, UDP端口 %4)")
+                       .arg(sent).arg(discoveryInterfaces.size()).arg(discoveryCmd.size()).arg(kDiscoveryPort));
     }
 }
 
-void MainWindow::onDeviceDiscoveryResponse(const QByteArray &data, const QHostAddress &sender)
+void MainWindow::onDeviceDiscoveryResponse(const QByteArray &data, const QHostAddress &sender, int interfaceIndex)
 {
     try
     {
-        // 打印接收到的原始数据包内容
-        QString hexData = data.toHex(' ');
-        // logMessage(QString("收到UDP数据包，发送者: %1，数据长度: %2 字节").arg(sender.toString()).arg(data.size()));
-        // logMessage(QString("原始数据: %1").arg(hexData));
-
-        // 调用详细的包分析函数
-        // printPacketDetails(data, sender);
-
-        // 检查起始字节
-        if (static_cast<unsigned char>(data[0]) != 0xAA)
-        {
-            // logMessage(QString("起始字节错误，期望0xAA，实际收到0x%1").arg(QString::number(static_cast<unsigned char>(data[0]), 16).toUpper()));
-            return;
-        }
-
-        // 检查协议版本
-        if (static_cast<unsigned char>(data[1]) != 0x00)
+        DiscoveryReply reply;
+        if (!parseDiscoveryReply(data, &reply))
         {
-            // logMessage(QString("协议版本错误，期望0x00，实际收到0x%1").arg(QString::number(static_cast<unsigned char>(data[1]), 16).toUpper()));
             return;
         }
+        const QString deviceIP = discoveryIpString(reply.ip);
 
-        // 解析长度字段 (小端序)
-        uint16_t length = (static_cast<unsigned char>(data[3]) << 8) | static_cast<unsigned char>(data[2]);
-        // logMessage(QString("数据包长度字段: %1 字节 (小端序)").arg(length));
-        if (data.size() < length)
+        // 快速重发与多网口会收到同一台雷达的多次应答，按 SN 合并，只处理首次（或IP变化）
+        auto known = discoveredLidars.constFind(reply.sn);
+        if (known != discoveredLidars.constEnd() && known.value().ip == reply.ip)
         {
-            // logMessage(QString("数据包长度不匹配，长度字段: %1，实际数据: %2").arg(length).arg(data.size()));
             return;
         }
+        discoveredLidars.insert(reply.sn, reply);
 
-        // 检查cmd_id是否为0x0000 (广播发现)
-        uint16_t cmdId = (static_cast<unsigned char>(data[8]) << 8) | static_cast<unsigned char>(data[9]);
-        // logMessage(QString("命令ID: 0x%1").arg(QString::number(cmdId, 16).toUpper().rightJustified(4, '0')));
-        if (cmdId != 0x0000)
-        {
-            // logMessage(QString("命令ID不匹配，期望0x0000，实际收到0x%1").arg(QString::number(cmdId, 16).toUpper().rightJustified(4, '0')));
-            return;
-        }
+        const QString ifaceName = (interfaceIndex >= 0 && interfaceIndex < discoveryInterfaces.size())
+                                      ? discoveryInterfaces[interfaceIndex].name : QString("?");
+        logMessage(QString("发现雷达: %1 (IP: %2，网口: %3，用时 %4 ms)")
+                       .arg(reply.sn.isEmpty() ? sender.toString() : reply.sn)
+                       .arg(deviceIP).arg(ifaceName).arg(discoveryClock.elapsed()));
 
-        // 检查cmd_type是否为0x01 (ACK回复)
-        uint8_t cmdType = static_cast<unsigned char>(data[10]);
-        // logMessage(QString("命令类型: 0x%1").arg(QString::number(cmdType, 16).toUpper().rightJustified(2, '0')));
-        if (cmdType != 0x01)
+        // 与任一本机网口在同一子网即可直连
+        bool reachable = false;
+        for (const DiscoveryInterface &di : discoveryInterfaces)
         {
-            // logMessage(QString("命令类型不匹配，期望0x01 (ACK)，实际收到0x%1").arg(QString::number(cmdType, 16).toUpper().rightJustified(2, '0')));
-            return;
-        }
-
-        // 检查sender_type是否为1 (雷达)
-        uint8_t senderType = static_cast<unsigned char>(data[11]);
-        // logMessage(QString("发送者类型: 0x%1").arg(QString::number(senderType, 16).toUpper().rightJustified(2, '0')));
-        if (senderType != 0x01)
-        {
-            // logMessage(QString("发送者类型不匹配，期望0x01 (雷达)，实际收到0x%1").arg(QString::number(senderType, 16).toUpper().rightJustified(2, '0')));
-            return;
-        }
-
-        // 检查data段长度
-        if (data.size() < 24 + 24)
-        { // 包头24字节 + data段至少24字节
-            // logMessage(QString("data段长度不足，需要至少24字节，实际可用%1字节").arg(data.size() - 24));
-            return;
-        }
-
-        // 解析data段
-        int dataOffset = 24; // 跳过包头
-        // logMessage(QString("data段起始偏移: %1 字节").arg(dataOffset));
-
-        uint8_t retCode = static_cast<unsigned char>(data[dataOffset]);
-        // logMessage(QString("返回码: 0x%1").arg(QString::number(retCode, 16).toUpper().rightJustified(2, '0')));
-        if (retCode != 0x00)
-        {
-            // logMessage(QString("设备发现回复错误码: %1，表示操作失败").arg(retCode));
-            return;
-        }
-
-        // 解析雷达类型
-        uint8_t devType = static_cast<unsigned char>(data[dataOffset + 1]);
-        // logMessage(QString("雷达类型: 0x%1").arg(QString::number(devType, 16).toUpper().rightJustified(2, '0')));
-
-        // 解析序列号 (16字节)
-        QByteArray serialNumber = data.mid(dataOffset + 2, 16);
-        QString serialStr = QString::fromLatin1(serialNumber).trimmed();
-        // logMessage(QString("雷达序列号: %1").arg(serialStr));
-
-        // 跳过ret_code, dev_type, serial_number (1+1+16=18字节)
-        int ipOffset = dataOffset + 18;
-        // logMessage(QString("IP地址偏移: %1 字节").arg(ipOffset));
-
-        // 解析雷达IP地址 (4字节)
-        if (ipOffset + 4 > data.size())
-        {
-            // logMessage(QString("IP地址偏移超出数据包范围，偏移: %1，数据包大小: %2").arg(ipOffset).arg(data.size()));
-            return;
+            // 取不到掩码时按 255.255.255.0 处理（与旧版一致）
+            const quint32 mask = di.netmask.isNull() ? 0xFFFFFF00u : di.netmask.toIPv4Address();
+            if (!di.ip.isNull() && di.ip != QHostAddress(QHostAddress::AnyIPv4) && di.ip.toIPv4Address() != reply.ip &&
+                (di.ip.toIPv4Address() & mask) == (reply.ip & mask))
+            {
+                reachable = true;
+                break;
+            }
         }
-
-        QString deviceIP = QString("%1.%2.%3.%4")
-                               .arg(static_cast<unsigned char>(data[ipOffset]))
-                               .arg(static_cast<unsigned char>(data[ipOffset + 1]))
-                               .arg(static_cast<unsigned char>(data[ipOffset + 2]))
-                               .arg(static_cast<unsigned char>(data[ipOffset + 3]));
-
-        // logMessage(QString("解析到雷达IP: %1").arg(deviceIP));
-
-        // 解析控制端口 (2字节, 小端序)
-        if (ipOffset + 6 <= data.size())
+        // 回退绑定 AnyIPv4 时没有网口信息，按主机有线IP判断
+        QString currentHostIP = getCurrentHostIP();
+        const QHostAddress hostAddr(currentHostIP);
+        if (!reachable && !hostAddr.isNull() && hostAddr.toIPv4Address() != reply.ip &&
+            (hostAddr.toIPv4Address() & 0xFFFFFF00u) == (reply.ip & 0xFFFFFF00u))
         {
-            uint16_t cmdPort = (static_cast<unsigned char>(data[ipOffset + 5]) << 8) |
-                               static_cast<unsigned char>(data[ipOffset + 4]);
-            // logMessage(QString("雷达控制端口: %1").arg(cmdPort));
+            reachable = true;
         }
 
-        logMessage(QString("发现雷达: %1 (IP: %2)").arg(sender.toString()).arg(deviceIP));
-
         // 检查是否需要更新主机IP
-        QString currentHostIP = getCurrentHostIP();
         if (!currentHostIP.isEmpty())
         {
-            // 检查是否在同一网段
-            QHostAddress deviceAddr(deviceIP);
-            QHostAddress hostAddr(currentHostIP);
-
-            if (deviceAddr.isNull() || hostAddr.isNull())
-            {
-                return;
-            }
-
-            // 计算网络地址 (假设子网掩码为255.255.255.0)
-            quint32 deviceNet = deviceAddr.toIPv4Address() & 0xFFFFFF00;
-            quint32 hostNet = hostAddr.toIPv4Address() & 0xFFFFFF00;
-
             if (deviceIP == currentHostIP) {
                 logMessage(QString("检测到设备IP与主机IP完全相同 (%1)，存在地址冲突，必须更新主机IP")
                                .arg(deviceIP));
@@ -1002,8 +1145,14 @@ void MainWindow::onDeviceDiscoveryResponse(const QByteArray &data, const QHostAd
                 }
                 return; // 提前退出，避免继续误初始化 SDK
             }
-            else if (deviceNet != hostNet)
+            else if (!reachable)
             {
+                if (discoverySettling)
+                {
+                    // 已有可直连的雷达，不为个别雷达修改主机IP
+                    logMessage(QString("雷达 %1 与本机各网口均不在同一网段，本次忽略").arg(deviceIP));
+                    return;
+                }
                 logMessage(QString("设备IP %1 与主机IP %2 不在同一网段，需要更新主机IP").arg(deviceIP).arg(currentHostIP));
 
                 // 计算兼容的主机IP
@@ -1023,13 +1172,8 @@ void MainWindow::onDeviceDiscoveryResponse(const QByteArray &data, const QHostAd
                     }
                     lastAttemptedIP = newHostIP;
 
-                    if (discoverySocket)
-                    {
-                        discoverySocket->close();
-                        discoverySocket->deleteLater();
-                        discoverySocket = nullptr;
-                        logMessage("已临时关闭 discovery socket 以避免修改IP冲突");
-                    }
+                    // 修改IP前关闭发现套接字，避免冲突
+                    stopDeviceDiscovery();
 
                     // 尝试自动更新主机IP
                     if (updateHostIPForDevice(deviceIP))
@@ -1068,18 +1212,21 @@ void MainWindow::onDeviceDiscoveryResponse(const QByteArray &data, const QHostAd
                     }
                 }
             }
-            else
+            else if (!discoverySettling)
             {
-                logMessage(QString("设备IP %1 与主机IP %2 在同一网段，无需更新").arg(deviceIP).arg(currentHostIP));
+                logMessage(QString("设备IP %1 与本机网口在同一网段，无需更新").arg(deviceIP));
 
-                // 发现设备后，延迟停止设备发现，然后初始化SDK
-                logMessage("设备发现完成，准备停止扫描并初始化SDK");
+                // 发现首台可直连的雷达后继续快速重发一小段时间，合并其余雷达的应答，然后初始化SDK
+                discoverySettling = true;
+                logMessage("设备发现完成，等待其余设备应答后停止扫描并初始化SDK");
 
                 QTimer *stopTimer = new QTimer(this);
                 stopTimer->setSingleShot(true);
                 connect(stopTimer, &QTimer::timeout, this, [this, stopTimer]()
                         {
                 try {
+                    logMessage(QString("本轮共发现 %1 台雷达，用时 %2 ms").arg(discoveredLidars.size()).arg(discoveryClock.elapsed()));
+                    startupTimeline.mark(StartupDiscoveryDone);
                     if (discoveryActive) {
                         stopDeviceDiscovery();
                     }
@@ -1097,14 +1244,14 @@ void MainWindow::onDeviceDiscoveryResponse(const QByteArray &data, const QHostAd
                             initTimer->deleteLater();
                         }
                     });
-                    initTimer->start(500);
+                    initTimer->start(100);
 
                     stopTimer->deleteLater();
                 } catch (...) {
                     logMessage("停止设备发现时发生异常");
                     stopTimer->deleteLater();
                 } });
-                stopTimer->start(100);
+                stopTimer->start(kDiscoverySettleMs);
             }
         }
     }
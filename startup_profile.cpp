@@ -0,0 +1,79 @@
+#include "startup_profile.h"
+#include <QDateTime>
+#include <QPair>
+#include <QSettings>
+#include <QVector>
+#include <algorithm>
+
+const char* startupPhaseName(int phase)
+{
+    switch (phase) {
+        case StartupUiReady: return "界面";
+        case StartupDiscoveryDone: return "设备发现";
+        case StartupSdkInit: return "SDK 初始化";
+        case StartupNetworkValidated: return "网络校验";
+        case StartupFirstDevice: return "首台设备";
+        case StartupFirstPoint: return "首帧点云";
+        default: return "?";
+    }
+}
+
+StartupTimeline::StartupTimeline()
+{
+    for (auto& ms : m_ms) ms.store(-1, std::memory_order_relaxed);
+}
+
+void StartupTimeline::start()
+{
+    for (auto& ms : m_ms) ms.store(-1, std::memory_order_relaxed);
+    m_clock.start();
+}
+
+bool StartupTimeline::mark(StartupPhase phase)
+{
+    if (!m_clock.isValid() || m_ms[phase].load(std::memory_order_relaxed) >= 0) return false;
+    int64_t expected = -1;
+    return m_ms[phase].compare_exchange_strong(expected, m_clock.elapsed(), std::memory_order_relaxed);
+}
+
+QString StartupTimeline::report() const
+{
+    QVector<QPair<int64_t, int>> reached;
+    for (int i = 0; i < StartupPhaseCount; ++i) {
+        const int64_t ms = m_ms[i].load(std::memory_order_relaxed);
+        if (ms >= 0) reached.append(qMakePair(ms, i));
+    }
+    std::stable_sort(reached.begin(), reached.end(),
+                     [](const QPair<int64_t, int>& a, const QPair<int64_t, int>& b) { return a.first < b.first; });
+    QStringList parts;
+    for (const auto& r : reached) parts << QString("%1 %2 ms").arg(startupPhaseName(r.second)).arg(r.first);
+    return parts.join(", ");
+}
+
+StartupProfile StartupProfile::load()
+{
+    QSettings settings("Livox", "LivoxViewerQT");
+    StartupProfile p;
+    p.hostIp = settings.value("startup/hostIp").toString();
+    p.configPath = settings.value("startup/configPath").toString();
+    p.lidarSns = settings.value("startup/lidarSns").toStringList();
+    p.lidarIps = settings.value("startup/lidarIps").toStringList();
+    p.savedAtMs = settings.value("startup/savedAt", 0).toLongLong();
+    return p;
+}
+
+void StartupProfile::save() const
+{
+    QSettings settings("Livox", "LivoxViewerQT");
+    settings.setValue("startup/hostIp", hostIp);
+    settings.setValue("startup/configPath", configPath);
+    settings.setValue("startup/lidarSns", lidarSns);
+    settings.setValue("startup/lidarIps", lidarIps);
+    settings.setValue("startup/savedAt", QDateTime::currentMSecsSinceEpoch());
+}
+
+void StartupProfile::clear()
+{
+    QSettings settings("Livox", "LivoxViewerQT");
+    settings.remove("startup");
+}
@@ -0,0 +1,58 @@
+#ifndef STARTUP_PROFILE_H
+#define STARTUP_PROFILE_H
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <cstdint>
+
+enum StartupPhase {
+    StartupUiReady = 0,         // 主窗口构造完成
+    StartupDiscoveryDone,       // 设备发现结束（完整流程）
+    StartupSdkInit,             // LivoxLidarSdkInit 返回
+    StartupNetworkValidated,    // 后台网络校验通过（快速启动）
+    StartupFirstDevice,
+    StartupFirstPoint,
+    StartupPhaseCount
+};
+
+const char* startupPhaseName(int phase);
+
+// 启动阶段计时：记录各阶段首次到达时相对 start() 的耗时，任意线程可调用 mark()
+class StartupTimeline
+{
+public:
+    StartupTimeline();
+
+    void start();
+    // 仅首次标记生效；返回本次是否为首次
+    bool mark(StartupPhase phase);
+    bool reached(StartupPhase phase) const { return m_ms[phase].load(std::memory_order_relaxed) >= 0; }
+    int64_t elapsedMs(StartupPhase phase) const { return m_ms[phase].load(std::memory_order_relaxed); }
+    // 按到达顺序列出已到达的阶段，如 "界面 180 ms, SDK 初始化 420 ms, ..."
+    QString report() const;
+
+private:
+    QElapsedTimer m_clock;
+    std::atomic<int64_t> m_ms[StartupPhaseCount];
+};
+
+// 上次成功连上雷达时的网络与设备信息。下次启动时若主机仍持有该 IP 且配置文件仍在，
+// 跳过设备发现直接初始化 SDK，网络校验放到后台进行，校验失败再回到完整流程
+struct StartupProfile {
+    QString hostIp;
+    QString configPath;
+    QStringList lidarSns;
+    QStringList lidarIps;
+    qint64 savedAtMs = 0;       // 保存时间（Unix 时间 ms），save() 时取当前时间
+
+    bool isValid() const { return !hostIp.isEmpty() && !configPath.isEmpty(); }
+
+    // QSettings("Livox", "LivoxViewerQT") 的 startup/ 分组
+    static StartupProfile load();
+    void save() const;
+    static void clear();
+};
+
+#endif // STARTUP_PROFILE_H
@@ -0,0 +1,145 @@
+#include "stream_health.h"
+#include "point_decode.h"
+#include <QMutexLocker>
+#include <algorithm>
+
+const char* streamGapBucketName(int bucket)
+{
+    static const char* names[kStreamGapBuckets] = { "1", "2", "3-4", "5-8", "9-16", "17-64", "65-256", ">256" };
+    return (bucket >= 0 && bucket < kStreamGapBuckets) ? names[bucket] : "?";
+}
+
+namespace {
+
+int gapBucket(uint32_t gap)
+{
+    if (gap <= 2) return int(gap) - 1;
+    if (gap <= 4) return 2;
+    if (gap <= 8) return 3;
+    if (gap <= 16) return 4;
+    if (gap <= 64) return 5;
+    if (gap <= 256) return 6;
+    return 7;
+}
+
+} // namespace
+
+StreamHealthMonitor::StreamHealthMonitor()
+{
+    m_sinceSnapshot.start();
+}
+
+void StreamHealthMonitor::record(uint32_t handle, int kind, const LivoxLidarEthernetPacket* packet)
+{
+    if (!packet) return;
+    const uint64_t ts = parsePacketTimestamp(packet->timestamp);
+
+    QMutexLocker locker(&m_mutex);
+    StreamState& st = m_streams[streamKey(handle, kind)];
+    StreamHealthSummary& s = st.summary;
+    s.received++;
+
+    if (!st.started) {
+        st.started = true;
+        s.handle = handle;
+        s.kind = kind;
+        st.expectedUdp = uint16_t(packet->udp_cnt + 1);
+        st.receivedMask = 1;
+        st.lastFrame = packet->frame_cnt;
+        st.lastTimestamp = ts;
+        return;
+    }
+
+    const int diff = int(int16_t(uint16_t(packet->udp_cnt - st.expectedUdp)));
+
+    if (diff < 0 && -diff <= kReorderWindow) {
+        // 迟到的包：若之前按缺口计为丢包则扣回
+        const int k = -diff - 1;
+        const uint64_t bit = uint64_t(1) << k;
+        if (st.receivedMask & bit) {
+            s.duplicates++;
+        } else {
+            st.receivedMask |= bit;
+            s.reordered++;
+            if (s.lost > 0) s.lost--;
+        }
+        return;
+    }
+    if (diff < 0 ? -diff >= kResyncDistance : diff >= kResyncDistance) {
+        // 计数大幅跳变：设备重启或重新开始采样，从当前包重新同步
+        s.resyncs++;
+        st.expectedUdp = uint16_t(packet->udp_cnt + 1);
+        st.receivedMask = 1;
+        st.lastFrame = packet->frame_cnt;
+        st.lastTimestamp = ts;
+        return;
+    }
+    if (diff < 0) {
+        // 超出乱序窗口的旧包，无法判断是否已计为丢包
+        s.reordered++;
+        return;
+    }
+
+    // 顺序到达（diff > 0 表示中间丢了 diff 个包）
+    const uint32_t gap = uint32_t(diff);
+    if (gap > 0) {
+        s.lost += gap;
+        s.maxGap = std::max(s.maxGap, gap);
+        s.gapHistogram[gapBucket(gap)]++;
+    }
+    const uint32_t advance = gap + 1;
+    st.receivedMask = (advance >= 64 ? 0 : st.receivedMask << advance) | 1;
+    st.expectedUdp = uint16_t(packet->udp_cnt + 1);
+
+    const uint8_t frameDelta = uint8_t(packet->frame_cnt - st.lastFrame);
+    if (gap == 0 && frameDelta > 1) s.frameSkips++;
+    st.lastFrame = packet->frame_cnt;
+
+    // 时间戳：回退，或超出（丢包数 + 1）个平均间隔的 4 倍再加 1ms 视为跳变
+    const int64_t delta = int64_t(ts - st.lastTimestamp);
+    st.lastTimestamp = ts;
+    if (delta < 0) {
+        s.timestampBackward++;
+        s.lastJumpNs = delta;
+        return;
+    }
+    const double expected = st.avgIntervalNs * advance;
+    if (st.intervalSamples >= 16 && double(delta) > expected * 4.0 + 1e6) {
+        s.timestampJumps++;
+        s.lastJumpNs = int64_t(double(delta) - expected);
+        return;
+    }
+    const double interval = double(delta) / advance;
+    st.avgIntervalNs = st.intervalSamples == 0 ? interval : st.avgIntervalNs + (interval - st.avgIntervalNs) * 0.01;
+    st.intervalSamples++;
+}
+
+QVector<StreamHealthSummary> StreamHealthMonitor::snapshot()
+{
+    QVector<StreamHealthSummary> out;
+    QMutexLocker locker(&m_mutex);
+    const double seconds = std::max(1e-3, double(m_sinceSnapshot.restart()) / 1000.0);
+    out.reserve(m_streams.size());
+    for (auto it = m_streams.begin(); it != m_streams.end(); ++it) {
+        StreamState& st = it.value();
+        StreamHealthSummary s = st.summary;
+        const uint64_t expectedTotal = s.received + s.lost;
+        s.lossRate = expectedTotal ? double(s.lost) / double(expectedTotal) : 0.0;
+        // 迟到的包会扣回丢包数，区间内的差值可能为负
+        const double recvDelta = double(s.received - st.receivedAtSnapshot);
+        const double lostDelta = std::max(0.0, double(s.lost) - double(st.lostAtSnapshot));
+        s.recentLossRate = (recvDelta + lostDelta) > 0 ? lostDelta / (recvDelta + lostDelta) : 0.0;
+        s.packetsPerSec = recvDelta / seconds;
+        st.receivedAtSnapshot = s.received;
+        st.lostAtSnapshot = s.lost;
+        out.append(s);
+    }
+    return out;
+}
+
+void StreamHealthMonitor::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_streams.clear();
+    m_sinceSnapshot.restart();
+}
@@ -0,0 +1,80 @@
+#ifndef STREAM_HEALTH_H
+#define STREAM_HEALTH_H
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QVector>
+#include <cstdint>
+
+extern "C" {
+    #include "livox_lidar_def.h"
+}
+
+// 数据流类型（udp_cnt 按数据流各自递增）
+enum StreamKind {
+    StreamPointCloud = 0,
+    StreamImu = 1
+};
+
+// 连续丢包长度分布：1, 2, 3-4, 5-8, 9-16, 17-64, 65-256, >256
+static const int kStreamGapBuckets = 8;
+const char* streamGapBucketName(int bucket);
+
+struct StreamHealthSummary {
+    uint32_t handle = 0;
+    int kind = StreamPointCloud;
+    uint64_t received = 0;
+    uint64_t lost = 0;              // 按 udp_cnt 缺口推算（迟到的包会扣回）
+    uint64_t reordered = 0;         // 迟到（乱序）到达的包
+    uint64_t duplicates = 0;
+    uint64_t resyncs = 0;           // 计数大幅跳变（设备重启/重新开始采样），不计入丢包
+    uint64_t frameSkips = 0;        // frame_cnt 跳变次数
+    uint64_t timestampBackward = 0; // 时间戳回退
+    uint64_t timestampJumps = 0;    // 时间戳向前跳变（超出丢包可解释的范围）
+    int64_t lastJumpNs = 0;         // 最近一次时间戳异常的幅度
+    uint32_t maxGap = 0;            // 最大连续丢包数
+    uint64_t gapHistogram[kStreamGapBuckets] = {};
+    double lossRate = 0.0;          // 累计丢包率
+    double recentLossRate = 0.0;    // 距上次 snapshot 的丢包率
+    double packetsPerSec = 0.0;     // 距上次 snapshot
+};
+
+// 每设备数据链路健康监测：根据 udp_cnt/frame_cnt/timestamp 检测丢包、乱序、
+// 连续丢包（突发）与时间戳跳变，用于调整主机 socket 缓冲区、发现过载的采集主机。
+// record() 在 SDK 回调线程调用，snapshot() 在 GUI 线程调用。
+class StreamHealthMonitor
+{
+public:
+    static const int kReorderWindow = 64;       // 小于该距离的回退视为乱序
+    static const int kResyncDistance = 4096;    // 超过该距离的跳变视为重新同步
+
+    StreamHealthMonitor();
+
+    void record(uint32_t handle, int kind, const LivoxLidarEthernetPacket* packet);
+
+    QVector<StreamHealthSummary> snapshot();
+    void reset();
+
+private:
+    struct StreamState {
+        bool started = false;
+        uint16_t expectedUdp = 0;
+        uint64_t receivedMask = 0;      // bit i：udp_cnt 为 expectedUdp-1-i 的包已收到
+        uint8_t lastFrame = 0;
+        uint64_t lastTimestamp = 0;
+        double avgIntervalNs = 0.0;     // 相邻包时间戳间隔的滑动平均
+        uint64_t intervalSamples = 0;
+        uint64_t receivedAtSnapshot = 0;
+        uint64_t lostAtSnapshot = 0;
+        StreamHealthSummary summary;
+    };
+
+    static uint64_t streamKey(uint32_t handle, int kind) { return (uint64_t(handle) << 8) | uint64_t(kind & 0xFF); }
+
+    QMutex m_mutex;
+    QMap<uint64_t, StreamState> m_streams;
+    QElapsedTimer m_sinceSnapshot;
+};
+
+#endif // STREAM_HEALTH_H
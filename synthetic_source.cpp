@@ -0,0 +1,381 @@
+#include "synthetic_source.h"
+#include "point_decode.h"
+#include "packet_crc.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const SyntheticModelSpec kModelSpecs[] = {
+    // 名称      设备类型                点频(pts/s) 单包点数 帧率 IMU
+    { "Mid360", kLivoxLidarTypeMid360, 200000, 96, 10, 200 },
+    { "HAP",    kLivoxLidarTypeHAP,    452000, 96, 10, 200 },
+    { "Avia",   kLivoxLidarTypeAvia,   240000, 96, 10, 200 },
+};
+
+const SyntheticModelSpec& syntheticModelSpec(int model)
+{
+    if (model < 0 || model > SyntheticAvia) model = SyntheticMid360;
+    return kModelSpecs[model];
+}
+
+SyntheticLidarDevice::SyntheticLidarDevice(int model, uint8_t dataType, uint32_t handle, uint32_t seed)
+    : m_model(model)
+    , m_spec(syntheticModelSpec(model))
+    , m_dataType(dataType)
+    , m_handle(handle)
+    , m_rng(seed ? seed : 1)
+{
+    if (pointDataSize(m_dataType) == 0) {
+        m_dataType = kLivoxLidarCartesianCoordinateHighData;
+    }
+}
+
+void SyntheticLidarDevice::setDataType(uint8_t dataType)
+{
+    if (pointDataSize(dataType) != 0) {
+        m_dataType = dataType;
+    }
+}
+
+// count 个事件、每秒 rate 个时的时刻（ns），先分出整秒避免 64 位乘法溢出
+static uint64_t scheduleOffsetNs(uint64_t count, uint64_t rate)
+{
+    return count / rate * 1000000000ULL + count % rate * 1000000000ULL / rate;
+}
+
+uint64_t SyntheticLidarDevice::pointPacketOffsetNs(uint64_t n) const
+{
+    return scheduleOffsetNs(n * m_spec.pointsPerPacket, m_spec.pointsPerSecond);
+}
+
+uint64_t SyntheticLidarDevice::imuPacketOffsetNs(uint64_t n) const
+{
+    return scheduleOffsetNs(n, m_spec.imuRateHz);
+}
+
+float SyntheticLidarDevice::noise()
+{
+    // xorshift32，返回 [-1, 1)
+    m_rng ^= m_rng << 13;
+    m_rng ^= m_rng >> 17;
+    m_rng ^= m_rng << 5;
+    return static_cast<float>(m_rng >> 8) / 8388608.0f - 1.0f;
+}
+
+void SyntheticLidarDevice::scanDirection(uint64_t n, float& dx, float& dy, float& dz) const
+{
+    const double pointsPerFrame = double(m_spec.pointsPerSecond) / m_spec.frameRateHz;
+    double yawDeg = 0.0;
+    double pitchDeg = 0.0;
+
+    switch (m_model) {
+    case SyntheticHAP: {
+        // 120°x25° 视场，128 线交错扫描，每帧横向偏移形成非重复覆盖
+        const uint64_t frame = uint64_t(n / pointsPerFrame);
+        const double u = std::fmod(n / pointsPerFrame + frame * 0.013, 1.0);
+        const uint64_t row = (n * 37) % 128;
+        yawDeg = -60.0 + 120.0 * u;
+        pitchDeg = -12.5 + 25.0 * (row + 0.5) / 128.0;
+        break;
+    }
+    case SyntheticAvia: {
+        // 双棱镜花瓣扫描，70.4° 圆形视场
+        const double t = double(n) / m_spec.pointsPerSecond;
+        const double w1 = 2.0 * M_PI * 101.3;
+        const double w2 = -2.0 * M_PI * 67.9;
+        yawDeg = 17.6 * (std::cos(w1 * t) + std::cos(w2 * t));
+        pitchDeg = 17.6 * (std::sin(w1 * t) + std::sin(w2 * t));
+        break;
+    }
+    case SyntheticMid360:
+    default: {
+        // 360°x59°（-7°~52°）非重复扫描
+        yawDeg = 360.0 * std::fmod(n / (pointsPerFrame * 0.97), 1.0);
+        pitchDeg = -7.0 + 59.0 * std::fmod(n * 0.6180339887498949, 1.0);
+        break;
+    }
+    }
+
+    const double yaw = yawDeg * M_PI / 180.0;
+    const double pitch = pitchDeg * M_PI / 180.0;
+    dx = float(std::cos(pitch) * std::cos(yaw));
+    dy = float(std::cos(pitch) * std::sin(yaw));
+    dz = float(std::sin(pitch));
+}
+
+void SyntheticLidarDevice::tracePoint(float dx, float dy, float dz, float& range, uint8_t& reflectivity, uint8_t& tag)
+{
+    // 房间边界（雷达坐标系）
+    const float lo[3] = { -20.0f, -12.0f, -1.0f };
+    const float hi[3] = {  20.0f,  12.0f,  4.0f };
+    const float d[3] = { dx, dy, dz };
+
+    int axis = 0;
+    range = 1e9f;
+    for (int a = 0; a < 3; ++a) {
+        if (std::fabs(d[a]) < 1e-6f) continue;
+        const float t = (d[a] > 0 ? hi[a] : lo[a]) / d[a];
+        if (t < range) { range = t; axis = a; }
+    }
+
+    // 地面 / 天花板 / 两组墙面反射率不同，1m 棋盘格条纹
+    static const uint8_t kBase[3][2] = { { 140, 140 }, { 60, 60 }, { 25, 90 } };
+    const float hx = dx * range, hy = dy * range, hz = dz * range;
+    const int checker = (int(std::floor(hx)) + int(std::floor(hy)) + int(std::floor(hz))) & 1;
+    int refl = kBase[axis][d[axis] > 0 ? 1 : 0] + checker * 50;
+    refl += int(noise() * 8.0f);
+    reflectivity = uint8_t(std::clamp(refl, 0, 255));
+
+    range += noise() * 0.01f;
+    tag = 0;
+
+    // 约 0.5% 的近距离噪点（灰尘/雨雾）
+    if ((m_rng & 1023) < 5) {
+        range = 0.2f + 0.15f * (noise() + 1.0f);
+        reflectivity = uint8_t(5 + (m_rng & 7));
+        tag = 0x01;
+    }
+}
+
+void SyntheticLidarDevice::writePoint(uint8_t* dst, float dx, float dy, float dz, float range,
+                                      uint8_t reflectivity, uint8_t tag) const
+{
+    switch (m_dataType) {
+    case kLivoxLidarCartesianCoordinateLowData: {
+        LivoxLidarCartesianLowRawPoint p;
+        p.x = int16_t(std::lround(dx * range * 100.0f));
+        p.y = int16_t(std::lround(dy * range * 100.0f));
+        p.z = int16_t(std::lround(dz * range * 100.0f));
+        p.reflectivity = reflectivity;
+        p.tag = tag;
+        memcpy(dst, &p, sizeof(p));
+        break;
+    }
+    case kLivoxLidarSphericalCoordinateData: {
+        LivoxLidarSpherPoint p;
+        double theta = std::acos(std::clamp(double(dz), -1.0, 1.0)) * 180.0 / M_PI;
+        double phi = std::atan2(double(dy), double(dx)) * 180.0 / M_PI;
+        if (phi < 0) phi += 360.0;
+        p.depth = uint32_t(std::lround(range * 1000.0f));
+        p.theta = uint16_t(std::lround(theta * 100.0));
+        p.phi = uint16_t(std::lround(phi * 100.0) % 36000);
+        p.reflectivity = reflectivity;
+        p.tag = tag;
+        memcpy(dst, &p, sizeof(p));
+        break;
+    }
+    case kLivoxLidarCartesianCoordinateHighData:
+    default: {
+        LivoxLidarCartesianHighRawPoint p;
+        p.x = int32_t(std::lround(dx * range * 1000.0f));
+        p.y = int32_t(std::lround(dy * range * 1000.0f));
+        p.z = int32_t(std::lround(dz * range * 1000.0f));
+        p.reflectivity = reflectivity;
+        p.tag = tag;
+        memcpy(dst, &p, sizeof(p));
+        break;
+    }
+    }
+}
+
+LivoxLidarEthernetPacket* SyntheticLidarDevice::preparePacket(QByteArray& buffer, uint8_t dataType,
+                                                              uint32_t dotNum, uint64_t timestampNs)
+{
+    const uint32_t pointSize = (dataType == kLivoxLidarImuData) ? sizeof(LivoxLidarImuRawPoint) : pointDataSize(dataType);
+    const uint32_t size = uint32_t(offsetof(LivoxLidarEthernetPacket, data)) + pointSize * dotNum;
+    const int bufferSize = int(size);
+    if (buffer.size() != bufferSize) {
+        buffer.fill('\0', bufferSize);
+    }
+
+    LivoxLidarEthernetPacket* packet = reinterpret_cast<LivoxLidarEthernetPacket*>(buffer.data());
+    memset(packet, 0, offsetof(LivoxLidarEthernetPacket, data));
+    packet->version = 0;
+    packet->length = uint16_t(size);
+    packet->dot_num = uint16_t(dotNum);
+    packet->data_type = dataType;
+    packet->time_type = 0;
+    for (int i = 0; i < 8; ++i) {
+        packet->timestamp[i] = uint8_t(timestampNs >> (8 * i));
+    }
+    return packet;
+}
+
+LivoxLidarEthernetPacket* SyntheticLidarDevice::nextPointPacket(uint64_t timestampNs)
+{
+    const uint32_t dotNum = m_spec.pointsPerPacket;
+    const uint32_t pointSize = pointDataSize(m_dataType);
+    LivoxLidarEthernetPacket* packet = preparePacket(m_pointBuffer, m_dataType, dotNum, timestampNs);
+
+    const uint64_t pointsPerFrame = m_spec.pointsPerSecond / m_spec.frameRateHz;
+    m_frameCnt = uint8_t(m_pointIndex / pointsPerFrame);
+    packet->udp_cnt = m_udpCnt++;
+    packet->frame_cnt = m_frameCnt;
+    packet->time_interval = uint16_t(10000000ULL * dotNum / m_spec.pointsPerSecond); // 0.1us
+
+    uint8_t* dst = packet->data;
+    for (uint32_t i = 0; i < dotNum; ++i, ++m_pointIndex, dst += pointSize) {
+        float dx, dy, dz, range;
+        uint8_t reflectivity, tag;
+        scanDirection(m_pointIndex, dx, dy, dz);
+        tracePoint(dx, dy, dz, range, reflectivity, tag);
+        writePoint(dst, dx, dy, dz, range, reflectivity, tag);
+    }
+    finalizePacketCrc(packet);
+    return packet;
+}
+
+LivoxLidarEthernetPacket* SyntheticLidarDevice::nextImuPacket(uint64_t timestampNs)
+{
+    LivoxLidarEthernetPacket* packet = preparePacket(m_imuBuffer, kLivoxLidarImuData, 1, timestampNs);
+    packet->udp_cnt = m_imuUdpCnt++;
+
+    // 静止姿态：角速度为白噪声，加速度约 1g 竖直向上
+    LivoxLidarImuRawPoint imu;
+    imu.gyro_x = noise() * 0.002f;
+    imu.gyro_y = noise() * 0.002f;
+    imu.gyro_z = noise() * 0.002f;
+    imu.acc_x = noise() * 0.004f;
+    imu.acc_y = noise() * 0.004f;
+    imu.acc_z = 1.0f + noise() * 0.004f;
+    memcpy(packet->data, &imu, sizeof(imu));
+    finalizePacketCrc(packet);
+    return packet;
+}
+
+void SyntheticLidarSource::setPointCloudCallback(LivoxLidarPointCloudCallBack callback, void* clientData)
+{
+    m_pointCallback = callback;
+    m_pointClientData = clientData;
+}
+
+void SyntheticLidarSource::setImuCallback(LivoxLidarImuDataCallback callback, void* clientData)
+{
+    m_imuCallback = callback;
+    m_imuClientData = clientData;
+}
+
+uint32_t SyntheticLidarSource::deviceHandle(int index)
+{
+    // 与 SDK 一致：句柄为网络字节序 IP 按小端读出
+    return 192u | (168u << 8) | (1u << 16) | (uint32_t(100 + index) << 24);
+}
+
+bool SyntheticLidarSource::start(const SyntheticSourceOptions& options)
+{
+    if (m_running.load() || options.deviceCount < 1 || options.rateMultiplier <= 0.0) {
+        return false;
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    m_options = options;
+    m_options.deviceCount = std::min(options.deviceCount, 155);
+    m_packetsSent = 0;
+    m_pointsSent = 0;
+    m_imuPacketsSent = 0;
+    m_running = true;
+    m_thread = std::thread(&SyntheticLidarSource::run, this);
+    return true;
+}
+
+void SyntheticLidarSource::stop()
+{
+    m_running = false;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void SyntheticSchedule::reset(const SyntheticSourceOptions& options, uint64_t baseNs)
+{
+    m_devices.clear();
+    m_phaseNs.clear();
+    m_pointPackets.clear();
+    m_imuPackets.clear();
+    m_heap.clear();
+    m_baseNs = baseNs;
+    for (int i = 0; i < options.deviceCount; ++i) {
+        m_devices.emplace_back(options.model, options.dataType, SyntheticLidarSource::deviceHandle(i),
+                               options.seed + uint32_t(i) * 7919u);
+        // 各设备错开起始相位，避免所有包在同一时刻到达
+        m_phaseNs.push_back(uint64_t(i) * 37000ULL);
+        m_pointPackets.push_back(0);
+        m_imuPackets.push_back(0);
+        m_heap.push_back(dueOf(uint32_t(i), false));
+        if (options.imuEnabled) m_heap.push_back(dueOf(uint32_t(i), true));
+    }
+    std::make_heap(m_heap.begin(), m_heap.end(), std::greater<Due>());
+}
+
+SyntheticSchedule::Due SyntheticSchedule::dueOf(uint32_t index, bool imu) const
+{
+    const SyntheticLidarDevice& dev = m_devices[index];
+    const uint64_t offset = imu ? dev.imuPacketOffsetNs(m_imuPackets[index]) : dev.pointPacketOffsetNs(m_pointPackets[index]);
+    return Due{ m_phaseNs[index] + offset, index, imu };
+}
+
+bool SyntheticSchedule::next(uint64_t untilNs, SyntheticPacket& out)
+{
+    if (m_heap.empty() || m_heap.front().offsetNs > untilNs) return false;
+    std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Due>());
+    const Due due = m_heap.back();
+    SyntheticLidarDevice& dev = m_devices[due.index];
+    out.offsetNs = due.offsetNs;
+    out.handle = dev.handle();
+    out.devType = dev.devType();
+    out.imu = due.imu;
+    if (due.imu) {
+        out.packet = dev.nextImuPacket(m_baseNs + due.offsetNs);
+        m_imuPackets[due.index]++;
+    } else {
+        out.packet = dev.nextPointPacket(m_baseNs + due.offsetNs);
+        m_pointPackets[due.index]++;
+    }
+    m_heap.back() = dueOf(due.index, due.imu);
+    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<Due>());
+    return true;
+}
+
+void SyntheticLidarSource::run()
+{
+    using namespace std::chrono;
+
+    const uint64_t baseNs = uint64_t(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+    SyntheticSchedule schedule;
+    schedule.reset(m_options, baseNs);
+    const auto wallStart = steady_clock::now();
+
+    while (m_running.load()) {
+        // 模拟时间 = 实际流逝时间 x 倍率
+        const double elapsed = double(duration_cast<nanoseconds>(steady_clock::now() - wallStart).count());
+        const uint64_t simNs = uint64_t(elapsed * m_options.rateMultiplier);
+
+        // 按到期先后输出，多设备自然交错；每轮最多补发一批，及时响应 stop()
+        bool emitted = false;
+        SyntheticPacket p;
+        for (int burst = 0; burst < 1024 && m_running.load() && schedule.next(simNs, p); ++burst) {
+            if (p.imu) {
+                if (m_imuCallback) m_imuCallback(p.handle, p.devType, p.packet, m_imuClientData);
+                m_imuPacketsSent.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                if (m_pointCallback) m_pointCallback(p.handle, p.devType, p.packet, m_pointClientData);
+                m_packetsSent.fetch_add(1, std::memory_order_relaxed);
+                m_pointsSent.fetch_add(p.packet->dot_num, std::memory_order_relaxed);
+            }
+            emitted = true;
+        }
+
+        if (!emitted) {
+            std::this_thread::sleep_for(microseconds(500));
+        }
+    }
+}
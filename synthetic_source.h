@@ -0,0 +1,161 @@
+#ifndef SYNTHETIC_SOURCE_H
+#define SYNTHETIC_SOURCE_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    #include "livox_lidar_def.h"
+}
+
+// 模拟雷达型号
+enum SyntheticLidarModel {
+    SyntheticMid360 = 0,
+    SyntheticHAP,
+    SyntheticAvia
+};
+
+// 型号参数（点频、单包点数、帧率、IMU频率按官方规格取值）
+struct SyntheticModelSpec {
+    const char* name;
+    uint8_t devType;
+    uint32_t pointsPerSecond;
+    uint32_t pointsPerPacket;
+    uint32_t frameRateHz;
+    uint32_t imuRateHz;
+};
+
+const SyntheticModelSpec& syntheticModelSpec(int model);
+
+// 单台虚拟雷达：按扫描模式生成点云包与 IMU 包
+// 场景为 40m x 24m x 5m 的房间（雷达离地 1m），墙面带条纹反射率，少量点打上噪点 tag
+class SyntheticLidarDevice
+{
+public:
+    SyntheticLidarDevice(int model, uint8_t dataType, uint32_t handle, uint32_t seed = 1);
+
+    uint32_t handle() const { return m_handle; }
+    uint8_t devType() const { return m_spec.devType; }
+    uint8_t dataType() const { return m_dataType; }
+    const SyntheticModelSpec& spec() const { return m_spec; }
+    void setDataType(uint8_t dataType);
+
+    // 第 n 个点云包 / IMU 包相对起始时刻的时间。按 n 直接计算（整秒 + 余数），
+    // 点频不能整除单包点数时也不会累积舍入误差
+    uint64_t pointPacketOffsetNs(uint64_t n) const;
+    uint64_t imuPacketOffsetNs(uint64_t n) const;
+
+    // 生成下一包，返回的指针在下次调用前有效
+    LivoxLidarEthernetPacket* nextPointPacket(uint64_t timestampNs);
+    LivoxLidarEthernetPacket* nextImuPacket(uint64_t timestampNs);
+
+private:
+    void scanDirection(uint64_t n, float& dx, float& dy, float& dz) const;
+    void tracePoint(float dx, float dy, float dz, float& range, uint8_t& reflectivity, uint8_t& tag);
+    void writePoint(uint8_t* dst, float dx, float dy, float dz, float range, uint8_t reflectivity, uint8_t tag) const;
+    LivoxLidarEthernetPacket* preparePacket(QByteArray& buffer, uint8_t dataType, uint32_t dotNum, uint64_t timestampNs);
+    float noise();
+
+    int m_model;
+    SyntheticModelSpec m_spec;
+    uint8_t m_dataType;
+    uint32_t m_handle;
+    uint32_t m_rng;
+
+    uint64_t m_pointIndex = 0;   // 累计点序号（决定扫描位置）
+    uint16_t m_udpCnt = 0;
+    uint16_t m_imuUdpCnt = 0;
+    uint8_t m_frameCnt = 0;
+    QByteArray m_pointBuffer;
+    QByteArray m_imuBuffer;
+};
+
+struct SyntheticSourceOptions {
+    int model = SyntheticMid360;
+    uint8_t dataType = kLivoxLidarCartesianCoordinateHighData;
+    int deviceCount = 1;
+    double rateMultiplier = 1.0;  // 相对真实速率的倍数
+    bool imuEnabled = true;
+    uint32_t seed = 1;
+};
+
+// 按时间先后合并 N 台虚拟雷达的点云与 IMU 包（SyntheticLidarSource 与模拟 SDK 共用）
+struct SyntheticPacket {
+    uint64_t offsetNs = 0;          // 相对起始时刻
+    uint32_t handle = 0;
+    uint8_t devType = 0;
+    bool imu = false;
+    LivoxLidarEthernetPacket* packet = nullptr;   // 下次 next() 前有效
+};
+
+class SyntheticSchedule
+{
+public:
+    // 包时间戳 = baseNs + offsetNs
+    void reset(const SyntheticSourceOptions& options, uint64_t baseNs);
+    // 生成下一个到期时间不晚于 untilNs 的包；没有则返回 false
+    bool next(uint64_t untilNs, SyntheticPacket& out);
+    std::vector<SyntheticLidarDevice>& devices() { return m_devices; }
+    const std::vector<SyntheticLidarDevice>& devices() const { return m_devices; }
+
+private:
+    struct Due {
+        uint64_t offsetNs;
+        uint32_t index;
+        bool imu;
+        bool operator>(const Due& o) const { return offsetNs > o.offsetNs; }
+    };
+    Due dueOf(uint32_t index, bool imu) const;
+
+    std::vector<SyntheticLidarDevice> m_devices;
+    std::vector<uint64_t> m_phaseNs;
+    std::vector<uint64_t> m_pointPackets;
+    std::vector<uint64_t> m_imuPackets;
+    std::vector<Due> m_heap;        // 最小堆
+    uint64_t m_baseNs = 0;
+};
+
+// 模拟数据源：在独立线程中以 N 台虚拟雷达的速率调用 SDK 同签名回调
+class SyntheticLidarSource
+{
+public:
+    SyntheticLidarSource() = default;
+    ~SyntheticLidarSource() { stop(); }
+
+    void setPointCloudCallback(LivoxLidarPointCloudCallBack callback, void* clientData);
+    void setImuCallback(LivoxLidarImuDataCallback callback, void* clientData);
+
+    bool start(const SyntheticSourceOptions& options);
+    void stop();
+    bool isRunning() const { return m_running.load(); }
+    SyntheticSourceOptions options() const { return m_options; }
+
+    // 第 index 台虚拟设备的句柄（192.168.1.100+index，与 SDK 相同的按 IP 编码方式）
+    static uint32_t deviceHandle(int index);
+
+    uint64_t packetsSent() const { return m_packetsSent.load(); }
+    uint64_t pointsSent() const { return m_pointsSent.load(); }
+    uint64_t imuPacketsSent() const { return m_imuPacketsSent.load(); }
+
+private:
+    void run();
+
+    SyntheticSourceOptions m_options;
+    LivoxLidarPointCloudCallBack m_pointCallback = nullptr;
+    void* m_pointClientData = nullptr;
+    LivoxLidarImuDataCallback m_imuCallback = nullptr;
+    void* m_imuClientData = nullptr;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_packetsSent{0};
+    std::atomic<uint64_t> m_pointsSent{0};
+    std::atomic<uint64_t> m_imuPacketsSent{0};
+};
+
+#endif // SYNTHETIC_SOURCE_H
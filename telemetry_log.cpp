@@ -0,0 +1,334 @@
+#include "telemetry_log.h"
+#include <QMutexLocker>
+#include <algorithm>
+#include <cstring>
+
+static const char kTelemetryMagic[8] = { 'L', 'V', 'X', 'T', 'L', 'M', '0', '1' };
+
+namespace {
+
+const TelemetryMetricInfo kMetricInfo[TelemetryMetricCount] = {
+    { "核心温度", "°C", 0.01 },
+    { "工作状态", "", 1.0 },
+    { "时间同步类型", "", 1.0 },
+    { "时间偏移", "us", 1e-3 },
+    { "诊断状态", "", 1.0 },
+    { "HMS 故障数", "", 1.0 },
+    { "参数查询耗时", "ms", 1e-3 },
+    { "点云包率", "包/s", 0.01 },
+    { "近期丢包率", "%", 1e-4 },
+};
+
+uint64_t seriesKey(uint32_t handle, int metric)
+{
+    return (uint64_t(handle) << 8) | uint64_t(metric & 0xFF);
+}
+
+void appendVarint(QByteArray& out, int64_t v)
+{
+    uint64_t z = (uint64_t(v) << 1) ^ uint64_t(v >> 63);
+    char buf[10];
+    int n = 0;
+    while (z >= 0x80) {
+        buf[n++] = char(uint8_t(z) | 0x80);
+        z >>= 7;
+    }
+    buf[n++] = char(z);
+    out.append(buf, n);
+}
+
+bool readVarint(const uint8_t*& p, const uint8_t* end, int64_t& v)
+{
+    uint64_t z = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        const uint8_t b = *p++;
+        z |= uint64_t(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            v = int64_t(z >> 1) ^ -int64_t(z & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+const TelemetryMetricInfo& telemetryMetricInfo(int metric)
+{
+    static const TelemetryMetricInfo unknown = { "未知", "", 1.0 };
+    if (metric < 0 || metric >= TelemetryMetricCount) return unknown;
+    return kMetricInfo[metric];
+}
+
+bool TelemetryWriter::open(const QString& filePath)
+{
+    QMutexLocker lk(&m_mutex);
+    if (m_file.isOpen()) m_file.close();
+    m_series.clear();
+    m_lastFlushNs = 0;
+    m_samples = 0;
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return m_file.write(kTelemetryMagic, sizeof(kTelemetryMagic)) == qint64(sizeof(kTelemetryMagic));
+}
+
+void TelemetryWriter::close()
+{
+    QMutexLocker lk(&m_mutex);
+    if (!m_file.isOpen()) return;
+    for (auto it = m_series.begin(); it != m_series.end(); ++it) writeBlock(it.value());
+    m_series.clear();
+    m_file.close();
+}
+
+bool TelemetryWriter::isOpen() const
+{
+    QMutexLocker lk(&m_mutex);
+    return m_file.isOpen();
+}
+
+QString TelemetryWriter::fileName() const
+{
+    QMutexLocker lk(&m_mutex);
+    return m_file.fileName();
+}
+
+void TelemetryWriter::setDeviceName(uint32_t handle, const QString& name)
+{
+    const QByteArray utf8 = name.toUtf8();
+    TelemetryBlockHeader h;
+    h.type = TelemetryRecordDevice;
+    h.handle = handle;
+    h.size = uint32_t(utf8.size());
+    QMutexLocker lk(&m_mutex);
+    if (!m_file.isOpen()) return;
+    m_file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    m_file.write(utf8);
+}
+
+void TelemetryWriter::append(uint32_t handle, int metric, int64_t timeNs, int64_t value)
+{
+    if (metric < 0 || metric >= TelemetryMetricCount) return;
+    QMutexLocker lk(&m_mutex);
+    if (!m_file.isOpen()) return;
+    Series& s = m_series[seriesKey(handle, metric)];
+    TelemetryBlockHeader& h = s.header;
+    // 系统时间被回调时不让序列时间回退（块内与块边界相同处理，读取端按块 lastNs 二分查找依赖单调）
+    if (s.started && timeNs < s.prevNs) timeNs = s.prevNs;
+    if (h.count == 0) {
+        h.type = TelemetryRecordData;
+        h.metric = uint8_t(metric);
+        h.handle = handle;
+        h.firstNs = timeNs;
+        h.firstValue = value;
+        h.minValue = value;
+        h.maxValue = value;
+        s.payload.clear();
+        s.prevDelta = 0;
+    } else {
+        const int64_t delta = timeNs - s.prevNs;
+        appendVarint(s.payload, delta - s.prevDelta);
+        appendVarint(s.payload, int64_t(uint64_t(value) - uint64_t(s.prevValue)));
+        s.prevDelta = delta;
+        if (value < h.minValue) h.minValue = value;
+        if (value > h.maxValue) h.maxValue = value;
+    }
+    h.lastNs = timeNs;
+    h.count++;
+    s.prevNs = timeNs;
+    s.prevValue = value;
+    s.started = true;
+    m_samples++;
+    if (h.count >= kBlockSamples) writeBlock(s);
+
+    if (m_lastFlushNs == 0) m_lastFlushNs = timeNs;
+    if (timeNs - m_lastFlushNs >= int64_t(kFlushIntervalMs) * 1000000LL) {
+        for (auto it = m_series.begin(); it != m_series.end(); ++it) writeBlock(it.value());
+        m_file.flush();
+        m_lastFlushNs = timeNs;
+    }
+}
+
+void TelemetryWriter::writeBlock(Series& s)
+{
+    if (s.header.count == 0) return;
+    s.header.size = uint32_t(s.payload.size());
+    m_file.write(reinterpret_cast<const char*>(&s.header), sizeof(s.header));
+    m_file.write(s.payload);
+    s.header.count = 0;
+    s.payload.clear();
+}
+
+void TelemetryWriter::flush()
+{
+    QMutexLocker lk(&m_mutex);
+    if (!m_file.isOpen()) return;
+    for (auto it = m_series.begin(); it != m_series.end(); ++it) writeBlock(it.value());
+    m_file.flush();
+}
+
+uint64_t TelemetryWriter::samples() const
+{
+    QMutexLocker lk(&m_mutex);
+    return m_samples;
+}
+
+qint64 TelemetryWriter::bytesWritten() const
+{
+    QMutexLocker lk(&m_mutex);
+    return m_file.isOpen() ? m_file.pos() : 0;
+}
+
+bool TelemetryReader::open(const QString& filePath)
+{
+    close();
+    m_error.clear();
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = QString("无法打开文件: %1").arg(filePath);
+        return false;
+    }
+    char magic[sizeof(kTelemetryMagic)] = {};
+    if (m_file.read(magic, sizeof(magic)) != qint64(sizeof(magic)) ||
+        memcmp(magic, kTelemetryMagic, sizeof(magic)) != 0) {
+        m_error = "不是有效的遥测记录文件";
+        close();
+        return false;
+    }
+
+    const qint64 fileSize = m_file.size();
+    qint64 pos = m_file.pos();
+    TelemetryBlockHeader h;
+    while (pos + qint64(sizeof(h)) <= fileSize) {
+        if (!m_file.seek(pos) || m_file.read(reinterpret_cast<char*>(&h), sizeof(h)) != qint64(sizeof(h))) break;
+        const qint64 payload = pos + qint64(sizeof(h));
+        if (payload + qint64(h.size) > fileSize) break;
+        if (h.type == TelemetryRecordData) {
+            if (h.count == 0 || h.metric >= TelemetryMetricCount || h.lastNs < h.firstNs) break;
+            Block b;
+            b.offset = payload;
+            b.header = h;
+            m_index[seriesKey(h.handle, h.metric)].append(b);
+            if (m_firstNs == 0 || h.firstNs < m_firstNs) m_firstNs = h.firstNs;
+            if (h.lastNs > m_lastNs) m_lastNs = h.lastNs;
+        } else if (h.type == TelemetryRecordDevice) {
+            m_names[h.handle] = QString::fromUtf8(m_file.read(h.size));
+        } else {
+            break;
+        }
+        pos = payload + qint64(h.size);
+    }
+    return true;
+}
+
+void TelemetryReader::close()
+{
+    if (m_file.isOpen()) m_file.close();
+    m_index.clear();
+    m_names.clear();
+    m_firstNs = 0;
+    m_lastNs = 0;
+}
+
+QVector<TelemetryReader::SeriesInfo> TelemetryReader::series() const
+{
+    QVector<SeriesInfo> out;
+    for (auto it = m_index.constBegin(); it != m_index.constEnd(); ++it) {
+        const QVector<Block>& blocks = it.value();
+        SeriesInfo info;
+        info.handle = blocks.front().header.handle;
+        info.metric = blocks.front().header.metric;
+        info.firstNs = blocks.front().header.firstNs;
+        info.lastNs = blocks.back().header.lastNs;
+        for (const Block& b : blocks) info.samples += b.header.count;
+        out.append(info);
+    }
+    return out;
+}
+
+QVector<TelemetryPoint> TelemetryReader::query(uint32_t handle, int metric, int64_t fromNs, int64_t toNs, int columns)
+{
+    QVector<TelemetryPoint> out;
+    auto it = m_index.constFind(seriesKey(handle, metric));
+    if (it == m_index.constEnd() || toNs < fromNs || !m_file.isOpen()) return out;
+    const QVector<Block>& blocks = it.value();
+    const double scale = telemetryMetricInfo(metric).scale;
+    const double span = double(toNs - fromNs) + 1.0;
+
+    struct Column {
+        bool used = false;
+        int64_t minNs = 0, maxNs = 0;
+        int64_t minValue = 0, maxValue = 0;
+    };
+    QVector<Column> cols(columns > 0 ? columns : 0);
+    auto columnOf = [&](int64_t t) {
+        const int c = int(double(t - fromNs) * double(columns) / span);
+        return c < columns ? c : columns - 1;
+    };
+    auto add = [&](int64_t t, int64_t v) {
+        if (t < fromNs || t > toNs) return;
+        if (columns <= 0) {
+            TelemetryPoint p;
+            p.timeNs = t;
+            p.value = double(v) * scale;
+            out.append(p);
+            return;
+        }
+        Column& c = cols[columnOf(t)];
+        if (!c.used) {
+            c.used = true;
+            c.minNs = c.maxNs = t;
+            c.minValue = c.maxValue = v;
+        } else if (v < c.minValue) {
+            c.minValue = v;
+            c.minNs = t;
+        } else if (v > c.maxValue) {
+            c.maxValue = v;
+            c.maxNs = t;
+        }
+    };
+
+    // 每序列的块按时间追加，lastNs 单调不减
+    auto first = std::lower_bound(blocks.begin(), blocks.end(), fromNs,
+                                  [](const Block& b, int64_t t) { return b.header.lastNs < t; });
+    QByteArray payload;
+    for (auto b = first; b != blocks.end() && b->header.firstNs <= toNs; ++b) {
+        const TelemetryBlockHeader& h = b->header;
+        if (columns > 0 && h.firstNs >= fromNs && h.lastNs <= toNs && columnOf(h.firstNs) == columnOf(h.lastNs)) {
+            add(h.firstNs, h.minValue);
+            add(h.lastNs, h.maxValue);
+            continue;
+        }
+        payload.resize(int(h.size));
+        if (!m_file.seek(b->offset) || m_file.read(payload.data(), h.size) != qint64(h.size)) break;
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(payload.constData());
+        const uint8_t* end = p + payload.size();
+        int64_t t = h.firstNs;
+        int64_t v = h.firstValue;
+        int64_t delta = 0;
+        add(t, v);
+        for (int i = 1; i < h.count; ++i) {
+            int64_t dod = 0, dv = 0;
+            if (!readVarint(p, end, dod) || !readVarint(p, end, dv)) break;
+            delta += dod;
+            t += delta;
+            v = int64_t(uint64_t(v) + uint64_t(dv));
+            add(t, v);
+        }
+    }
+
+    for (const Column& c : cols) {
+        if (!c.used) continue;
+        TelemetryPoint a, b;
+        const bool minFirst = c.minNs <= c.maxNs;
+        a.timeNs = minFirst ? c.minNs : c.maxNs;
+        a.value = double(minFirst ? c.minValue : c.maxValue) * scale;
+        b.timeNs = minFirst ? c.maxNs : c.minNs;
+        b.value = double(minFirst ? c.maxValue : c.minValue) * scale;
+        out.append(a);
+        if (c.minNs != c.maxNs || c.minValue != c.maxValue) out.append(b);
+    }
+    return out;
+}
@@ -0,0 +1,149 @@
+#ifndef TELEMETRY_LOG_H
+#define TELEMETRY_LOG_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <cstdint>
+
+// 遥测指标：每设备一条序列，值按定点整数存储（显示值 = 存储值 × scale）
+enum TelemetryMetric {
+    TelemetryCoreTemp = 0,      // 0.01 °C
+    TelemetryWorkState,
+    TelemetryTimeSyncType,
+    TelemetryTimeOffset,        // ns
+    TelemetryDiagStatus,
+    TelemetryHmsCount,          // 非零 HMS 码个数
+    TelemetryParamLatency,      // 参数查询耗时 us
+    TelemetryPacketRate,        // 点云包/s × 100
+    TelemetryPacketLoss,        // 近期丢包率 × 1e6
+    TelemetryMetricCount
+};
+
+struct TelemetryMetricInfo {
+    const char* name;
+    const char* unit;
+    double scale;
+};
+
+const TelemetryMetricInfo& telemetryMetricInfo(int metric);
+
+// 遥测文件（.lvxtlm）：8 字节魔数后是若干条记录，每条为 TelemetryBlockHeader + size 字节载荷。
+// 数据块载荷为第 2 个样本起的 zigzag 变长整数对：时间戳二阶差分、值一阶差分（等间隔采样、
+// 值不变时每样本 2 字节）。块头带时间范围与最小/最大值，打开时只读块头即可建立时间索引。
+#pragma pack(push, 1)
+struct TelemetryBlockHeader {
+    uint8_t type = 0;           // TelemetryRecordType
+    uint8_t metric = 0;
+    uint16_t count = 0;         // 样本数
+    uint32_t handle = 0;
+    uint32_t size = 0;          // 载荷字节数
+    int64_t firstNs = 0;        // 首/末样本时间（Unix 时间 ns）
+    int64_t lastNs = 0;
+    int64_t firstValue = 0;
+    int64_t minValue = 0;
+    int64_t maxValue = 0;
+};
+#pragma pack(pop)
+
+enum TelemetryRecordType : uint8_t {
+    TelemetryRecordData = 1,
+    TelemetryRecordDevice = 2   // 载荷为设备名（UTF-8），用于跨会话识别句柄
+};
+
+struct TelemetryPoint {
+    int64_t timeNs = 0;
+    double value = 0.0;         // 已乘 scale
+};
+
+// 追加写入：每条序列在内存中累积一个块，满 kBlockSamples 或距上次写出超过 kFlushIntervalMs 时写出，
+// 异常退出最多丢失一个刷新间隔的数据。线程安全，可在 SDK 回调线程中调用。
+class TelemetryWriter
+{
+public:
+    static const int kBlockSamples = 1024;
+    static const int kFlushIntervalMs = 30000;
+
+    TelemetryWriter() = default;
+    ~TelemetryWriter() { close(); }
+
+    bool open(const QString& filePath);
+    void close();
+    bool isOpen() const;
+    QString fileName() const;
+
+    void setDeviceName(uint32_t handle, const QString& name);
+    void append(uint32_t handle, int metric, int64_t timeNs, int64_t value);
+    // 写出所有未满的块（查询正在记录的文件前调用）
+    void flush();
+
+    uint64_t samples() const;
+    qint64 bytesWritten() const;
+
+private:
+    struct Series {
+        QByteArray payload;
+        TelemetryBlockHeader header;
+        int64_t prevNs = 0;         // 跨块保留，新块首个时间同样不早于上一块最后一个
+        int64_t prevDelta = 0;
+        int64_t prevValue = 0;
+        bool started = false;
+    };
+
+    void writeBlock(Series& s);
+
+    mutable QMutex m_mutex;
+    QFile m_file;
+    QMap<uint64_t, Series> m_series;
+    int64_t m_lastFlushNs = 0;
+    uint64_t m_samples = 0;
+};
+
+class TelemetryReader
+{
+public:
+    struct SeriesInfo {
+        uint32_t handle = 0;
+        int metric = 0;
+        uint64_t samples = 0;
+        int64_t firstNs = 0;
+        int64_t lastNs = 0;
+    };
+
+    TelemetryReader() = default;
+    ~TelemetryReader() { close(); }
+
+    // 只读块头建立索引；末尾不完整的块（正在写入或异常退出）被忽略
+    bool open(const QString& filePath);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+    QString errorString() const { return m_error; }
+    QString fileName() const { return m_file.fileName(); }
+
+    QVector<SeriesInfo> series() const;
+    QString deviceName(uint32_t handle) const { return m_names.value(handle); }
+    int64_t firstNs() const { return m_firstNs; }
+    int64_t lastNs() const { return m_lastNs; }
+
+    // [fromNs, toNs] 内的样本。columns > 0 时按列做最小/最大值抽取（每列至多 2 点），
+    // 整块落在一列内的只用块头的最小/最大值，不解码载荷，因此查询耗时只与列数和跨列块数有关
+    QVector<TelemetryPoint> query(uint32_t handle, int metric, int64_t fromNs, int64_t toNs, int columns = 0);
+
+private:
+    struct Block {
+        qint64 offset = 0;      // 载荷在文件中的位置
+        TelemetryBlockHeader header;
+    };
+
+    QFile m_file;
+    QString m_error;
+    QMap<uint64_t, QVector<Block>> m_index;     // 每序列按时间顺序的块
+    QMap<uint32_t, QString> m_names;
+    int64_t m_firstNs = 0;
+    int64_t m_lastNs = 0;
+};
+
+#endif // TELEMETRY_LOG_H
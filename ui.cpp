@@ -18,6 +18,9 @@
 #include <QAbstractSocket>
 #include <QListWidget>
 #include <QDesktopServices>
+#include <QStandardPaths>
+#include <algorithm>
+#include <cmath>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -27,28 +30,76 @@ MainWindow::MainWindow(QWidget *parent)
     , statusLabel(nullptr)
     , pointCloudCallbackEnabled(false)
     , isNormalMode(true)
-    , discoverySocket(nullptr)
     , discoveryTimer(nullptr)
     , discoveryActive(false)
     , recordParamsButton(nullptr)
     , isRecordingParams(false)
 {
+    startupTimeline.start();
+    // 日志：后台线程按天写文件，界面每 100ms 批量追加
+    appLog.start(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) +
+                     QString("/logs/LivoxViewerQT_%1.log").arg(QDate::currentDate().toString("yyyyMMdd")),
+                 true);
+    // 有上次成功的网络配置时，SDK 初始化与网络校验在后台线程进行，与界面构造并行
+    const bool fastStart = tryFastStartup();
     setupUI();
 
+    // 点云流水线：滤波阶段与输出（保存/显示）
+    syncPipelineOptions();
+    pipeline.addFilter([this](QVector<Point3D>& points) { applyPointCloudFilters(points); });
+    pipeline.addSink([this](const PointCloudFrame& frame, const PipelineOutput& info) { onPipelineFrame(frame, info); });
+    pipeline.setDeskew(&pointDeskew);
+    pipeline.setClockAligner(&clockAligner);
+    setupStatsDock();
+    setupHealthDock();
+    PipelineTrace::setThreadName("GUI");
+
+    // 车队模式：工作线程处理数据包，上次开启时启动即恢复
+    fleetIngest.setHandler([this](uint32_t handle, const LivoxLidarEthernetPacket* packet, uint64_t arrivalNs, bool render) {
+        handleFleetPacket(handle, packet, arrivalNs, render);
+    });
+    fleetIngest.setBatchHandler([this](uint32_t handle, int packets, uint64_t points, uint64_t busyNs) {
+        pipelineStats.recordPackets(handle, packets, points, busyNs);
+    });
+    if (QSettings("Livox", "LivoxViewerQT").value("fleet/enabled", false).toBool()) setFleetMode(true);
+
+#ifdef LIVOX_SDK_MOCK
+    // 模拟SDK：无需设备发现，直接初始化
+    Q_UNUSED(fastStart);
+    QTimer::singleShot(0, this, &MainWindow::setupLivoxSDK);
+#else
     // 启动设备发现，SDK初始化将在设备发现完成后进行
-    startDeviceDiscovery();
+    if (!fastStart) startDeviceDiscovery();
+#endif
 
     // 移除状态栏自动更新逻辑
 
-    // 设置参数查询定时器
-    paramQueryTimer = new QTimer(this);
-    connect(paramQueryTimer, &QTimer::timeout, this, &MainWindow::onParamQueryTimeout);
-    paramQueryTimer->start(1000); // 每1秒查询一次参数
+    // 参数轮询：当前设备 1 秒，其余设备 5 秒，失败退避；值变化时才刷新界面
+    paramPoller.setQueryFunction([this](uint32_t handle) {
+        return QueryLivoxLidarInternalInfo(handle, onQueryInternalInfoResponse, this) == kLivoxLidarStatusSuccess;
+    });
+    paramPoller.setFormatter([](uint16_t key, const QByteArray& raw) {
+        QByteArray copy = raw;
+        return parseParamValue(key, reinterpret_cast<uint8_t*>(copy.data()), uint16_t(copy.size()));
+    });
+    paramPoller.setChangeNotifier([this](uint32_t handle) {
+        Q_UNUSED(handle);
+        if (paramUiPending.exchange(true)) return;
+        QMetaObject::invokeMethod(this, [this]() {
+            paramUiPending.store(false);
+            if (currentDevice) applyDeviceParams(currentDevice->handle);
+        }, Qt::QueuedConnection);
+    });
+    paramPoller.setResponseObserver([this](uint32_t handle, const DeviceParamStatus& status) {
+        if (telemetryWriter.isOpen()) recordParamTelemetry(handle, status);
+    });
+    paramPoller.start();
 
     // 恢复窗口布局与几何
     QSettings settings("Livox", "LivoxViewerQT");
     restoreGeometry(settings.value("geometry").toByteArray());
     restoreState(settings.value("windowState").toByteArray());
+    startupTimeline.mark(StartupUiReady);
 }
 
 MainWindow::~MainWindow()
@@ -58,7 +109,13 @@ MainWindow::~MainWindow()
     settings.setValue("geometry", saveGeometry());
     settings.setValue("windowState", saveState());
 
+    syntheticSource.stop();
+    fleetIngest.stop();
+    stopImuFileAnalysis();
+    paramPoller.stop();
+    stopTelemetryRecording();
     stopDeviceDiscovery();
+    if (networkCheckThread.joinable()) networkCheckThread.join();
     cleanupLivoxSDK();
 }
 
@@ -101,7 +158,7 @@ void MainWindow::setupUI()
     spinFrameIntervalTop->setRange(100, 30000);
     spinFrameIntervalTop->setSingleStep(100);
     spinFrameIntervalTop->setSuffix(" ms");
-    spinFrameIntervalTop->setValue(static_cast<int>(frameIntervalMs));
+    spinFrameIntervalTop->setValue(static_cast<int>(pipeline.windowMs()));
     spinFrameIntervalTop->setToolTip("点云积分时间/帧间隔（渲染为滑动窗口显示）");
     connect(spinFrameIntervalTop, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::onFrameIntervalChanged);
 
@@ -153,6 +210,62 @@ void MainWindow::setupUI()
     planarRadiusSpin->setToolTip("平面投影的半径大小");
     connect(planarRadiusSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &MainWindow::onPlanarProjectionRadiusChanged);
 
+    // 运动去畸变
+    QLabel* lblDeskew = new QLabel("运动去畸变:", toolbarRow2);
+    deskewCheck = new QCheckBox("IMU", toolbarRow2);
+    deskewCheck->setToolTip("按包内逐点时间与 IMU 陀螺仪积分的旋转，将积分窗口内的点校正到窗口末尾时刻（需开启IMU数据）");
+    deskewCheck->setChecked(QSettings("Livox", "LivoxViewerQT").value("view/deskew", false).toBool());
+    pointDeskew.setEnabled(deskewCheck->isChecked());
+    connect(deskewCheck, &QCheckBox::toggled, [this](bool on) {
+        pointDeskew.setEnabled(on);
+        if (!on) pointDeskew.reset();
+        QSettings("Livox", "LivoxViewerQT").setValue("view/deskew", on);
+        logMessage(on ? "运动去畸变已开启" : "运动去畸变已关闭");
+    });
+
+    // 渲染帧率与自适应点数预算（点云窗口创建后再应用到 pointCloudWidget）
+    QLabel* lblTargetFps = new QLabel("目标帧率:", toolbarRow2);
+    targetFpsSpin = new QSpinBox(toolbarRow2);
+    targetFpsSpin->setRange(5, 120);
+    targetFpsSpin->setSuffix(" fps");
+    targetFpsSpin->setValue(QSettings("Livox", "LivoxViewerQT").value("view/targetFps", 30).toInt());
+    targetFpsSpin->setToolTip("渲染刷新率；开启自适应点数时按此帧率调整每帧绘制的点数");
+    connect(targetFpsSpin, QOverload<int>::of(&QSpinBox::valueChanged), [this](int fps) {
+        if (renderTimer) renderTimer->setInterval(1000 / fps);
+        if (pointCloudWidget) pointCloudWidget->setTargetFps(fps);
+        QSettings("Livox", "LivoxViewerQT").setValue("view/targetFps", fps);
+    });
+    adaptiveBudgetCheck = new QCheckBox("自适应点数", toolbarRow2);
+    adaptiveBudgetCheck->setToolTip("绘制耗时超出目标帧率时按分层抽样减少绘制点数，相机静止后恢复全部点");
+    adaptiveBudgetCheck->setChecked(QSettings("Livox", "LivoxViewerQT").value("view/adaptiveBudget", true).toBool());
+    connect(adaptiveBudgetCheck, &QCheckBox::toggled, [this](bool on) {
+        if (pointCloudWidget) pointCloudWidget->setAdaptiveBudgetEnabled(on);
+        QSettings("Livox", "LivoxViewerQT").setValue("view/adaptiveBudget", on);
+    });
+
+    // 累积地图（八叉树 LOD）
+    accumulateCheck = new QCheckBox("累积地图", toolbarRow2);
+    accumulateCheck->setToolTip("持续累积新到达的点（不随滑动窗口过期），按视锥与屏幕空间误差分级绘制，适合长时间累积与回放建图");
+    QPushButton* btnClearAccumulated = new QPushButton("清空累积", toolbarRow2);
+    btnClearAccumulated->setEnabled(false);
+    connect(accumulateCheck, &QCheckBox::toggled, [this, btnClearAccumulated](bool on) {
+        if (!pointCloudWidget) return;
+        pointCloudWidget->setAccumulationEnabled(on);
+        if (on && accumulateSinkId == 0) {
+            accumulateSinkId = pipeline.addChunkSink([this](const PointCloudFrame& chunk, const PipelineOutput&) {
+                pointCloudWidget->appendAccumulated(chunk.points);
+            });
+        } else if (!on && accumulateSinkId != 0) {
+            pipeline.removeChunkSink(accumulateSinkId);
+            accumulateSinkId = 0;
+        }
+        btnClearAccumulated->setEnabled(on);
+        logMessage(on ? "累积地图已开启" : "累积地图已关闭");
+    });
+    connect(btnClearAccumulated, &QPushButton::clicked, [this]() {
+        if (pointCloudWidget) pointCloudWidget->clearAccumulated();
+    });
+
 
 
     // 纯色选择控件
@@ -268,6 +381,16 @@ void MainWindow::setupUI()
     row2Layout->addWidget(planarProjectionCheck);
     row2Layout->addWidget(lblPlanarRadius);
     row2Layout->addWidget(planarRadiusSpin);
+    row2Layout->addSpacing(10);
+    row2Layout->addWidget(lblDeskew);
+    row2Layout->addWidget(deskewCheck);
+    row2Layout->addSpacing(10);
+    row2Layout->addWidget(lblTargetFps);
+    row2Layout->addWidget(targetFpsSpin);
+    row2Layout->addWidget(adaptiveBudgetCheck);
+    row2Layout->addSpacing(10);
+    row2Layout->addWidget(accumulateCheck);
+    row2Layout->addWidget(btnClearAccumulated);
     row2Layout->addStretch();
 
     // 将两行添加到主工具栏
@@ -278,6 +401,8 @@ void MainWindow::setupUI()
     pointCloudWidget = new PointCloudWidget(centralContainer);
     pointCloudWidget->setMinimumSize(800, 500);
     pointCloudWidget->setPointSize(pointSizePx);
+    pointCloudWidget->setTargetFps(targetFpsSpin->value());
+    pointCloudWidget->setAdaptiveBudgetEnabled(adaptiveBudgetCheck->isChecked());
 
     centralLayout->addWidget(viewerToolbar);
     centralLayout->addWidget(pointCloudWidget, 1);
@@ -755,6 +880,9 @@ void MainWindow::setupUI()
     QSpinBox* yEdit = new QSpinBox();
     QSpinBox* zEdit = new QSpinBox();
     QPushButton* attitudeButton = new QPushButton("应用");
+    QPushButton* hostExtrinsicButton = new QPushButton("应用到主机");
+    QPushButton* hostExtrinsicClearButton = new QPushButton("清除主机外参");
+    hostExtrinsicButton->setToolTip("不写入雷达，在解码时将外参应用到该设备的点云（多雷达拼接显示）");
     rollEdit->setRange(-180.0, 180.0);
     pitchEdit->setRange(-90.0, 90.0);
     yawEdit->setRange(-180.0, 180.0);
@@ -776,8 +904,35 @@ void MainWindow::setupUI()
         applyLayout->addWidget(attitudeButton);
         attitudeLayout->addRow(QString(), applyRow);
     }
+    {
+        QWidget* hostRow = new QWidget();
+        QHBoxLayout* hostLayout = new QHBoxLayout(hostRow);
+        hostLayout->setContentsMargins(0,0,0,0);
+        hostLayout->addStretch();
+        hostLayout->addWidget(hostExtrinsicClearButton);
+        hostLayout->addWidget(hostExtrinsicButton);
+        attitudeLayout->addRow(QString(), hostRow);
+    }
     paramControls[kKeyInstallAttitude] = attitudeTab;
     connect(attitudeButton, &QPushButton::clicked, [this, rollEdit, pitchEdit, yawEdit, xEdit, yEdit, zEdit]() { applyAttitudeConfig(kKeyInstallAttitude, rollEdit->value(), pitchEdit->value(), yawEdit->value(), xEdit->value(), yEdit->value(), zEdit->value()); });
+    connect(hostExtrinsicButton, &QPushButton::clicked, [this, rollEdit, pitchEdit, yawEdit, xEdit, yEdit, zEdit]() {
+        if (!currentDevice) {
+            logMessage("未选择设备，无法设置主机外参");
+            return;
+        }
+        ExtrinsicParams params;
+        params.roll = float(rollEdit->value());
+        params.pitch = float(pitchEdit->value());
+        params.yaw = float(yawEdit->value());
+        params.x = xEdit->value() / 1000.0f;   // mm → m
+        params.y = yEdit->value() / 1000.0f;
+        params.z = zEdit->value() / 1000.0f;
+        setHostExtrinsic(currentDevice->handle, currentDevice->sn, params);
+    });
+    connect(hostExtrinsicClearButton, &QPushButton::clicked, [this]() {
+        if (!currentDevice) return;
+        clearHostExtrinsic(currentDevice->handle, currentDevice->sn);
+    });
     paramTabWidget->addTab(attitudeTab, "外参配置");
     attitudeTab->setLayout(attitudeLayout);
 
@@ -886,6 +1041,10 @@ void MainWindow::setupUI()
     QVBoxLayout* logLayout = new QVBoxLayout(logDockContent);
     logText = new QTextEdit(logDockContent);
     logText->setMinimumHeight(160);
+    logText->document()->setMaximumBlockCount(10000);
+    logFlushTimer = new QTimer(this);
+    connect(logFlushTimer, &QTimer::timeout, this, &MainWindow::flushLogView);
+    logFlushTimer->start(100);
     QPushButton* clearLogButton = new QPushButton("清除日志", logDockContent);
     logLayout->addWidget(logText);
     logLayout->addWidget(clearLogButton);
@@ -937,6 +1096,23 @@ void MainWindow::setupUI()
     QAction* actionCapturePCD = saveMenu->addAction("保存PCD点云...");
     QAction* actionCaptureLAS = saveMenu->addAction("保存LAS点云...");
     QAction* actionSaveIMU = toolsMenu->addAction("保存IMU数据...");
+    toolsMenu->addSeparator();
+    actionSyntheticSource = toolsMenu->addAction("模拟数据源...");
+    connect(actionSyntheticSource, &QAction::triggered, this, [this]() {
+        runSyntheticSourceDialog();
+    });
+    QMenu* traceMenu = toolsMenu->addMenu("性能追踪");
+    QAction* actionTraceRecord = traceMenu->addAction("记录性能追踪");
+    actionTraceRecord->setCheckable(true);
+    QAction* actionTraceExport = traceMenu->addAction("导出追踪 (Chrome Trace)...");
+    connect(actionTraceRecord, &QAction::toggled, this, [this](bool on) {
+        if (on) PipelineTrace::clear();
+        PipelineTrace::setEnabled(on);
+        logMessage(on ? "性能追踪已开启" : "性能追踪已停止");
+    });
+    connect(actionTraceExport, &QAction::triggered, this, [this]() {
+        exportPipelineTrace();
+    });
 
     // 固件升级
     QAction* actionUpgrade = deviceMenu->addAction("固件升级...");
@@ -1226,6 +1402,12 @@ void MainWindow::setupUI()
         h2->addStretch();
         v->addWidget(row2);
 
+        QCheckBox* chkRaw = new QCheckBox("同时录制原始数据包（.lvxraw）", &dlg);
+        chkRaw->setToolTip("按到达顺序保存点云与 IMU 原始包及主机接收时间，\n"
+                           "可用模拟SDK回放或 LivoxConvert 转换");
+        chkRaw->setChecked(QSettings("Livox", "LivoxViewerQT").value("capture/rawPackets", false).toBool());
+        v->addWidget(chkRaw);
+
         QDialogButtonBox* box = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dlg);
         v->addWidget(box);
 
@@ -1260,7 +1442,8 @@ void MainWindow::setupUI()
         currentCapture = CaptureLVX2;
         statusLabelBar->setText("正在录制LVX2...");
         logMessage(QString("LVX2保存路径: %1").arg(QDir::toNativeSeparators(filePath)));
-        startLvx2Recording(filePath, captureSecondsRemaining);
+        QSettings("Livox", "LivoxViewerQT").setValue("capture/rawPackets", chkRaw->isChecked());
+        startLvx2Recording(filePath, captureSecondsRemaining, chkRaw->isChecked());
         captureTimer->start(1000);
     });
 
@@ -1387,7 +1570,7 @@ void MainWindow::setupUI()
     renderTimer = new QTimer(this);
     renderTimer->setTimerType(Qt::PreciseTimer);
     connect(renderTimer, &QTimer::timeout, this, &MainWindow::onRenderTick);
-    renderTimer->start(33);
+    renderTimer->start(1000 / targetFpsSpin->value());
     // 采集定时器
     captureTimer = new QTimer(this);
     connect(captureTimer, &QTimer::timeout, this, &MainWindow::onCaptureTick);
@@ -1398,6 +1581,12 @@ void MainWindow::setupUI()
     connect(actionSaveIMU, &QAction::triggered, this, &MainWindow::onActionCaptureImuTriggered);
     actionShowImuCharts = toolsMenu->addAction("IMU数据绘图");
     connect(actionShowImuCharts, &QAction::triggered, this, &MainWindow::onActionShowImuCharts);
+    QAction* actionImuAnalysis = toolsMenu->addAction("IMU噪声分析...");
+    connect(actionImuAnalysis, &QAction::triggered, this, &MainWindow::onActionImuAnalysis);
+    QAction* actionTelemetry = toolsMenu->addAction("遥测记录...");
+    connect(actionTelemetry, &QAction::triggered, this, &MainWindow::onActionTelemetry);
+    QAction* actionFleetOverview = toolsMenu->addAction("设备总览...");
+    connect(actionFleetOverview, &QAction::triggered, this, &MainWindow::onActionFleetOverview);
     
     // 点云滤波
     QAction* actionPointCloudFilter = toolsMenu->addAction("点云滤波...");
@@ -1658,7 +1847,14 @@ void MainWindow::onDeviceSelected()
         QMutexLocker locker(&deviceMutex);
         auto it = devices.begin();
         std::advance(it, currentRow);
+        if (!currentDevice || currentDevice->handle != it.key()) {
+            updatedConfigKeys.clear();
+            paramUiRevision = 0;
+        }
         currentDevice = &(it.value());
+        paramPoller.setFocus(currentDevice->handle);
+        paramPoller.requestNow(currentDevice->handle);
+        applyDeviceParams(currentDevice->handle);
         if (currentDevice->is_connected) {
             if (statusLabel) statusLabel->setText("状态: 已连接");
         } else {
@@ -1676,11 +1872,60 @@ void MainWindow::updateDeviceList()
     }
 }
 
+QString MainWindow::deviceListText(const DeviceInfo& device) const
+{
+    QString text = QString("%1 (%2) - %3").arg(device.sn).arg(device.product_info).arg(device.is_streaming ? "数据流中" : "已连接");
+    ClockSyncSummary s;
+    if (clockAligner.summary(device.handle, &s) && s.state != ClockUnknown) {
+        if (s.reference) {
+            text += QString(" | 时钟: 参考, 漂移 %1 ppm").arg(s.driftPpm, 0, 'f', 1);
+        } else {
+            text += QString(" | 时钟: %1 ms, 漂移 %2 ppm")
+                        .arg(double(s.toReferenceNs) / 1e6, 0, 'f', 1)
+                        .arg(s.driftPpm, 0, 'f', 1);
+        }
+    }
+    const DeviceParamStatus p = paramPoller.status(device.handle);
+    if (p.hasTemperature) text += QString(" | %1°C").arg(p.coreTempC, 0, 'f', 1);
+    return text;
+}
+
+QString MainWindow::clockSyncToolTip(uint32_t handle) const
+{
+    ClockSyncSummary s;
+    if (!clockAligner.summary(handle, &s)) return QString();
+    return QString("时钟同步: %1%2\n相对参考设备: %3 ms\n相对主机偏移: %4 ms\n漂移: %5 ppm\n"
+                   "到达抖动: %6 us\n拟合残差: %7 us\n重新同步: %8 次\n合并时%9")
+        .arg(clockSyncStateName(s.state), s.reference ? "（参考设备）" : "")
+        .arg(double(s.toReferenceNs) / 1e6, 0, 'f', 3)
+        .arg(double(s.offsetNs) / 1e6, 0, 'f', 3)
+        .arg(s.driftPpm, 0, 'f', 2)
+        .arg(s.jitterUs, 0, 'f', 0)
+        .arg(s.residualUs, 0, 'f', 0)
+        .arg(s.resets)
+        .arg(clockAligner.isEnabled() ? "按统一时基对齐" : "使用原始时间戳");
+}
+
+void MainWindow::refreshDeviceListSync()
+{
+    if (!deviceList) return;
+    QMutexLocker locker(&deviceMutex);
+    for (int i = 0; i < deviceList->count(); ++i) {
+        QListWidgetItem* item = deviceList->item(i);
+        const uint32_t handle = item->data(Qt::UserRole).toUInt();
+        auto it = devices.constFind(handle);
+        if (it == devices.constEnd()) continue;
+        const QString text = deviceListText(it.value());
+        if (item->text() != text) item->setText(text);
+        item->setToolTip(clockSyncToolTip(handle));
+    }
+}
+
 void MainWindow::addDeviceToList(const DeviceInfo& device)
 {
-    QString deviceText = QString("%1 (%2) - %3").arg(device.sn).arg(device.product_info).arg(device.is_streaming ? "数据流中" : "已连接");
-    QListWidgetItem* item = new QListWidgetItem(deviceText);
+    QListWidgetItem* item = new QListWidgetItem(deviceListText(device));
     item->setData(Qt::UserRole, device.handle);
+    item->setToolTip(clockSyncToolTip(device.handle));
     deviceList->addItem(item);
 }
 
@@ -1691,8 +1936,7 @@ void MainWindow::updateDeviceInfo(const DeviceInfo& device)
     for (int i = 0; i < deviceList->count(); ++i) {
         QListWidgetItem* item = deviceList->item(i);
         if (item->data(Qt::UserRole).toUInt() == device.handle) {
-            QString deviceText = QString("%1 (%2) - %3").arg(device.sn).arg(device.product_info).arg(device.is_streaming ? "数据流中" : "已连接");
-            item->setText(deviceText);
+            item->setText(deviceListText(device));
             break;
         }
     }
@@ -1705,20 +1949,30 @@ void MainWindow::updateStatus()
 
 void MainWindow::logMessage(const QString& message)
 {
-    QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
-    QString logEntry = QString("[%1] %2").arg(timestamp).arg(message);
-    logText->append(logEntry);
-    qDebug() << logEntry;
+    appLog.post(LogInfo, message);
+}
+
+void MainWindow::logMessage(const QString& message, LogLevel level, const char* site)
+{
+    appLog.post(level, message, site);
+}
+
+void MainWindow::flushLogView()
+{
+    const QStringList lines = appLog.takeLines();
+    if (lines.isEmpty() || !logText) return;
+    // 一次追加全部新行，只触发一次排版
+    logText->append(lines.join('\n'));
 }
 
 void MainWindow::onTabChanged(int index)
 {
     if (!currentDevice || !currentDevice->is_connected) return;
     updatedConfigKeys.clear();
-    livox_status status = QueryLivoxLidarInternalInfo(currentDevice->handle, onQueryInternalInfoResponse, this);
-    if (status != kLivoxLidarStatusSuccess) {
-        logMessage(QString("标签页切换时查询设备参数失败，错误码: %1").arg(status));
-    }
+    paramUiRevision = 0;
+    // 先用缓存刷新，再请求一次最新值
+    applyDeviceParams(currentDevice->handle);
+    paramPoller.invalidate(currentDevice->handle, ParamGroupConfig);
 }
 
 bool MainWindow::runConfigGeneratorDialog()
@@ -2022,3 +2276,744 @@ void MainWindow::updateNoiseFilterList()
         removeNoiseFilterButton->setEnabled(!noiseFilterTags.isEmpty());
     }
 }
+
+void MainWindow::runSyntheticSourceDialog()
+{
+    // 运行中再次点击则停止
+    if (syntheticSource.isRunning()) {
+        syntheticSource.stop();
+        actionSyntheticSource->setText("模拟数据源...");
+        logMessage(QString("模拟数据源已停止：点云包 %1，点数 %2，IMU包 %3")
+                       .arg(syntheticSource.packetsSent())
+                       .arg(syntheticSource.pointsSent())
+                       .arg(syntheticSource.imuPacketsSent()));
+        statusLabelBar->setText("模拟数据源已停止");
+        return;
+    }
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("模拟数据源");
+    QVBoxLayout* v = new QVBoxLayout(&dlg);
+    QFormLayout* form = new QFormLayout();
+
+    QComboBox* comboModel = new QComboBox(&dlg);
+    for (int m = SyntheticMid360; m <= SyntheticAvia; ++m) {
+        const SyntheticModelSpec& spec = syntheticModelSpec(m);
+        comboModel->addItem(QString("%1 (%2 点/秒)").arg(spec.name).arg(spec.pointsPerSecond), m);
+    }
+    form->addRow("雷达型号:", comboModel);
+
+    QComboBox* comboDataType = new QComboBox(&dlg);
+    comboDataType->addItem("笛卡尔坐标高精度 (32bit)", int(kLivoxLidarCartesianCoordinateHighData));
+    comboDataType->addItem("笛卡尔坐标低精度 (16bit)", int(kLivoxLidarCartesianCoordinateLowData));
+    comboDataType->addItem("球坐标", int(kLivoxLidarSphericalCoordinateData));
+    form->addRow("点云数据类型:", comboDataType);
+
+    QSpinBox* spinDevices = new QSpinBox(&dlg);
+    spinDevices->setRange(1, 32);
+    spinDevices->setValue(1);
+    form->addRow("虚拟设备数:", spinDevices);
+
+    QDoubleSpinBox* spinRate = new QDoubleSpinBox(&dlg);
+    spinRate->setRange(0.1, 100.0);
+    spinRate->setDecimals(1);
+    spinRate->setSingleStep(0.5);
+    spinRate->setValue(1.0);
+    spinRate->setSuffix(" x");
+    form->addRow("速率倍数:", spinRate);
+
+    QCheckBox* cbImu = new QCheckBox("发送IMU数据", &dlg);
+    cbImu->setChecked(true);
+    form->addRow("", cbImu);
+    v->addLayout(form);
+
+    QDialogButtonBox* box = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dlg);
+    v->addWidget(box);
+    connect(box, &QDialogButtonBox::accepted, &dlg, &QDialog::accept);
+    connect(box, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+
+    if (dlg.exec() != QDialog::Accepted) return;
+
+    SyntheticSourceOptions options;
+    options.model = comboModel->currentData().toInt();
+    options.dataType = uint8_t(comboDataType->currentData().toInt());
+    options.deviceCount = spinDevices->value();
+    options.rateMultiplier = spinRate->value();
+    options.imuEnabled = cbImu->isChecked();
+
+    syntheticSource.setPointCloudCallback(onPointCloudData, this);
+    syntheticSource.setImuCallback(onImuData, this);
+    if (!syntheticSource.start(options)) {
+        QMessageBox::warning(this, "模拟数据源", "模拟数据源启动失败");
+        return;
+    }
+    actionSyntheticSource->setText("停止模拟数据源");
+    const SyntheticModelSpec& spec = syntheticModelSpec(options.model);
+    logMessage(QString("模拟数据源已启动：%1 x %2 台，%3 倍速率，约 %4 点/秒")
+                   .arg(spec.name)
+                   .arg(options.deviceCount)
+                   .arg(options.rateMultiplier)
+                   .arg(qulonglong(spec.pointsPerSecond * options.deviceCount * options.rateMultiplier)));
+    statusLabelBar->setText("模拟数据源运行中");
+}
+
+void MainWindow::setupStatsDock()
+{
+    // 性能统计 Dock（默认隐藏）
+    statsDock = new QDockWidget("性能统计", this);
+    statsDock->setObjectName("StatsDock");
+    statsDock->setAllowedAreas(Qt::AllDockWidgetAreas);
+    QWidget* content = new QWidget(statsDock);
+    QVBoxLayout* layout = new QVBoxLayout(content);
+
+    statsStageTable = new QTableWidget(StageCount, 6, content);
+    statsStageTable->setHorizontalHeaderLabels({"阶段", "平均(us)", "P50(us)", "P99(us)", "最大(us)", "次数"});
+    statsStageTable->verticalHeader()->setVisible(false);
+    statsStageTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    statsStageTable->setSelectionMode(QAbstractItemView::NoSelection);
+    statsStageTable->horizontalHeader()->setStretchLastSection(true);
+    for (int i = 0; i < StageCount; ++i) {
+        statsStageTable->setItem(i, 0, new QTableWidgetItem(QString::fromUtf8(pipelineStageName(i))));
+        for (int c = 1; c < 6; ++c) statsStageTable->setItem(i, c, new QTableWidgetItem("-"));
+    }
+    layout->addWidget(statsStageTable);
+
+    statsDeviceTable = new QTableWidget(0, 4, content);
+    statsDeviceTable->setHorizontalHeaderLabels({"设备", "包/秒", "点/秒", "队列深度"});
+    statsDeviceTable->verticalHeader()->setVisible(false);
+    statsDeviceTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    statsDeviceTable->setSelectionMode(QAbstractItemView::NoSelection);
+    statsDeviceTable->horizontalHeader()->setStretchLastSection(true);
+    layout->addWidget(statsDeviceTable);
+
+    statsSummaryLabel = new QLabel("-", content);
+    layout->addWidget(statsSummaryLabel);
+
+    // 端到端延迟：各段平均值与总延迟分布（每设备一条曲线）
+    layout->addWidget(new QLabel("端到端延迟（包到达 → 显示，ms）", content));
+    latencyTable = new QTableWidget(0, 10, content);
+    latencyTable->setHorizontalHeaderLabels({"设备", "帧数", "解码", "合并", "上传", "显示", "平均", "P50", "P99", "最大"});
+    latencyTable->verticalHeader()->setVisible(false);
+    latencyTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    latencyTable->setSelectionMode(QAbstractItemView::NoSelection);
+    latencyTable->horizontalHeader()->setStretchLastSection(true);
+    layout->addWidget(latencyTable);
+
+    latencyChart = new QChart();
+    latencyAxisX = new QValueAxis(); latencyAxisX->setTitleText("总延迟 (ms)");
+    latencyAxisX->setRange(0, LatencyTracker::kBucketMs * LatencyTracker::kBucketCount);
+    latencyAxisY = new QValueAxis(); latencyAxisY->setTitleText("帧占比 (%)"); latencyAxisY->setRange(0, 100);
+    latencyChart->addAxis(latencyAxisX, Qt::AlignBottom);
+    latencyChart->addAxis(latencyAxisY, Qt::AlignLeft);
+    latencyChart->legend()->setVisible(true);
+    QChartView* latencyChartView = new QChartView(latencyChart, content);
+    latencyChartView->setRenderHint(QPainter::Antialiasing);
+    latencyChartView->setMinimumHeight(180);
+    layout->addWidget(latencyChartView);
+
+    QHBoxLayout* buttons = new QHBoxLayout();
+    QPushButton* resetButton = new QPushButton("重置统计", content);
+    QPushButton* latencyCsvButton = new QPushButton("导出延迟CSV...", content);
+    buttons->addWidget(resetButton);
+    buttons->addWidget(latencyCsvButton);
+    layout->addLayout(buttons);
+    connect(resetButton, &QPushButton::clicked, this, [this]() {
+        pipelineStats.reset();
+        latencyTracker.reset();
+    });
+    connect(latencyCsvButton, &QPushButton::clicked, this, &MainWindow::exportLatencyCsv);
+
+    content->setLayout(layout);
+    statsDock->setWidget(content);
+    addDockWidget(Qt::RightDockWidgetArea, statsDock);
+    statsDock->hide();
+
+    actionStatsOverlay = new QAction("性能叠加层", this);
+    actionStatsOverlay->setCheckable(true);
+    viewMenu->addSeparator();
+    viewMenu->addAction(actionStatsOverlay);
+    viewMenu->addAction(statsDock->toggleViewAction());
+
+    statsTimer = new QTimer(this);
+    connect(statsTimer, &QTimer::timeout, this, &MainWindow::onStatsTick);
+    connect(actionStatsOverlay, &QAction::toggled, this, [this](bool) { updateStatsEnabled(); });
+    connect(statsDock, &QDockWidget::visibilityChanged, this, [this](bool) { updateStatsEnabled(); });
+
+    pipeline.setStats(&pipelineStats);
+    pointCloudWidget->setPipelineStats(&pipelineStats);
+    // 帧交换即该帧已提交显示
+    connect(pointCloudWidget, &QOpenGLWidget::frameSwapped, this, [this]() {
+        latencyTracker.framePresented(hostMonotonicNs());
+    });
+}
+
+void MainWindow::updateStatsEnabled()
+{
+    // 叠加层与统计面板都不可见时停止采集，记录接口只剩一次原子读
+    const bool enabled = (actionStatsOverlay && actionStatsOverlay->isChecked()) ||
+                         (statsDock && statsDock->isVisible());
+    if (enabled == pipelineStats.isEnabled()) {
+        if (!enabled && pointCloudWidget) pointCloudWidget->setStatsOverlay(false);
+        return;
+    }
+    pipelineStats.setEnabled(enabled);
+    latencyTracker.setEnabled(enabled);
+    if (enabled) {
+        pipelineStats.reset();
+        latencyTracker.reset();
+        statsTimer->start(500);
+    } else {
+        statsTimer->stop();
+        if (pointCloudWidget) pointCloudWidget->setStatsOverlay(false);
+    }
+}
+
+void MainWindow::onStatsTick()
+{
+    const PipelineStatsSnapshot snap = pipelineStats.snapshot(pipeline.pendingDepths());
+    auto us = [](double v) { return QString::number(v, 'f', v < 100.0 ? 1 : 0); };
+
+    if (statsDock && statsDock->isVisible()) {
+        for (int i = 0; i < StageCount; ++i) {
+            const StageSummary& s = snap.stages[i];
+            const bool has = s.count > 0;
+            statsStageTable->item(i, 1)->setText(has ? us(s.avgUs) : "-");
+            statsStageTable->item(i, 2)->setText(has ? us(s.p50Us) : "-");
+            statsStageTable->item(i, 3)->setText(has ? us(s.p99Us) : "-");
+            statsStageTable->item(i, 4)->setText(has ? us(s.maxUs) : "-");
+            statsStageTable->item(i, 5)->setText(QString::number(qulonglong(s.count)));
+        }
+        statsDeviceTable->setRowCount(snap.devices.size());
+        for (int r = 0; r < snap.devices.size(); ++r) {
+            const DeviceRateSummary& d = snap.devices[r];
+            const QStringList cells = { statsDeviceName(d.handle),
+                                        QString::number(d.packetsPerSec, 'f', 0),
+                                        QString::number(d.pointsPerSec, 'f', 0),
+                                        QString::number(d.queueDepth) };
+            for (int c = 0; c < cells.size(); ++c) {
+                QTableWidgetItem* item = statsDeviceTable->item(r, c);
+                if (!item) {
+                    item = new QTableWidgetItem();
+                    statsDeviceTable->setItem(r, c, item);
+                }
+                item->setText(cells[c]);
+            }
+        }
+        QString summary = QString("渲染帧率: %1 fps    每帧上传: %2 KB")
+                              .arg(snap.framesPerSec, 0, 'f', 1)
+                              .arg(snap.uploadBytesPerFrame / 1024.0, 0, 'f', 0);
+        if (pointDeskew.isEnabled()) {
+            const PointDeskewCounters dc = pointDeskew.counters();
+            summary += QString("    去畸变: %1 点（IMU不足跳过 %2）").arg(dc.deskewedPoints).arg(dc.skippedPoints);
+        }
+        statsSummaryLabel->setText(summary);
+        updateLatencyView();
+    }
+
+    if (actionStatsOverlay && actionStatsOverlay->isChecked() && pointCloudWidget) {
+        QStringList lines;
+        lines << QString("%1 %2 %3 %4 %5").arg("stage", -10).arg("avg", 8).arg("p50", 8).arg("p99", 8).arg("max(us)", 8);
+        for (int i = 0; i < StageCount; ++i) {
+            const StageSummary& s = snap.stages[i];
+            if (s.count == 0) continue;
+            lines << QString("%1 %2 %3 %4 %5").arg(QString::fromUtf8(pipelineStageName(i)), -10)
+                         .arg(us(s.avgUs), 8).arg(us(s.p50Us), 8).arg(us(s.p99Us), 8).arg(us(s.maxUs), 8);
+        }
+        for (const DeviceRateSummary& d : snap.devices) {
+            lines << QString("%1  %2 pkt/s  %3 pts/s  q=%4").arg(statsDeviceName(d.handle))
+                         .arg(d.packetsPerSec, 0, 'f', 0).arg(d.pointsPerSec, 0, 'f', 0).arg(d.queueDepth);
+        }
+        lines << QString("%1 fps  %2 KB/frame").arg(snap.framesPerSec, 0, 'f', 1)
+                     .arg(snap.uploadBytesPerFrame / 1024.0, 0, 'f', 0);
+        const RenderBudgetStatus b = pointCloudWidget->renderBudgetStatus();
+        if (b.enabled) {
+            const QString budget = b.budget > 0 ? QString::number(b.budget / 1000) + "k" : QString("-");
+            lines << QString("draw %1k / %2k pts  budget %3 @ %4 fps%5").arg(b.drawnPoints / 1000).arg(b.totalPoints / 1000)
+                         .arg(budget).arg(b.targetFps).arg(b.settled ? "  (still: full)" : "");
+        }
+        if (pointCloudWidget->isAccumulationEnabled()) {
+            const LodRenderStats l = pointCloudWidget->lodStats();
+            lines << QString("lod %1/%2 nodes  %3k/%4k pts  gpu %5 MB  up %6").arg(l.visibleNodes).arg(l.tree.nodes)
+                         .arg(l.drawnPoints / 1000).arg(qulonglong(l.tree.points / 1000)).arg(l.gpuBytes >> 20).arg(l.uploads);
+        }
+        for (const LatencyDeviceSummary& l : latencyTracker.snapshot().devices) {
+            lines << QString("%1  latency avg %2 / p99 %3 ms").arg(statsDeviceName(l.handle))
+                         .arg(l.avgMs[LatencyTotal], 0, 'f', 1).arg(l.p99TotalMs, 0, 'f', 1);
+        }
+        pointCloudWidget->setStatsOverlay(true, lines);
+    }
+}
+
+void MainWindow::exportPipelineTrace()
+{
+    if (!PipelineTrace::isEnabled()) {
+        QMessageBox::information(this, "导出追踪", "请先在 工具 → 性能追踪 中开启“记录性能追踪”并复现问题。");
+        return;
+    }
+    bool ok = false;
+    int sec = QInputDialog::getInt(this, "导出追踪", "导出最近时长(秒):", 10, 1, 600, 1, &ok);
+    if (!ok) return;
+
+    QString defaultName = QString("livox_trace_%1.json").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+    QString fileName = QFileDialog::getSaveFileName(this, "选择追踪文件保存路径",
+                                                    QDir::homePath() + "/" + defaultName,
+                                                    "Chrome Trace (*.json)");
+    if (fileName.isEmpty()) return;
+    if (!fileName.endsWith(".json", Qt::CaseInsensitive)) {
+        fileName += ".json";
+    }
+
+    QString error;
+    const int events = PipelineTrace::writeChromeTrace(fileName, sec, &error);
+    if (events < 0) {
+        logMessage(QString("追踪导出失败: %1").arg(error));
+        QMessageBox::warning(this, "导出追踪", QString("写入失败: %1").arg(error));
+        return;
+    }
+    logMessage(QString("追踪已导出: %1（%2 个事件，可在 ui.perfetto.dev 或 chrome://tracing 打开）")
+                   .arg(QDir::toNativeSeparators(fileName)).arg(events));
+    statusLabelBar->setText("追踪导出完成");
+}
+
+QString MainWindow::statsDeviceName(uint32_t handle) const
+{
+    auto it = devices.constFind(handle);
+    if (it != devices.constEnd() && !it.value().sn.isEmpty()) return it.value().sn;
+    return QString("%1.%2.%3.%4").arg(handle & 0xFF).arg((handle >> 8) & 0xFF)
+                                 .arg((handle >> 16) & 0xFF).arg((handle >> 24) & 0xFF);
+}
+
+void MainWindow::updateLatencyView()
+{
+    const LatencySnapshot snap = latencyTracker.snapshot();
+    auto ms = [](double v) { return QString::number(v, 'f', 1); };
+
+    latencyTable->setRowCount(snap.devices.size());
+    double peak = 0.0;
+    for (int r = 0; r < snap.devices.size(); ++r) {
+        const LatencyDeviceSummary& d = snap.devices[r];
+        const QStringList cells = { statsDeviceName(d.handle), QString::number(qulonglong(d.frames)),
+                                    ms(d.avgMs[LatencyDecode]), ms(d.avgMs[LatencyMerge]),
+                                    ms(d.avgMs[LatencyUpload]), ms(d.avgMs[LatencyPresent]),
+                                    ms(d.avgMs[LatencyTotal]), ms(d.p50TotalMs), ms(d.p99TotalMs), ms(d.maxTotalMs) };
+        for (int c = 0; c < cells.size(); ++c) {
+            QTableWidgetItem* item = latencyTable->item(r, c);
+            if (!item) {
+                item = new QTableWidgetItem();
+                latencyTable->setItem(r, c, item);
+            }
+            item->setText(cells[c]);
+        }
+
+        // 直方图按帧占比绘制，横坐标取桶中点
+        QLineSeries* series = latencySeries.value(d.handle, nullptr);
+        if (!series) {
+            series = new QLineSeries();
+            series->setName(statsDeviceName(d.handle));
+            latencyChart->addSeries(series);
+            series->attachAxis(latencyAxisX);
+            series->attachAxis(latencyAxisY);
+            latencySeries.insert(d.handle, series);
+        }
+        QVector<QPointF> points;
+        points.reserve(d.histogram.size());
+        for (int i = 0; i < d.histogram.size(); ++i) {
+            const double pct = d.frames ? 100.0 * d.histogram[i] / double(d.frames) : 0.0;
+            peak = std::max(peak, pct);
+            points.append(QPointF((i + 0.5) * LatencyTracker::kBucketMs, pct));
+        }
+        series->replace(points);
+    }
+    latencyAxisY->setRange(0, std::max(5.0, std::ceil(peak / 5.0) * 5.0));
+}
+
+void MainWindow::exportLatencyCsv()
+{
+    QString defaultName = QString("%1_latency.csv").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+    QString fileName = QFileDialog::getSaveFileName(this, "选择CSV文件保存路径",
+                                                    QDir::homePath() + "/" + defaultName,
+                                                    "CSV文件 (*.csv)");
+    if (fileName.isEmpty()) return;
+    if (!fileName.endsWith(".csv", Qt::CaseInsensitive)) {
+        fileName += ".csv";
+    }
+    QString error;
+    if (!latencyTracker.writeCsv(fileName, &error)) {
+        logMessage(QString("延迟CSV导出失败: %1").arg(error));
+        return;
+    }
+    logMessage(QString("延迟CSV已导出: %1").arg(QDir::toNativeSeparators(fileName)));
+}
+
+void MainWindow::setupHealthDock()
+{
+    // 数据链路健康 Dock（默认隐藏），监测本身常开以便告警
+    healthDock = new QDockWidget("链路健康", this);
+    healthDock->setObjectName("HealthDock");
+    healthDock->setAllowedAreas(Qt::AllDockWidgetAreas);
+    QWidget* content = new QWidget(healthDock);
+    QVBoxLayout* layout = new QVBoxLayout(content);
+
+    healthTable = new QTableWidget(0, 14, content);
+    healthTable->setHorizontalHeaderLabels({"设备", "数据流", "包/秒", "接收", "丢包", "丢包率", "近期丢包率",
+                                            "乱序", "重复", "重同步", "帧计数跳变", "时间戳异常", "CRC错误", "连续丢包分布"});
+    healthTable->verticalHeader()->setVisible(false);
+    healthTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    healthTable->setSelectionMode(QAbstractItemView::NoSelection);
+    healthTable->horizontalHeader()->setStretchLastSection(true);
+    layout->addWidget(healthTable);
+
+    QSettings settings("Livox", "LivoxViewerQT");
+    QHBoxLayout* alertRow = new QHBoxLayout();
+    healthAlertCheck = new QCheckBox("丢包告警", content);
+    healthAlertCheck->setChecked(settings.value("health/alertEnabled", false).toBool());
+    healthAlertThreshold = new QDoubleSpinBox(content);
+    healthAlertThreshold->setRange(0.01, 50.0);
+    healthAlertThreshold->setDecimals(2);
+    healthAlertThreshold->setSuffix(" %");
+    healthAlertThreshold->setValue(settings.value("health/alertThreshold", 1.0).toDouble());
+    crcModeCombo = new QComboBox(content);
+    crcModeCombo->addItem("关闭", int(PacketCrcOff));
+    crcModeCombo->addItem("丢弃错误包", int(PacketCrcDrop));
+    crcModeCombo->addItem("标记错误点", int(PacketCrcTag));
+    crcModeCombo->setCurrentIndex(qBound(0, settings.value("health/crcMode", int(PacketCrcOff)).toInt(), 2));
+    pipeline.setCrcMode(crcModeCombo->currentData().toInt());
+    clockAlignCheck = new QCheckBox("时钟对齐", content);
+    clockAlignCheck->setToolTip("按主机到达时间在线估计各设备时钟偏移与漂移，多设备合并前映射到统一时基；\n"
+                                "各设备已通过 PTP/GPS 同步时可关闭，直接使用原始时间戳");
+    clockAlignCheck->setChecked(settings.value("health/clockAlign", true).toBool());
+    clockAligner.setEnabled(clockAlignCheck->isChecked());
+    QPushButton* resetButton = new QPushButton("重置", content);
+    alertRow->addWidget(new QLabel("CRC校验:", content));
+    alertRow->addWidget(crcModeCombo);
+    alertRow->addSpacing(12);
+    alertRow->addWidget(clockAlignCheck);
+    alertRow->addSpacing(12);
+    alertRow->addWidget(healthAlertCheck);
+    alertRow->addWidget(new QLabel("近期丢包率超过:", content));
+    alertRow->addWidget(healthAlertThreshold);
+    alertRow->addStretch();
+    alertRow->addWidget(resetButton);
+    layout->addLayout(alertRow);
+
+    connect(healthAlertCheck, &QCheckBox::toggled, this, [](bool on) {
+        QSettings("Livox", "LivoxViewerQT").setValue("health/alertEnabled", on);
+    });
+    connect(healthAlertThreshold, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, [](double v) {
+        QSettings("Livox", "LivoxViewerQT").setValue("health/alertThreshold", v);
+    });
+    connect(crcModeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int) {
+        const int mode = crcModeCombo->currentData().toInt();
+        pipeline.setCrcMode(mode);
+        QSettings("Livox", "LivoxViewerQT").setValue("health/crcMode", mode);
+        logMessage(QString("CRC校验: %1（%2）").arg(crcModeCombo->currentText(), crc32Implementation()));
+    });
+    connect(clockAlignCheck, &QCheckBox::toggled, this, [this](bool on) {
+        clockAligner.setEnabled(on);
+        // 待处理帧的时间基不同，切换时清空
+        pipeline.clearPending();
+        QSettings("Livox", "LivoxViewerQT").setValue("health/clockAlign", on);
+        logMessage(on ? "多设备时钟对齐已开启" : "多设备时钟对齐已关闭，使用原始时间戳");
+    });
+    connect(resetButton, &QPushButton::clicked, this, [this]() {
+        streamHealth.reset();
+        pipeline.resetCrcCounters();
+        healthLastAlertMs.clear();
+        healthLastTimestampIssues.clear();
+        healthTable->setRowCount(0);
+    });
+
+    content->setLayout(layout);
+    healthDock->setWidget(content);
+    addDockWidget(Qt::BottomDockWidgetArea, healthDock);
+    healthDock->hide();
+    viewMenu->addAction(healthDock->toggleViewAction());
+
+    healthTimer = new QTimer(this);
+    connect(healthTimer, &QTimer::timeout, this, &MainWindow::onHealthTick);
+    healthTimer->start(1000);
+}
+
+void MainWindow::onHealthTick()
+{
+    refreshDeviceListSync();
+
+    const QVector<StreamHealthSummary> streams = streamHealth.snapshot();
+    const double thresholdPct = healthAlertThreshold->value();
+    lastHealthStreams = streams;
+    refreshFleetOverview();
+
+    if (telemetryWriter.isOpen()) {
+        const int64_t nowNs = QDateTime::currentMSecsSinceEpoch() * 1000000LL;
+        for (const StreamHealthSummary& s : streams) {
+            if (s.kind != StreamPointCloud) continue;
+            telemetryWriter.append(s.handle, TelemetryPacketRate, nowNs, int64_t(std::llround(s.packetsPerSec * 100.0)));
+            telemetryWriter.append(s.handle, TelemetryPacketLoss, nowNs, int64_t(std::llround(s.recentLossRate * 1e6)));
+        }
+    }
+
+    // 告警：近期丢包率超过阈值或出现新的时间戳异常，每数据流 10 秒内最多一次
+    if (healthAlertCheck->isChecked()) {
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        for (const StreamHealthSummary& s : streams) {
+            const uint64_t key = (uint64_t(s.handle) << 8) | uint64_t(s.kind);
+            const uint64_t tsIssues = s.timestampBackward + s.timestampJumps;
+            const bool lossAlert = s.recentLossRate * 100.0 > thresholdPct;
+            const bool tsAlert = tsIssues > healthLastTimestampIssues.value(key, 0);
+            healthLastTimestampIssues[key] = tsIssues;
+            if (!lossAlert && !tsAlert) continue;
+            if (nowMs - healthLastAlertMs.value(key, 0) < 10000) continue;
+            healthLastAlertMs[key] = nowMs;
+
+            const QString stream = QString("%1 %2").arg(statsDeviceName(s.handle), s.kind == StreamImu ? "IMU" : "点云");
+            if (lossAlert) {
+                logMessage(QString("[告警] %1 近期丢包率 %2%（最大连续丢包 %3），请检查网络或增大主机 socket 接收缓冲区")
+                               .arg(stream).arg(s.recentLossRate * 100.0, 0, 'f', 2).arg(s.maxGap));
+            }
+            if (tsAlert) {
+                logMessage(QString("[告警] %1 时间戳异常（回退 %2 次，跳变 %3 次，最近幅度 %4 ms）")
+                               .arg(stream).arg(s.timestampBackward).arg(s.timestampJumps)
+                               .arg(double(s.lastJumpNs) / 1e6, 0, 'f', 3));
+            }
+            statusLabelBar->setText(QString("链路告警: %1").arg(stream));
+        }
+    }
+
+    if (!healthDock || !healthDock->isVisible()) return;
+
+    const QMap<uint32_t, PacketCrcCounters> crc = pipeline.crcCounters();
+    healthTable->setRowCount(streams.size());
+    for (int r = 0; r < streams.size(); ++r) {
+        const StreamHealthSummary& s = streams[r];
+        QStringList gaps;
+        for (int b = 0; b < kStreamGapBuckets; ++b) {
+            if (s.gapHistogram[b]) gaps << QString("%1:%2").arg(streamGapBucketName(b)).arg(s.gapHistogram[b]);
+        }
+        const QStringList cells = {
+            statsDeviceName(s.handle),
+            s.kind == StreamImu ? "IMU" : "点云",
+            QString::number(s.packetsPerSec, 'f', 0),
+            QString::number(qulonglong(s.received)),
+            QString::number(qulonglong(s.lost)),
+            QString::number(s.lossRate * 100.0, 'f', 3) + "%",
+            QString::number(s.recentLossRate * 100.0, 'f', 3) + "%",
+            QString::number(qulonglong(s.reordered)),
+            QString::number(qulonglong(s.duplicates)),
+            QString::number(qulonglong(s.resyncs)),
+            QString::number(qulonglong(s.frameSkips)),
+            QString("%1/%2").arg(s.timestampBackward).arg(s.timestampJumps),
+            (s.kind == StreamPointCloud && crc.contains(s.handle))
+                ? QString("%1/%2").arg(crc.value(s.handle).failed).arg(crc.value(s.handle).checked) : QString("-"),
+            gaps.isEmpty() ? "-" : gaps.join(" ")
+        };
+        for (int c = 0; c < cells.size(); ++c) {
+            QTableWidgetItem* item = healthTable->item(r, c);
+            if (!item) {
+                item = new QTableWidgetItem();
+                healthTable->setItem(r, c, item);
+            }
+            item->setText(cells[c]);
+        }
+        QTableWidgetItem* recent = healthTable->item(r, 6);
+        recent->setForeground(s.recentLossRate * 100.0 > thresholdPct ? QBrush(Qt::red) : QBrush());
+    }
+}
+
+void MainWindow::setFleetMode(bool enabled)
+{
+    if (enabled != fleetMode.load()) {
+        if (enabled) {
+            // 已在线的设备先登记，启动时均分到各工作线程
+            QList<uint32_t> handles;
+            {
+                QMutexLocker locker(&deviceMutex);
+                handles = devices.keys();
+            }
+            for (uint32_t handle : handles) fleetIngest.addDevice(handle);
+            fleetIngest.start();
+            fleetMode.store(true);
+            for (uint32_t handle : handles) {
+                if (!fleetIngest.isRendered(handle)) pipeline.clearDevice(handle);
+            }
+            logMessage(QString("车队模式已开启：%1 个接收线程，仅解码选中显示的设备").arg(fleetIngest.workerCount()));
+        } else {
+            fleetMode.store(false);
+            fleetIngest.stop();
+            logMessage("车队模式已关闭，所有设备的数据包恢复在界面线程处理");
+        }
+        QSettings("Livox", "LivoxViewerQT").setValue("fleet/enabled", enabled);
+    }
+    if (fleetModeCheck && fleetModeCheck->isChecked() != enabled) {
+        fleetModeCheck->blockSignals(true);
+        fleetModeCheck->setChecked(enabled);
+        fleetModeCheck->blockSignals(false);
+    }
+    refreshFleetOverview();
+}
+
+void MainWindow::setFleetDeviceRendered(uint32_t handle, bool rendered)
+{
+    fleetIngest.setRendered(handle, rendered);
+    // 停止显示的设备移出合并窗口，其时间戳不再决定窗口末尾
+    if (!rendered) pipeline.clearDevice(handle);
+    auto it = fleetTiles.find(handle);
+    if (it != fleetTiles.end() && it.value().render->isChecked() != rendered) {
+        it.value().render->blockSignals(true);
+        it.value().render->setChecked(rendered);
+        it.value().render->blockSignals(false);
+    }
+}
+
+void MainWindow::onActionFleetOverview()
+{
+    if (fleetWindow && fleetWindow->isVisible()) {
+        fleetWindow->raise();
+        fleetWindow->activateWindow();
+        return;
+    }
+    fleetWindow = new QWidget(this, Qt::Window);
+    fleetWindow->setAttribute(Qt::WA_DeleteOnClose);
+    fleetWindow->setWindowTitle("设备总览");
+    fleetWindow->resize(960, 600);
+    QVBoxLayout* layout = new QVBoxLayout(fleetWindow);
+
+    QHBoxLayout* topRow = new QHBoxLayout();
+    fleetModeCheck = new QCheckBox("车队模式", fleetWindow);
+    fleetModeCheck->setToolTip("数据包在回调线程按设备入队，由多个工作线程并行解码与录制，不经过界面线程；\n"
+                               "只有勾选“显示点云”的设备参与合并渲染，其余设备只统计与录制");
+    fleetModeCheck->setChecked(fleetMode.load());
+    QPushButton* showAllButton = new QPushButton("全部显示", fleetWindow);
+    QPushButton* hideAllButton = new QPushButton("全部隐藏", fleetWindow);
+    fleetSummaryLabel = new QLabel(fleetWindow);
+    topRow->addWidget(fleetModeCheck);
+    topRow->addWidget(showAllButton);
+    topRow->addWidget(hideAllButton);
+    topRow->addSpacing(12);
+    topRow->addWidget(fleetSummaryLabel, 1);
+    layout->addLayout(topRow);
+
+    QScrollArea* scroll = new QScrollArea(fleetWindow);
+    scroll->setWidgetResizable(true);
+    QWidget* tiles = new QWidget(scroll);
+    fleetGrid = new QGridLayout(tiles);
+    fleetGrid->setSpacing(6);
+    fleetGrid->setAlignment(Qt::AlignTop | Qt::AlignLeft);
+    scroll->setWidget(tiles);
+    layout->addWidget(scroll, 1);
+
+    connect(fleetModeCheck, &QCheckBox::toggled, this, &MainWindow::setFleetMode);
+    connect(showAllButton, &QPushButton::clicked, this, [this]() {
+        if (!fleetMode.load()) return;
+        for (uint32_t handle : fleetTiles.keys()) setFleetDeviceRendered(handle, true);
+    });
+    connect(hideAllButton, &QPushButton::clicked, this, [this]() {
+        if (!fleetMode.load()) return;
+        for (uint32_t handle : fleetTiles.keys()) setFleetDeviceRendered(handle, false);
+    });
+    connect(fleetWindow, &QObject::destroyed, this, [this]() {
+        fleetWindow = nullptr;
+        fleetModeCheck = nullptr;
+        fleetSummaryLabel = nullptr;
+        fleetGrid = nullptr;
+        fleetTiles.clear();
+    });
+
+    refreshFleetOverview();
+    fleetWindow->show();
+}
+
+void MainWindow::refreshFleetOverview()
+{
+    if (!fleetWindow || !fleetGrid) return;
+    const int columns = 4;
+
+    QVector<FleetWorkerStats> workers;
+    QMap<uint32_t, FleetDeviceStats> fleet;
+    for (const FleetDeviceStats& s : fleetIngest.snapshot(&workers)) fleet.insert(s.handle, s);
+    QMap<uint32_t, StreamHealthSummary> health;
+    for (const StreamHealthSummary& s : lastHealthStreams) {
+        if (s.kind == StreamPointCloud) health.insert(s.handle, s);
+    }
+    QList<uint32_t> handles;
+    {
+        QMutexLocker locker(&deviceMutex);
+        handles = devices.keys();
+    }
+
+    // 设备增减时重建磁贴，否则只更新文字
+    if (handles != fleetTiles.keys()) {
+        for (const FleetTile& t : fleetTiles) delete t.frame;
+        fleetTiles.clear();
+        QWidget* parent = fleetGrid->parentWidget();
+        for (int i = 0; i < handles.size(); ++i) {
+            const uint32_t handle = handles[i];
+            FleetTile t;
+            t.frame = new QFrame(parent);
+            t.frame->setObjectName("FleetTile");
+            t.frame->setMinimumWidth(210);
+            QVBoxLayout* v = new QVBoxLayout(t.frame);
+            v->setContentsMargins(6, 4, 6, 4);
+            v->setSpacing(2);
+            t.title = new QLabel(t.frame);
+            t.title->setStyleSheet("font-weight: bold;");
+            t.stats = new QLabel(t.frame);
+            t.render = new QCheckBox("显示点云", t.frame);
+            v->addWidget(t.title);
+            v->addWidget(t.stats);
+            v->addWidget(t.render);
+            connect(t.render, &QCheckBox::toggled, this, [this, handle](bool on) { setFleetDeviceRendered(handle, on); });
+            fleetGrid->addWidget(t.frame, i / columns, i % columns);
+            fleetTiles.insert(handle, t);
+        }
+    }
+
+    const bool fleetOn = fleetMode.load();
+    const double thresholdPct = healthAlertThreshold ? healthAlertThreshold->value() : 1.0;
+    int rendered = 0;
+    for (auto it = fleetTiles.begin(); it != fleetTiles.end(); ++it) {
+        const uint32_t handle = it.key();
+        FleetTile& t = it.value();
+        const StreamHealthSummary h = health.value(handle);
+        const FleetDeviceStats f = fleet.value(handle);
+        const DeviceParamStatus p = paramPoller.status(handle);
+
+        QStringList lines;
+        lines << QString("%1 包/s  丢包 %2%").arg(h.packetsPerSec, 0, 'f', 0).arg(h.recentLossRate * 100.0, 0, 'f', 2);
+        lines << (p.hasTemperature ? QString("温度 %1 °C").arg(p.coreTempC, 0, 'f', 1) : QString("温度 -"));
+        if (fleetOn) {
+            lines << QString("线程 %1  %2 us/包  队列丢弃 %3").arg(f.worker).arg(f.busyUsPerPacket, 0, 'f', 1).arg(f.dropped);
+        }
+        const QString text = lines.join('\n');
+        if (t.title->text() != statsDeviceName(handle)) t.title->setText(statsDeviceName(handle));
+        if (t.stats->text() != text) t.stats->setText(text);
+
+        // 边框：灰 无数据；红 丢包超过告警阈值；橙 接收队列溢出；绿 正常
+        QString color = "#4caf50";
+        if (h.packetsPerSec <= 0.0) color = "#9e9e9e";
+        else if (h.recentLossRate * 100.0 > thresholdPct) color = "#e53935";
+        else if (fleetOn && f.dropped > 0) color = "#fb8c00";
+        if (t.color != color) {
+            t.color = color;
+            t.frame->setStyleSheet(QString("QFrame#FleetTile { border: 2px solid %1; border-radius: 4px; }").arg(color));
+        }
+
+        const bool on = fleetOn ? f.rendered : true;
+        if (on) rendered++;
+        t.render->setEnabled(fleetOn);
+        if (t.render->isChecked() != on) {
+            t.render->blockSignals(true);
+            t.render->setChecked(on);
+            t.render->blockSignals(false);
+        }
+    }
+
+    QString summary = QString("%1 台设备，显示 %2 台").arg(fleetTiles.size()).arg(rendered);
+    if (fleetOn) {
+        QStringList busy;
+        for (const FleetWorkerStats& w : workers) busy << QString("%1%").arg(w.busyRatio * 100.0, 0, 'f', 0);
+        summary += QString("；接收线程 %1，忙碌 %2").arg(workers.size()).arg(busy.join(" / "));
+    } else {
+        summary += "（车队模式关闭：所有设备在界面线程解码并显示）";
+    }
+    fleetSummaryLabel->setText(summary);
+}